@@ -0,0 +1,156 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestModifiedContention.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test speed of Modified() under contention.
+// .SECTION Description
+// Time vtkObject::Modified on distinct arrays from all SMP threads, compare
+// with the same number of calls from a single thread, and check that the
+// modified times stay unique and ordered.
+
+#include "vtkCommand.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+const vtkIdType NUMBER_OF_ARRAYS = 64;
+const int MODIFIED_PER_ARRAY = 20000;
+
+class ModifiedFunctor
+{
+public:
+  std::vector<vtkSmartPointer<vtkFloatArray> >& Arrays;
+  vtkSMPThreadLocal<std::vector<vtkMTimeType> > Times;
+  bool Ordered;
+
+  ModifiedFunctor(std::vector<vtkSmartPointer<vtkFloatArray> >& arrays)
+    : Arrays(arrays), Ordered(true) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<vtkMTimeType>& times = this->Times.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkFloatArray* array = this->Arrays[i];
+      vtkMTimeType last = array->GetMTime();
+      for (int j = 0; j < MODIFIED_PER_ARRAY; ++j)
+      {
+        array->Modified();
+        vtkMTimeType current = array->GetMTime();
+        if (current <= last)
+        {
+          this->Ordered = false;
+        }
+        last = current;
+      }
+      times.push_back(last);
+    }
+  }
+};
+
+class vtkCountingCommand : public vtkCommand
+{
+public:
+  static vtkCountingCommand* New() { return new vtkCountingCommand; }
+  void Execute(vtkObject*, unsigned long, void*) override { ++this->Count; }
+  int Count;
+
+protected:
+  vtkCountingCommand() : Count(0) {}
+};
+
+}
+
+int TestModifiedContention(int, char*[])
+{
+  std::vector<vtkSmartPointer<vtkFloatArray> > arrays(NUMBER_OF_ARRAYS);
+  for (vtkIdType i = 0; i < NUMBER_OF_ARRAYS; ++i)
+  {
+    arrays[i] = vtkSmartPointer<vtkFloatArray>::New();
+  }
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  ModifiedFunctor serial(arrays);
+  serial(0, NUMBER_OF_ARRAYS);
+  timer->StopTimer();
+  double serialTime = timer->GetElapsedTime();
+
+  timer->StartTimer();
+  ModifiedFunctor parallel(arrays);
+  vtkSMPTools::For(0, NUMBER_OF_ARRAYS, 1, parallel);
+  timer->StopTimer();
+  double parallelTime = timer->GetElapsedTime();
+
+  double callCount = static_cast<double>(NUMBER_OF_ARRAYS) * MODIFIED_PER_ARRAY;
+  std::cout << "<DartMeasurement name=\"ModifiedSerial\" type=\"numeric/double\">"
+            << 1.0e9 * serialTime / callCount << "</DartMeasurement>" << std::endl;
+  std::cout << "<DartMeasurement name=\"ModifiedContended\" type=\"numeric/double\">"
+            << 1.0e9 * parallelTime / callCount << "</DartMeasurement>" << std::endl;
+  std::cout << "Modified(): " << 1.0e9 * serialTime / callCount << " ns serial, "
+            << 1.0e9 * parallelTime / callCount << " ns/call with "
+            << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads" << std::endl;
+
+  // Every thread sees increasing times, and no two calls share a time.
+  if (!serial.Ordered || !parallel.Ordered)
+  {
+    std::cerr << "Modified times are not increasing." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<vtkMTimeType> times;
+  vtkSMPThreadLocal<std::vector<vtkMTimeType> >::iterator it;
+  for (it = parallel.Times.begin(); it != parallel.Times.end(); ++it)
+  {
+    times.insert(times.end(), it->begin(), it->end());
+  }
+  std::sort(times.begin(), times.end());
+  if (static_cast<vtkIdType>(times.size()) != NUMBER_OF_ARRAYS ||
+      std::adjacent_find(times.begin(), times.end()) != times.end())
+  {
+    std::cerr << "Modified times are not unique." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Modifying an array does not allocate its information.
+  vtkNew<vtkFloatArray> fresh;
+  fresh->Modified();
+  if (fresh->HasInformation())
+  {
+    std::cerr << "Modified() created the array information." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Observers still see ModifiedEvent, and nothing once removed.
+  vtkNew<vtkCountingCommand> observer;
+  unsigned long tag = fresh->AddObserver(vtkCommand::ModifiedEvent, observer.GetPointer());
+  vtkMTimeType before = fresh->GetMTime();
+  fresh->Modified();
+  fresh->RemoveObserver(tag);
+  fresh->Modified();
+  if (observer->Count != 1 || fresh->GetMTime() <= before)
+  {
+    std::cerr << "ModifiedEvent invoked " << observer->Count << " times." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
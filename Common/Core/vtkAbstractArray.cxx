@@ -310,11 +310,16 @@ int vtkAbstractArray::CopyInformation(vtkInformation* infoFrom, int deep)
 // call modified on superclass
 void vtkAbstractArray::Modified()
 {
-    vtkInformation *info = this->GetInformation();
-    // Clear key-value pairs that are now out of date.
+  // Clear key-value pairs that are now out of date. Do not create the
+  // information just to clear it: Modified() is called for every
+  // array written by a filter, often from many threads.
+  if (this->HasInformation())
+  {
+    vtkInformation *info = this->Information;
     info->Remove(PER_COMPONENT());
     info->Remove(PER_FINITE_COMPONENT());
-    this->Superclass::Modified();
+  }
+  this->Superclass::Modified();
 }
 
 //----------------------------------------------------------------------------
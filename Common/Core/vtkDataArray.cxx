@@ -1632,11 +1632,14 @@ void vtkDataArray::ComputeRange(double range[2], int comp)
 // call modified on superclass
 void vtkDataArray::Modified()
 {
-    vtkInformation *info = this->GetInformation();
+  if (this->HasInformation())
+  {
+    vtkInformation *info = this->Information;
     // Clear key-value pairs that are now out of date.
     info->Remove(L2_NORM_RANGE());
     info->Remove(L2_NORM_FINITE_RANGE());
-    this->Superclass::Modified();
+  }
+  this->Superclass::Modified();
 }
 
 namespace
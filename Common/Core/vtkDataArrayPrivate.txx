@@ -154,7 +154,11 @@ public:
   {
     VTK_ASSUME(this->Array->GetNumberOfComponents() == NumComps);
     vtkDataArrayAccessor<ArrayT> access(this->Array);
-    auto &range = MinAndMaxT::TLRange.Local();
+    // Work on a local copy: the thread local range may alias the array
+    // values, which would keep the compiler from holding the range in
+    // registers and vectorizing the loop.
+    auto &tlRange = MinAndMaxT::TLRange.Local();
+    std::array<APIType, 2 * NumComps> range = tlRange;
     for(vtkIdType tupleIdx = begin; tupleIdx < end; ++tupleIdx)
     {
       for(int compIdx = 0, j = 0; compIdx < NumComps; ++compIdx, j+=2)
@@ -164,6 +168,7 @@ public:
         range[j+1] = detail::max(range[j+1], value);
       }
     }
+    tlRange = range;
   }
 };
 
@@ -188,7 +193,9 @@ public:
   {
     VTK_ASSUME(this->Array->GetNumberOfComponents() == NumComps);
     vtkDataArrayAccessor<ArrayT> access(this->Array);
-    auto &range = MinAndMaxT::TLRange.Local();
+    // See AllValuesMinAndMax.
+    auto &tlRange = MinAndMaxT::TLRange.Local();
+    std::array<APIType, 2 * NumComps> range = tlRange;
     for(vtkIdType tupleIdx = begin; tupleIdx < end; ++tupleIdx)
     {
       for(int compIdx = 0, j = 0; compIdx < NumComps; ++compIdx, j+=2)
@@ -201,6 +208,7 @@ public:
         }
       }
     }
+    tlRange = range;
   }
 };
 
@@ -201,18 +201,30 @@ void vtkInformation::Clear()
 //----------------------------------------------------------------------------
 void vtkInformation::Copy(vtkInformation* from, int deep)
 {
-  vtkInformationInternals* oldInternal = this->Internal;
-  this->Internal = new vtkInformationInternals;
+  // Move the current entries aside and fill the recycled storage. The old
+  // values are released only once the copy is done since they may own
+  // the values being copied.
+  typedef vtkInformationInternals::MapType MapType;
+  MapType oldMap;
+  oldMap.swap(this->Internal->Spare);
+  oldMap.swap(this->Internal->Map);
   if(from)
   {
-    typedef vtkInformationInternals::MapType MapType;
     for(MapType::const_iterator i = from->Internal->Map.begin();
         i != from->Internal->Map.end(); ++i)
     {
       this->CopyEntry(from, i->first, deep);
     }
   }
-  delete oldInternal;
+  for(MapType::iterator i = oldMap.begin(); i != oldMap.end(); ++i)
+  {
+    i->second->UnRegister(nullptr);
+  }
+  oldMap.clear();
+  if(this->Internal->Spare.empty())
+  {
+    this->Internal->Spare.swap(oldMap);
+  }
 }
 
 //----------------------------------------------------------------------------
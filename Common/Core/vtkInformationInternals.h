@@ -27,12 +27,8 @@
 #include "vtkInformationKey.h"
 #include "vtkObjectBase.h"
 
-#define VTK_INFORMATION_USE_HASH_MAP
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-# include <vtksys/hash_map.hxx>
-#else
-# include <map>
-#endif
+#include <utility>
+#include <vector>
 
 //----------------------------------------------------------------------------
 class vtkInformationInternals
@@ -40,23 +36,65 @@ class vtkInformationInternals
 public:
   typedef vtkInformationKey* KeyType;
   typedef vtkObjectBase* DataType;
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  struct HashFun
+
+  // Information objects rarely hold more than a few tens of entries, and
+  // the same objects are filled, copied and cleared for every pipeline
+  // request. A flat array searched linearly is faster than a hash table
+  // at these sizes and does not allocate a node per entry or a bucket
+  // table per object. The interface is the subset of std::map used by
+  // vtkInformation and vtkInformationIterator.
+  class MapType
   {
-    size_t operator()(KeyType key) const
+  public:
+    typedef std::pair<KeyType, DataType> value_type;
+    typedef std::vector<value_type>::iterator iterator;
+    typedef std::vector<value_type>::const_iterator const_iterator;
+
+    iterator begin() { return this->Entries.begin(); }
+    iterator end() { return this->Entries.end(); }
+    const_iterator begin() const { return this->Entries.begin(); }
+    const_iterator end() const { return this->Entries.end(); }
+    size_t size() const { return this->Entries.size(); }
+    bool empty() const { return this->Entries.empty(); }
+
+    iterator find(KeyType key)
     {
-      return static_cast<size_t>(key - KeyType(nullptr));
+      iterator i = this->Entries.begin();
+      iterator e = this->Entries.end();
+      while(i != e && i->first != key)
+      {
+        ++i;
+      }
+      return i;
     }
+    const_iterator find(KeyType key) const
+    {
+      const_iterator i = this->Entries.begin();
+      const_iterator e = this->Entries.end();
+      while(i != e && i->first != key)
+      {
+        ++i;
+      }
+      return i;
+    }
+
+    // The caller guarantees that the key is not present yet.
+    void insert(const value_type& entry) { this->Entries.push_back(entry); }
+    void erase(iterator i) { this->Entries.erase(i); }
+
+    // Removes all entries but keeps the allocated storage.
+    void clear() { this->Entries.clear(); }
+    void swap(MapType& other) { this->Entries.swap(other.Entries); }
+
+  private:
+    std::vector<value_type> Entries;
   };
-  typedef vtksys::hash_map<KeyType, DataType, HashFun> MapType;
-#else
-  typedef std::map<KeyType, DataType> MapType;
-#endif
+
   MapType Map;
 
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  vtkInformationInternals(): Map(33) {}
-#endif
+  // Storage recycled by vtkInformation::Copy so that re-filling the same
+  // information object does not allocate. Always empty between calls.
+  MapType Spare;
 
   ~vtkInformationInternals()
   {
@@ -70,7 +108,5 @@ public:
   }
 };
 
-#undef VTK_INFORMATION_USE_HASH_MAP
-
 #endif
 // VTK-HeaderTest-Exclude: vtkInformationInternals.h
@@ -108,6 +108,7 @@ public:
   unsigned long GetTag(vtkCommand*);
   int HasObserver(unsigned long event);
   int HasObserver(unsigned long event, vtkCommand *cmd);
+  int HasObservers() { return this->Start != nullptr; }
   void GrabFocus(vtkCommand *c1, vtkCommand *c2) {this->Focus1 = c1; this->Focus2 = c2;}
   void ReleaseFocus() {this->Focus1 = nullptr; this->Focus2 = nullptr;}
   void PrintSelf(ostream& os, vtkIndent indent);
@@ -460,6 +461,12 @@ int vtkSubjectHelper::HasObserver(unsigned long event, vtkCommand *cmd)
 int vtkSubjectHelper::InvokeEvent(unsigned long event, void *callData,
                                    vtkObject *self)
 {
+  // Nothing to dispatch once every observer has been removed.
+  if (!this->Start)
+  {
+    return 0;
+  }
+
   int focusHandled = 0;
 
   // When we invoke an event, the observer may add or remove observers.  To make
@@ -848,7 +855,11 @@ void vtkObject::InternalReleaseFocus()
 void vtkObject::Modified()
 {
   this->MTime.Modified();
-  this->InvokeEvent(vtkCommand::ModifiedEvent,nullptr);
+  // Most objects have no observer: skip the event dispatch entirely.
+  if (this->SubjectHelper && this->SubjectHelper->HasObservers())
+  {
+    this->SubjectHelper->InvokeEvent(vtkCommand::ModifiedEvent, nullptr, this);
+  }
 }
 
 //----------------------------------------------------------------------------
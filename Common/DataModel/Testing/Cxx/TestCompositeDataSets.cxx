@@ -16,8 +16,11 @@
 #include "vtkDataObjectTree.h"
 #include "vtkDataObjectTreeIterator.h"
 #include "vtkInformation.h"
+#include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkSmartPointer.h"
 #include "vtkStdString.h"
 #include "vtkUniformGrid.h"
@@ -27,11 +30,90 @@
 #include <vector>
 
 
+//------------------------------------------------------------------------------
+static vtkSmartPointer<vtkPolyData> MakeSegment(double x0, double x1)
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(x0, 0.0, -x0);
+  points->InsertNextPoint(x1, 1.0, -x1);
+  vtkSmartPointer<vtkPolyData> pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points.GetPointer());
+  return pd;
+}
+
+//------------------------------------------------------------------------------
+static bool CheckBounds(vtkCompositeDataSet* cds, double xmin, double xmax)
+{
+  double bounds[6];
+  cds->GetBounds(bounds);
+  if (bounds[0] != xmin || bounds[1] != xmax || bounds[2] != 0.0 ||
+      bounds[3] != 1.0 || bounds[4] != -xmax || bounds[5] != -xmin)
+  {
+    std::cerr << "Wrong bounds " << bounds[0] << " " << bounds[1] << " "
+              << bounds[2] << " " << bounds[3] << " " << bounds[4] << " "
+              << bounds[5] << ", expected x in [" << xmin << ", " << xmax
+              << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+static int TestCompositeDataSetBounds()
+{
+  int errors = 0;
+
+  // Nested blocks, an empty leaf, a null block and a shared leaf.
+  vtkNew<vtkMultiBlockDataSet> root;
+  vtkNew<vtkMultiBlockDataSet> nested;
+  vtkSmartPointer<vtkPolyData> shared = MakeSegment(2.0, 3.0);
+  nested->SetBlock(0, MakeSegment(-1.0, 0.5));
+  nested->SetBlock(1, shared);
+  root->SetBlock(0, nested.GetPointer());
+  root->SetBlock(1, shared);
+  root->SetBlock(2, vtkSmartPointer<vtkPolyData>::New());
+  root->SetBlock(3, nullptr);
+  errors += !CheckBounds(root.GetPointer(), -1.0, 3.0);
+
+  // Modifying the points of a leaf invalidates the cached bounds.
+  shared->GetPoints()->SetPoint(1, 5.0, 1.0, -5.0);
+  shared->GetPoints()->Modified();
+  errors += !CheckBounds(root.GetPointer(), -1.0, 5.0);
+
+  // So does replacing a block deep in the tree.
+  nested->SetBlock(0, MakeSegment(0.0, 1.0));
+  errors += !CheckBounds(root.GetPointer(), 0.0, 5.0);
+
+  // Leaves sharing their points.
+  vtkNew<vtkPolyData> sharedPoints;
+  sharedPoints->SetPoints(shared->GetPoints());
+  root->SetBlock(2, sharedPoints.GetPointer());
+  errors += !CheckBounds(root.GetPointer(), 0.0, 5.0);
+  shared->GetPoints()->SetPoint(0, -2.0, 0.0, 2.0);
+  shared->GetPoints()->Modified();
+  errors += !CheckBounds(root.GetPointer(), -2.0, 5.0);
+
+  // No point at all gives uninitialized bounds.
+  vtkNew<vtkMultiBlockDataSet> empty;
+  empty->SetBlock(0, vtkSmartPointer<vtkPolyData>::New());
+  double bounds[6];
+  empty->GetBounds(bounds);
+  if (vtkMath::AreBoundsInitialized(bounds))
+  {
+    std::cerr << "Bounds of empty blocks should be uninitialized." << std::endl;
+    ++errors;
+  }
+
+  return errors;
+}
+
 //------------------------------------------------------------------------------
 int TestCompositeDataSets(int , char *[])
 {
   int errors = 0;
 
+  errors += TestCompositeDataSetBounds();
+
 
   return( errors );
 }
@@ -0,0 +1,178 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConcurrentUnionFind.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Merge random pairs of ids concurrently, and compare the labels with the
+// ones of a serial union-find.
+
+#include "vtkConcurrentUnionFind.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+struct UnionEdges
+{
+  vtkConcurrentUnionFind *Sets;
+  const vtkIdType *Edges;
+
+  UnionEdges(vtkConcurrentUnionFind *sets, const vtkIdType *edges) :
+    Sets(sets), Edges(edges) {}
+
+  void operator() (vtkIdType edgeId, vtkIdType endEdgeId)
+  {
+    for ( ; edgeId < endEdgeId; ++edgeId)
+    {
+      this->Sets->Union(this->Edges[2*edgeId], this->Edges[2*edgeId+1]);
+    }
+  }
+};
+
+vtkIdType SerialFind(std::vector<vtkIdType> &parent, vtkIdType id)
+{
+  while ( parent[id] != id )
+  {
+    id = parent[id] = parent[parent[id]];
+  }
+  return id;
+}
+
+// Label the ids like vtkConcurrentUnionFind, numbering the sets in the order
+// of their smallest id.
+vtkIdType SerialLabel(vtkIdType numIds, const std::vector<vtkIdType> &edges,
+                      const unsigned char *mask, std::vector<vtkIdType> &labels)
+{
+  std::vector<vtkIdType> parent(numIds);
+  for (vtkIdType id=0; id < numIds; ++id)
+  {
+    parent[id] = id;
+  }
+  for (size_t i=0; i < edges.size(); i+=2)
+  {
+    vtkIdType root = SerialFind(parent, edges[i]);
+    vtkIdType root2 = SerialFind(parent, edges[i+1]);
+    parent[std::max(root,root2)] = std::min(root,root2);
+  }
+  std::vector<vtkIdType> setIds(numIds, -1);
+  vtkIdType numSets = 0;
+  labels.resize(numIds);
+  for (vtkIdType id=0; id < numIds; ++id)
+  {
+    if ( mask && !mask[id] )
+    {
+      labels[id] = -1;
+      continue;
+    }
+    vtkIdType root = SerialFind(parent, id);
+    if ( setIds[root] < 0 )
+    {
+      setIds[root] = numSets++;
+    }
+    labels[id] = setIds[root];
+  }
+  return numSets;
+}
+
+int CheckLabels(const char *name, vtkIdType numIds,
+                const std::vector<vtkIdType> &edges, const unsigned char *mask)
+{
+  vtkConcurrentUnionFind sets;
+  sets.Initialize(numIds);
+  UnionEdges unionEdges(&sets, &edges[0]);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(edges.size()/2), unionEdges);
+  std::vector<vtkIdType> labels(numIds);
+  vtkIdType numSets = sets.Label(&labels[0], mask);
+
+  std::vector<vtkIdType> expected;
+  vtkIdType expectedNumSets = SerialLabel(numIds, edges, mask, expected);
+  if ( numSets != expectedNumSets )
+  {
+    cerr << name << ": found " << numSets << " sets instead of "
+         << expectedNumSets << endl;
+    return 1;
+  }
+  for (vtkIdType id=0; id < numIds; ++id)
+  {
+    if ( labels[id] != expected[id] )
+    {
+      cerr << name << ": id " << id << " is labeled " << labels[id]
+           << " instead of " << expected[id] << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+}
+
+int TestConcurrentUnionFind(int, char *[])
+{
+  const vtkIdType numIds = 200000;
+  int errors = 0;
+
+  // Sparse random edges leave many sets
+  std::vector<vtkIdType> edges;
+  unsigned int seed = 1;
+  for (vtkIdType i=0; i < numIds/2; ++i)
+  {
+    seed = seed * 1103515245 + 12345;
+    vtkIdType id = (seed >> 8) % numIds;
+    seed = seed * 1103515245 + 12345;
+    vtkIdType id2 = (seed >> 8) % numIds;
+    edges.push_back(id);
+    edges.push_back(id2);
+  }
+  errors += CheckLabels("Random edges", numIds, edges, nullptr);
+
+  // Long chains, built from both ends
+  edges.clear();
+  for (vtkIdType id=numIds-1; id > 0; --id)
+  {
+    if ( id % 1000 )
+    {
+      edges.push_back(id);
+      edges.push_back(id-1);
+    }
+  }
+  for (vtkIdType id=1; id < numIds/2; ++id)
+  {
+    if ( id % 1000 )
+    {
+      edges.push_back(id-1);
+      edges.push_back(id);
+    }
+  }
+  errors += CheckLabels("Chains", numIds, edges, nullptr);
+
+  // Masked ids are left alone
+  std::vector<unsigned char> mask(numIds);
+  for (vtkIdType id=0; id < numIds; ++id)
+  {
+    mask[id] = ( id % 7 != 3 );
+  }
+  edges.clear();
+  for (vtkIdType id=2; id < numIds; ++id)
+  {
+    vtkIdType id2 = id/2 + (id % 5);
+    if ( mask[id] && mask[id2] )
+    {
+      edges.push_back(id);
+      edges.push_back(id2);
+    }
+  }
+  errors += CheckLabels("Masked ids", numIds, edges, &mask[0]);
+
+  return ( errors ? EXIT_FAILURE : EXIT_SUCCESS );
+}
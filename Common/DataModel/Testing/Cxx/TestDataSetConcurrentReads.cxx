@@ -0,0 +1,213 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetConcurrentReads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Read vtkPolyData and vtkUnstructuredGrid from all SMP threads through the
+// thread-safe API, letting the first calls build the cells and links, and
+// check that the concurrency checks report unsafe uses.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vector>
+
+namespace
+{
+
+const int RESOLUTION = 60;
+
+// Expose the access checks to simulate a read in progress in another thread.
+class vtkReadablePolyData : public vtkPolyData
+{
+public:
+  static vtkReadablePolyData* New();
+  vtkTypeMacro(vtkReadablePolyData, vtkPolyData);
+  void BeginRead() { this->BeginAccess(false); }
+  void EndRead() { this->EndAccess(false); }
+  bool HasLinks() { return this->Links != nullptr; }
+};
+vtkStandardNewMacro(vtkReadablePolyData);
+
+void MakeQuads(vtkPolyData* pd, vtkUnstructuredGrid* ug)
+{
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= RESOLUTION; ++j)
+  {
+    for (int i = 0; i <= RESOLUTION; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.0);
+    }
+  }
+  vtkNew<vtkCellArray> quads;
+  for (int j = 0; j < RESOLUTION; ++j)
+  {
+    for (int i = 0; i < RESOLUTION; ++i)
+    {
+      vtkIdType p = i + j * (RESOLUTION + 1);
+      vtkIdType quad[4] = { p, p + 1, p + RESOLUTION + 2, p + RESOLUTION + 1 };
+      quads->InsertNextCell(4, quad);
+    }
+  }
+  pd->SetPoints(points.GetPointer());
+  pd->SetPolys(quads.GetPointer());
+  ug->SetPoints(points.GetPointer());
+  ug->SetCells(VTK_QUAD, quads.GetPointer());
+}
+
+// For each cell, sum its point ids, the number of cells using its first
+// point, its type and the x coordinate of its first point.
+class ReadFunctor
+{
+public:
+  vtkDataSet* DataSet;
+  std::vector<double>& Sums;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  ReadFunctor(vtkDataSet* ds, std::vector<double>& sums) : DataSet(ds), Sums(sums) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* ptIds = this->PointIds.Local();
+    vtkIdList* cellIds = this->CellIds.Local();
+    vtkGenericCell* cell = this->Cell.Local();
+    for (vtkIdType c = begin; c < end; ++c)
+    {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      this->DataSet->GetCellPoints(c, npts, pts, ptIds);
+      double sum = 0.0;
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        sum += pts[i];
+      }
+      this->DataSet->GetPointCells(pts[0], cellIds);
+      this->DataSet->GetCell(c, cell);
+      this->Sums[c] = sum + cellIds->GetNumberOfIds() +
+        this->DataSet->GetCellType(c) + cell->GetPoints()->GetPoint(0)[0];
+    }
+  }
+};
+
+bool CheckReads(vtkDataSet* ds)
+{
+  vtkIdType numCells = ds->GetNumberOfCells();
+  std::vector<double> parallel(numCells);
+  ReadFunctor functor(ds, parallel);
+  vtkSMPTools::For(0, numCells, functor);
+
+  vtkNew<vtkIdList> ptIds;
+  vtkNew<vtkIdList> cellIds;
+  for (vtkIdType c = 0; c < numCells; ++c)
+  {
+    ds->GetCellPoints(c, ptIds.GetPointer());
+    double sum = 0.0;
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+    {
+      sum += ptIds->GetId(i);
+    }
+    ds->GetPointCells(ptIds->GetId(0), cellIds.GetPointer());
+    sum += cellIds->GetNumberOfIds() + ds->GetCellType(c) + ds->GetPoint(ptIds->GetId(0))[0];
+    if (sum != parallel[c])
+    {
+      cerr << ds->GetClassName() << ": wrong result for cell " << c << endl;
+      return false;
+    }
+  }
+  if (ds->GetNumberOfConcurrencyViolations() != 0)
+  {
+    cerr << ds->GetClassName() << ": unexpected concurrency violations" << endl;
+    return false;
+  }
+  return true;
+}
+
+}
+
+int TestDataSetConcurrentReads(int, char*[])
+{
+  vtkDataSet::GlobalConcurrencyChecksOn();
+
+  // The polydata builds its cells and links in the first threaded calls,
+  // the grid builds its links up front, on request.
+  vtkNew<vtkReadablePolyData> pd;
+  vtkNew<vtkUnstructuredGrid> ug;
+  MakeQuads(pd.GetPointer(), ug.GetPointer());
+  if (!pd->NeedToBuildCells() || pd->HasLinks() || ug->GetCellLinks())
+  {
+    cerr << "Cells or links built too early." << endl;
+    return EXIT_FAILURE;
+  }
+  ug->PrepareForConcurrentReads();
+  if (ug->GetCellLinks())
+  {
+    cerr << "Links built without being requested." << endl;
+    return EXIT_FAILURE;
+  }
+  ug->PrepareForConcurrentReads(true);
+  if (!ug->GetCellLinks() || !CheckReads(ug.GetPointer()) || !CheckReads(pd.GetPointer()) ||
+      pd->NeedToBuildCells() || !pd->HasLinks())
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Only the cells are built unless the links are requested.
+  vtkNew<vtkReadablePolyData> cellsOnly;
+  vtkNew<vtkUnstructuredGrid> unused;
+  MakeQuads(cellsOnly.GetPointer(), unused.GetPointer());
+  cellsOnly->PrepareForConcurrentReads();
+  if (cellsOnly->NeedToBuildCells() || cellsOnly->HasLinks())
+  {
+    cerr << "Wrong structures built for cell reads." << endl;
+    return EXIT_FAILURE;
+  }
+  cellsOnly->PrepareForConcurrentReads(true);
+  if (!cellsOnly->HasLinks())
+  {
+    cerr << "Links not built on request." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Methods that are not thread safe, called while another thread reads,
+  // are reported.
+  int warnings = vtkObject::GetGlobalWarningDisplay();
+  vtkObject::GlobalWarningDisplayOff();
+  pd->BeginRead();
+  pd->GetCell(0);
+  pd->EndRead();
+  pd->GetCell(0);
+  pd->BeginRead();
+  pd->BuildLinks();
+  pd->EndRead();
+  vtkObject::SetGlobalWarningDisplay(warnings);
+  vtkDataSet::GlobalConcurrencyChecksOff();
+  if (pd->GetNumberOfConcurrencyViolations() != 2)
+  {
+    cerr << "Expected 2 concurrency violations, got "
+         << pd->GetNumberOfConcurrencyViolations() << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,204 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPointLocatorBatchedQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the batched closest N points and radius queries of the point
+// locators with their single point queries, for the points of the dataset
+// and for other points, and check some of the closest N points against a
+// brute force search.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+const int NUMBER_OF_CLOSEST = 10;
+const double RADIUS = 0.08;
+
+void RandomPoints(vtkMinimalStandardRandomSequence* random, vtkIdType numPts,
+                  vtkPoints* points)
+{
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(-1.0, 1.0);
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+// The closest N points must be at the N smallest distances
+bool CheckClosest(vtkPolyData* pd, const double x[3], vtkIdList* ids)
+{
+  std::vector<double> dist2(pd->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < pd->GetNumberOfPoints(); ++i)
+  {
+    dist2[i] = vtkMath::Distance2BetweenPoints(x, pd->GetPoint(i));
+  }
+  std::sort(dist2.begin(), dist2.end());
+  for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+  {
+    if (vtkMath::Distance2BetweenPoints(x, pd->GetPoint(ids->GetId(i))) != dist2[i])
+    {
+      return false;
+    }
+  }
+  return ids->GetNumberOfIds() == NUMBER_OF_CLOSEST;
+}
+
+bool CheckQueries(vtkAbstractPointLocator* locator, vtkPolyData* pd,
+                  vtkPoints* queries, bool closestN)
+{
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> neighbors;
+  vtkNew<vtkDoubleArray> dist2;
+  vtkNew<vtkIdTypeArray> neighbors2;
+  vtkNew<vtkIdTypeArray> offsets2;
+  if (closestN)
+  {
+    locator->FindAllClosestNPoints(NUMBER_OF_CLOSEST, queries, offsets.GetPointer(),
+                                   neighbors.GetPointer(), dist2.GetPointer());
+    locator->FindAllClosestNPoints(NUMBER_OF_CLOSEST, queries, offsets2.GetPointer(),
+                                   neighbors2.GetPointer());
+  }
+  else
+  {
+    locator->FindAllPointsWithinRadius(RADIUS, queries, offsets.GetPointer(),
+                                       neighbors.GetPointer(), dist2.GetPointer());
+    locator->FindAllPointsWithinRadius(RADIUS, queries, offsets2.GetPointer(),
+                                       neighbors2.GetPointer());
+  }
+
+  vtkIdType numQueries = queries ? queries->GetNumberOfPoints() : pd->GetNumberOfPoints();
+  if (offsets->GetNumberOfTuples() != numQueries + 1 ||
+      neighbors->GetNumberOfTuples() != offsets->GetValue(numQueries) ||
+      dist2->GetNumberOfTuples() != neighbors->GetNumberOfTuples() ||
+      offsets2->GetNumberOfTuples() != numQueries + 1 ||
+      neighbors2->GetNumberOfTuples() != neighbors->GetNumberOfTuples())
+  {
+    cerr << locator->GetClassName() << ": wrong graph size" << endl;
+    return false;
+  }
+
+  vtkNew<vtkIdList> ids;
+  vtkIdType total = 0;
+  for (vtkIdType q = 0; q < numQueries; ++q)
+  {
+    double x[3];
+    if (queries)
+    {
+      queries->GetPoint(q, x);
+    }
+    else
+    {
+      pd->GetPoint(q, x);
+    }
+    if (closestN)
+    {
+      locator->FindClosestNPoints(NUMBER_OF_CLOSEST, x, ids.GetPointer());
+      if (q % 10 == 0 && !CheckClosest(pd, x, ids.GetPointer()))
+      {
+        cerr << locator->GetClassName() << ": query " << q
+             << " did not return the closest points" << endl;
+        return false;
+      }
+    }
+    else
+    {
+      locator->FindPointsWithinRadius(RADIUS, x, ids.GetPointer());
+    }
+
+    vtkIdType offset = offsets->GetValue(q);
+    if (offsets->GetValue(q + 1) - offset != ids->GetNumberOfIds() ||
+        offsets2->GetValue(q) != offset)
+    {
+      cerr << locator->GetClassName() << ": query " << q << " has "
+           << offsets->GetValue(q + 1) - offset << " neighbors instead of "
+           << ids->GetNumberOfIds() << endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+    {
+      vtkIdType ptId = ids->GetId(i);
+      if (neighbors->GetValue(offset + i) != ptId ||
+          neighbors2->GetValue(offset + i) != ptId ||
+          dist2->GetValue(offset + i) !=
+            vtkMath::Distance2BetweenPoints(x, pd->GetPoint(ptId)))
+      {
+        cerr << locator->GetClassName() << ": query " << q << " neighbor " << i
+             << " differs" << endl;
+        return false;
+      }
+    }
+    total += ids->GetNumberOfIds();
+  }
+
+  if (total == 0)
+  {
+    cerr << locator->GetClassName() << ": no neighbors found" << endl;
+    return false;
+  }
+  return true;
+}
+
+}
+
+int TestPointLocatorBatchedQueries(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  RandomPoints(random.GetPointer(), 5000, points.GetPointer());
+  vtkNew<vtkPolyData> pd;
+  pd->SetPoints(points.GetPointer());
+  vtkNew<vtkPoints> queries;
+  RandomPoints(random.GetPointer(), 1000, queries.GetPointer());
+
+  vtkSmartPointer<vtkAbstractPointLocator> locators[2] = {
+    vtkSmartPointer<vtkStaticPointLocator>::New(),
+    vtkSmartPointer<vtkKdTreePointLocator>::New()
+  };
+  for (int i = 0; i < 2; ++i)
+  {
+    vtkAbstractPointLocator* locator = locators[i];
+    locator->SetDataSet(pd.GetPointer());
+    for (int closestN = 0; closestN < 2; ++closestN)
+    {
+      if (!CheckQueries(locator, pd.GetPointer(), nullptr, closestN != 0) ||
+          !CheckQueries(locator, pd.GetPointer(), queries.GetPointer(),
+                        closestN != 0))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -16,12 +16,206 @@
 #include "vtkAbstractCellLocator.h"
 
 #include "vtkObjectFactory.h"
+#include "vtkBoundingBox.h"
 #include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkPoints.h"
 #include "vtkDataSet.h"
 #include "vtkMath.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+// Fill the cell bounds cache.
+struct vtkCellBoundsFunctor
+{
+  vtkDataSet *DataSet;
+  double (*CellBounds)[6];
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      this->DataSet->GetCellBounds(cellId, this->CellBounds[cellId]);
+    }
+  }
+};
+
+// Queries of the batched methods, sorted by the Morton code of their
+// position: (code, query id).
+typedef std::pair<unsigned int, vtkIdType> vtkQueryCode;
+
+// Spread the lower 10 bits of x so that there are two zero bits between
+// consecutive bits.
+inline unsigned int vtkSpreadBits(unsigned int x)
+{
+  x &= 0x3ff;
+  x = (x | x << 16) & 0x30000ff;
+  x = (x | x << 8) & 0x300f00f;
+  x = (x | x << 4) & 0x30c30c3;
+  x = (x | x << 2) & 0x9249249;
+  return x;
+}
+
+// Compute the Morton code of each query point, or of the middle of each
+// segment, quantized to 10 bits per axis over the bounds of the queries.
+struct vtkQueryCodeFunctor
+{
+  vtkPoints *P1;
+  vtkPoints *P2;
+  double Bounds[6];
+  std::vector<vtkQueryCode> &Codes;
+
+  vtkQueryCodeFunctor(vtkPoints *p1, vtkPoints *p2, std::vector<vtkQueryCode> &codes)
+    : P1(p1), P2(p2), Codes(codes)
+  {
+    vtkBoundingBox bbox(p1->GetBounds());
+    if (p2)
+    {
+      bbox.AddBounds(p2->GetBounds());
+    }
+    bbox.GetBounds(this->Bounds);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3], y[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->P1->GetPoint(i, x);
+      if (this->P2)
+      {
+        this->P2->GetPoint(i, y);
+        x[0] = 0.5 * (x[0] + y[0]);
+        x[1] = 0.5 * (x[1] + y[1]);
+        x[2] = 0.5 * (x[2] + y[2]);
+      }
+      unsigned int code = 0;
+      for (int j = 0; j < 3; ++j)
+      {
+        double length = this->Bounds[2*j+1] - this->Bounds[2*j];
+        double q = length > 0.0 ? 1023.0 * (x[j] - this->Bounds[2*j]) / length : 0.0;
+        code |= vtkSpreadBits(static_cast<unsigned int>(std::min(std::max(q, 0.0), 1023.0)))
+          << (2 - j);
+      }
+      this->Codes[i] = vtkQueryCode(code, i);
+    }
+  }
+};
+
+void vtkSortQueries(vtkPoints *p1, vtkPoints *p2, std::vector<vtkQueryCode> &codes)
+{
+  vtkIdType numQueries = p1->GetNumberOfPoints();
+  codes.resize(numQueries);
+  vtkQueryCodeFunctor functor(p1, p2, codes);
+  vtkSMPTools::For(0, numQueries, functor);
+  vtkSMPTools::Sort(codes.begin(), codes.end());
+}
+
+// Run FindCell() for a range of sorted queries.
+struct vtkFindCellsFunctor
+{
+  vtkAbstractCellLocator *Locator;
+  vtkPoints *Points;
+  const vtkQueryCode *Queries;
+  vtkIdType *CellIds;
+  double *PCoords;
+  double *Weights;
+  int NumberOfWeights;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double> > CellWeights;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell *cell = this->Cell.Local();
+    std::vector<double> &weights = this->CellWeights.Local();
+    weights.resize(this->NumberOfWeights);
+    double x[3], pcoords[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType id = this->Queries[i].second;
+      this->Points->GetPoint(id, x);
+      vtkIdType cellId = this->Locator->FindCell(x, 0.0, cell, pcoords, &weights[0]);
+      this->CellIds[id] = cellId;
+      if (this->PCoords)
+      {
+        double *pc = this->PCoords + 3 * id;
+        pc[0] = cellId < 0 ? 0.0 : pcoords[0];
+        pc[1] = cellId < 0 ? 0.0 : pcoords[1];
+        pc[2] = cellId < 0 ? 0.0 : pcoords[2];
+      }
+      if (this->Weights)
+      {
+        double *w = this->Weights + id * this->NumberOfWeights;
+        int numWeights = cellId < 0 ? 0 : static_cast<int>(cell->GetNumberOfPoints());
+        std::copy(weights.begin(), weights.begin() + numWeights, w);
+        std::fill(w + numWeights, w + this->NumberOfWeights, 0.0);
+      }
+    }
+  }
+};
+
+}
+
+// Run IntersectWithLineConcurrently() for a range of sorted queries.
+struct vtkIntersectWithLinesFunctor
+{
+  vtkAbstractCellLocator *Locator;
+  vtkPoints *P1;
+  vtkPoints *P2;
+  double Tolerance;
+  const vtkQueryCode *Queries;
+  vtkIdType *CellIds;
+  double *T;
+  double *X;
+  double *PCoords;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell *cell = this->Cell.Local();
+    double a0[3], a1[3], t, x[3], pcoords[3];
+    int subId;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType id = this->Queries[i].second;
+      this->P1->GetPoint(id, a0);
+      this->P2->GetPoint(id, a1);
+      vtkIdType cellId = -1;
+      if (!this->Locator->IntersectWithLineConcurrently(
+            a0, a1, this->Tolerance, t, x, pcoords, subId, cellId, cell))
+      {
+        cellId = -1;
+        t = 0.0;
+        x[0] = x[1] = x[2] = 0.0;
+        pcoords[0] = pcoords[1] = pcoords[2] = 0.0;
+      }
+      this->CellIds[id] = cellId;
+      if (this->T)
+      {
+        this->T[id] = t;
+      }
+      if (this->X)
+      {
+        std::copy(x, x + 3, this->X + 3 * id);
+      }
+      if (this->PCoords)
+      {
+        std::copy(pcoords, pcoords + 3, this->PCoords + 3 * id);
+      }
+    }
+  }
+};
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -33,6 +227,7 @@ vtkAbstractCellLocator::vtkAbstractCellLocator()
   this->RetainCellLists            = 1;
   this->NumberOfCellsPerNode       = 32;
   this->UseExistingSearchStructure = 0;
+  this->RefitSearchStructure       = 0;
   this->LazyEvaluation             = 0;
   this->GenericCell                = vtkGenericCell::New();
 }
@@ -49,9 +244,15 @@ bool vtkAbstractCellLocator::StoreCellBounds()
   // Allocate space for cell bounds storage, then fill
   vtkIdType numCells = this->DataSet->GetNumberOfCells();
   this->CellBounds = new double [numCells][6];
-  for (vtkIdType j=0; j<numCells; j++)
+  if (numCells > 0)
   {
-    this->DataSet->GetCellBounds(j, CellBounds[j]);
+    // The first call builds the cells of the dataset if needed, the
+    // others can then run concurrently.
+    this->DataSet->GetCellBounds(0, this->CellBounds[0]);
+    vtkCellBoundsFunctor functor;
+    functor.DataSet = this->DataSet;
+    functor.CellBounds = this->CellBounds;
+    vtkSMPTools::For(1, numCells, functor);
   }
   return true;
 }
@@ -157,6 +358,155 @@ vtkIdType vtkAbstractCellLocator::FindClosestPointWithinRadius(
   return 0;
 }
 //----------------------------------------------------------------------------
+bool vtkAbstractCellLocator::PrepareForConcurrentQueries()
+{
+  this->Update();
+  return false;
+}
+//----------------------------------------------------------------------------
+bool vtkAbstractCellLocator::PrepareForConcurrentFindCell()
+{
+  return this->PrepareForConcurrentQueries();
+}
+//----------------------------------------------------------------------------
+int vtkAbstractCellLocator::IntersectWithLineConcurrently(
+  double p1[3], double p2[3], double tol,
+  double& t, double x[3], double pcoords[3],
+  int &subId, vtkIdType &cellId, vtkGenericCell *cell)
+{
+  return this->IntersectWithLine(p1, p2, tol, t, x, pcoords,
+                                 subId, cellId, cell);
+}
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindCells(
+  vtkPoints *points, vtkIdList *cellIds,
+  vtkDoubleArray *pcoords, vtkDoubleArray *weights)
+{
+  if (!this->DataSet || !points || !cellIds)
+  {
+    vtkErrorMacro(<< "A dataset, query points and cell ids are required");
+    return;
+  }
+
+  vtkIdType numQueries = points->GetNumberOfPoints();
+  int numWeights = std::max(this->DataSet->GetMaxCellSize(), 1);
+  cellIds->SetNumberOfIds(numQueries);
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numQueries);
+  }
+  if (weights)
+  {
+    weights->SetNumberOfComponents(numWeights);
+    weights->SetNumberOfTuples(numQueries);
+  }
+  if (numQueries == 0)
+  {
+    return;
+  }
+
+  bool concurrent = this->PrepareForConcurrentFindCell();
+  std::vector<vtkQueryCode> queries;
+  vtkSortQueries(points, nullptr, queries);
+
+  vtkFindCellsFunctor functor;
+  functor.Locator = this;
+  functor.Points = points;
+  functor.Queries = &queries[0];
+  functor.CellIds = cellIds->GetPointer(0);
+  functor.PCoords = pcoords ? pcoords->GetPointer(0) : nullptr;
+  functor.Weights = weights ? weights->GetPointer(0) : nullptr;
+  functor.NumberOfWeights = numWeights;
+  if (concurrent)
+  {
+    vtkSMPTools::For(0, numQueries, functor);
+  }
+  else
+  {
+    functor(0, numQueries);
+  }
+}
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::IntersectWithLines(
+  vtkPoints *p1, vtkPoints *p2, double tol, vtkIdList *cellIds,
+  vtkDoubleArray *t, vtkPoints *x, vtkDoubleArray *pcoords)
+{
+  if (!this->DataSet || !p1 || !p2 || !cellIds)
+  {
+    vtkErrorMacro(<< "A dataset, segment end points and cell ids are required");
+    return;
+  }
+  vtkIdType numQueries = p1->GetNumberOfPoints();
+  if (p2->GetNumberOfPoints() != numQueries)
+  {
+    vtkErrorMacro(<< "The segments need as many start as end points");
+    return;
+  }
+
+  cellIds->SetNumberOfIds(numQueries);
+  if (t)
+  {
+    t->SetNumberOfComponents(1);
+    t->SetNumberOfTuples(numQueries);
+  }
+  if (x)
+  {
+    x->SetDataTypeToDouble();
+    x->SetNumberOfPoints(numQueries);
+  }
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numQueries);
+  }
+  if (numQueries == 0)
+  {
+    return;
+  }
+
+  bool concurrent = this->PrepareForConcurrentQueries();
+  std::vector<vtkQueryCode> queries;
+  vtkSortQueries(p1, p2, queries);
+
+  vtkIntersectWithLinesFunctor functor;
+  functor.Locator = this;
+  functor.P1 = p1;
+  functor.P2 = p2;
+  functor.Tolerance = tol;
+  functor.Queries = &queries[0];
+  functor.CellIds = cellIds->GetPointer(0);
+  functor.T = t ? t->GetPointer(0) : nullptr;
+  functor.X = x ? static_cast<double*>(x->GetVoidPointer(0)) : nullptr;
+  functor.PCoords = pcoords ? pcoords->GetPointer(0) : nullptr;
+  if (concurrent)
+  {
+    vtkSMPTools::For(0, numQueries, functor);
+  }
+  else
+  {
+    functor(0, numQueries);
+  }
+}
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::ComputeQueryOrder(
+  vtkPoints *p1, vtkPoints *p2, vtkIdList *order)
+{
+  vtkIdType numQueries = p1->GetNumberOfPoints();
+  order->SetNumberOfIds(numQueries);
+  if (numQueries == 0)
+  {
+    return;
+  }
+  std::vector<vtkQueryCode> queries;
+  vtkSortQueries(p1, p2, queries);
+  vtkIdType *ids = order->GetPointer(0);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    ids[i] = queries[i].second;
+  }
+}
+//----------------------------------------------------------------------------
 void vtkAbstractCellLocator::FindCellsWithinBounds(
   double *vtkNotUsed(bbox), vtkIdList *vtkNotUsed(cells))
 {
@@ -224,6 +574,8 @@ void vtkAbstractCellLocator::PrintSelf(ostream& os, vtkIndent indent)
      << this->NumberOfCellsPerNode << "\n";
   os << indent << "UseExistingSearchStructure: "
      << this->UseExistingSearchStructure << "\n";
+  os << indent << "RefitSearchStructure: "
+     << this->RefitSearchStructure << "\n";
   os << indent << "LazyEvaluation: "
      << this->LazyEvaluation << "\n";
 }
@@ -41,12 +41,14 @@
 #include "vtkLocator.h"
 
 class vtkCellArray;
+class vtkDoubleArray;
 class vtkGenericCell;
 class vtkIdList;
 class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractCellLocator : public vtkLocator
 {
+friend struct vtkIntersectWithLinesFunctor;
 public:
   vtkTypeMacro(vtkAbstractCellLocator,vtkLocator);
   void PrintSelf(ostream& os, vtkIndent indent) override;
@@ -111,6 +113,23 @@ public:
   vtkBooleanMacro(UseExistingSearchStructure,int);
   //@}
 
+  //@{
+  /**
+   * Some locators support refitting their search structure when the
+   * dataset changes while keeping the same cells, typically a mesh
+   * deforming over time. When this flag is on and the dataset keeps its
+   * number of cells, the tree is kept and only its bounds are updated
+   * from the new cell bounds, bottom-up, instead of rebuilding it. The
+   * caller is responsible for the connectivity being unchanged. Queries
+   * remain exact, but the tree degrades if the cells move a lot relative
+   * to each other. Off by default; ignored if
+   * UseExistingSearchStructure is on.
+   */
+  vtkSetMacro(RefitSearchStructure,int);
+  vtkGetMacro(RefitSearchStructure,int);
+  vtkBooleanMacro(RefitSearchStructure,int);
+  //@}
+
   /**
    * Return intersection point (if any) of finite line with cells contained
    * in cell locator. See vtkCell.h parameters documentation.
@@ -270,6 +289,37 @@ public:
    */
   virtual bool InsideCellBounds(double x[3], vtkIdType cell_ID);
 
+  /**
+   * Batched version of FindCell(x, tol2, cell, pcoords, weights). For each
+   * point of points, cellIds receives the id of the cell containing the
+   * point, or -1. If given, pcoords receives the parametric coordinates of
+   * the point in the cell (3 components) and weights its interpolation
+   * weights, with as many components as the largest cell of the dataset.
+   * Both are zero for points outside the dataset. The locator is built if
+   * needed, then the queries are processed in the order of a space filling
+   * curve, so that consecutive queries visit the same parts of the search
+   * structure, with vtkSMPTools if the locator supports concurrent queries.
+   * Results are stored in the order of points.
+   */
+  virtual void FindCells(vtkPoints *points, vtkIdList *cellIds,
+                         vtkDoubleArray *pcoords = nullptr,
+                         vtkDoubleArray *weights = nullptr);
+
+  /**
+   * Batched version of IntersectWithLine(p1, p2, tol, t, x, pcoords, subId,
+   * cellId, cell) for the segments (p1->GetPoint(i), p2->GetPoint(i)).
+   * cellIds receives the id of the cell hit by each segment, or -1. If
+   * given, t, x and pcoords receive the parametric coordinate of the
+   * intersection along the segment, the intersection point (x is converted
+   * to double precision) and its parametric coordinates in the cell; they
+   * are zero for segments that hit nothing. The queries are ordered and
+   * processed as in FindCells().
+   */
+  virtual void IntersectWithLines(vtkPoints *p1, vtkPoints *p2, double tol,
+                                  vtkIdList *cellIds, vtkDoubleArray *t = nullptr,
+                                  vtkPoints *x = nullptr,
+                                  vtkDoubleArray *pcoords = nullptr);
+
 protected:
    vtkAbstractCellLocator();
   ~vtkAbstractCellLocator() override;
@@ -286,11 +336,50 @@ protected:
   virtual void FreeCellBounds();
   //@}
 
+  /**
+   * Called by the batched queries before the first query. Build the search
+   * structure if needed and return true if FindCell() and
+   * IntersectWithLineConcurrently() may then be called from several
+   * threads with different generic cells. The default implementation
+   * calls Update() and returns false, so that the queries are made from a
+   * single thread.
+   */
+  virtual bool PrepareForConcurrentQueries();
+
+  /**
+   * Called by FindCells() before the first query. Build the search
+   * structure if needed and return true if FindCell() may then be called
+   * from several threads with different generic cells. The default
+   * implementation returns PrepareForConcurrentQueries(). Locators that do
+   * not implement FindCell() must return false: the default FindCell()
+   * goes through vtkDataSet::FindCell(), which is not thread safe.
+   */
+  virtual bool PrepareForConcurrentFindCell();
+
+  /**
+   * Version of IntersectWithLine() used by the batched queries. Subclasses
+   * whose IntersectWithLine() uses internal scratch space override it with
+   * a version that does not. The default implementation calls
+   * IntersectWithLine().
+   */
+  virtual int IntersectWithLineConcurrently(
+    double p1[3], double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell);
+
+  /**
+   * Fill order with the indices of the batched queries sorted along a
+   * Morton curve: the points of p1, or the midpoints of the segments
+   * (p1->GetPoint(i), p2->GetPoint(i)) if p2 is not nullptr. Used by
+   * subclasses that reimplement the batched queries.
+   */
+  static void ComputeQueryOrder(vtkPoints *p1, vtkPoints *p2, vtkIdList *order);
+
   int NumberOfCellsPerNode;
   int RetainCellLists;
   int CacheCellBounds;
   int LazyEvaluation;
   int UseExistingSearchStructure;
+  int RefitSearchStructure;
   vtkGenericCell *GenericCell;
   double (*CellBounds)[6];
 
@@ -15,7 +15,143 @@
 #include "vtkAbstractPointLocator.h"
 
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Helper classes to process batched queries. The queries are split in
+// batches of consecutive queries in the order of the search structure; each
+// batch gathers the neighbors of its queries before they are copied to
+// their place in the output graph.
+namespace
+{
+
+const vtkIdType QUERY_BATCH_SIZE = 256;
+
+struct NeighborBatch
+{
+  std::vector<vtkIdType> Ids;
+  std::vector<double> Dist2;
+};
+
+struct FindNeighbors
+{
+  vtkAbstractPointLocator *Locator;
+  vtkDataSet *DataSet;
+  vtkPoints *Queries;
+  const vtkIdType *Order;
+  vtkIdType NumQueries;
+  bool ClosestN;
+  int N;
+  double R;
+  bool ComputeDist2;
+  vtkIdType *Counts;
+  NeighborBatch *Batches;
+  vtkSMPThreadLocalObject<vtkIdList> PIds;
+
+  void Initialize()
+  {
+    vtkIdList*& pIds = this->PIds.Local();
+    pIds->Allocate(128);
+  }
+
+  void operator() (vtkIdType batchId, vtkIdType endBatchId)
+  {
+    vtkIdList*& pIds = this->PIds.Local();
+    double x[3], y[3];
+
+    for ( ; batchId < endBatchId; ++batchId)
+    {
+      NeighborBatch& batch = this->Batches[batchId];
+      vtkIdType end = std::min((batchId + 1) * QUERY_BATCH_SIZE, this->NumQueries);
+      for (vtkIdType i = batchId * QUERY_BATCH_SIZE; i < end; ++i)
+      {
+        vtkIdType q = this->Order[i];
+        if ( this->Queries )
+        {
+          this->Queries->GetPoint(q, x);
+        }
+        else
+        {
+          this->DataSet->GetPoint(q, x);
+        }
+        if ( this->ClosestN )
+        {
+          this->Locator->FindClosestNPoints(this->N, x, pIds);
+        }
+        else
+        {
+          this->Locator->FindPointsWithinRadius(this->R, x, pIds);
+        }
+
+        vtkIdType numIds = pIds->GetNumberOfIds();
+        this->Counts[q] = numIds;
+        for (vtkIdType j = 0; j < numIds; ++j)
+        {
+          vtkIdType ptId = pIds->GetId(j);
+          batch.Ids.push_back(ptId);
+          if ( this->ComputeDist2 )
+          {
+            this->DataSet->GetPoint(ptId, y);
+            batch.Dist2.push_back(vtkMath::Distance2BetweenPoints(x, y));
+          }
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+// Copy the neighbors of each batch to the output graph
+struct ScatterNeighbors
+{
+  const vtkIdType *Order;
+  vtkIdType NumQueries;
+  const vtkIdType *Offsets;
+  NeighborBatch *Batches;
+  vtkIdType *Neighbors;
+  double *Dist2;
+
+  void operator() (vtkIdType batchId, vtkIdType endBatchId)
+  {
+    for ( ; batchId < endBatchId; ++batchId)
+    {
+      NeighborBatch& batch = this->Batches[batchId];
+      vtkIdType end = std::min((batchId + 1) * QUERY_BATCH_SIZE, this->NumQueries);
+      vtkIdType k = 0;
+      for (vtkIdType i = batchId * QUERY_BATCH_SIZE; i < end; ++i)
+      {
+        vtkIdType q = this->Order[i];
+        vtkIdType offset = this->Offsets[q];
+        vtkIdType numIds = this->Offsets[q + 1] - offset;
+        std::copy(batch.Ids.begin() + k, batch.Ids.begin() + k + numIds,
+                  this->Neighbors + offset);
+        if ( this->Dist2 )
+        {
+          std::copy(batch.Dist2.begin() + k, batch.Dist2.begin() + k + numIds,
+                    this->Dist2 + offset);
+        }
+        k += numIds;
+      }
+      // Release the memory as soon as possible
+      std::vector<vtkIdType>().swap(batch.Ids);
+      std::vector<double>().swap(batch.Dist2);
+    }
+  }
+};
+
+} // anonymous namespace
 
 
 //-----------------------------------------------------------------------------
@@ -68,6 +204,121 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(double R, double x,
   this->FindPointsWithinRadius(R,p,result);
 }
 
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::
+FindAllClosestNPoints(int N, vtkPoints *queries, vtkIdTypeArray *offsets,
+                      vtkIdTypeArray *neighbors, vtkDoubleArray *dist2)
+{
+  this->FindAllNeighbors(true, N, 0.0, queries, offsets, neighbors, dist2);
+}
+
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::
+FindAllPointsWithinRadius(double R, vtkPoints *queries, vtkIdTypeArray *offsets,
+                          vtkIdTypeArray *neighbors, vtkDoubleArray *dist2)
+{
+  this->FindAllNeighbors(false, 0, R, queries, offsets, neighbors, dist2);
+}
+
+//-----------------------------------------------------------------------------
+// Default order of the batched queries: the input order.
+void vtkAbstractPointLocator::GetQueryOrder(vtkPoints *queries, vtkIdList *order)
+{
+  vtkIdType numQueries = ( queries ? queries->GetNumberOfPoints() :
+                           this->DataSet->GetNumberOfPoints() );
+  order->SetNumberOfIds(numQueries);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    order->SetId(i, i);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// The single point queries are thread safe once the locator is built, the
+// batches of queries are processed concurrently in the order returned by
+// GetQueryOrder(), then the neighborhoods are moved to the position of
+// their query in the output graph.
+void vtkAbstractPointLocator::
+FindAllNeighbors(bool closestN, int N, double R, vtkPoints *queries,
+                 vtkIdTypeArray *offsets, vtkIdTypeArray *neighbors,
+                 vtkDoubleArray *dist2)
+{
+  if ( !offsets || !neighbors )
+  {
+    vtkErrorMacro("Offsets and neighbors arrays are required");
+    return;
+  }
+  offsets->Reset();
+  neighbors->Reset();
+  if ( dist2 )
+  {
+    dist2->Reset();
+  }
+  if ( !this->DataSet || this->DataSet->GetNumberOfPoints() < 1 )
+  {
+    vtkErrorMacro("No points to locate");
+    return;
+  }
+
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+
+  vtkIdType numQueries = ( queries ? queries->GetNumberOfPoints() :
+                           this->DataSet->GetNumberOfPoints() );
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(numQueries + 1);
+  vtkIdType *offsetsPtr = offsets->GetPointer(0);
+  offsetsPtr[0] = 0;
+  if ( numQueries < 1 )
+  {
+    return;
+  }
+
+  vtkIdList *order = vtkIdList::New();
+  this->GetQueryOrder(queries, order);
+
+  // Gather the neighbors of each batch, the counts are stored one slot
+  // ahead to compute the offsets in place.
+  vtkIdType numBatches = (numQueries - 1) / QUERY_BATCH_SIZE + 1;
+  NeighborBatch *batches = new NeighborBatch [numBatches];
+  FindNeighbors find;
+  find.Locator = this;
+  find.DataSet = this->DataSet;
+  find.Queries = queries;
+  find.Order = order->GetPointer(0);
+  find.NumQueries = numQueries;
+  find.ClosestN = closestN;
+  find.N = N;
+  find.R = R;
+  find.ComputeDist2 = (dist2 != nullptr);
+  find.Counts = offsetsPtr + 1;
+  find.Batches = batches;
+  vtkSMPTools::For(0, numBatches, 1, find);
+
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    offsetsPtr[i + 1] += offsetsPtr[i];
+  }
+
+  neighbors->SetNumberOfComponents(1);
+  neighbors->SetNumberOfTuples(offsetsPtr[numQueries]);
+  if ( dist2 )
+  {
+    dist2->SetNumberOfComponents(1);
+    dist2->SetNumberOfTuples(offsetsPtr[numQueries]);
+  }
+  ScatterNeighbors scatter;
+  scatter.Order = order->GetPointer(0);
+  scatter.NumQueries = numQueries;
+  scatter.Offsets = offsetsPtr;
+  scatter.Batches = batches;
+  scatter.Neighbors = neighbors->GetPointer(0);
+  scatter.Dist2 = ( dist2 ? dist2->GetPointer(0) : nullptr );
+  vtkSMPTools::For(0, numBatches, 1, scatter);
+
+  delete [] batches;
+  order->Delete();
+}
+
 //-----------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
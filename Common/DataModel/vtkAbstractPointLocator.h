@@ -33,7 +33,10 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 #include "vtkLocator.h"
 
+class vtkDoubleArray;
 class vtkIdList;
+class vtkIdTypeArray;
+class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -93,6 +96,31 @@ public:
                                       vtkIdList *result);
   //@}
 
+  //@{
+  /**
+   * Batched versions of FindClosestNPoints() and FindPointsWithinRadius()
+   * that query all the points of queries at once, or all the points of the
+   * dataset if queries is nullptr. The result is a neighbor graph in
+   * compressed sparse row form: the neighbors of the i-th query are the
+   * values of neighbors from offsets->GetValue(i) to
+   * offsets->GetValue(i+1) excluded, and offsets has one more value than
+   * there are queries. If given, dist2 receives the squared distances of
+   * the neighbors to their query. Each neighborhood is the one returned by
+   * the single point method, in the same order. The locator is built if
+   * needed, then the queries are processed concurrently with vtkSMPTools
+   * in the order of the search structure (see GetQueryOrder()), so that
+   * consecutive queries visit the same buckets.
+   */
+  virtual void FindAllClosestNPoints(int N, vtkPoints *queries,
+                                     vtkIdTypeArray *offsets,
+                                     vtkIdTypeArray *neighbors,
+                                     vtkDoubleArray *dist2 = nullptr);
+  virtual void FindAllPointsWithinRadius(double R, vtkPoints *queries,
+                                         vtkIdTypeArray *offsets,
+                                         vtkIdTypeArray *neighbors,
+                                         vtkDoubleArray *dist2 = nullptr);
+  //@}
+
   /**
    * Provide an accessor to the bounds.
    */
@@ -111,6 +139,20 @@ protected:
   vtkAbstractPointLocator();
   ~vtkAbstractPointLocator() override;
 
+  /**
+   * Return in order the ids of the queries (the points of the dataset if
+   * queries is nullptr) in the order the batched queries process them.
+   * The default keeps the input order, subclasses sort the queries by
+   * bucket or region. Called after BuildLocator().
+   */
+  virtual void GetQueryOrder(vtkPoints *queries, vtkIdList *order);
+
+  // Shared implementation of the batched queries, the closest N points if
+  // closestN is true, otherwise the points within radius R
+  void FindAllNeighbors(bool closestN, int N, double R, vtkPoints *queries,
+                        vtkIdTypeArray *offsets, vtkIdTypeArray *neighbors,
+                        vtkDoubleArray *dist2);
+
   double Bounds[6]; // bounds of points
   vtkIdType NumberOfBuckets; // total size of locator
 
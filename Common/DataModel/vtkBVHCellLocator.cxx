@@ -0,0 +1,1585 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBVHCellLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkBVHCellLocator);
+
+//-----------------------------------------------------------------------------
+// Node of the hierarchy. The two children of an inner node are stored one
+// after the other.
+struct vtkBVHNode
+{
+  double Bounds[6];
+  vtkIdType Start; // leaf: first triangle; inner node: left child
+  vtkIdType Count; // leaf: number of triangles; inner node: 0
+  int Axis; // inner node: axis along which the children were split
+};
+
+//-----------------------------------------------------------------------------
+// The hierarchy and its triangles, stored in the order of the leaves.
+struct vtkBVHTree
+{
+  std::vector<vtkBVHNode> Nodes;
+  int Depth;
+
+  // First vertex of each triangle and edges to the other two
+  std::vector<double> V0[3];
+  std::vector<double> E1[3];
+  std::vector<double> E2[3];
+
+  // Cell of each triangle and index of the triangle in the cell, -1 if the
+  // cell is itself a triangle
+  std::vector<vtkIdType> CellIds;
+  std::vector<int> SubIds;
+
+  // Dipole approximation of the triangles of each node, for the winding
+  // number: sum of the area weighted normals, area weighted center, and
+  // radius of the ball around the center containing the node
+  std::vector<double> NodeNormals;
+  std::vector<double> NodeCenters;
+  std::vector<double> NodeRadii;
+
+  vtkBVHTree() : Depth(0) {}
+};
+
+namespace
+{
+
+// Number of segments traversing the hierarchy together
+const int VTK_BVH_PACKET_SIZE = 8;
+
+// Ranges at least this large are binned with vtkSMPTools
+const vtkIdType VTK_BVH_PARALLEL_BINNING = 65536;
+
+// Relative enlargement of the ray/box overlap, so that rounding errors do
+// not cull triangles lying on the faces of a box
+const double VTK_BVH_BOX_SLACK = 1.0 + 1.0e-12;
+
+// Nodes farther from the query point than this many times their radius are
+// replaced by their dipole when computing the winding number
+const double VTK_BVH_DIPOLE_DISTANCE = 2.0;
+
+//-----------------------------------------------------------------------------
+inline void vtkBVHInitBounds(double b[6])
+{
+  b[0] = b[2] = b[4] = VTK_DOUBLE_MAX;
+  b[1] = b[3] = b[5] = -VTK_DOUBLE_MAX;
+}
+
+inline void vtkBVHAddBounds(double b[6], const double a[6])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    b[2 * i] = std::min(b[2 * i], a[2 * i]);
+    b[2 * i + 1] = std::max(b[2 * i + 1], a[2 * i + 1]);
+  }
+}
+
+inline void vtkBVHAddPoint(double b[6], const double x[3])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    b[2 * i] = std::min(b[2 * i], x[i]);
+    b[2 * i + 1] = std::max(b[2 * i + 1], x[i]);
+  }
+}
+
+// Half of the surface area of a box, zero if empty
+inline double vtkBVHHalfArea(const double b[6])
+{
+  if (b[0] > b[1])
+  {
+    return 0.0;
+  }
+  double dx = b[1] - b[0], dy = b[3] - b[2], dz = b[5] - b[4];
+  return dx * dy + dy * dz + dz * dx;
+}
+
+//-----------------------------------------------------------------------------
+// Triangles extracted from the 2D cells, three point ids each.
+struct vtkBVHTriangles
+{
+  std::vector<vtkIdType> Points;
+  std::vector<vtkIdType> CellIds;
+  std::vector<int> SubIds;
+
+  void Add(vtkIdType a, vtkIdType b, vtkIdType c, vtkIdType cellId, int subId)
+  {
+    this->Points.push_back(a);
+    this->Points.push_back(b);
+    this->Points.push_back(c);
+    this->CellIds.push_back(cellId);
+    this->SubIds.push_back(subId);
+  }
+};
+
+void vtkBVHCollectTriangles(vtkDataSet *ds, vtkBVHTriangles &tris)
+{
+  vtkIdType numCells = ds->GetNumberOfCells();
+  vtkNew<vtkIdList> ptIds;
+  vtkNew<vtkIdList> triIds;
+  vtkNew<vtkPoints> triPts;
+  vtkNew<vtkGenericCell> cell;
+  vtkIdType npts;
+  const vtkIdType *pts;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    switch (ds->GetCellType(cellId))
+    {
+      case VTK_EMPTY_CELL:
+      case VTK_VERTEX:
+      case VTK_POLY_VERTEX:
+      case VTK_LINE:
+      case VTK_POLY_LINE:
+        break;
+
+      case VTK_TRIANGLE:
+        ds->GetCellPoints(cellId, npts, pts, ptIds.GetPointer());
+        tris.Add(pts[0], pts[1], pts[2], cellId, -1);
+        break;
+
+      case VTK_QUAD:
+        ds->GetCellPoints(cellId, npts, pts, ptIds.GetPointer());
+        tris.Add(pts[0], pts[1], pts[2], cellId, 0);
+        tris.Add(pts[0], pts[2], pts[3], cellId, 1);
+        break;
+
+      case VTK_TRIANGLE_STRIP:
+        // Every other triangle is flipped to keep the orientation of the strip
+        ds->GetCellPoints(cellId, npts, pts, ptIds.GetPointer());
+        for (vtkIdType i = 0; i + 2 < npts; ++i)
+        {
+          vtkIdType flip = i % 2;
+          tris.Add(pts[i + flip], pts[i + 1 - flip], pts[i + 2], cellId,
+                   static_cast<int>(i));
+        }
+        break;
+
+      default:
+        ds->GetCell(cellId, cell.GetPointer());
+        if (cell->GetCellDimension() == 2 &&
+            cell->Triangulate(0, triIds.GetPointer(), triPts.GetPointer()))
+        {
+          vtkIdType numTris = triIds->GetNumberOfIds() / 3;
+          for (vtkIdType i = 0; i < numTris; ++i)
+          {
+            tris.Add(triIds->GetId(3 * i), triIds->GetId(3 * i + 1),
+                     triIds->GetId(3 * i + 2), cellId, static_cast<int>(i));
+          }
+        }
+        break;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Compute the bounds and the center of the bounds of each triangle.
+struct vtkBVHTriangleBounds
+{
+  vtkDataSet *DataSet;
+  const vtkIdType *Points;
+  double *Bounds;
+  double *Centroids;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType tri = begin; tri < end; ++tri)
+    {
+      double *b = this->Bounds + 6 * tri;
+      vtkBVHInitBounds(b);
+      for (int i = 0; i < 3; ++i)
+      {
+        this->DataSet->GetPoint(this->Points[3 * tri + i], x);
+        vtkBVHAddPoint(b, x);
+      }
+      for (int i = 0; i < 3; ++i)
+      {
+        this->Centroids[3 * tri + i] = 0.5 * (b[2 * i] + b[2 * i + 1]);
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Bounds of a range of triangles and of their centroids.
+struct vtkBVHRangeBox
+{
+  double Bounds[6];
+  double CentroidBounds[6];
+
+  vtkBVHRangeBox()
+  {
+    vtkBVHInitBounds(this->Bounds);
+    vtkBVHInitBounds(this->CentroidBounds);
+  }
+};
+
+// A bin of the surface area heuristic.
+struct vtkBVHBin
+{
+  double Bounds[6];
+  vtkIdType Count;
+
+  vtkBVHBin() : Count(0) { vtkBVHInitBounds(this->Bounds); }
+};
+
+// Triangle data and binning parameters shared by the build steps.
+struct vtkBVHBinningSpace
+{
+  const double *TriangleBounds;
+  const double *Centroids;
+  vtkIdType *Order;
+  int NumberOfBins;
+  double Min[3];
+  double Scale[3];
+
+  int BinIndex(int axis, vtkIdType tri) const
+  {
+    int bin = static_cast<int>(
+      (this->Centroids[3 * tri + axis] - this->Min[axis]) * this->Scale[axis]);
+    return bin < 0 ? 0 : (bin >= this->NumberOfBins ? this->NumberOfBins - 1 : bin);
+  }
+
+  void AddToBox(vtkBVHRangeBox &box, vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType tri = this->Order[i];
+      vtkBVHAddBounds(box.Bounds, this->TriangleBounds + 6 * tri);
+      vtkBVHAddPoint(box.CentroidBounds, this->Centroids + 3 * tri);
+    }
+  }
+
+  // bins holds NumberOfBins bins for each of the three axes
+  void AddToBins(vtkBVHBin *bins, vtkIdType begin, vtkIdType end) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType tri = this->Order[i];
+      const double *b = this->TriangleBounds + 6 * tri;
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        vtkBVHBin &bin = bins[axis * this->NumberOfBins + this->BinIndex(axis, tri)];
+        vtkBVHAddBounds(bin.Bounds, b);
+        ++bin.Count;
+      }
+    }
+  }
+};
+
+// Parallel versions of AddToBox() and AddToBins() for the large ranges.
+struct vtkBVHRangeBoxFunctor
+{
+  const vtkBVHBinningSpace &Space;
+  vtkSMPThreadLocal<vtkBVHRangeBox> LocalBox;
+  vtkBVHRangeBox Box;
+
+  vtkBVHRangeBoxFunctor(const vtkBVHBinningSpace &space) : Space(space) {}
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    this->Space.AddToBox(this->LocalBox.Local(), begin, end);
+  }
+
+  void Reduce()
+  {
+    vtkSMPThreadLocal<vtkBVHRangeBox>::iterator itr;
+    for (itr = this->LocalBox.begin(); itr != this->LocalBox.end(); ++itr)
+    {
+      vtkBVHAddBounds(this->Box.Bounds, (*itr).Bounds);
+      vtkBVHAddBounds(this->Box.CentroidBounds, (*itr).CentroidBounds);
+    }
+  }
+};
+
+struct vtkBVHBinsFunctor
+{
+  const vtkBVHBinningSpace &Space;
+  vtkSMPThreadLocal<std::vector<vtkBVHBin> > LocalBins;
+  std::vector<vtkBVHBin> Bins;
+
+  vtkBVHBinsFunctor(const vtkBVHBinningSpace &space)
+    : Space(space), Bins(3 * space.NumberOfBins) {}
+
+  void Initialize()
+  {
+    this->LocalBins.Local().assign(3 * this->Space.NumberOfBins, vtkBVHBin());
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    this->Space.AddToBins(&this->LocalBins.Local()[0], begin, end);
+  }
+
+  void Reduce()
+  {
+    vtkSMPThreadLocal<std::vector<vtkBVHBin> >::iterator itr;
+    for (itr = this->LocalBins.begin(); itr != this->LocalBins.end(); ++itr)
+    {
+      for (size_t i = 0; i < this->Bins.size(); ++i)
+      {
+        vtkBVHAddBounds(this->Bins[i].Bounds, (*itr)[i].Bounds);
+        this->Bins[i].Count += (*itr)[i].Count;
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// A range of triangles left for a subtree built on its own.
+struct vtkBVHSubtree
+{
+  vtkIdType Node; // node of the top of the tree replaced by the subtree
+  int NodeDepth;
+  vtkIdType Begin;
+  vtkIdType End;
+  std::vector<vtkBVHNode> Nodes;
+  int Depth;
+};
+
+// Binned SAH builder. Every node covers a range of Order, which is
+// partitioned in place as the nodes are split.
+struct vtkBVHBuilder
+{
+  const double *TriangleBounds;
+  const double *Centroids;
+  vtkIdType *Order;
+  int NumberOfBins;
+  vtkIdType MaxLeafSize;
+
+  // Build the hierarchy of the triangles Order[begin, end) into nodes. If
+  // subtrees is not null, the ranges smaller than subtreeSize are left as
+  // leaves and appended to subtrees. Return the depth of the hierarchy.
+  int Build(std::vector<vtkBVHNode> &nodes, vtkIdType begin, vtkIdType end,
+            bool parallel, vtkIdType subtreeSize,
+            std::vector<vtkBVHSubtree> *subtrees) const
+  {
+    nodes.clear();
+    nodes.push_back(vtkBVHNode());
+    nodes[0].Start = begin;
+    nodes[0].Count = end - begin;
+    nodes[0].Axis = 0;
+    int depth = 0;
+    std::vector<std::pair<vtkIdType, int> > stack(1, std::make_pair(0, 0));
+    while (!stack.empty())
+    {
+      vtkIdType idx = stack.back().first;
+      int nodeDepth = stack.back().second;
+      stack.pop_back();
+      depth = std::max(depth, nodeDepth);
+      vtkIdType first = nodes[idx].Start, count = nodes[idx].Count;
+
+      vtkBVHRangeBox box;
+      vtkBVHBinningSpace space = this->MakeSpace();
+      if (parallel && count >= VTK_BVH_PARALLEL_BINNING)
+      {
+        vtkBVHRangeBoxFunctor functor(space);
+        vtkSMPTools::For(first, first + count, functor);
+        box = functor.Box;
+      }
+      else
+      {
+        space.AddToBox(box, first, first + count);
+      }
+      std::copy(box.Bounds, box.Bounds + 6, nodes[idx].Bounds);
+
+      if (subtrees && count < subtreeSize)
+      {
+        vtkBVHSubtree subtree;
+        subtree.Node = idx;
+        subtree.NodeDepth = nodeDepth;
+        subtree.Begin = first;
+        subtree.End = first + count;
+        subtree.Depth = 0;
+        subtrees->push_back(subtree);
+        continue;
+      }
+
+      int axis;
+      vtkIdType mid;
+      if (!this->Split(space, box, first, first + count, parallel, axis, mid))
+      {
+        continue;
+      }
+      vtkIdType left = static_cast<vtkIdType>(nodes.size());
+      vtkBVHNode child;
+      child.Axis = 0;
+      child.Start = first;
+      child.Count = mid - first;
+      nodes.push_back(child);
+      child.Start = mid;
+      child.Count = first + count - mid;
+      nodes.push_back(child);
+      nodes[idx].Start = left;
+      nodes[idx].Count = 0;
+      nodes[idx].Axis = axis;
+      stack.push_back(std::make_pair(left, nodeDepth + 1));
+      stack.push_back(std::make_pair(left + 1, nodeDepth + 1));
+    }
+    return depth;
+  }
+
+  vtkBVHBinningSpace MakeSpace() const
+  {
+    vtkBVHBinningSpace space;
+    space.TriangleBounds = this->TriangleBounds;
+    space.Centroids = this->Centroids;
+    space.Order = this->Order;
+    space.NumberOfBins = this->NumberOfBins;
+    return space;
+  }
+
+  // Choose the split of Order[begin, end) with the lowest SAH cost and
+  // partition the range. Return false if the range should be a leaf.
+  bool Split(vtkBVHBinningSpace &space, const vtkBVHRangeBox &box,
+             vtkIdType begin, vtkIdType end, bool parallel, int &axis,
+             vtkIdType &mid) const
+  {
+    vtkIdType count = end - begin;
+    if (count <= 1)
+    {
+      return false;
+    }
+    bool flat = true;
+    for (int i = 0; i < 3; ++i)
+    {
+      double extent = box.CentroidBounds[2 * i + 1] - box.CentroidBounds[2 * i];
+      space.Min[i] = box.CentroidBounds[2 * i];
+      space.Scale[i] = extent > 0.0 ? this->NumberOfBins / extent : 0.0;
+      flat = flat && extent <= 0.0;
+    }
+
+    // All the centroids coincide: split in the middle if the leaf would be
+    // too large.
+    if (flat)
+    {
+      axis = 0;
+      mid = begin + count / 2;
+      return count > this->MaxLeafSize;
+    }
+
+    std::vector<vtkBVHBin> bins;
+    if (parallel && count >= VTK_BVH_PARALLEL_BINNING)
+    {
+      vtkBVHBinsFunctor functor(space);
+      vtkSMPTools::For(begin, end, functor);
+      bins.swap(functor.Bins);
+    }
+    else
+    {
+      bins.resize(3 * this->NumberOfBins);
+      space.AddToBins(&bins[0], begin, end);
+    }
+
+    // Sweep the bins of each axis from both sides to evaluate the cost of
+    // splitting after each bin.
+    int numBins = this->NumberOfBins;
+    std::vector<double> rightArea(numBins);
+    std::vector<vtkIdType> rightCount(numBins);
+    double bestCost = VTK_DOUBLE_MAX;
+    int bestBin = -1;
+    axis = -1;
+    for (int a = 0; a < 3; ++a)
+    {
+      if (space.Scale[a] == 0.0)
+      {
+        continue;
+      }
+      const vtkBVHBin *axisBins = &bins[a * numBins];
+      double acc[6];
+      vtkBVHInitBounds(acc);
+      vtkIdType accCount = 0;
+      for (int i = numBins - 1; i > 0; --i)
+      {
+        vtkBVHAddBounds(acc, axisBins[i].Bounds);
+        accCount += axisBins[i].Count;
+        rightArea[i] = vtkBVHHalfArea(acc);
+        rightCount[i] = accCount;
+      }
+      vtkBVHInitBounds(acc);
+      accCount = 0;
+      for (int i = 0; i < numBins - 1; ++i)
+      {
+        vtkBVHAddBounds(acc, axisBins[i].Bounds);
+        accCount += axisBins[i].Count;
+        if (accCount == 0 || rightCount[i + 1] == 0)
+        {
+          continue;
+        }
+        double cost = vtkBVHHalfArea(acc) * accCount +
+          rightArea[i + 1] * rightCount[i + 1];
+        if (cost < bestCost)
+        {
+          bestCost = cost;
+          bestBin = i;
+          axis = a;
+        }
+      }
+    }
+    if (axis < 0)
+    {
+      return false;
+    }
+
+    // Cost relative to a leaf, with a traversal step as expensive as a
+    // triangle test.
+    double area = vtkBVHHalfArea(box.Bounds);
+    if (count <= this->MaxLeafSize &&
+        (area <= 0.0 || 1.0 + bestCost / area >= count))
+    {
+      return false;
+    }
+
+    const vtkBVHBinningSpace &s = space;
+    int splitAxis = axis;
+    mid = std::partition(this->Order + begin, this->Order + end,
+                         [&s, splitAxis, bestBin](vtkIdType tri)
+                         { return s.BinIndex(splitAxis, tri) <= bestBin; }) -
+      this->Order;
+    return true;
+  }
+};
+
+// Build the subtrees left by the top of the hierarchy.
+struct vtkBVHSubtreeFunctor
+{
+  const vtkBVHBuilder &Builder;
+  std::vector<vtkBVHSubtree> &Subtrees;
+
+  vtkBVHSubtreeFunctor(const vtkBVHBuilder &builder, std::vector<vtkBVHSubtree> &subtrees)
+    : Builder(builder), Subtrees(subtrees) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkBVHSubtree &subtree = this->Subtrees[i];
+      subtree.Depth = this->Builder.Build(subtree.Nodes, subtree.Begin, subtree.End,
+                                          false, 0, nullptr);
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Copy the triangles in the order of the leaves.
+struct vtkBVHFlattenFunctor
+{
+  vtkDataSet *DataSet;
+  const vtkBVHTriangles &Triangles;
+  const vtkIdType *Order;
+  vtkBVHTree *Tree;
+
+  vtkBVHFlattenFunctor(vtkDataSet *ds, const vtkBVHTriangles &tris,
+                       const vtkIdType *order, vtkBVHTree *tree)
+    : DataSet(ds), Triangles(tris), Order(order), Tree(tree) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x0[3], x1[3], x2[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType tri = this->Order[i];
+      const vtkIdType *pts = &this->Triangles.Points[3 * tri];
+      this->DataSet->GetPoint(pts[0], x0);
+      this->DataSet->GetPoint(pts[1], x1);
+      this->DataSet->GetPoint(pts[2], x2);
+      for (int j = 0; j < 3; ++j)
+      {
+        this->Tree->V0[j][i] = x0[j];
+        this->Tree->E1[j][i] = x1[j] - x0[j];
+        this->Tree->E2[j][i] = x2[j] - x0[j];
+      }
+      this->Tree->CellIds[i] = this->Triangles.CellIds[tri];
+      this->Tree->SubIds[i] = this->Triangles.SubIds[tri];
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Segments traversing the hierarchy together, in structure of arrays so
+// that the loops over the segments can be vectorized.
+template <int N>
+struct vtkBVHRayPacket
+{
+  double Origin[3][N];
+  double Direction[3][N];
+  double InverseDirection[3][N];
+  double T[N]; // parametric coordinate of the closest hit, or of the end point
+  double U[N];
+  double V[N];
+  vtkIdType Triangle[N]; // closest triangle hit, or -1
+
+  void Set(int lane, const double p1[3], const double p2[3])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      double d = p2[i] - p1[i];
+      this->Origin[i][lane] = p1[i];
+      this->Direction[i][lane] = d;
+      this->InverseDirection[i][lane] =
+        1.0 / (d != 0.0 ? d : std::numeric_limits<double>::min());
+    }
+    this->T[lane] = 1.0;
+    this->U[lane] = this->V[lane] = 0.0;
+    this->Triangle[lane] = -1;
+  }
+
+  // Unused lane: a negative T culls every box and triangle.
+  void Disable(int lane)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Origin[i][lane] = this->Direction[i][lane] = 0.0;
+      this->InverseDirection[i][lane] = 1.0;
+    }
+    this->T[lane] = -1.0;
+    this->U[lane] = this->V[lane] = 0.0;
+    this->Triangle[lane] = -1;
+  }
+};
+
+// Return true if any segment of the packet may hit a triangle closer than
+// its current hit in the box.
+template <int N>
+inline bool vtkBVHIntersectBox(const vtkBVHRayPacket<N> &r, const double b[6])
+{
+  bool hit = false;
+  for (int l = 0; l < N; ++l)
+  {
+    double tx0 = (b[0] - r.Origin[0][l]) * r.InverseDirection[0][l];
+    double tx1 = (b[1] - r.Origin[0][l]) * r.InverseDirection[0][l];
+    double ty0 = (b[2] - r.Origin[1][l]) * r.InverseDirection[1][l];
+    double ty1 = (b[3] - r.Origin[1][l]) * r.InverseDirection[1][l];
+    double tz0 = (b[4] - r.Origin[2][l]) * r.InverseDirection[2][l];
+    double tz1 = (b[5] - r.Origin[2][l]) * r.InverseDirection[2][l];
+    double tmin = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)),
+                           std::max(std::min(tz0, tz1), 0.0));
+    double tmax = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)),
+                           std::min(std::max(tz0, tz1), r.T[l]));
+    hit |= (tmin <= tmax * VTK_BVH_BOX_SLACK);
+  }
+  return hit;
+}
+
+// Moller-Trumbore intersection of the packet with the triangles
+// [begin, end) of a leaf. The loop over the segments has no branches.
+template <int N>
+inline void vtkBVHIntersectTriangles(vtkBVHRayPacket<N> &r, const vtkBVHTree *tree,
+                                     vtkIdType begin, vtkIdType end)
+{
+  for (vtkIdType tri = begin; tri < end; ++tri)
+  {
+    const double v0x = tree->V0[0][tri], v0y = tree->V0[1][tri], v0z = tree->V0[2][tri];
+    const double e1x = tree->E1[0][tri], e1y = tree->E1[1][tri], e1z = tree->E1[2][tri];
+    const double e2x = tree->E2[0][tri], e2y = tree->E2[1][tri], e2z = tree->E2[2][tri];
+    for (int l = 0; l < N; ++l)
+    {
+      const double dx = r.Direction[0][l], dy = r.Direction[1][l], dz = r.Direction[2][l];
+      const double px = dy * e2z - dz * e2y;
+      const double py = dz * e2x - dx * e2z;
+      const double pz = dx * e2y - dy * e2x;
+      const double det = e1x * px + e1y * py + e1z * pz;
+      const double inv = 1.0 / det;
+      const double sx = r.Origin[0][l] - v0x;
+      const double sy = r.Origin[1][l] - v0y;
+      const double sz = r.Origin[2][l] - v0z;
+      const double u = (sx * px + sy * py + sz * pz) * inv;
+      const double qx = sy * e1z - sz * e1y;
+      const double qy = sz * e1x - sx * e1z;
+      const double qz = sx * e1y - sy * e1x;
+      const double v = (dx * qx + dy * qy + dz * qz) * inv;
+      const double t = (e2x * qx + e2y * qy + e2z * qz) * inv;
+      const bool hit = (det != 0.0) & (u >= 0.0) & (v >= 0.0) & (u + v <= 1.0) &
+        (t >= 0.0) & (t <= r.T[l]);
+      r.T[l] = hit ? t : r.T[l];
+      r.U[l] = hit ? u : r.U[l];
+      r.V[l] = hit ? v : r.V[l];
+      r.Triangle[l] = hit ? tri : r.Triangle[l];
+    }
+  }
+}
+
+// Find the closest triangle hit by each segment of the packet. Children
+// are visited in the mean direction of the packet along their split axis.
+template <int N>
+void vtkBVHTraverse(const vtkBVHTree *tree, vtkBVHRayPacket<N> &r)
+{
+  const int fixedSize = 64;
+  vtkIdType fixedStack[fixedSize];
+  std::vector<vtkIdType> largeStack;
+  vtkIdType *stack = fixedStack;
+  if (tree->Depth + 2 > fixedSize)
+  {
+    largeStack.resize(tree->Depth + 2);
+    stack = &largeStack[0];
+  }
+
+  const vtkBVHNode *nodes = &tree->Nodes[0];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const vtkBVHNode &node = nodes[stack[--top]];
+    if (!vtkBVHIntersectBox(r, node.Bounds))
+    {
+      continue;
+    }
+    if (node.Count > 0)
+    {
+      vtkBVHIntersectTriangles(r, tree, node.Start, node.Start + node.Count);
+      continue;
+    }
+    double d = 0.0;
+    for (int l = 0; l < N; ++l)
+    {
+      d += r.Direction[node.Axis][l];
+    }
+    stack[top++] = d < 0.0 ? node.Start : node.Start + 1;
+    stack[top++] = d < 0.0 ? node.Start + 1 : node.Start;
+  }
+}
+
+// Parametric coordinates of a hit in its cell. Triangle cells use the
+// barycentric coordinates of the hit, other cells are evaluated. The cell
+// is loaded in cell if needed or if getCell is true.
+void vtkBVHHitCoordinates(vtkDataSet *ds, const vtkBVHTree *tree, vtkIdType tri,
+                          double u, double v, const double x[3], double pcoords[3],
+                          int &subId, vtkGenericCell *cell, bool getCell,
+                          std::vector<double> &weights)
+{
+  vtkIdType cellId = tree->CellIds[tri];
+  if (tree->SubIds[tri] < 0)
+  {
+    pcoords[0] = u;
+    pcoords[1] = v;
+    pcoords[2] = 0.0;
+    subId = 0;
+    if (getCell)
+    {
+      ds->GetCell(cellId, cell);
+    }
+    return;
+  }
+  ds->GetCell(cellId, cell);
+  weights.resize(std::max(cell->GetNumberOfPoints(), static_cast<vtkIdType>(1)));
+  double closest[3], dist2, xx[3] = { x[0], x[1], x[2] };
+  cell->EvaluatePosition(xx, closest, subId, pcoords, dist2, &weights[0]);
+}
+
+//-----------------------------------------------------------------------------
+// Squared distance from a point to a box, zero inside the box.
+inline double vtkBVHBoxDistance2(const double b[6], const double x[3])
+{
+  double d2 = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    double d = std::max(std::max(b[2 * i] - x[i], x[i] - b[2 * i + 1]), 0.0);
+    d2 += d * d;
+  }
+  return d2;
+}
+
+// Closest point of the segment a + t * ab, t in [0, 1], to p.
+inline double vtkBVHClosestPointOnSegment(const double a[3], const double ab[3],
+                                          const double p[3], double closest[3])
+{
+  double l2 = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+  double t = 0.0;
+  if (l2 > 0.0)
+  {
+    t = ((p[0] - a[0]) * ab[0] + (p[1] - a[1]) * ab[1] + (p[2] - a[2]) * ab[2]) / l2;
+    t = std::min(std::max(t, 0.0), 1.0);
+  }
+  double d2 = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    closest[i] = a[i] + t * ab[i];
+    d2 += (p[i] - closest[i]) * (p[i] - closest[i]);
+  }
+  return d2;
+}
+
+// Closest point of a triangle to p, following the Voronoi regions of the
+// triangle (see Ericson, Real-Time Collision Detection, 5.1.5). Return the
+// squared distance, and whether the closest point is inside the triangle
+// rather than on its boundary.
+double vtkBVHClosestPointOnTriangle(const vtkBVHTree *tree, vtkIdType tri,
+                                    const double p[3], double closest[3],
+                                    bool &interior)
+{
+  double a[3], ab[3], ac[3], ap[3], bp[3], cp[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    a[i] = tree->V0[i][tri];
+    ab[i] = tree->E1[i][tri];
+    ac[i] = tree->E2[i][tri];
+    ap[i] = p[i] - a[i];
+    bp[i] = ap[i] - ab[i];
+    cp[i] = ap[i] - ac[i];
+  }
+  double s, t;
+  double d1 = ab[0] * ap[0] + ab[1] * ap[1] + ab[2] * ap[2];
+  double d2 = ac[0] * ap[0] + ac[1] * ap[1] + ac[2] * ap[2];
+  double d3 = ab[0] * bp[0] + ab[1] * bp[1] + ab[2] * bp[2];
+  double d4 = ac[0] * bp[0] + ac[1] * bp[1] + ac[2] * bp[2];
+  double d5 = ab[0] * cp[0] + ab[1] * cp[1] + ab[2] * cp[2];
+  double d6 = ac[0] * cp[0] + ac[1] * cp[1] + ac[2] * cp[2];
+  double va = d3 * d6 - d5 * d4;
+  double vb = d5 * d2 - d1 * d6;
+  double vc = d1 * d4 - d3 * d2;
+  interior = false;
+  if (d1 <= 0.0 && d2 <= 0.0)
+  {
+    s = t = 0.0; // vertex a
+  }
+  else if (d3 >= 0.0 && d4 <= d3)
+  {
+    s = 1.0; // vertex b
+    t = 0.0;
+  }
+  else if (d6 >= 0.0 && d5 <= d6)
+  {
+    s = 0.0; // vertex c
+    t = 1.0;
+  }
+  else if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+  {
+    s = d1 / (d1 - d3); // edge ab
+    t = 0.0;
+  }
+  else if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+  {
+    s = 0.0; // edge ac
+    t = d2 / (d2 - d6);
+  }
+  else if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+  {
+    t = (d4 - d3) / ((d4 - d3) + (d5 - d6)); // edge bc
+    s = 1.0 - t;
+  }
+  else if (va + vb + vc > 0.0)
+  {
+    s = vb / (va + vb + vc); // face
+    t = vc / (va + vb + vc);
+    interior = true;
+  }
+  else
+  {
+    // Degenerate triangle: closest point of its edges
+    double bc[3] = { ac[0] - ab[0], ac[1] - ab[1], ac[2] - ab[2] };
+    double b[3] = { a[0] + ab[0], a[1] + ab[1], a[2] + ab[2] }, x[3];
+    double dist2 = vtkBVHClosestPointOnSegment(a, ab, p, closest);
+    double d = vtkBVHClosestPointOnSegment(a, ac, p, x);
+    if (d < dist2)
+    {
+      dist2 = d;
+      std::copy(x, x + 3, closest);
+    }
+    d = vtkBVHClosestPointOnSegment(b, bc, p, x);
+    if (d < dist2)
+    {
+      dist2 = d;
+      std::copy(x, x + 3, closest);
+    }
+    return dist2;
+  }
+  double dist2 = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    closest[i] = a[i] + s * ab[i] + t * ac[i];
+    dist2 += (p[i] - closest[i]) * (p[i] - closest[i]);
+  }
+  return dist2;
+}
+
+// Find the triangle closest to x, among the ones closer than sqrt(dist2).
+// Return -1 if there is none, otherwise update dist2 and closest. The
+// nearest child of a node is visited first, and the nodes farther than the
+// current closest triangle are skipped.
+vtkIdType vtkBVHFindClosestTriangle(const vtkBVHTree *tree, const double x[3],
+                                    double &dist2, double closest[3],
+                                    bool &interior)
+{
+  const int fixedSize = 64;
+  std::pair<vtkIdType, double> fixedStack[fixedSize];
+  std::vector<std::pair<vtkIdType, double> > largeStack;
+  std::pair<vtkIdType, double> *stack = fixedStack;
+  if (tree->Depth + 2 > fixedSize)
+  {
+    largeStack.resize(tree->Depth + 2);
+    stack = &largeStack[0];
+  }
+
+  const vtkBVHNode *nodes = &tree->Nodes[0];
+  vtkIdType best = -1;
+  double y[3];
+  bool in;
+  int top = 0;
+  stack[top++] = std::make_pair(static_cast<vtkIdType>(0),
+                                vtkBVHBoxDistance2(nodes[0].Bounds, x));
+  while (top > 0)
+  {
+    --top;
+    if (stack[top].second > dist2)
+    {
+      continue;
+    }
+    const vtkBVHNode &node = nodes[stack[top].first];
+    if (node.Count > 0)
+    {
+      for (vtkIdType tri = node.Start; tri < node.Start + node.Count; ++tri)
+      {
+        double d2 = vtkBVHClosestPointOnTriangle(tree, tri, x, y, in);
+        if (d2 < dist2 || (d2 == dist2 && best < 0))
+        {
+          dist2 = d2;
+          best = tri;
+          interior = in;
+          std::copy(y, y + 3, closest);
+        }
+      }
+      continue;
+    }
+    double d0 = vtkBVHBoxDistance2(nodes[node.Start].Bounds, x);
+    double d1 = vtkBVHBoxDistance2(nodes[node.Start + 1].Bounds, x);
+    int near = d1 < d0 ? 1 : 0;
+    stack[top++] = std::make_pair(node.Start + 1 - near, near ? d0 : d1);
+    stack[top++] = std::make_pair(node.Start + near, near ? d1 : d0);
+  }
+  return best;
+}
+
+// Solid angle of a triangle seen from x (Van Oosterom and Strackee),
+// positive if x is behind the triangle.
+inline double vtkBVHSolidAngle(const vtkBVHTree *tree, vtkIdType tri, const double x[3])
+{
+  double a[3], b[3], c[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    a[i] = tree->V0[i][tri] - x[i];
+    b[i] = a[i] + tree->E1[i][tri];
+    c[i] = a[i] + tree->E2[i][tri];
+  }
+  double la = sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+  double lb = sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+  double lc = sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+  double det = a[0] * (b[1] * c[2] - b[2] * c[1]) +
+    a[1] * (b[2] * c[0] - b[0] * c[2]) + a[2] * (b[0] * c[1] - b[1] * c[0]);
+  double ab = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  double bc = b[0] * c[0] + b[1] * c[1] + b[2] * c[2];
+  double ca = c[0] * a[0] + c[1] * a[1] + c[2] * a[2];
+  return 2.0 * atan2(det, la * lb * lc + ab * lc + bc * la + ca * lb);
+}
+
+// Compute the dipoles of the nodes, children first (they are stored after
+// their parent).
+void vtkBVHComputeDipoles(vtkBVHTree *tree)
+{
+  vtkIdType numNodes = static_cast<vtkIdType>(tree->Nodes.size());
+  std::vector<double> areas(numNodes, 0.0);
+  tree->NodeNormals.assign(3 * numNodes, 0.0);
+  tree->NodeCenters.assign(3 * numNodes, 0.0);
+  tree->NodeRadii.assign(numNodes, 0.0);
+  for (vtkIdType n = numNodes - 1; n >= 0; --n)
+  {
+    const vtkBVHNode &node = tree->Nodes[n];
+    double *normal = &tree->NodeNormals[3 * n];
+    double *center = &tree->NodeCenters[3 * n];
+    if (node.Count > 0)
+    {
+      for (vtkIdType tri = node.Start; tri < node.Start + node.Count; ++tri)
+      {
+        double e1[3], e2[3], nt[3];
+        for (int i = 0; i < 3; ++i)
+        {
+          e1[i] = tree->E1[i][tri];
+          e2[i] = tree->E2[i][tri];
+        }
+        nt[0] = 0.5 * (e1[1] * e2[2] - e1[2] * e2[1]);
+        nt[1] = 0.5 * (e1[2] * e2[0] - e1[0] * e2[2]);
+        nt[2] = 0.5 * (e1[0] * e2[1] - e1[1] * e2[0]);
+        double area = sqrt(nt[0] * nt[0] + nt[1] * nt[1] + nt[2] * nt[2]);
+        for (int i = 0; i < 3; ++i)
+        {
+          normal[i] += nt[i];
+          center[i] += area * (tree->V0[i][tri] + (e1[i] + e2[i]) / 3.0);
+        }
+        areas[n] += area;
+      }
+    }
+    else
+    {
+      for (vtkIdType child = node.Start; child < node.Start + 2; ++child)
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          normal[i] += tree->NodeNormals[3 * child + i];
+          center[i] += areas[child] * tree->NodeCenters[3 * child + i];
+        }
+        areas[n] += areas[child];
+      }
+    }
+
+    double r2 = 0.0;
+    for (int i = 0; i < 3; ++i)
+    {
+      center[i] = areas[n] > 0.0 ? center[i] / areas[n] :
+        0.5 * (node.Bounds[2 * i] + node.Bounds[2 * i + 1]);
+      double d = std::max(center[i] - node.Bounds[2 * i],
+                          node.Bounds[2 * i + 1] - center[i]);
+      r2 += d * d;
+    }
+    tree->NodeRadii[n] = sqrt(r2);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Intersect packets of segments taken in the order of the space filling
+// curve.
+struct vtkBVHIntersectPacketsFunctor
+{
+  typedef vtkBVHRayPacket<VTK_BVH_PACKET_SIZE> PacketType;
+
+  vtkDataSet *DataSet;
+  const vtkBVHTree *Tree;
+  vtkPoints *P1;
+  vtkPoints *P2;
+  const vtkIdType *Order;
+  vtkIdType NumberOfQueries;
+  vtkIdType *CellIds;
+  double *T;
+  double *X;
+  double *PCoords;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double> > Weights;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell *cell = this->Cell.Local();
+    std::vector<double> &weights = this->Weights.Local();
+    PacketType rays;
+    double a[3], b[3];
+    for (vtkIdType packet = begin; packet < end; ++packet)
+    {
+      vtkIdType first = packet * VTK_BVH_PACKET_SIZE;
+      int n = static_cast<int>(
+        std::min(static_cast<vtkIdType>(VTK_BVH_PACKET_SIZE), this->NumberOfQueries - first));
+      for (int l = 0; l < VTK_BVH_PACKET_SIZE; ++l)
+      {
+        if (l < n)
+        {
+          this->P1->GetPoint(this->Order[first + l], a);
+          this->P2->GetPoint(this->Order[first + l], b);
+          rays.Set(l, a, b);
+        }
+        else
+        {
+          rays.Disable(l);
+        }
+      }
+      vtkBVHTraverse(this->Tree, rays);
+
+      for (int l = 0; l < n; ++l)
+      {
+        vtkIdType q = this->Order[first + l];
+        vtkIdType tri = rays.Triangle[l];
+        double t = 0.0, x[3] = { 0.0, 0.0, 0.0 }, pcoords[3] = { 0.0, 0.0, 0.0 };
+        if (tri >= 0)
+        {
+          t = rays.T[l];
+          for (int i = 0; i < 3; ++i)
+          {
+            x[i] = rays.Origin[i][l] + t * rays.Direction[i][l];
+          }
+          if (this->PCoords)
+          {
+            int subId;
+            vtkBVHHitCoordinates(this->DataSet, this->Tree, tri, rays.U[l], rays.V[l],
+                                 x, pcoords, subId, cell, false, weights);
+          }
+        }
+        this->CellIds[q] = tri >= 0 ? this->Tree->CellIds[tri] : -1;
+        if (this->T)
+        {
+          this->T[q] = t;
+        }
+        if (this->X)
+        {
+          std::copy(x, x + 3, this->X + 3 * q);
+        }
+        if (this->PCoords)
+        {
+          std::copy(pcoords, pcoords + 3, this->PCoords + 3 * q);
+        }
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->NumberOfCellsPerNode = 4;
+  this->NumberOfBins = 16;
+  this->Tree = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::GetNumberOfTriangles()
+{
+  return this->Tree ? static_cast<vtkIdType>(this->Tree->CellIds.size()) : 0;
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::GetNumberOfNodes()
+{
+  return this->Tree ? static_cast<vtkIdType>(this->Tree->Nodes.size()) : 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  delete this->Tree;
+  this->Tree = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  // Do we need to build?
+  if ( this->Tree && this->DataSet && (this->BuildTime > this->MTime)
+       && (this->BuildTime > this->DataSet->GetMTime()) )
+  {
+    return;
+  }
+
+  vtkDebugMacro( << "Building BVH cell locator" );
+  if ( !this->DataSet || this->DataSet->GetNumberOfCells() < 1 )
+  {
+    vtkErrorMacro( << "No cells to build");
+    return;
+  }
+  this->FreeSearchStructure();
+
+  // Decompose the 2D cells into triangles and compute their bounds
+  vtkBVHTriangles tris;
+  vtkBVHCollectTriangles(this->DataSet, tris);
+  vtkIdType numTris = static_cast<vtkIdType>(tris.CellIds.size());
+  if ( numTris == 0 )
+  {
+    vtkErrorMacro( << "No 2D cells to build");
+    return;
+  }
+
+  std::vector<double> triBounds(6 * numTris);
+  std::vector<double> centroids(3 * numTris);
+  vtkBVHTriangleBounds boundsFunctor;
+  boundsFunctor.DataSet = this->DataSet;
+  boundsFunctor.Points = &tris.Points[0];
+  boundsFunctor.Bounds = &triBounds[0];
+  boundsFunctor.Centroids = &centroids[0];
+  vtkSMPTools::For(0, numTris, boundsFunctor);
+
+  std::vector<vtkIdType> order(numTris);
+  for (vtkIdType i = 0; i < numTris; ++i)
+  {
+    order[i] = i;
+  }
+
+  vtkBVHBuilder builder;
+  builder.TriangleBounds = &triBounds[0];
+  builder.Centroids = &centroids[0];
+  builder.Order = &order[0];
+  builder.NumberOfBins = this->NumberOfBins;
+  builder.MaxLeafSize = std::max(this->NumberOfCellsPerNode, 1);
+
+  // Split the top of the hierarchy with parallel binning until there are
+  // enough subtrees to keep the threads busy, then build the subtrees
+  // concurrently and append them to the top.
+  vtkIdType numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  vtkIdType subtreeSize = std::max(static_cast<vtkIdType>(1024), numTris / (4 * numThreads));
+  vtkBVHTree *tree = new vtkBVHTree;
+  std::vector<vtkBVHSubtree> subtrees;
+  tree->Depth = builder.Build(tree->Nodes, 0, numTris, true, subtreeSize, &subtrees);
+  vtkBVHSubtreeFunctor subtreeFunctor(builder, subtrees);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1, subtreeFunctor);
+
+  std::vector<vtkBVHSubtree>::iterator itr;
+  for (itr = subtrees.begin(); itr != subtrees.end(); ++itr)
+  {
+    // The root of the subtree replaces its node, the other nodes are
+    // appended and their children renumbered.
+    vtkIdType offset = static_cast<vtkIdType>(tree->Nodes.size()) - 1;
+    for (size_t i = 0; i < itr->Nodes.size(); ++i)
+    {
+      vtkBVHNode node = itr->Nodes[i];
+      if (node.Count == 0)
+      {
+        node.Start += offset;
+      }
+      if (i == 0)
+      {
+        tree->Nodes[itr->Node] = node;
+      }
+      else
+      {
+        tree->Nodes.push_back(node);
+      }
+    }
+    tree->Depth = std::max(tree->Depth, itr->NodeDepth + itr->Depth);
+  }
+
+  // Store the triangles in the order of the leaves
+  for (int i = 0; i < 3; ++i)
+  {
+    tree->V0[i].resize(numTris);
+    tree->E1[i].resize(numTris);
+    tree->E2[i].resize(numTris);
+  }
+  tree->CellIds.resize(numTris);
+  tree->SubIds.resize(numTris);
+  vtkBVHFlattenFunctor flatten(this->DataSet, tris, &order[0], tree);
+  vtkSMPTools::For(0, numTris, flatten);
+  vtkBVHComputeDipoles(tree);
+
+  this->Tree = tree;
+  this->BuildTime.Modified();
+}
+
+//-----------------------------------------------------------------------------
+bool vtkBVHCellLocator::PrepareForConcurrentQueries()
+{
+  this->BuildLocator();
+  return this->Tree != nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkBVHCellLocator::PrepareForConcurrentFindCell()
+{
+  // FindCell() is inherited and calls vtkDataSet::FindCell(), which builds
+  // a point locator on first use.
+  this->BuildLocator();
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+int vtkBVHCellLocator::
+IntersectWithLine(double p1[3], double p2[3], double vtkNotUsed(tol),
+                  double &t, double x[3], double pcoords[3],
+                  int &subId, vtkIdType &cellId, vtkGenericCell *cell)
+{
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return 0;
+  }
+
+  vtkBVHRayPacket<1> ray;
+  ray.Set(0, p1, p2);
+  vtkBVHTraverse(this->Tree, ray);
+  vtkIdType tri = ray.Triangle[0];
+  if ( tri < 0 )
+  {
+    return 0;
+  }
+
+  t = ray.T[0];
+  for (int i = 0; i < 3; ++i)
+  {
+    x[i] = p1[i] + t * ray.Direction[i][0];
+  }
+  cellId = this->Tree->CellIds[tri];
+  std::vector<double> weights;
+  vtkBVHHitCoordinates(this->DataSet, this->Tree, tri, ray.U[0], ray.V[0], x,
+                       pcoords, subId, cell, true, weights);
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::FindClosestPoint(
+  double x[3], double closestPoint[3], vtkGenericCell *cell,
+  vtkIdType &cellId, int &subId, double &dist2)
+{
+  int inside;
+  if ( !this->FindClosestPointWithinRadius(x, VTK_DOUBLE_MAX, closestPoint,
+                                           cell, cellId, subId, dist2, inside) )
+  {
+    cellId = -1;
+    subId = 0;
+    dist2 = -1.0;
+  }
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindClosestPointWithinRadius(
+  double x[3], double radius, double closestPoint[3], vtkGenericCell *cell,
+  vtkIdType &cellId, int &subId, double &dist2, int &inside)
+{
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return 0;
+  }
+
+  bool interior = false;
+  dist2 = ( radius < sqrt(VTK_DOUBLE_MAX) ? radius * radius : VTK_DOUBLE_MAX );
+  vtkIdType tri = vtkBVHFindClosestTriangle(this->Tree, x, dist2, closestPoint,
+                                            interior);
+  if ( tri < 0 )
+  {
+    return 0;
+  }
+
+  // The closest point of a triangle cell is inside it if it is not on its
+  // boundary. Other cells are evaluated.
+  cellId = this->Tree->CellIds[tri];
+  this->DataSet->GetCell(cellId, cell);
+  if ( this->Tree->SubIds[tri] < 0 )
+  {
+    subId = 0;
+    inside = interior ? 1 : 0;
+    return 1;
+  }
+  double pcoords[3], d2, fixedWeights[VTK_CELL_SIZE];
+  std::vector<double> largeWeights;
+  double *weights = fixedWeights;
+  if ( cell->GetNumberOfPoints() > VTK_CELL_SIZE )
+  {
+    largeWeights.resize(cell->GetNumberOfPoints());
+    weights = &largeWeights[0];
+  }
+  inside = cell->EvaluatePosition(x, nullptr, subId, pcoords, d2, weights);
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+double vtkBVHCellLocator::GetWindingNumber(double x[3])
+{
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return 0.0;
+  }
+
+  const vtkBVHTree *tree = this->Tree;
+  std::vector<vtkIdType> stack(1, 0);
+  double solidAngle = 0.0;
+  while (!stack.empty())
+  {
+    vtkIdType n = stack.back();
+    stack.pop_back();
+    const vtkBVHNode &node = tree->Nodes[n];
+    const double *center = &tree->NodeCenters[3 * n];
+    const double *normal = &tree->NodeNormals[3 * n];
+    double d[3] = { center[0] - x[0], center[1] - x[1], center[2] - x[2] };
+    double dist = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    if (dist > VTK_BVH_DIPOLE_DISTANCE * tree->NodeRadii[n])
+    {
+      solidAngle += (d[0] * normal[0] + d[1] * normal[1] + d[2] * normal[2]) /
+        (dist * dist * dist);
+    }
+    else if (node.Count > 0)
+    {
+      for (vtkIdType tri = node.Start; tri < node.Start + node.Count; ++tri)
+      {
+        solidAngle += vtkBVHSolidAngle(tree, tri, x);
+      }
+    }
+    else
+    {
+      stack.push_back(node.Start);
+      stack.push_back(node.Start + 1);
+    }
+  }
+  return solidAngle / (4.0 * vtkMath::Pi());
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::IntersectWithLines(
+  vtkPoints *p1, vtkPoints *p2, double vtkNotUsed(tol), vtkIdList *cellIds,
+  vtkDoubleArray *t, vtkPoints *x, vtkDoubleArray *pcoords)
+{
+  if (!this->DataSet || !p1 || !p2 || !cellIds)
+  {
+    vtkErrorMacro(<< "A dataset, segment end points and cell ids are required");
+    return;
+  }
+  vtkIdType numQueries = p1->GetNumberOfPoints();
+  if (p2->GetNumberOfPoints() != numQueries)
+  {
+    vtkErrorMacro(<< "The segments need as many start as end points");
+    return;
+  }
+
+  cellIds->SetNumberOfIds(numQueries);
+  if (t)
+  {
+    t->SetNumberOfComponents(1);
+    t->SetNumberOfTuples(numQueries);
+  }
+  if (x)
+  {
+    x->SetDataTypeToDouble();
+    x->SetNumberOfPoints(numQueries);
+  }
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numQueries);
+  }
+  if (numQueries == 0)
+  {
+    return;
+  }
+
+  if (!this->PrepareForConcurrentQueries())
+  {
+    for (vtkIdType i = 0; i < numQueries; ++i)
+    {
+      cellIds->SetId(i, -1);
+    }
+    if (t)
+    {
+      t->FillComponent(0, 0.0);
+    }
+    if (x)
+    {
+      vtkDataArray *xData = x->GetData();
+      for (int i = 0; i < 3; ++i)
+      {
+        xData->FillComponent(i, 0.0);
+      }
+    }
+    if (pcoords)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        pcoords->FillComponent(i, 0.0);
+      }
+    }
+    return;
+  }
+
+  vtkNew<vtkIdList> order;
+  vtkAbstractCellLocator::ComputeQueryOrder(p1, p2, order.GetPointer());
+
+  vtkBVHIntersectPacketsFunctor functor;
+  functor.DataSet = this->DataSet;
+  functor.Tree = this->Tree;
+  functor.P1 = p1;
+  functor.P2 = p2;
+  functor.Order = order->GetPointer(0);
+  functor.NumberOfQueries = numQueries;
+  functor.CellIds = cellIds->GetPointer(0);
+  functor.T = t ? t->GetPointer(0) : nullptr;
+  functor.X = x ? static_cast<double*>(x->GetVoidPointer(0)) : nullptr;
+  functor.PCoords = pcoords ? pcoords->GetPointer(0) : nullptr;
+  vtkIdType numPackets = (numQueries + VTK_BVH_PACKET_SIZE - 1) / VTK_BVH_PACKET_SIZE;
+  vtkSMPTools::For(0, numPackets, functor);
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::GenerateRepresentation(int level, vtkPolyData *pd)
+{
+  // Make sure locator has been built successfully
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return;
+  }
+
+  vtkPoints *pts = vtkPoints::New();
+  vtkCellArray *polys = vtkCellArray::New();
+  static const vtkIdType faces[6][4] = { {0,4,6,2}, {1,3,7,5}, {0,1,5,4},
+                                         {2,6,7,3}, {0,2,3,1}, {4,5,7,6} };
+
+  std::vector<std::pair<vtkIdType, int> > stack(1, std::make_pair(0, 0));
+  while (!stack.empty())
+  {
+    const vtkBVHNode &node = this->Tree->Nodes[stack.back().first];
+    int depth = stack.back().second;
+    stack.pop_back();
+    if (node.Count == 0 && depth != level)
+    {
+      stack.push_back(std::make_pair(node.Start, depth + 1));
+      stack.push_back(std::make_pair(node.Start + 1, depth + 1));
+      continue;
+    }
+
+    // Corners in (i-j-k) order and the six faces of the box
+    vtkIdType pIds[8];
+    for (int i = 0; i < 8; ++i)
+    {
+      pIds[i] = pts->InsertNextPoint(node.Bounds[i & 1],
+                                     node.Bounds[2 + ((i >> 1) & 1)],
+                                     node.Bounds[4 + ((i >> 2) & 1)]);
+    }
+    for (int i = 0; i < 6; ++i)
+    {
+      polys->InsertNextCell(4);
+      for (int j = 0; j < 4; ++j)
+      {
+        polys->InsertCellPoint(pIds[faces[i][j]]);
+      }
+    }
+  }
+
+  pd->SetPoints(pts);
+  pd->SetPolys(polys);
+  pts->Delete();
+  polys->Delete();
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number Of Bins: " << this->NumberOfBins << "\n";
+  os << indent << "Number Of Triangles: " << this->GetNumberOfTriangles() << "\n";
+  os << indent << "Number Of Nodes: " << this->GetNumberOfNodes() << "\n";
+}
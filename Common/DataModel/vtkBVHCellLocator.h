@@ -0,0 +1,236 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkBVHCellLocator
+ * @brief   bounding volume hierarchy for fast ray casting on surfaces
+ *
+ * vtkBVHCellLocator is a type of vtkAbstractCellLocator dedicated to
+ * intersecting many lines with surface meshes. The 2D cells of the dataset
+ * are decomposed into triangles, which are organized in a bounding volume
+ * hierarchy split with the surface area heuristic (SAH). Cells of other
+ * dimensions are ignored.
+ *
+ * The hierarchy is built with vtkSMPTools: the triangle bounds are computed
+ * in parallel, the top levels are split with parallel binning, and the
+ * subtrees below them are built concurrently. The triangles are then
+ * stored in the order of the leaves as structure of arrays (one vertex and
+ * two edges per triangle), so that intersections are computed directly
+ * with the Moller-Trumbore algorithm rather than through the vtkCell API.
+ *
+ * IntersectWithLines() processes the segments in packets of
+ * neighboring segments (see vtkAbstractCellLocator::FindCells()) that
+ * traverse the hierarchy together. The inner loops run over the segments
+ * of a packet without branches so that the compiler can vectorize them.
+ * The packets are processed with vtkSMPTools.
+ *
+ * The closest point queries traverse the hierarchy nearest node first and
+ * skip the nodes farther than the closest triangle found so far. The
+ * winding number of a point is computed with the hierarchy as well: nodes
+ * far enough from the point are replaced by a dipole (the sum of the area
+ * weighted normals of their triangles), which makes it a fast
+ * inside/outside test for closed or nearly closed surfaces.
+ *
+ * @warning
+ * The tolerance of the line intersection methods is ignored: triangles are
+ * intersected exactly, and the cells touched at an edge or a vertex may
+ * differ from the ones returned by other locators.
+ *
+ * @warning
+ * FindCell() is not accelerated: it goes through vtkDataSet::FindCell(),
+ * and FindCells() answers its queries from a single thread.
+ *
+ * @warning
+ * Build in Release or RelWithDebInfo: the traversal relies on compiler
+ * optimization to be fast.
+ *
+ * @sa
+ * vtkAbstractCellLocator vtkModifiedBSPTree vtkOBBTree vtkStaticCellLocator
+ */
+
+#ifndef vtkBVHCellLocator_h
+#define vtkBVHCellLocator_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkAbstractCellLocator.h"
+
+// Forward declarations for PIMPL
+struct vtkBVHTree;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkBVHCellLocator *New();
+  vtkTypeMacro(vtkBVHCellLocator,vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Number of bins per axis used to evaluate the surface area heuristic
+   * when splitting a node. More bins give a better tree at the price of a
+   * longer build. The default is 16.
+   */
+  vtkSetClampMacro(NumberOfBins,int,2,256);
+  vtkGetMacro(NumberOfBins,int);
+  //@}
+
+  /**
+   * Return the number of triangles and of nodes in the hierarchy. Only
+   * meaningful after the locator has been built.
+   */
+  vtkIdType GetNumberOfTriangles();
+  vtkIdType GetNumberOfNodes();
+
+  /**
+   * Return intersection point (if any) AND the cell which was intersected by
+   * the finite line. The cell is returned as a cell id and as a generic cell.
+   * This method is thread safe once the locator has been built.
+   */
+  int IntersectWithLine(double a0[3], double a1[3], double tol,
+                        double& t, double x[3], double pcoords[3],
+                        int &subId, vtkIdType &cellId,
+                        vtkGenericCell *cell) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(double p1[3], double p2[3], double tol,
+                        double& t, double x[3], double pcoords[3], int &subId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId);
+  }
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(double p1[3], double p2[3], double tol,
+                        double &t, double x[3], double pcoords[3],
+                        int &subId, vtkIdType &cellId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
+  }
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3],
+                        vtkPoints *points, vtkIdList *cellIds) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, points, cellIds);
+  }
+
+  /**
+   * Return the closest point and the cell which is closest to the point x.
+   * Cells that do not have a 2D decomposition are ignored. This method is
+   * thread safe once the locator has been built, provided that each thread
+   * uses its own generic cell.
+   */
+  void FindClosestPoint(double x[3], double closestPoint[3],
+                        vtkGenericCell *cell, vtkIdType &cellId,
+                        int &subId, double& dist2) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  void FindClosestPoint(double x[3], double closestPoint[3],
+                        vtkIdType &cellId, int &subId, double& dist2) override
+  {
+    this->Superclass::FindClosestPoint(x, closestPoint, cellId, subId, dist2);
+  }
+
+  /**
+   * Return the closest point within a specified radius and the cell which
+   * is closest to the point x, see vtkAbstractCellLocator. Thread safe once
+   * the locator has been built, provided that each thread uses its own
+   * generic cell.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                         double closestPoint[3],
+                                         vtkGenericCell *cell, vtkIdType &cellId,
+                                         int &subId, double& dist2,
+                                         int &inside) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                         double closestPoint[3], vtkIdType &cellId,
+                                         int &subId, double& dist2) override
+  {
+    return this->Superclass::FindClosestPointWithinRadius(
+      x, radius, closestPoint, cellId, subId, dist2);
+  }
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                         double closestPoint[3],
+                                         vtkGenericCell *cell, vtkIdType &cellId,
+                                         int &subId, double& dist2) override
+  {
+    return this->Superclass::FindClosestPointWithinRadius(
+      x, radius, closestPoint, cell, cellId, subId, dist2);
+  }
+
+  /**
+   * Return the generalized winding number of the surface around x: the sum
+   * of the solid angles of the triangles seen from x, divided by 4 pi. It
+   * is close to 1 inside a closed surface whose normals point outward, and
+   * close to 0 outside of it. The triangles of the distant nodes are
+   * approximated by dipoles. Thread safe once the locator has been built.
+   */
+  double GetWindingNumber(double x[3]);
+
+  /**
+   * Intersect the segments in packets, see the class documentation. The
+   * results are the same as the ones of IntersectWithLine().
+   */
+  void IntersectWithLines(vtkPoints *p1, vtkPoints *p2, double tol,
+                          vtkIdList *cellIds, vtkDoubleArray *t = nullptr,
+                          vtkPoints *x = nullptr,
+                          vtkDoubleArray *pcoords = nullptr) override;
+
+  //@{
+  /**
+   * Satisfy vtkLocator abstract interface. GenerateRepresentation() outputs
+   * the boxes of the nodes at the given depth, and of the leaves above it.
+   * A negative level outputs all the leaves.
+   */
+  void GenerateRepresentation(int level, vtkPolyData *pd) override;
+  void FreeSearchStructure() override;
+  void BuildLocator() override;
+  //@}
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator() override;
+
+  bool PrepareForConcurrentQueries() override;
+  bool PrepareForConcurrentFindCell() override;
+
+  int NumberOfBins;
+  vtkBVHTree *Tree;
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&) = delete;
+  void operator=(const vtkBVHCellLocator&) = delete;
+};
+
+#endif
@@ -140,12 +140,27 @@ int vtkCellLocator::GenerateIndex(int offset, int numDivs, int i, int j,
 //----------------------------------------------------------------------------
 void vtkCellLocator::ComputeOctantBounds(int i, int j, int k)
 {
-  this->OctantBounds[0] = this->Bounds[0] + i*H[0];
-  this->OctantBounds[1] = this->OctantBounds[0] + H[0];
-  this->OctantBounds[2] = this->Bounds[2] + j*H[1];
-  this->OctantBounds[3] = this->OctantBounds[2] + H[1];
-  this->OctantBounds[4] = this->Bounds[4] + k*H[2];
-  this->OctantBounds[5] = this->OctantBounds[4] + H[2];
+  this->ComputeOctantBounds(i, j, k, this->OctantBounds);
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLocator::ComputeOctantBounds(int i, int j, int k, double bounds[6])
+{
+  bounds[0] = this->Bounds[0] + i*H[0];
+  bounds[1] = bounds[0] + H[0];
+  bounds[2] = this->Bounds[2] + j*H[1];
+  bounds[3] = bounds[2] + H[1];
+  bounds[4] = this->Bounds[4] + k*H[2];
+  bounds[5] = bounds[4] + H[2];
+}
+
+//----------------------------------------------------------------------------
+static bool vtkCellLocator_InsideOctant(const double bounds[6],
+                                        const double x[3], double tol)
+{
+  return bounds[0]-tol <= x[0] && x[0] <= bounds[1]+tol &&
+         bounds[2]-tol <= x[1] && x[1] <= bounds[3]+tol &&
+         bounds[4]-tol <= x[2] && x[2] <= bounds[5]+tol;
 }
 
 //----------------------------------------------------------------------------
@@ -155,6 +170,35 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
                                       double& t, double x[3], double pcoords[3],
                                       int &subId, vtkIdType &cellId,
                                       vtkGenericCell *cell)
+{
+  return this->IntersectWithLineInternal(a0, a1, tol, t, x, pcoords, subId,
+                                         cellId, cell, true);
+}
+
+//----------------------------------------------------------------------------
+int vtkCellLocator::IntersectWithLineConcurrently(
+  double a0[3], double a1[3], double tol, double& t, double x[3],
+  double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell)
+{
+  return this->IntersectWithLineInternal(a0, a1, tol, t, x, pcoords, subId,
+                                         cellId, cell, false);
+}
+
+//----------------------------------------------------------------------------
+bool vtkCellLocator::PrepareForConcurrentQueries()
+{
+  this->Superclass::PrepareForConcurrentQueries();
+  this->BuildLocatorIfNeeded();
+  return this->Tree != nullptr;
+}
+
+//----------------------------------------------------------------------------
+// Without the visited marks, a cell spanning several of the octants crossed
+// by the line may be tested more than once, with the same result.
+int vtkCellLocator::IntersectWithLineInternal(
+  double a0[3], double a1[3], double tol, double& t, double x[3],
+  double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell,
+  bool markVisited)
 {
   double origin[3];
   double direction1[3];
@@ -163,7 +207,7 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
   double hitPosition[3];
   double hitCellBoundsPosition[3], cellBounds[6];
   double result;
-  double bounds2[6];
+  double bounds2[6], octantBounds[6];
   int i, leafStart, prod, loop;
   vtkIdType bestCellId = -1, cId;
   int idx;
@@ -216,11 +260,14 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
     // Clear the array that indicates whether we have visited this cell.
     // The array is only cleared when the query number rolls over.  This
     // saves a number of calls to memset.
-    this->QueryNumber++;
-    if (this->QueryNumber == 0)
+    if (markVisited)
     {
-      this->ClearCellHasBeenVisited();
-      this->QueryNumber++;    // can't use 0 as a marker
+      this->QueryNumber++;
+      if (this->QueryNumber == 0)
+      {
+        this->ClearCellHasBeenVisited();
+        this->QueryNumber++;    // can't use 0 as a marker
+      }
     }
 
     // set up curr and stop dist
@@ -255,14 +302,17 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
     {
       if (this->Tree[idx])
       {
-        this->ComputeOctantBounds(pos[0]-1,pos[1]-1,pos[2]-1);
+        this->ComputeOctantBounds(pos[0]-1,pos[1]-1,pos[2]-1, octantBounds);
         for (tMax = VTK_DOUBLE_MAX, cellId=0;
         cellId < this->Tree[idx]->GetNumberOfIds(); cellId++)
         {
           cId = this->Tree[idx]->GetId(cellId);
-          if (this->CellHasBeenVisited[cId] != this->QueryNumber)
+          if (!markVisited || this->CellHasBeenVisited[cId] != this->QueryNumber)
           {
-            this->CellHasBeenVisited[cId] = this->QueryNumber;
+            if (markVisited)
+            {
+              this->CellHasBeenVisited[cId] = this->QueryNumber;
+            }
             int hitCellBounds = 0;
 
             // check whether we intersect the cell bounds
@@ -287,9 +337,12 @@ int vtkCellLocator::IntersectWithLine(double a0[3], double a1[3], double tol,
               this->DataSet->GetCell(cId, cell);
               if (cell->IntersectWithLine(a0, a1, tol, t, x, pcoords, subId) )
               {
-                if ( ! this->IsInOctantBounds(x, tol) )
+                if ( ! vtkCellLocator_InsideOctant(octantBounds, x, tol) )
                 {
-                  this->CellHasBeenVisited[cId] = 0; //mark the cell non-visited
+                  if (markVisited)
+                  {
+                    this->CellHasBeenVisited[cId] = 0; //mark the cell non-visited
+                  }
                 }
                 else
                 {
@@ -177,6 +177,20 @@ protected:
   void ClearCellHasBeenVisited();
   void ClearCellHasBeenVisited(int id);
 
+  bool PrepareForConcurrentQueries() override;
+  int IntersectWithLineConcurrently(
+    double a0[3], double a1[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId,
+    vtkGenericCell *cell) override;
+
+  // Implements IntersectWithLine(), and IntersectWithLineConcurrently()
+  // when markVisited is false: the visited cells are then not recorded in
+  // CellHasBeenVisited and no member of the locator is modified.
+  int IntersectWithLineInternal(
+    double a0[3], double a1[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell,
+    bool markVisited);
+
   double Distance2ToBucket(double x[3], int nei[3]);
   double Distance2ToBounds(double x[3], double bounds[6]);
 
@@ -199,6 +213,7 @@ protected:
   unsigned char QueryNumber;
 
   void ComputeOctantBounds(int i, int j, int k);
+  void ComputeOctantBounds(int i, int j, int k, double bounds[6]);
   double OctantBounds[6]; //the bounds of the current octant
   int IsInOctantBounds(double x[3], double tol = 0.0)
   {
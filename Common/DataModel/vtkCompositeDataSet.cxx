@@ -14,25 +14,66 @@
 =========================================================================*/
 #include "vtkCompositeDataSet.h"
 
+#include "vtkBoundingBox.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataSet.h"
 #include "vtkInformation.h"
 #include "vtkInformationStringKey.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
 
 vtkInformationKeyMacro(vtkCompositeDataSet, NAME, String);
 vtkInformationKeyMacro(vtkCompositeDataSet, CURRENT_PROCESS_CAN_LOAD_BLOCK, Integer);
 
+//----------------------------------------------------------------------------
+class vtkCompositeDataSetBoundsCache
+{
+public:
+  // Leaves the bounds were computed from, in traversal order.
+  std::vector<vtkDataSet*> Leaves;
+  double Bounds[6];
+  vtkTimeStamp ComputeTime;
+};
+
+namespace
+{
+// Compute the bounds of a list of point coordinates. vtkPoints caches its
+// bounds, so that the datasets using them only copy them afterwards.
+class vtkLeafBoundsFunctor
+{
+public:
+  const std::vector<vtkPoints*>& Points;
+
+  vtkLeafBoundsFunctor(const std::vector<vtkPoints*>& points) : Points(points) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Points[i]->ComputeBounds();
+    }
+  }
+};
+}
+
 //----------------------------------------------------------------------------
 vtkCompositeDataSet::vtkCompositeDataSet()
 {
+  this->BoundsCache = new vtkCompositeDataSetBoundsCache;
 }
 
 //----------------------------------------------------------------------------
 vtkCompositeDataSet::~vtkCompositeDataSet()
 {
+  delete this->BoundsCache;
 }
 
 //----------------------------------------------------------------------------
@@ -109,6 +150,76 @@ vtkIdType vtkCompositeDataSet::GetNumberOfPoints()
   return numPts;
 }
 
+//----------------------------------------------------------------------------
+void vtkCompositeDataSet::GetBounds(double bounds[6])
+{
+  // Checking the leaves is cheap compared to computing their bounds, and
+  // catches blocks replaced deeper in the tree, which does not modify this
+  // dataset.
+  std::vector<vtkDataSet*> leaves;
+  bool modified = false;
+  vtkMTimeType computeTime = this->BoundsCache->ComputeTime.GetMTime();
+  vtkCompositeDataIterator* iter = this->NewIterator();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (ds)
+    {
+      leaves.push_back(ds);
+      modified = modified || ds->GetMTime() > computeTime;
+    }
+  }
+  iter->Delete();
+
+  vtkCompositeDataSetBoundsCache* cache = this->BoundsCache;
+  if (modified || computeTime == 0 || leaves != cache->Leaves)
+  {
+    cache->Leaves = leaves;
+
+    // Computing the bounds of the points is the expensive part, and is
+    // done in parallel. A dataset may appear several times in the tree, and
+    // datasets may share their points: each vtkPoints is handed to a
+    // single thread, since it caches its bounds.
+    std::vector<vtkPoints*> points;
+    for (size_t i = 0; i < leaves.size(); ++i)
+    {
+      vtkPointSet* ps = vtkPointSet::SafeDownCast(leaves[i]);
+      if (ps && ps->GetPoints())
+      {
+        points.push_back(ps->GetPoints());
+      }
+    }
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    vtkLeafBoundsFunctor functor(points);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(points.size()), 1, functor);
+
+    // The datasets themselves cache their bounds too, and other types may
+    // share arrays (e.g. rectilinear coordinates): gather them serially.
+    vtkBoundingBox box;
+    for (size_t i = 0; i < leaves.size(); ++i)
+    {
+      if (leaves[i]->GetNumberOfPoints() > 0)
+      {
+        double leafBounds[6];
+        leaves[i]->GetBounds(leafBounds);
+        box.AddBounds(leafBounds);
+      }
+    }
+
+    if (box.IsValid())
+    {
+      box.GetBounds(cache->Bounds);
+    }
+    else
+    {
+      vtkMath::UninitializeBounds(cache->Bounds);
+    }
+    cache->ComputeTime.Modified();
+  }
+  std::copy(cache->Bounds, cache->Bounds + 6, bounds);
+}
+
 //----------------------------------------------------------------------------
 void vtkCompositeDataSet::PrintSelf(ostream& os, vtkIndent indent)
 {
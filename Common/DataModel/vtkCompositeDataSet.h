@@ -37,6 +37,7 @@
 #include "vtkDataObject.h"
 
 class vtkCompositeDataIterator;
+class vtkCompositeDataSetBoundsCache;
 class vtkCompositeDataSetInternals;
 class vtkInformation;
 class vtkInformationStringKey;
@@ -117,6 +118,15 @@ public:
    */
   virtual vtkIdType GetNumberOfPoints();
 
+  /**
+   * Return the bounds of all the datasets in the tree. Empty datasets are
+   * ignored; if there is no point at all the bounds are uninitialized (see
+   * vtkMath::UninitializeBounds). The bounds of the points of the leaves
+   * are computed in parallel, once per vtkPoints, and the result is kept
+   * until a leaf is modified or the set of leaves changes.
+   */
+  virtual void GetBounds(double bounds[6]);
+
   /**
    * Key used to put node name in the meta-data associated with a node.
    */
@@ -135,6 +145,7 @@ public:
   vtkCompositeDataSet();
   ~vtkCompositeDataSet() override;
  private:
+  vtkCompositeDataSetBoundsCache* BoundsCache;
 
   vtkCompositeDataSet(const vtkCompositeDataSet&) = delete;
   void operator=(const vtkCompositeDataSet&) = delete;
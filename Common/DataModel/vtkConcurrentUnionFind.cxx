@@ -0,0 +1,244 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConcurrentUnionFind.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkConcurrentUnionFind.h"
+
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+//----------------------------------------------------------------------------
+// Helper classes to support efficient computing, and threaded execution.
+namespace {
+
+// The roots are numbered by chunks of ids
+const vtkIdType CHUNK_SIZE = 1 << 16;
+
+typedef std::atomic<vtkIdType> ParentType;
+
+//----------------------------------------------------------------------------
+struct InitializeParents
+{
+  ParentType *Parent;
+
+  InitializeParents(ParentType *parent) : Parent(parent) {}
+
+  void operator() (vtkIdType id, vtkIdType endId)
+  {
+    for ( ; id < endId; ++id)
+    {
+      this->Parent[id].store(id, std::memory_order_relaxed);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Label the ids with their root, or -1 when they are rejected by the mask
+struct FindRoots
+{
+  vtkConcurrentUnionFind *Sets;
+  const unsigned char *Mask;
+  vtkIdType *Labels;
+
+  FindRoots(vtkConcurrentUnionFind *sets, const unsigned char *mask,
+            vtkIdType *labels) :
+    Sets(sets), Mask(mask), Labels(labels) {}
+
+  void operator() (vtkIdType id, vtkIdType endId)
+  {
+    for ( ; id < endId; ++id)
+    {
+      this->Labels[id] = ( this->Mask && !this->Mask[id] ? -1 :
+                           this->Sets->Find(id) );
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Count the roots of each chunk of ids, then number them from the offset
+// of the chunk. The set numbers are stored in the parents of the roots.
+struct NumberRoots
+{
+  ParentType *Parent;
+  const vtkIdType *Labels;
+  vtkIdType NumIds;
+  vtkIdType *ChunkRoots;
+  bool Count;
+
+  NumberRoots(ParentType *parent, const vtkIdType *labels, vtkIdType numIds,
+              vtkIdType *chunkRoots, bool count) :
+    Parent(parent), Labels(labels), NumIds(numIds), ChunkRoots(chunkRoots),
+    Count(count) {}
+
+  void operator() (vtkIdType chunk, vtkIdType endChunk)
+  {
+    for ( ; chunk < endChunk; ++chunk)
+    {
+      vtkIdType id = chunk * CHUNK_SIZE;
+      vtkIdType endId = std::min(id + CHUNK_SIZE, this->NumIds);
+      vtkIdType setId = ( this->Count ? 0 : this->ChunkRoots[chunk] );
+      for ( ; id < endId; ++id)
+      {
+        if ( this->Labels[id] == id )
+        {
+          if ( !this->Count )
+          {
+            this->Parent[id].store(setId, std::memory_order_relaxed);
+          }
+          setId++;
+        }
+      }
+      if ( this->Count )
+      {
+        this->ChunkRoots[chunk] = setId;
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Replace the roots by their set numbers
+struct Relabel
+{
+  ParentType *Parent;
+  vtkIdType *Labels;
+
+  Relabel(ParentType *parent, vtkIdType *labels) :
+    Parent(parent), Labels(labels) {}
+
+  void operator() (vtkIdType id, vtkIdType endId)
+  {
+    for ( ; id < endId; ++id)
+    {
+      if ( this->Labels[id] >= 0 )
+      {
+        this->Labels[id] =
+          this->Parent[this->Labels[id]].load(std::memory_order_relaxed);
+      }
+    }
+  }
+};
+
+} //anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkConcurrentUnionFind::vtkConcurrentUnionFind()
+{
+  this->Parent = nullptr;
+  this->NumberOfIds = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkConcurrentUnionFind::~vtkConcurrentUnionFind()
+{
+  delete [] this->Parent;
+}
+
+//----------------------------------------------------------------------------
+void vtkConcurrentUnionFind::Initialize(vtkIdType numIds)
+{
+  if ( numIds != this->NumberOfIds )
+  {
+    delete [] this->Parent;
+    this->Parent = ( numIds > 0 ? new ParentType[numIds] : nullptr );
+    this->NumberOfIds = numIds;
+  }
+  InitializeParents initialize(this->Parent);
+  vtkSMPTools::For(0, numIds, initialize);
+}
+
+//----------------------------------------------------------------------------
+// Follow the parents up to the root, then point the ids of the path to the
+// root. Concurrent unions may link the root meanwhile: the parents met
+// during the compression may then be smaller than the root, and are kept.
+vtkIdType vtkConcurrentUnionFind::Find(vtkIdType id)
+{
+  vtkIdType root = id, p;
+  while ( (p=this->Parent[root].load()) != root )
+  {
+    root = p;
+  }
+  while ( id > root )
+  {
+    p = this->Parent[id].load();
+    if ( p > root )
+    {
+      this->Parent[id].compare_exchange_strong(p, root);
+    }
+    id = p;
+  }
+  return root;
+}
+
+//----------------------------------------------------------------------------
+// The larger root is linked to the smaller one, provided it is still a
+// root; otherwise another thread linked it first and the roots are
+// searched again.
+bool vtkConcurrentUnionFind::Union(vtkIdType id, vtkIdType id2)
+{
+  for (;;)
+  {
+    vtkIdType root = this->Find(id);
+    vtkIdType root2 = this->Find(id2);
+    if ( root == root2 )
+    {
+      return false;
+    }
+    if ( root > root2 )
+    {
+      std::swap(root, root2);
+    }
+    vtkIdType expected = root2;
+    if ( this->Parent[root2].compare_exchange_strong(expected, root) )
+    {
+      return true;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkConcurrentUnionFind::
+Label(vtkIdType *labels, const unsigned char *mask)
+{
+  vtkIdType numIds = this->NumberOfIds;
+  if ( numIds < 1 )
+  {
+    return 0;
+  }
+
+  // The roots are the smallest ids of their sets. Numbering them in order
+  // gives the set numbers of a serial traversal of the ids.
+  FindRoots findRoots(this, mask, labels);
+  vtkSMPTools::For(0, numIds, findRoots);
+
+  vtkIdType numChunks = (numIds - 1) / CHUNK_SIZE + 1;
+  std::vector<vtkIdType> chunkRoots(numChunks);
+  NumberRoots countRoots(this->Parent, labels, numIds, &chunkRoots[0], true);
+  vtkSMPTools::For(0, numChunks, countRoots);
+  vtkIdType numSets = 0;
+  for (vtkIdType chunk=0; chunk < numChunks; ++chunk)
+  {
+    vtkIdType count = chunkRoots[chunk];
+    chunkRoots[chunk] = numSets;
+    numSets += count;
+  }
+  NumberRoots numberRoots(this->Parent, labels, numIds, &chunkRoots[0], false);
+  vtkSMPTools::For(0, numChunks, numberRoots);
+
+  Relabel relabel(this->Parent, labels);
+  vtkSMPTools::For(0, numIds, relabel);
+
+  return numSets;
+}
@@ -0,0 +1,96 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConcurrentUnionFind.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConcurrentUnionFind
+ * @brief   disjoint sets of ids merged concurrently
+ *
+ * vtkConcurrentUnionFind partitions the ids 0 to n-1 in disjoint sets.
+ * Initially each id is a set of its own. Union() merges the sets of two
+ * ids, and Find() returns the root of the set of an id; both may be called
+ * concurrently, for instance from a vtkSMPTools functor. Label() finally
+ * numbers the sets.
+ *
+ * The root of a set is its smallest id: the parent of an id is always
+ * smaller than the id, except for the roots which are their own parent.
+ * A root is linked to the other root with a compare-and-swap, so that two
+ * threads cannot both link the same root, and the union is retried when
+ * the root changed meanwhile. Find() compresses the paths with
+ * compare-and-swap as well, only ever replacing a parent by one of its
+ * ancestors. The parent links thus always decrease, and no cycle can be
+ * formed.
+ *
+ * It is not derived from vtkObject so it can be allocated on the stack.
+ *
+ * @sa
+ * vtkSMPTools
+*/
+
+#ifndef vtkConcurrentUnionFind_h
+#define vtkConcurrentUnionFind_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkSystemIncludes.h"
+
+#include <atomic> // For std::atomic
+
+class VTKCOMMONDATAMODEL_EXPORT vtkConcurrentUnionFind
+{
+public:
+  vtkConcurrentUnionFind();
+  ~vtkConcurrentUnionFind();
+
+  /**
+   * Make each of the ids 0 to numIds-1 a set of its own.
+   */
+  void Initialize(vtkIdType numIds);
+
+  /**
+   * Return the number of ids.
+   */
+  vtkIdType GetNumberOfIds() const
+    { return this->NumberOfIds; }
+
+  /**
+   * Return the root of the set of an id, the smallest id of the set. This
+   * method is thread safe.
+   */
+  vtkIdType Find(vtkIdType id);
+
+  /**
+   * Merge the sets of two ids. Return true if they were in different sets.
+   * This method is thread safe.
+   */
+  bool Union(vtkIdType id, vtkIdType id2);
+
+  /**
+   * Number the sets in the order of their smallest id, and store the set
+   * number of each id in labels. The ids rejected by the optional mask (a
+   * zero value) are given the label -1 and do not count as sets; they
+   * should not have been merged with other ids. The number of sets is
+   * returned. The sets are lost: Initialize() must be called again before
+   * other unions. This method must not run concurrently with the others.
+   */
+  vtkIdType Label(vtkIdType *labels, const unsigned char *mask = nullptr);
+
+private:
+  std::atomic<vtkIdType> *Parent;
+  vtkIdType NumberOfIds;
+
+  vtkConcurrentUnionFind(const vtkConcurrentUnionFind&) = delete;
+  void operator=(const vtkConcurrentUnionFind&) = delete;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkConcurrentUnionFind.h
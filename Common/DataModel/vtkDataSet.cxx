@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkDataSet.h"
 
+#include "vtkAtomic.h"
 #include "vtkCallbackCommand.h"
 #include "vtkCell.h"
 #include "vtkCellData.h"
@@ -25,11 +26,26 @@
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkPointData.h"
+#include "vtkSimpleCriticalSection.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredData.h"
 
 #include <cmath>
 
+// Lock for lazily built structures and access counters for the concurrency
+// checks.
+class vtkDataSetConcurrency
+{
+public:
+  vtkDataSetConcurrency() : Readers(0), Writers(0), Violations(0) {}
+
+  vtkSimpleCriticalSection BuildLock;
+  vtkAtomic<int> Readers;
+  vtkAtomic<int> Writers;
+  vtkAtomic<vtkIdType> Violations;
+};
+
+int vtkDataSet::GlobalConcurrencyChecks = 0;
 
 //----------------------------------------------------------------------------
 // Constructor with default bounds (0,1, 0,1, 0,1).
@@ -55,6 +71,8 @@ vtkDataSet::vtkDataSet ()
 
   this->ScalarRange[0] = 0.0;
   this->ScalarRange[1] = 1.0;
+
+  this->Concurrency = new vtkDataSetConcurrency;
 }
 
 //----------------------------------------------------------------------------
@@ -67,6 +85,84 @@ vtkDataSet::~vtkDataSet ()
   this->CellData->Delete();
 
   this->DataObserver->Delete();
+
+  delete this->Concurrency;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataSet::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                               const vtkIdType*& pts, vtkIdList *ptIds) const
+{
+  // The topological inquiries of the subclasses are not const
+  const_cast<vtkDataSet*>(this)->GetCellPoints(cellId, ptIds);
+  npts = ptIds->GetNumberOfIds();
+  pts = ptIds->GetPointer(0);
+}
+
+//----------------------------------------------------------------------------
+void vtkDataSet::SetGlobalConcurrencyChecks(int val)
+{
+  vtkDataSet::GlobalConcurrencyChecks = val;
+}
+
+//----------------------------------------------------------------------------
+int vtkDataSet::GetGlobalConcurrencyChecks()
+{
+  return vtkDataSet::GlobalConcurrencyChecks;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkDataSet::GetNumberOfConcurrencyViolations()
+{
+  return this->Concurrency->Violations.load();
+}
+
+//----------------------------------------------------------------------------
+void vtkDataSet::LockBuild()
+{
+  this->Concurrency->BuildLock.Lock();
+}
+
+//----------------------------------------------------------------------------
+void vtkDataSet::UnlockBuild()
+{
+  this->Concurrency->BuildLock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkDataSet::BeginAccess(bool write)
+{
+  vtkDataSetConcurrency* c = this->Concurrency;
+  bool conflict;
+  if (write)
+  {
+    int writers = ++c->Writers;
+    conflict = writers > 1 || c->Readers.load() > 0;
+  }
+  else
+  {
+    ++c->Readers;
+    conflict = c->Writers.load() > 0;
+  }
+  if (conflict)
+  {
+    ++c->Violations;
+    vtkErrorMacro("Concurrent access to a dataset with a method that is not "
+                  "thread safe.");
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkDataSet::EndAccess(bool write)
+{
+  if (write)
+  {
+    --this->Concurrency->Writers;
+  }
+  else
+  {
+    --this->Concurrency->Readers;
+  }
 }
 
 //----------------------------------------------------------------------------
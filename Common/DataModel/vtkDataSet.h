@@ -47,6 +47,7 @@ class vtkCell;
 class vtkCellData;
 class vtkCellIterator;
 class vtkCellTypes;
+class vtkDataSetConcurrency;
 class vtkGenericCell;
 class vtkIdList;
 class vtkPointData;
@@ -163,6 +164,20 @@ public:
    */
   virtual void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds) = 0;
 
+  /**
+   * Topological inquiry to get points defining cell without using any
+   * scratch space of the dataset. On return pts points to the npts ids of
+   * the points of the cell, either in the connectivity of the dataset or in
+   * ptIds. ptIds is owned by the caller and must not be shared between
+   * threads; pts remains valid until the dataset or ptIds is modified.
+   * The dataset is logically unchanged, although its cells may be built
+   * on the first call.
+   * THIS METHOD IS THREAD SAFE IF FIRST CALLED FROM A SINGLE THREAD AND
+   * THE DATASET IS NOT MODIFIED, OR AFTER PrepareForConcurrentReads()
+   */
+  virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                             const vtkIdType*& pts, vtkIdList *ptIds) const;
+
   /**
    * Topological inquiry to get cells using point.
    * THIS METHOD IS THREAD SAFE IF FIRST CALLED FROM A SINGLE THREAD AND
@@ -197,6 +212,43 @@ public:
   virtual vtkIdType FindPoint(double x[3]) = 0;
   //@}
 
+  /**
+   * Build the structures that GetCell(cellId, vtkGenericCell*),
+   * GetCellType(), GetCellBounds() and GetCellPoints() would otherwise
+   * build on first use, so that these methods can then be called from
+   * several threads. When pointCells is true, also build the links used by
+   * GetPointCells() and GetCellNeighbors(), which take much more memory:
+   * only request them if these methods are called. Each structure is
+   * built at most once, even when this method or one of the methods above
+   * is first called by several threads at the same time: one thread builds
+   * while the others wait. The dataset must not be modified while it is
+   * read concurrently.
+   */
+  virtual void PrepareForConcurrentReads(bool vtkNotUsed(pointCells) = false) {}
+
+  //@{
+  /**
+   * Debugging aid to find threaded code that uses a dataset unsafely. When
+   * on, vtkPolyData and vtkUnstructuredGrid count, and report as errors,
+   * calls to methods that are not thread safe (for example GetCell(cellId)
+   * or rebuilding the links) made while another thread is using the same
+   * dataset. Off by default since it adds two atomic operations to every
+   * checked call.
+   */
+  static void SetGlobalConcurrencyChecks(int val);
+  static int GetGlobalConcurrencyChecks();
+  static void GlobalConcurrencyChecksOn()
+    { vtkDataSet::SetGlobalConcurrencyChecks(1); }
+  static void GlobalConcurrencyChecksOff()
+    { vtkDataSet::SetGlobalConcurrencyChecks(0); }
+  //@}
+
+  /**
+   * Number of unsafe concurrent accesses detected on this dataset while
+   * global concurrency checks were on.
+   */
+  vtkIdType GetNumberOfConcurrencyViolations();
+
   /**
    * Locate cell based on global coordinate x and tolerance
    * squared. If cell and cellId is non-nullptr, then search starts from
@@ -487,6 +539,48 @@ protected:
    */
   bool IsAnyBitSet(vtkUnsignedCharArray *a, int bitFlag);
 
+  //@{
+  /**
+   * Serialize the lazy construction of internal structures, see
+   * PrepareForConcurrentReads(). Subclasses test whether the structure
+   * exists, then lock, test again and build it before unlocking. The
+   * structure must be assigned only once it is complete.
+   */
+  void LockBuild();
+  void UnlockBuild();
+  //@}
+
+  /**
+   * Scope of an access checked by the global concurrency checks. Readers
+   * may overlap with each other, writers (calls that are not thread safe)
+   * may not overlap with anything.
+   */
+  class vtkConcurrencyCheck
+  {
+  public:
+    vtkConcurrencyCheck(vtkDataSet* ds, bool write)
+      : DataSet(vtkDataSet::GlobalConcurrencyChecks ? ds : nullptr), Write(write)
+    {
+      if (this->DataSet)
+      {
+        this->DataSet->BeginAccess(this->Write);
+      }
+    }
+    ~vtkConcurrencyCheck()
+    {
+      if (this->DataSet)
+      {
+        this->DataSet->EndAccess(this->Write);
+      }
+    }
+  private:
+    vtkDataSet* DataSet;
+    bool Write;
+  };
+  void BeginAccess(bool write);
+  void EndAccess(bool write);
+  static int GlobalConcurrencyChecks;
+
   vtkCellData *CellData;   // Scalars, vectors, etc. associated w/ each cell
   vtkPointData *PointData;   // Scalars, vectors, etc. associated w/ each point
   vtkCallbackCommand *DataObserver; // Observes changes to cell/point data
@@ -513,6 +607,8 @@ protected:
 
 
 private:
+  vtkDataSetConcurrency* Concurrency;
+
   void InternalDataSetCopy(vtkDataSet *src);
   /**
    * Called when point/cell data is modified
@@ -83,6 +83,7 @@ public:
                                   double tol2, int& subId, double pcoords[3],
                                   double *weights) override;
   int GetCellType(vtkIdType cellId) override;
+  using vtkDataSet::GetCellPoints;
   void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds) override
     {vtkStructuredData::GetCellPoints(cellId,ptIds,this->DataDescription,
                                       this->GetDimensions());}
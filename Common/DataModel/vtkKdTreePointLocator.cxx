@@ -14,12 +14,42 @@
 =========================================================================*/
 #include "vtkKdTreePointLocator.h"
 
+#include "vtkIdList.h"
 #include "vtkKdTree.h"
 #include "vtkObjectFactory.h"
+#include "vtkPoints.h"
 #include "vtkPointSet.h"
+#include "vtkSMPTools.h"
+
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkKdTreePointLocator);
 
+namespace
+{
+// Compute the region of each query, the queries outside of the tree are
+// given region -1.
+struct FindQueryRegions
+{
+  vtkKdTree *KdTree;
+  vtkPoints *Points;
+  std::pair<int, vtkIdType> *Regions;
+
+  void operator() (vtkIdType qId, vtkIdType end)
+  {
+    double x[3];
+    for ( ; qId < end; ++qId)
+    {
+      this->Points->GetPoint(qId, x);
+      this->Regions[qId].first =
+        this->KdTree->GetRegionContainingPoint(x[0], x[1], x[2]);
+      this->Regions[qId].second = qId;
+    }
+  }
+};
+}
+
 vtkKdTreePointLocator::vtkKdTreePointLocator()
 {
   this->KdTree = nullptr;
@@ -62,6 +92,33 @@ void vtkKdTreePointLocator::FindPointsWithinRadius(double R, const double x[3],
   this->KdTree->FindPointsWithinRadius(R, x, result);
 }
 
+void vtkKdTreePointLocator::GetQueryOrder(vtkPoints *queries, vtkIdList *order)
+{
+  vtkPointSet* pointSet = vtkPointSet::SafeDownCast(this->GetDataSet());
+  vtkPoints *points = ( queries ? queries :
+                        (pointSet ? pointSet->GetPoints() : nullptr) );
+  if ( !this->KdTree || !points )
+  {
+    this->Superclass::GetQueryOrder(queries, order);
+    return;
+  }
+
+  vtkIdType numQueries = points->GetNumberOfPoints();
+  std::vector<std::pair<int, vtkIdType> > regions(numQueries);
+  FindQueryRegions find;
+  find.KdTree = this->KdTree;
+  find.Points = points;
+  find.Regions = regions.data();
+  vtkSMPTools::For(0, numQueries, find);
+  vtkSMPTools::Sort(regions.begin(), regions.end());
+
+  order->SetNumberOfIds(numQueries);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    order->SetId(i, regions[i].second);
+  }
+}
+
 void vtkKdTreePointLocator::FreeSearchStructure()
 {
   if(this->KdTree)
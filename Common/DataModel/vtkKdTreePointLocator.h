@@ -19,6 +19,9 @@
  * vtkKdTreePointLocator is a wrapper class that derives from
  * vtkAbstractPointLocator and calls the search functions in vtkKdTree.
  *
+ * The batched queries FindAllClosestNPoints() and
+ * FindAllPointsWithinRadius() process the queries region by region.
+ *
  * @sa
  * vtkKdTree
 */
@@ -39,6 +42,11 @@ public:
   static vtkKdTreePointLocator* New();
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  // Re-use any superclass signatures that we don't override.
+  using vtkAbstractPointLocator::FindClosestPoint;
+  using vtkAbstractPointLocator::FindClosestNPoints;
+  using vtkAbstractPointLocator::FindPointsWithinRadius;
+
   /**
    * Given a position x, return the id of the point closest to it. Alternative
    * method requires separate x-y-z values.
@@ -89,6 +97,11 @@ protected:
   vtkKdTreePointLocator();
   ~vtkKdTreePointLocator() override;
 
+  /**
+   * Order the batched queries by region of the k-d tree.
+   */
+  void GetQueryOrder(vtkPoints *queries, vtkIdList *order) override;
+
   vtkKdTree* KdTree;
 
 private:
@@ -160,7 +160,7 @@ public:
   void PrintParentChildInfo(unsigned int level, unsigned int index);
 
   //Unhide superclass method
-  void GetBounds(double b[6]) { Superclass::GetBounds(b);}
+  void GetBounds(double b[6]) override { Superclass::GetBounds(b);}
 
   /**
    * Given a point q, find the highest level grid that contains it.
@@ -93,6 +93,7 @@ public:
   /**
    * vtkPath doesn't use cells, this method just clears ptIds.
    */
+  using vtkDataSet::GetCellPoints;
   void GetCellPoints(vtkIdType, vtkIdList *ptIds) override;
 
   /**
@@ -60,7 +60,8 @@ vtkPolyData::vtkPolyData () :
   Vertex(nullptr), PolyVertex(nullptr), Line(nullptr), PolyLine(nullptr),
   Triangle(nullptr), Quad(nullptr), Polygon(nullptr), TriangleStrip(nullptr),
   EmptyCell(nullptr), Verts(nullptr), Lines(nullptr), Polys(nullptr),
-  Strips(nullptr), Cells(nullptr), Links(nullptr)
+  Strips(nullptr), Cells(nullptr), Links(nullptr), PublishedCells(nullptr),
+  PublishedLinks(nullptr)
 {
   this->Information->Set(vtkDataObject::DATA_EXTENT_TYPE(), VTK_PIECES_EXTENT);
   this->Information->Set(vtkDataObject::DATA_PIECE_NUMBER(), -1);
@@ -200,22 +201,22 @@ void vtkPolyData::CopyStructure(vtkDataSet *ds)
   {
     this->Cells->UnRegister(this);
     this->Cells = nullptr;
+    this->PublishedCells = nullptr;
   }
 
   if ( this->Links )
   {
     this->Links->UnRegister(this);
     this->Links = nullptr;
+    this->PublishedLinks = nullptr;
   }
 }
 
 //----------------------------------------------------------------------------
 int vtkPolyData::GetCellType(vtkIdType cellId)
 {
-  if ( !this->Cells )
-  {
-    this->BuildCells();
-  }
+  vtkConcurrencyCheck check(this, false);
+  this->BuildCellsIfNeeded();
   return this->Cells->GetCellType(cellId);
 }
 
@@ -227,10 +228,8 @@ vtkCell *vtkPolyData::GetCell(vtkIdType cellId)
   vtkCell *cell = nullptr;
   unsigned char type;
 
-  if ( !this->Cells )
-  {
-    this->BuildCells();
-  }
+  vtkConcurrencyCheck check(this, true);
+  this->BuildCellsIfNeeded();
 
   type = this->Cells->GetCellType(cellId);
   loc = this->Cells->GetCellLocation(cellId);
@@ -344,10 +343,8 @@ void vtkPolyData::GetCell(vtkIdType cellId, vtkGenericCell *cell)
   unsigned char   type;
   double           x[3];
 
-  if ( !this->Cells )
-  {
-    this->BuildCells();
-  }
+  vtkConcurrencyCheck check(this, false);
+  this->BuildCellsIfNeeded();
 
   type = this->Cells->GetCellType(cellId);
   loc = this->Cells->GetCellLocation(cellId);
@@ -499,10 +496,8 @@ void vtkPolyData::GetCellBounds(vtkIdType cellId, double bounds[6])
   unsigned char type;
   double x[3];
 
-  if ( !this->Cells )
-  {
-    this->BuildCells();
-  }
+  vtkConcurrencyCheck check(this, false);
+  this->BuildCellsIfNeeded();
 
   type = this->Cells->GetCellType(cellId);
   loc = this->Cells->GetCellLocation(cellId);
@@ -803,12 +798,14 @@ void vtkPolyData::Cleanup()
   {
     this->Cells->UnRegister(this);
     this->Cells = nullptr;
+    this->PublishedCells = nullptr;
   }
 
   if ( this->Links )
   {
     this->Links->UnRegister(this);
     this->Links = nullptr;
+    this->PublishedLinks = nullptr;
   }
 }
 
@@ -904,17 +901,20 @@ vtkIdType vtkPolyData::GetNumberOfStrips()
 //----------------------------------------------------------------------------
 void vtkPolyData::DeleteCells()
 {
+  vtkConcurrencyCheck check(this, true);
   // if we have Links, we need to delete them (they are no longer valid)
   if (this->Links)
   {
     this->Links->UnRegister( this );
     this->Links = nullptr;
+    this->PublishedLinks = nullptr;
   }
 
   if (this->Cells)
   {
     this->Cells->UnRegister( this );
     this->Cells = nullptr;
+    this->PublishedCells = nullptr;
   }
 }
 
@@ -1046,22 +1046,43 @@ void vtkPolyData::BuildCells()
     }
   }
 
-  // set up the cell types data structure
-  this->Cells = vtkCellTypes::New();
-  this->Cells->SetCellTypes(nCells, types, locs);
-  this->Cells->Register(this);
-  this->Cells->Delete();
+  // set up the cell types data structure, and publish it once complete
+  vtkCellTypes *cells = vtkCellTypes::New();
+  cells->SetCellTypes(nCells, types, locs);
+  cells->Register(this);
+  cells->Delete();
   types->Delete();
   locs->Delete();
+  this->Cells = cells;
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyData::BuildCellsIfNeeded()
+{
+  // Cells is only read without the lock once the thread that built it has
+  // published it: the acquire load makes the complete structure visible.
+  vtkCellTypes *published = this->PublishedCells.load(std::memory_order_acquire);
+  if (!published || published != this->Cells)
+  {
+    this->LockBuild();
+    if (!this->Cells)
+    {
+      this->BuildCells();
+    }
+    this->PublishedCells.store(this->Cells, std::memory_order_release);
+    this->UnlockBuild();
+  }
 }
 
 //----------------------------------------------------------------------------
 void vtkPolyData::DeleteLinks()
 {
+  vtkConcurrencyCheck check(this, true);
   if (this->Links)
   {
     this->Links->UnRegister( this );
     this->Links = nullptr;
+    this->PublishedLinks = nullptr;
   }
 }
 
@@ -1080,19 +1101,49 @@ void vtkPolyData::BuildLinks(int initialSize)
     this->BuildCells();
   }
 
-  this->Links = vtkCellLinks::New();
+  vtkCellLinks *links = vtkCellLinks::New();
   if ( initialSize > 0 )
   {
-    this->Links->Allocate(initialSize);
+    links->Allocate(initialSize);
   }
   else
   {
-    this->Links->Allocate(this->GetNumberOfPoints());
+    links->Allocate(this->GetNumberOfPoints());
   }
-  this->Links->Register(this);
-  this->Links->Delete();
+  links->Register(this);
+  links->Delete();
 
-  this->Links->BuildLinks(this);
+  links->BuildLinks(this);
+  this->Links = links;
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyData::BuildLinksIfNeeded()
+{
+  // See BuildCellsIfNeeded(). BuildLinks() also builds Cells if needed, and
+  // publishes them before the links.
+  vtkCellLinks *published = this->PublishedLinks.load(std::memory_order_acquire);
+  if (!published || published != this->Links)
+  {
+    this->LockBuild();
+    if (!this->Links)
+    {
+      this->BuildLinks();
+    }
+    this->PublishedCells.store(this->Cells, std::memory_order_release);
+    this->PublishedLinks.store(this->Links, std::memory_order_release);
+    this->UnlockBuild();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyData::PrepareForConcurrentReads(bool pointCells)
+{
+  this->BuildCellsIfNeeded();
+  if (pointCells)
+  {
+    this->BuildLinksIfNeeded();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -1103,10 +1154,8 @@ void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
   vtkIdType *pts, npts;
 
   ptIds->Reset();
-  if ( this->Cells == nullptr )
-  {
-    this->BuildCells();
-  }
+  vtkConcurrencyCheck check(this, false);
+  this->BuildCellsIfNeeded();
 
   this->vtkPolyData::GetCellPoints(cellId, npts, pts);
   ptIds->InsertId (npts-1,pts[npts-1]);
@@ -1116,6 +1165,21 @@ void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                                const vtkIdType*& pts,
+                                vtkIdList *vtkNotUsed(ptIds)) const
+{
+  // Building the cells does not change the polydata as seen by the caller
+  vtkPolyData *self = const_cast<vtkPolyData*>(this);
+  vtkConcurrencyCheck check(self, false);
+  self->BuildCellsIfNeeded();
+
+  vtkIdType *cellPts;
+  self->vtkPolyData::GetCellPoints(cellId, npts, cellPts);
+  pts = cellPts;
+}
+
 //----------------------------------------------------------------------------
 void vtkPolyData::GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
 {
@@ -1123,10 +1187,8 @@ void vtkPolyData::GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
   vtkIdType numCells;
   vtkIdType i;
 
-  if ( ! this->Links )
-  {
-    this->BuildLinks();
-  }
+  vtkConcurrencyCheck check(this, false);
+  this->BuildLinksIfNeeded();
   cellIds->Reset();
 
   numCells = this->Links->GetNcells(ptId);
@@ -1637,10 +1699,8 @@ void vtkPolyData::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
   vtkIdType i, j, numPts, cellNum;
   int allFound, oneFound;
 
-  if ( ! this->Links )
-  {
-    this->BuildLinks();
-  }
+  vtkConcurrencyCheck check(this, false);
+  this->BuildLinksIfNeeded();
 
   cellIds->Reset();
 
@@ -1810,6 +1870,7 @@ void vtkPolyData::ShallowCopy(vtkDataObject *dataObject)
       this->Cells->UnRegister(this);
     }
     this->Cells = polyData->Cells;
+    this->PublishedCells = nullptr;
     if (this->Cells)
     {
       this->Cells->Register(this);
@@ -1820,6 +1881,7 @@ void vtkPolyData::ShallowCopy(vtkDataObject *dataObject)
       this->Links->Delete();
     }
     this->Links = polyData->Links;
+    this->PublishedLinks = nullptr;
     if (this->Links)
     {
       this->Links->Register(this);
@@ -1867,6 +1929,7 @@ void vtkPolyData::DeepCopy(vtkDataObject *dataObject)
     {
       this->Cells->UnRegister(this);
       this->Cells = nullptr;
+      this->PublishedCells = nullptr;
     }
     if (polyData->Cells)
     {
@@ -1877,6 +1940,7 @@ void vtkPolyData::DeepCopy(vtkDataObject *dataObject)
     {
       this->Links->UnRegister(this);
       this->Links = nullptr;
+      this->PublishedLinks = nullptr;
     }
     if (polyData->Links)
     {
@@ -53,6 +53,15 @@
  * (vtkDecimatePro expects triangles or triangle strips; vtkTubeFilter
  * expects lines). Read the documentation for each filter carefully to
  * understand how each part of vtkPolyData is processed.
+ *
+ * @warning
+ * GetCell(cellId) returns a cell owned by the dataset and must not be used
+ * from several threads. Threaded code should use GetCell(cellId,
+ * vtkGenericCell*), GetCellPoints(cellId, npts, pts, ptIds) and
+ * GetPointCells(). The cells and links they need are built once, either by
+ * PrepareForConcurrentReads() (the links only on request) or by the first
+ * call. Turn on
+ * vtkDataSet::GlobalConcurrencyChecksOn() to detect unsafe uses.
 */
 
 #ifndef vtkPolyData_h
@@ -65,6 +74,8 @@
 #include "vtkCellLinks.h" // Needed for inline methods
 #include "vtkCellArray.h" // Needed for inline methods
 
+#include <atomic> // For std::atomic
+
 class vtkVertex;
 class vtkPolyVertex;
 class vtkLine;
@@ -123,11 +134,25 @@ public:
   void GetCellPoints(vtkIdType cellId, vtkIdList *ptIds) override;
 
   /**
-   * Efficient method to obtain cells using a particular point. Make sure that
-   * routine BuildLinks() has been called.
+   * Thread-safe access to the point ids of a cell. pts points into the cell
+   * arrays, ptIds is not used. See vtkDataSet::GetCellPoints().
+   */
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                     const vtkIdType*& pts, vtkIdList *ptIds) const override;
+
+  /**
+   * Efficient method to obtain cells using a particular point. The links
+   * are built on first use.
    */
   void GetPointCells(vtkIdType ptId, vtkIdList *cellIds) override;
 
+  /**
+   * Build the cells, and the links if pointCells is true, at most once, so
+   * that the dataset can be read from several threads. See
+   * vtkDataSet::PrepareForConcurrentReads().
+   */
+  void PrepareForConcurrentReads(bool pointCells = false) override;
+
   /**
    * Compute the (X, Y, Z)  bounds of the data.
    */
@@ -560,6 +585,20 @@ protected:
   vtkCellTypes *Cells;
   vtkCellLinks *Links;
 
+  // Cells and Links as published by BuildCellsIfNeeded() and
+  // BuildLinksIfNeeded() once complete. Reset with Cells and Links.
+  std::atomic<vtkCellTypes*> PublishedCells;
+  std::atomic<vtkCellLinks*> PublishedLinks;
+
+  //@{
+  /**
+   * Build Cells or Links unless they exist. Unlike BuildCells() and
+   * BuildLinks(), these may be called concurrently.
+   */
+  void BuildCellsIfNeeded();
+  void BuildLinksIfNeeded();
+  //@}
+
 private:
   // Hide these from the user and the compiler.
 
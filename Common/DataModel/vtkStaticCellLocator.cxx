@@ -30,6 +30,8 @@
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkStaticCellLocator);
 
 //----------------------------------------------------------------------------
@@ -264,10 +266,14 @@ struct vtkCellProcessor
   virtual vtkIdType FindCell(double pos[3], vtkGenericCell *cell,
                              double pcoords[3], double* weights ) = 0;
   virtual void FindCellsWithinBounds(double *bbox, vtkIdList *cells) = 0;
+  virtual void FindCellsAlongLine(double a0[3], double a1[3], double tol,
+                                  vtkIdList *cells) = 0;
+  // When markVisited is false, the visited cells are not recorded and the
+  // method can be called concurrently.
   virtual int IntersectWithLine(double a0[3], double a1[3], double tol,
                                 double& t, double x[3], double pcoords[3],
                                 int &subId, vtkIdType &cellId,
-                                vtkGenericCell *cell) = 0;
+                                vtkGenericCell *cell, bool markVisited) = 0;
   // Convenience for computing
   virtual int IsEmpty(vtkIdType binId) = 0;
 };
@@ -339,10 +345,12 @@ struct CellProcessor : public vtkCellProcessor
   virtual vtkIdType FindCell(double pos[3], vtkGenericCell *cell,
                              double pcoords[3], double* weights );
   virtual void FindCellsWithinBounds(double *bbox, vtkIdList *cells);
+  virtual void FindCellsAlongLine(double a0[3], double a1[3], double tol,
+                                  vtkIdList *cells);
   virtual int IntersectWithLine(double a0[3], double a1[3], double tol,
                                 double& t, double x[3], double pcoords[3],
                                 int &subId, vtkIdType &cellId,
-                                vtkGenericCell *cell);
+                                vtkGenericCell *cell, bool markVisited);
   virtual int IsEmpty(vtkIdType binId)
   {
     return ( this->GetNumberOfIds(static_cast<T>(binId)) > 0 ? 0 : 1 );
@@ -565,6 +573,116 @@ FindCellsWithinBounds(double *bbox, vtkIdList *cells)
   }//k-footprint
 }
 
+//-----------------------------------------------------------------------------
+// The bins crossed by the line are walked in order, starting from the point
+// where the line enters the locator bounds. Only the cells whose bounds
+// (padded by the tolerance) are hit by the line are kept. No state is
+// modified, so the method can be called concurrently.
+template <typename T> void CellProcessor<T>::
+FindCellsAlongLine(double a0[3], double a1[3], double tol, vtkIdList *cells)
+{
+  double *bounds = this->Binner->Bounds;
+  double *h = this->Binner->H;
+  int *ndivs = this->Binner->Divisions;
+  double dir[3], t0 = 0.0, t1 = 1.0, ta, tb;
+  int i;
+
+  cells->Reset();
+
+  // Clip the line against the (padded) locator bounds
+  for (i=0; i < 3; i++)
+  {
+    dir[i] = a1[i] - a0[i];
+    if ( dir[i] != 0.0 )
+    {
+      ta = (bounds[2*i] - tol - a0[i]) / dir[i];
+      tb = (bounds[2*i+1] + tol - a0[i]) / dir[i];
+      t0 = std::max(t0, std::min(ta,tb));
+      t1 = std::min(t1, std::max(ta,tb));
+    }
+    else if ( a0[i] < (bounds[2*i]-tol) || a0[i] > (bounds[2*i+1]+tol) )
+    {
+      return;
+    }
+  }
+  if ( t0 > t1 )
+  {
+    return;
+  }
+
+  // Set up the walk: tNext is the parametric coordinate where the line
+  // leaves the current bin along each axis.
+  double x[3], tNext[3], tDelta[3], cellBounds[6], hit[3], t;
+  int ijk[3], step[3], axis;
+  for (i=0; i < 3; i++)
+  {
+    x[i] = a0[i] + t0*dir[i];
+  }
+  this->Binner->GetBinIndices(x, ijk);
+  for (i=0; i < 3; i++)
+  {
+    if ( dir[i] > 0.0 )
+    {
+      step[i] = 1;
+      tNext[i] = (bounds[2*i] + (ijk[i]+1)*h[i] - a0[i]) / dir[i];
+      tDelta[i] = h[i] / dir[i];
+    }
+    else if ( dir[i] < 0.0 )
+    {
+      step[i] = -1;
+      tNext[i] = (bounds[2*i] + ijk[i]*h[i] - a0[i]) / dir[i];
+      tDelta[i] = -h[i] / dir[i];
+    }
+    else
+    {
+      step[i] = 0;
+      tNext[i] = VTK_DOUBLE_MAX;
+      tDelta[i] = 0.0;
+    }
+  }
+
+  for (;;)
+  {
+    vtkIdType binId = ijk[0] + ijk[1]*this->xD + ijk[2]*this->xyD;
+    T numIds = this->GetNumberOfIds(binId);
+    const CellFragments<T> *ids = this->GetIds(binId);
+    for (T ii=0; ii < numIds; ii++)
+    {
+      vtkIdType cId = ids[ii].CellId;
+      const double *bds = this->CellBounds + 6*cId;
+      for (i=0; i < 3; i++)
+      {
+        cellBounds[2*i] = bds[2*i] - tol;
+        cellBounds[2*i+1] = bds[2*i+1] + tol;
+      }
+      if ( vtkBox::IntersectBox(cellBounds, a0, dir, hit, t) )
+      {
+        cells->InsertNextId(cId);
+      }
+    }
+
+    // Move to the neighboring bin across the nearest face
+    axis = ( tNext[0] < tNext[1] ? (tNext[0] < tNext[2] ? 0 : 2) :
+             (tNext[1] < tNext[2] ? 1 : 2) );
+    if ( tNext[axis] > t1 )
+    {
+      break;
+    }
+    ijk[axis] += step[axis];
+    if ( ijk[axis] < 0 || ijk[axis] >= ndivs[axis] )
+    {
+      break;
+    }
+    tNext[axis] += tDelta[axis];
+  }
+
+  // A cell spanning several of the bins is found once per bin
+  vtkIdType *cellIds = cells->GetPointer(0);
+  vtkIdType numCells = cells->GetNumberOfIds();
+  std::sort(cellIds, cellIds + numCells);
+  cells->SetNumberOfIds(std::unique(cellIds, cellIds + numCells) - cellIds);
+}
+
 //-----------------------------------------------------------------------------
 // This code is adapted from vtkCellLocator which has been tested over the
 // years.  Why mess with success? If I was to rewrite the algorithm I'd use a
@@ -573,7 +691,7 @@ FindCellsWithinBounds(double *bbox, vtkIdList *cells)
 template <typename T> int CellProcessor<T>::
 IntersectWithLine(double a0[3], double a1[3], double tol, double& t, double x[3],
                   double pcoords[3], int &subId, vtkIdType &cellId,
-                  vtkGenericCell *cell)
+                  vtkGenericCell *cell, bool markVisited)
 {
   double origin[3];
   double direction1[3];
@@ -637,19 +755,23 @@ IntersectWithLine(double a0[3], double a1[3], double tol, double& t, double x[3]
     bestCellId = -1;
 
     // Initialize intersection query array if necessary
-    if ( this->CellHasBeenVisited == nullptr )
+    if ( markVisited && this->CellHasBeenVisited == nullptr )
     {
       this->CellHasBeenVisited = new unsigned char [ this->NumCells ];
+      memset(this->CellHasBeenVisited, 0, this->NumCells);
     }
 
     // Clear the array that indicates whether we have visited this cell.
     // The array is only cleared when the query number rolls over.  This
     // saves a number of calls to memset.
-    this->QueryNumber++;
-    if (this->QueryNumber == 0)
+    if (markVisited)
     {
-      this->ClearCellHasBeenVisited();
-      this->QueryNumber++;    // can't use 0 as a marker
+      this->QueryNumber++;
+      if (this->QueryNumber == 0)
+      {
+        this->ClearCellHasBeenVisited();
+        this->QueryNumber++;    // can't use 0 as a marker
+      }
     }
 
     // set up curr and stop dist
@@ -686,9 +808,12 @@ IntersectWithLine(double a0[3], double a1[3], double tol, double& t, double x[3]
         for (tMax = VTK_DOUBLE_MAX, cellId=0; cellId < numCellsInBin; cellId++)
         {
           cId = cellIds[cellId].CellId;
-          if (this->CellHasBeenVisited[cId] != this->QueryNumber)
+          if (!markVisited || this->CellHasBeenVisited[cId] != this->QueryNumber)
           {
-            this->CellHasBeenVisited[cId] = this->QueryNumber;
+            if (markVisited)
+            {
+              this->CellHasBeenVisited[cId] = this->QueryNumber;
+            }
             int hitCellBounds = 0;
 
             // check whether we intersect the cell bounds
@@ -705,7 +830,10 @@ IntersectWithLine(double a0[3], double a1[3], double tol, double& t, double x[3]
               {
                 if ( ! this->IsInBinBounds(binBounds, x, tol) )
                 {
-                  this->CellHasBeenVisited[cId] = 0; //mark the cell non-visited
+                  if (markVisited)
+                  {
+                    this->CellHasBeenVisited[cId] = 0; //mark the cell non-visited
+                  }
                 }
                 else
                 {
@@ -872,6 +1000,19 @@ FindCellsWithinBounds(double *bbox, vtkIdList *cells)
 }
 
 
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::
+FindCellsAlongLine(double p1[3], double p2[3], double tol, vtkIdList *cells)
+{
+  this->BuildLocator();
+  if ( ! this->Processor )
+  {
+    cells->Reset();
+    return;
+  }
+  this->Processor->FindCellsAlongLine(p1, p2, tol, cells);
+}
+
 //-----------------------------------------------------------------------------
 int vtkStaticCellLocator::
 IntersectWithLine(double p1[3], double p2[3], double tol,
@@ -884,7 +1025,30 @@ IntersectWithLine(double p1[3], double p2[3], double tol,
     return 0;
   }
   return this->Processor->
-    IntersectWithLine(p1,p2,tol,t,x,pcoords,subId,cellId,cell);
+    IntersectWithLine(p1,p2,tol,t,x,pcoords,subId,cellId,cell,true);
+}
+
+//-----------------------------------------------------------------------------
+// Without the visited marks, a cell spanning several of the bins crossed by
+// the line may be tested more than once, with the same result.
+int vtkStaticCellLocator::
+IntersectWithLineConcurrently(double p1[3], double p2[3], double tol,
+                              double &t, double x[3], double pcoords[3],
+                              int &subId, vtkIdType &cellId, vtkGenericCell *cell)
+{
+  if ( ! this->Processor )
+  {
+    return 0;
+  }
+  return this->Processor->
+    IntersectWithLine(p1,p2,tol,t,x,pcoords,subId,cellId,cell,false);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkStaticCellLocator::PrepareForConcurrentQueries()
+{
+  this->BuildLocator();
+  return this->Processor != nullptr;
 }
 
 
@@ -94,6 +94,15 @@ public:
    */
   void FindCellsWithinBounds(double *bbox, vtkIdList *cells) override;
 
+  /**
+   * Given a finite line defined by the two points (p1,p2), return the list
+   * of unique cell ids whose bounds, padded by the tolerance, are crossed by
+   * the line. The ids are returned in increasing order. Once the locator is
+   * built, this method can be called concurrently from several threads.
+   */
+  void FindCellsAlongLine(double p1[3], double p2[3], double tolerance,
+                          vtkIdList *cells) override;
+
   /**
    * Return intersection point (if any) AND the cell which was intersected by
    * the finite line. The cell is returned as a cell id and as a generic cell.
@@ -187,6 +196,12 @@ protected:
   unsigned char *CellHasBeenVisited;
   unsigned char QueryNumber;
 
+  bool PrepareForConcurrentQueries() override;
+  int IntersectWithLineConcurrently(
+    double p1[3], double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int &subId, vtkIdType &cellId,
+    vtkGenericCell *cell) override;
+
 private:
   vtkStaticCellLocator(const vtkStaticCellLocator&) = delete;
   void operator=(const vtkStaticCellLocator&) = delete;
@@ -483,6 +483,7 @@ public:
   void FindClosestNPoints(int N, const double x[3], vtkIdList *result);
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList *result);
   void GenerateRepresentation(int vtkNotUsed(level), vtkPolyData *pd);
+  void GetQueryOrder(vtkPoints *queries, vtkIdList *order);
 
   // Internal methods
   void GetOverlappingBuckets(NeighborBuckets* buckets, const double x[3],
@@ -516,6 +517,33 @@ public:
       }
   };
 
+  // Bucket the queries of the batched methods
+  class MapQueries
+  {
+    public:
+      BucketList<TIds> *BList;
+      vtkPoints *Queries;
+      LocatorTuple<vtkIdType> *QueryMap;
+
+      MapQueries(BucketList<TIds> *blist, vtkPoints *queries,
+                 LocatorTuple<vtkIdType> *queryMap) :
+        BList(blist), Queries(queries), QueryMap(queryMap)
+      {
+      }
+
+      void  operator()(vtkIdType qId, vtkIdType end)
+      {
+        double x[3];
+        LocatorTuple<vtkIdType> *t = this->QueryMap + qId;
+        for ( ; qId < end; ++qId, ++t )
+        {
+          this->Queries->GetPoint(qId,x);
+          t->PtId = qId;
+          t->Bucket = this->BList->GetBucketIndex(x);
+        }
+      }
+  };
+
   // Explicit point representation (e.g., vtkPointSet), faster path
   template <typename T, typename TPts>
   class MapPointsArray
@@ -920,6 +948,19 @@ public:
 };
 }
 
+// Replace the farthest of the N sorted tuples, shifting the farther ones
+// rather than sorting again.
+inline void InsertIdTuple(IdTuple *res, int N, vtkIdType ptId, double dist2)
+{
+  int i = N - 1;
+  for ( ; i > 0 && dist2 < res[i-1].Dist2; --i)
+  {
+    res[i] = res[i-1];
+  }
+  res[i].PtId = ptId;
+  res[i].Dist2 = dist2;
+}
+
 //-----------------------------------------------------------------------------
 template <typename TIds> void BucketList<TIds>::
 FindClosestNPoints(int N, const double x[3], vtkIdList *result)
@@ -980,9 +1021,7 @@ FindClosestNPoints(int N, const double x[3], vtkIdList *result)
           }
           else if (dist2 < maxDistance)
           {
-            res[N-1].Dist2 = dist2;
-            res[N-1].PtId = ptId;
-            std::sort(res, res+N);
+            InsertIdTuple(res, N, ptId, dist2);
             maxDistance = res[N-1].Dist2;
           }
         }
@@ -1013,9 +1052,7 @@ FindClosestNPoints(int N, const double x[3], vtkIdList *result)
         dist2 = vtkMath::Distance2BetweenPoints(x,pt);
         if (dist2 < maxDistance)
         {
-          res[N-1].Dist2 = dist2;
-          res[N-1].PtId = ptId;
-          std::sort(res, res+N);
+          InsertIdTuple(res, N, ptId, dist2);
           maxDistance = res[N-1].Dist2;
         }
       }
@@ -1032,6 +1069,38 @@ FindClosestNPoints(int N, const double x[3], vtkIdList *result)
   delete [] res;
 }
 
+//-----------------------------------------------------------------------------
+// Order the queries by bucket. The points of the dataset are already sorted
+// in the map, other queries are bucketed and sorted the same way.
+template <typename TIds> void BucketList<TIds>::
+GetQueryOrder(vtkPoints *queries, vtkIdList *order)
+{
+  if ( !queries )
+  {
+    order->SetNumberOfIds(this->NumPts);
+    vtkIdType *orderPtr = order->GetPointer(0);
+    for (vtkIdType i=0; i < this->NumPts; ++i)
+    {
+      orderPtr[i] = this->Map[i].PtId;
+    }
+    return;
+  }
+
+  vtkIdType numQueries = queries->GetNumberOfPoints();
+  LocatorTuple<vtkIdType> *queryMap = new LocatorTuple<vtkIdType>[numQueries];
+  MapQueries mapper(this, queries, queryMap);
+  vtkSMPTools::For(0, numQueries, mapper);
+  vtkSMPTools::Sort(queryMap, queryMap + numQueries);
+
+  order->SetNumberOfIds(numQueries);
+  vtkIdType *orderPtr = order->GetPointer(0);
+  for (vtkIdType i=0; i < numQueries; ++i)
+  {
+    orderPtr[i] = queryMap[i].PtId;
+  }
+  delete [] queryMap;
+}
+
 //-----------------------------------------------------------------------------
 // The Radius defines a block of buckets which the sphere of radis R may
 // touch.
@@ -1547,6 +1616,27 @@ FindPointsWithinRadius(double R, const double x[3], vtkIdList *result)
   }
 }
 
+//-----------------------------------------------------------------------------
+// Process the batched queries bucket by bucket.
+void vtkStaticPointLocator::
+GetQueryOrder(vtkPoints *queries, vtkIdList *order)
+{
+  if ( !this->Buckets )
+  {
+    this->Superclass::GetQueryOrder(queries, order);
+  }
+  else if ( this->LargeIds )
+  {
+    static_cast<BucketList<vtkIdType>*>(this->Buckets)->
+      GetQueryOrder(queries,order);
+  }
+  else
+  {
+    static_cast<BucketList<int>*>(this->Buckets)->
+      GetQueryOrder(queries,order);
+  }
+}
+
 //-----------------------------------------------------------------------------
 void vtkStaticPointLocator::
 GenerateRepresentation(int level, vtkPolyData *pd)
@@ -28,6 +28,10 @@
  * (i.e., incremental point insertion is not supported). If you need to
  * incrementally insert points, use the vtkPointLocator or its kin to do so.
  *
+ * The batched queries FindAllClosestNPoints() and
+ * FindAllPointsWithinRadius() process the queries bucket by bucket, so that
+ * the concurrent threads work on compact regions of the locator.
+ *
  * @warning
  * This class is templated. It may run slower than serial execution if the code
  * is not optimized during compilation. Build in Release or ReleaseWithDebugInfo.
@@ -207,6 +211,11 @@ protected:
   vtkStaticPointLocator();
   ~vtkStaticPointLocator() override;
 
+  /**
+   * Order the batched queries by bucket.
+   */
+  void GetQueryOrder(vtkPoints *queries, vtkIdList *order) override;
+
   int NumberOfPointsPerBucket; // Used with AutomaticOn to control subdivide
   int Divisions[3]; // Number of sub-divisions in x-y-z directions
   double H[3]; // Width of each bucket in x-y-z directions
@@ -75,7 +75,7 @@ public:
 
   // Description:
   // Retrieve the bounds of the AMR domain
-  void GetBounds(double bounds[6]);
+  void GetBounds(double bounds[6]) override;
   const double* GetBounds();
   void GetMin(double min[3]);
   void GetMax(double max[3]);
@@ -124,6 +124,7 @@ vtkUnstructuredGrid::vtkUnstructuredGrid ()
 
   this->Connectivity = nullptr;
   this->Links = nullptr;
+  this->PublishedLinks = nullptr;
   this->Types = nullptr;
   this->Locations = nullptr;
 
@@ -392,6 +393,7 @@ void vtkUnstructuredGrid::CopyStructure(vtkDataSet *ds)
         this->Links->UnRegister(this);
       }
       this->Links = ug->Links;
+      this->PublishedLinks = nullptr;
       if (this->Links)
       {
         this->Links->Register(this);
@@ -467,6 +469,7 @@ void vtkUnstructuredGrid::Cleanup()
   {
     this->Links->UnRegister(this);
     this->Links = nullptr;
+    this->PublishedLinks = nullptr;
   }
 
   if ( this->Types )
@@ -512,6 +515,7 @@ void vtkUnstructuredGrid::Initialize()
 //----------------------------------------------------------------------------
 int vtkUnstructuredGrid::GetCellType(vtkIdType cellId)
 {
+  vtkConcurrencyCheck check(this, false);
 
   vtkDebugMacro(<< "Returning cell type " << static_cast<int>(this->Types->GetValue(cellId)));
   return static_cast<int>(this->Types->GetValue(cellId));
@@ -525,6 +529,7 @@ vtkCell *vtkUnstructuredGrid::GetCell(vtkIdType cellId)
   vtkCell *cell = nullptr;
   vtkIdType *pts, numPts;
 
+  vtkConcurrencyCheck check(this, true);
   loc = this->Locations->GetValue(cellId);
   vtkDebugMacro(<< "location = " <<  loc);
   this->Connectivity->GetCell(loc,numPts,pts);
@@ -889,6 +894,7 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
 {
   vtkIdType loc;
   vtkIdType *pts, numPts;
+  vtkConcurrencyCheck check(this, false);
 
   int cellType = static_cast<int>(this->Types->GetValue(cellId));
   cell->SetCellType(cellType);
@@ -925,6 +931,7 @@ void vtkUnstructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
   double x[3];
   vtkIdType *pts, numPts;
 
+  vtkConcurrencyCheck check(this, false);
   loc = this->Locations->GetValue(cellId);
   this->Connectivity->GetCell(loc,numPts,pts);
 
@@ -1387,14 +1394,47 @@ void vtkUnstructuredGrid::BuildLinks()
   // Remove the old links if they are already built
   if (this->Links)
   {
+    vtkConcurrencyCheck check(this, true);
     this->Links->UnRegister(this);
+    this->Links = nullptr;
+    this->PublishedLinks = nullptr;
   }
 
-  this->Links = vtkCellLinks::New();
-  this->Links->Allocate(this->GetNumberOfPoints());
-  this->Links->Register(this);
-  this->Links->BuildLinks(this, this->Connectivity);
-  this->Links->Delete();
+  // The links are published once complete, see BuildLinksIfNeeded().
+  vtkCellLinks *links = vtkCellLinks::New();
+  links->Allocate(this->GetNumberOfPoints());
+  links->Register(this);
+  links->BuildLinks(this, this->Connectivity);
+  links->Delete();
+  this->Links = links;
+}
+
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::BuildLinksIfNeeded()
+{
+  // Links is only read without the lock once the thread that built it has
+  // published it: the acquire load makes the complete links visible.
+  vtkCellLinks *published = this->PublishedLinks.load(std::memory_order_acquire);
+  if (!published || published != this->Links)
+  {
+    this->LockBuild();
+    if (!this->Links)
+    {
+      this->BuildLinks();
+    }
+    this->PublishedLinks.store(this->Links, std::memory_order_release);
+    this->UnlockBuild();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::PrepareForConcurrentReads(bool pointCells)
+{
+  // The cells are always stored with random access.
+  if (pointCells)
+  {
+    this->BuildLinksIfNeeded();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -1403,6 +1443,7 @@ void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
   vtkIdType i, loc;
   vtkIdType *pts, numPts;
 
+  vtkConcurrencyCheck check(this, false);
   loc = this->Locations->GetValue(cellId);
   this->Connectivity->GetCell(loc,numPts,pts);
   ptIds->SetNumberOfIds(numPts);
@@ -1426,6 +1467,17 @@ void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
   this->Connectivity->GetCell(loc,npts,pts);
 }
 
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                                        const vtkIdType*& pts,
+                                        vtkIdList *vtkNotUsed(ptIds)) const
+{
+  vtkConcurrencyCheck check(const_cast<vtkUnstructuredGrid*>(this), false);
+  vtkIdType *cellPts;
+  this->Connectivity->GetCell(this->Locations->GetValue(cellId), npts, cellPts);
+  pts = cellPts;
+}
+
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::GetFaceStream(vtkIdType cellId, vtkIdList *ptIds)
 {
@@ -1487,10 +1539,8 @@ void vtkUnstructuredGrid::GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
   int numCells;
   int i;
 
-  if ( ! this->Links )
-  {
-    this->BuildLinks();
-  }
+  vtkConcurrencyCheck check(this, false);
+  this->BuildLinksIfNeeded();
   cellIds->Reset();
 
   numCells = this->Links->GetNcells(ptId);
@@ -1693,6 +1743,7 @@ void vtkUnstructuredGrid::ShallowCopy(vtkDataObject *dataObject)
       this->Links->Delete();
     }
     this->Links = grid->Links;
+    this->PublishedLinks = nullptr;
     if (this->Links)
     {
       this->Links->Register(this);
@@ -1783,6 +1834,7 @@ void vtkUnstructuredGrid::DeepCopy(vtkDataObject *dataObject)
     {
       this->Links->UnRegister(this);
       this->Links = nullptr;
+      this->PublishedLinks = nullptr;
     }
     if ( this->Types )
     {
@@ -1872,10 +1924,8 @@ void vtkUnstructuredGrid::PrintSelf(ostream& os, vtkIndent indent)
 void vtkUnstructuredGrid::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
                                            vtkIdList *cellIds)
 {
-  if ( ! this->Links )
-  {
-    this->BuildLinks();
-  }
+  vtkConcurrencyCheck check(this, false);
+  this->BuildLinksIfNeeded();
 
   cellIds->Reset();
 
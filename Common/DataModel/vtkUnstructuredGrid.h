@@ -22,6 +22,14 @@
  * types. This includes 0D (e.g., points), 1D (e.g., lines, polylines), 2D
  * (e.g., triangles, polygons), and 3D (e.g., hexahedron, tetrahedron,
  * polyhedron, etc.).
+ *
+ * @warning
+ * GetCell(cellId) returns a cell owned by the dataset and must not be used
+ * from several threads. Threaded code should use GetCell(cellId,
+ * vtkGenericCell*), GetCellPoints() and GetPointCells(). The links needed
+ * by GetPointCells() and GetCellNeighbors() are built once, either by
+ * PrepareForConcurrentReads(true) or by the first call. Turn on
+ * vtkDataSet::GlobalConcurrencyChecksOn() to detect unsafe uses.
 */
 
 #ifndef vtkUnstructuredGrid_h
@@ -30,6 +38,8 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 #include "vtkUnstructuredGridBase.h"
 
+#include <atomic> // For std::atomic
+
 class vtkCellArray;
 class vtkCellLinks;
 class vtkConvexPointSet;
@@ -149,6 +159,20 @@ public:
   vtkCellIterator* NewCellIterator() override;
   //@}
 
+  /**
+   * Thread-safe access to the point ids of a cell. pts points into the
+   * connectivity array, ptIds is not used. See vtkDataSet::GetCellPoints().
+   */
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                     const vtkIdType*& pts, vtkIdList *ptIds) const override;
+
+  /**
+   * Build the links if pointCells is true, at most once, so that the
+   * dataset can be read from several threads. See
+   * vtkDataSet::PrepareForConcurrentReads().
+   */
+  void PrepareForConcurrentReads(bool pointCells = false) override;
+
   int GetCellType(vtkIdType cellId) override;
   vtkUnsignedCharArray* GetCellTypesArray() { return this->Types; }
   vtkIdTypeArray* GetCellLocationsArray() { return this->Locations; }
@@ -417,6 +441,9 @@ protected:
   // point data (i.e., scalars, vectors, normals, tcoords) inherited
   vtkCellArray *Connectivity;
   vtkCellLinks *Links;
+  // Links as published by BuildLinksIfNeeded() once complete. Reset with
+  // Links.
+  std::atomic<vtkCellLinks*> PublishedLinks;
   vtkUnsignedCharArray *Types;
   vtkIdTypeArray *Locations;
 
@@ -428,6 +455,12 @@ protected:
   vtkIdTypeArray *Faces;
   vtkIdTypeArray *FaceLocations;
 
+  /**
+   * Build Links unless they exist. Unlike BuildLinks(), this may be called
+   * concurrently.
+   */
+  void BuildLinksIfNeeded();
+
 private:
   // Hide these from the user and the compiler.
   vtkUnstructuredGrid(const vtkUnstructuredGrid&) = delete;
@@ -0,0 +1,225 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCachedCompositeDataPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkCachedCompositeDataPipeline restores the results of time
+// steps computed before, for simple and composite datasets, and that the
+// cache is discarded when the pipeline is modified or grows too large.
+
+#include "vtkCachedCompositeDataPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPassInputTypeAlgorithm.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+// Produce, for time step t, a polydata with 100 * (t + 1) points, or a
+// multiblock of two such polydata.
+class vtkTimeStepSource : public vtkPassInputTypeAlgorithm
+{
+public:
+  static vtkTimeStepSource* New();
+  vtkTypeMacro(vtkTimeStepSource, vtkPassInputTypeAlgorithm);
+
+  int Composite;
+  int NumberOfExecutions;
+
+protected:
+  vtkTimeStepSource() : Composite(0), NumberOfExecutions(0)
+  {
+    this->SetNumberOfInputPorts(0);
+  }
+
+  int RequestDataObject(vtkInformation*, vtkInformationVector**,
+                        vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    if (!outInfo->Get(vtkDataObject::DATA_OBJECT()))
+    {
+      vtkDataObject* output = this->Composite ?
+        static_cast<vtkDataObject*>(vtkMultiBlockDataSet::New()) :
+        static_cast<vtkDataObject*>(vtkPolyData::New());
+      outInfo->Set(vtkDataObject::DATA_OBJECT(), output);
+      output->Delete();
+    }
+    return 1;
+  }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+                         vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double steps[4] = { 0.0, 1.0, 2.0, 3.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps, 4);
+    double range[2] = { 0.0, 3.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+                  vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double t = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkDataObject* output = vtkDataObject::GetData(outInfo);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), t);
+    if (vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(output))
+    {
+      mb->SetNumberOfBlocks(2);
+      for (unsigned int i = 0; i < 2; ++i)
+      {
+        vtkNew<vtkPolyData> block;
+        this->Fill(block.GetPointer(), t);
+        mb->SetBlock(i, block.GetPointer());
+      }
+    }
+    else
+    {
+      this->Fill(vtkPolyData::SafeDownCast(output), t);
+    }
+    ++this->NumberOfExecutions;
+    return 1;
+  }
+
+  void Fill(vtkPolyData* pd, double t)
+  {
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(100 * (static_cast<int>(t) + 1));
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+    {
+      points->SetPoint(i, i, t, 0.0);
+    }
+    pd->SetPoints(points.GetPointer());
+  }
+
+private:
+  vtkTimeStepSource(const vtkTimeStepSource&) = delete;
+  void operator=(const vtkTimeStepSource&) = delete;
+};
+vtkStandardNewMacro(vtkTimeStepSource);
+
+// Deep copy the input to the output and count executions.
+class vtkCountingPassFilter : public vtkPassInputTypeAlgorithm
+{
+public:
+  static vtkCountingPassFilter* New();
+  vtkTypeMacro(vtkCountingPassFilter, vtkPassInputTypeAlgorithm);
+
+  int NumberOfExecutions;
+
+protected:
+  vtkCountingPassFilter() : NumberOfExecutions(0) {}
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector) override
+  {
+    vtkDataObject::GetData(outputVector)->DeepCopy(vtkDataObject::GetData(inputVector[0]));
+    ++this->NumberOfExecutions;
+    return 1;
+  }
+
+private:
+  vtkCountingPassFilter(const vtkCountingPassFilter&) = delete;
+  void operator=(const vtkCountingPassFilter&) = delete;
+};
+vtkStandardNewMacro(vtkCountingPassFilter);
+
+static vtkIdType NumberOfPoints(vtkDataObject* data)
+{
+  if (vtkMultiBlockDataSet* mb = vtkMultiBlockDataSet::SafeDownCast(data))
+  {
+    return vtkPolyData::SafeDownCast(mb->GetBlock(0))->GetNumberOfPoints() +
+      vtkPolyData::SafeDownCast(mb->GetBlock(1))->GetNumberOfPoints();
+  }
+  return vtkPolyData::SafeDownCast(data)->GetNumberOfPoints();
+}
+
+static int TestScrubbing(int composite)
+{
+  vtkNew<vtkTimeStepSource> source;
+  source->Composite = composite;
+  vtkNew<vtkCachedCompositeDataPipeline> sourceExec;
+  source->SetExecutive(sourceExec.GetPointer());
+  vtkNew<vtkCountingPassFilter> filter;
+  // The executive holds the connections, so it is set first.
+  vtkNew<vtkCachedCompositeDataPipeline> filterExec;
+  filter->SetExecutive(filterExec.GetPointer());
+  filter->SetInputConnection(source->GetOutputPort());
+
+  const vtkIdType perStep = composite ? 200 : 100;
+  const double times[] = { 0, 1, 2, 0, 1, 2, 1 };
+  for (int i = 0; i < 7; ++i)
+  {
+    filter->UpdateTimeStep(times[i]);
+    vtkDataObject* output = filter->GetOutputDataObject(0);
+    if (NumberOfPoints(output) != perStep * (static_cast<int>(times[i]) + 1) ||
+        output->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != times[i])
+    {
+      cerr << "Wrong output for time " << times[i] << endl;
+      return 0;
+    }
+  }
+  if (source->NumberOfExecutions != 3 || filter->NumberOfExecutions != 3 ||
+      filterExec->GetNumberOfHits() != 4 || filterExec->GetNumberOfCachedResults() != 3)
+  {
+    cerr << "Time steps were recomputed: " << source->NumberOfExecutions << " "
+         << filter->NumberOfExecutions << " " << filterExec->GetNumberOfHits() << endl;
+    return 0;
+  }
+
+  // Modifying the source invalidates every cached result downstream.
+  source->Modified();
+  filter->UpdateTimeStep(0);
+  if (source->NumberOfExecutions != 4 || filter->NumberOfExecutions != 4 ||
+      filterExec->GetNumberOfCachedResults() != 1)
+  {
+    cerr << "Modified pipeline did not re-execute." << endl;
+    return 0;
+  }
+
+  // A cache too small for two results keeps only the latest one.
+  filterExec->SetCacheMemoryLimit(filterExec->GetCacheMemorySize() + 1);
+  filter->UpdateTimeStep(1);
+  filter->UpdateTimeStep(0);
+  if (filter->NumberOfExecutions != 6 || filterExec->GetNumberOfCachedResults() != 1 ||
+      filterExec->GetCacheMemorySize() > filterExec->GetCacheMemoryLimit())
+  {
+    cerr << "The cache memory limit was not honored." << endl;
+    return 0;
+  }
+  if (NumberOfPoints(filter->GetOutputDataObject(0)) != perStep)
+  {
+    cerr << "Wrong output after eviction." << endl;
+    return 0;
+  }
+  return 1;
+}
+
+int TestCachedCompositeDataPipeline(int, char*[])
+{
+  if (!TestScrubbing(0))
+  {
+    cerr << "Failed with polydata." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!TestScrubbing(1))
+  {
+    cerr << "Failed with a multiblock dataset." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
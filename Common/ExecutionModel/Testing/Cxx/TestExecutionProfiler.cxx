@@ -0,0 +1,182 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExecutionProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkExecutionProfiler records the requests of every algorithm
+// while it is active, and nothing once it is stopped.
+
+#include "vtkElevationFilter.h"
+#include "vtkExecutionProfiler.h"
+#include "vtkNew.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+int TestExecutionProfiler(int argc, char* argv[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+
+  vtkNew<vtkExecutionProfiler> profiler;
+  if (vtkExecutionProfiler::GetActiveProfiler())
+  {
+    cerr << "A profiler is active before Start()." << endl;
+    return EXIT_FAILURE;
+  }
+  profiler->Start();
+  elevation->Update();
+  profiler->Stop();
+
+  vtkIdType sphereData = -1;
+  vtkIdType elevationData = -1;
+  bool sawInformation = false;
+  for (vtkIdType i = 0; i < profiler->GetNumberOfEvents(); ++i)
+  {
+    if (strcmp(profiler->GetEventRequestName(i), "REQUEST_INFORMATION") == 0)
+    {
+      sawInformation = true;
+    }
+    if (strcmp(profiler->GetEventRequestName(i), "REQUEST_DATA") == 0)
+    {
+      if (profiler->GetEventAlgorithm(i) == sphere.GetPointer())
+      {
+        sphereData = i;
+      }
+      else if (profiler->GetEventAlgorithm(i) == elevation.GetPointer())
+      {
+        elevationData = i;
+      }
+    }
+    if (profiler->GetEventDuration(i) < 0.0 || profiler->GetEventStartTime(i) < 0.0)
+    {
+      cerr << "Invalid event times." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (!sawInformation || sphereData < 0 || elevationData < 0)
+  {
+    cerr << "Missing pipeline requests in the profile." << endl;
+    profiler->PrintSummary(cerr);
+    return EXIT_FAILURE;
+  }
+  if (sphereData > elevationData)
+  {
+    cerr << "Source data was recorded after its consumer." << endl;
+    return EXIT_FAILURE;
+  }
+  if (strcmp(profiler->GetEventAlgorithmClassName(elevationData), "vtkElevationFilter") != 0 ||
+      profiler->GetEventInputMemorySize(elevationData) == 0 ||
+      profiler->GetEventOutputMemorySize(elevationData) == 0 ||
+      profiler->GetEventNumberOfOutputArrays(elevationData) < 2)
+  {
+    cerr << "Wrong data statistics for vtkElevationFilter." << endl;
+    return EXIT_FAILURE;
+  }
+  if (profiler->GetNumberOfThreads() < 1 ||
+      profiler->GetTotalTime(elevation.GetPointer(), "REQUEST_DATA") !=
+        profiler->GetEventDuration(elevationData))
+  {
+    cerr << "Wrong thread or time totals." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Nothing is recorded once the profiler is stopped.
+  vtkIdType numEvents = profiler->GetNumberOfEvents();
+  sphere->Modified();
+  elevation->Update();
+  if (profiler->GetNumberOfEvents() != numEvents)
+  {
+    cerr << "Events were recorded after Stop()." << endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ostringstream summary;
+  profiler->PrintSummary(summary);
+  if (summary.str().find("vtkSphereSource") == std::string::npos)
+  {
+    cerr << "Summary does not list the source." << endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ostringstream trace;
+  profiler->WriteChromeTrace(trace);
+  if (trace.str().compare(0, 15, "{\"traceEvents\":") != 0 ||
+      trace.str().find("\"name\":\"vtkElevationFilter\"") == std::string::npos ||
+      trace.str().find("\"output_kib\"") == std::string::npos)
+  {
+    cerr << "Unexpected trace:\n" << trace.str() << endl;
+    return EXIT_FAILURE;
+  }
+  // Timestamps are written in full, and the stream format is restored.
+  bool fixed = trace.str().find("e+") == std::string::npos;
+  for (size_t pos = trace.str().find("\"ts\":"); fixed && pos != std::string::npos;
+       pos = trace.str().find("\"ts\":", pos + 1))
+  {
+    size_t comma = trace.str().find(',', pos);
+    size_t dot = trace.str().find('.', pos);
+    fixed = dot < comma && comma - dot == 4;
+  }
+  if (!fixed || trace.precision() != 6 || (trace.flags() & std::ios::fixed))
+  {
+    cerr << "Timestamps are not written with a fixed precision:\n"
+         << trace.str() << endl;
+    return EXIT_FAILURE;
+  }
+
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/TestExecutionProfiler.json";
+  delete[] tempDir;
+  if (!profiler->WriteChromeTrace(fileName.c_str()))
+  {
+    cerr << "Could not write " << fileName << endl;
+    return EXIT_FAILURE;
+  }
+
+  profiler->Clear();
+  if (profiler->GetNumberOfEvents() != 0)
+  {
+    cerr << "Clear() did not remove the events." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // A profiler deleted while recording stays alive until it is stopped,
+  // and its events outlive the algorithms.
+  vtkExecutionProfiler* orphan = vtkExecutionProfiler::New();
+  orphan->Start();
+  orphan->Delete();
+  {
+    vtkNew<vtkSphereSource> temporary;
+    temporary->Update();
+  }
+  if (vtkExecutionProfiler::GetActiveProfiler() != orphan ||
+      orphan->GetNumberOfEvents() == 0 || orphan->GetEventAlgorithm(0) != nullptr ||
+      strcmp(orphan->GetEventAlgorithmClassName(0), "vtkSphereSource") != 0)
+  {
+    cerr << "Wrong events for a deleted profiler or algorithm." << endl;
+    return EXIT_FAILURE;
+  }
+  profiler->Start();
+  if (vtkExecutionProfiler::GetActiveProfiler() != profiler.GetPointer())
+  {
+    cerr << "The deleted profiler was not replaced." << endl;
+    return EXIT_FAILURE;
+  }
+  profiler->Stop();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,181 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineMemoryBudget.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkPipelineMemoryBudget releases intermediate outputs that do
+// not fit in the budget, that released outputs are regenerated on demand,
+// that outputs kept in the budget are reused, and that the outputs of
+// sources and of data given with SetInputData() are never released.
+
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPassInputTypeAlgorithm.h"
+#include "vtkPipelineMemoryBudget.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+// Deep copy the input to the output and count executions.
+class vtkCountingCopyFilter : public vtkPassInputTypeAlgorithm
+{
+public:
+  static vtkCountingCopyFilter* New();
+  vtkTypeMacro(vtkCountingCopyFilter, vtkPassInputTypeAlgorithm);
+
+  int NumberOfExecutions;
+
+protected:
+  vtkCountingCopyFilter() : NumberOfExecutions(0) {}
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector) override
+  {
+    vtkDataObject* input = vtkDataObject::GetData(inputVector[0]);
+    vtkDataObject* output = vtkDataObject::GetData(outputVector);
+    output->DeepCopy(input);
+    ++this->NumberOfExecutions;
+    return 1;
+  }
+
+private:
+  vtkCountingCopyFilter(const vtkCountingCopyFilter&) = delete;
+  void operator=(const vtkCountingCopyFilter&) = delete;
+};
+vtkStandardNewMacro(vtkCountingCopyFilter);
+
+static vtkIdType NumberOfCells(vtkAlgorithm* algorithm)
+{
+  return vtkPolyData::SafeDownCast(algorithm->GetOutputDataObject(0))->GetNumberOfCells();
+}
+
+int TestPipelineMemoryBudget(int, char*[])
+{
+  // sphere -> head -> first -> second -> last
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  vtkNew<vtkCountingCopyFilter> head;
+  head->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkCountingCopyFilter> first;
+  first->SetInputConnection(head->GetOutputPort());
+  vtkNew<vtkCountingCopyFilter> second;
+  second->SetInputConnection(first->GetOutputPort());
+  vtkNew<vtkCountingCopyFilter> last;
+  last->SetInputConnection(second->GetOutputPort());
+
+  vtkNew<vtkPipelineMemoryBudget> budget;
+  budget->Activate();
+
+  // Without a limit, the three intermediate outputs of filters are kept,
+  // the output of the source is not tracked.
+  last->Update();
+  vtkIdType numCells = NumberOfCells(last.GetPointer());
+  if (budget->GetNumberOfCachedOutputs() != 3 || budget->GetNumberOfEvictions() != 0)
+  {
+    cerr << "Expected 3 cached outputs and no eviction, got "
+         << budget->GetNumberOfCachedOutputs() << " and "
+         << budget->GetNumberOfEvictions() << endl;
+    return EXIT_FAILURE;
+  }
+  unsigned long outputSize = vtkPolyData::SafeDownCast(
+    first->GetOutputDataObject(0))->GetActualMemorySize();
+
+  // Re-executing the last filter reuses the output of the second one.
+  last->Modified();
+  last->Update();
+  if (budget->GetNumberOfHits() != 1 || second->NumberOfExecutions != 1)
+  {
+    cerr << "The cached intermediate output was not reused." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // A budget holding a single output releases the two least recently used
+  // ones, but never the output that was asked for.
+  budget->SetMaximumMemorySize(outputSize + outputSize / 2);
+  budget->ResetStatistics();
+  budget->Enforce(last->GetExecutive());
+  if (budget->GetNumberOfEvictions() != 2 || budget->GetNumberOfCachedOutputs() != 1 ||
+      budget->GetTotalMemorySize() > budget->GetMaximumMemorySize())
+  {
+    cerr << "Expected 2 evictions, got " << budget->GetNumberOfEvictions() << endl;
+    return EXIT_FAILURE;
+  }
+  if (NumberOfCells(head.GetPointer()) != 0 ||
+      sphere->GetOutput()->GetNumberOfCells() != numCells ||
+      first->GetOutputDataObject(0)->GetActualMemorySize() >= outputSize ||
+      NumberOfCells(last.GetPointer()) != numCells)
+  {
+    cerr << "The wrong outputs were released." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The second filter still has its output and does not re-execute.
+  last->Modified();
+  last->Update();
+  if (second->NumberOfExecutions != 1 || first->NumberOfExecutions != 1 ||
+      NumberOfCells(last.GetPointer()) != numCells)
+  {
+    cerr << "A cached output was not reused after eviction." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Released outputs are regenerated on demand.
+  second->Modified();
+  last->Update();
+  if (first->NumberOfExecutions != 2 || head->NumberOfExecutions != 2 ||
+      budget->GetNumberOfMisses() != 2 ||
+      NumberOfCells(last.GetPointer()) != numCells)
+  {
+    cerr << "Released outputs were not regenerated: " << budget->GetNumberOfMisses()
+         << " misses." << endl;
+    return EXIT_FAILURE;
+  }
+  if (budget->GetTotalMemorySize() > budget->GetMaximumMemorySize())
+  {
+    cerr << "The budget was not enforced at the end of the update." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The data given with SetInputData() is never released, even when it
+  // does not fit in the budget: it could not be regenerated.
+  vtkNew<vtkPolyData> mesh;
+  mesh->DeepCopy(sphere->GetOutput());
+  vtkNew<vtkCountingCopyFilter> meshFirst;
+  meshFirst->SetInputData(mesh.GetPointer());
+  vtkNew<vtkCountingCopyFilter> meshSecond;
+  meshSecond->SetInputConnection(meshFirst->GetOutputPort());
+  vtkNew<vtkCountingCopyFilter> meshLast;
+  meshLast->SetInputConnection(meshSecond->GetOutputPort());
+  budget->SetMaximumMemorySize(1);
+  meshLast->Update();
+  meshSecond->Modified();
+  meshLast->Update();
+  if (mesh->GetNumberOfCells() != numCells ||
+      NumberOfCells(meshLast.GetPointer()) != numCells)
+  {
+    cerr << "The data given with SetInputData() was released: "
+         << mesh->GetNumberOfCells() << " cells left." << endl;
+    return EXIT_FAILURE;
+  }
+
+  budget->Deactivate();
+  if (vtkPipelineMemoryBudget::GetActiveBudget() || budget->GetNumberOfCachedOutputs() != 0)
+  {
+    cerr << "Deactivate() did not reset the budget." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineUpdateLatency.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Measure the cost of the pipeline itself: Update() on a deep pipeline of
+// filters that do nothing, first when nothing changed and then when the
+// source is modified and every filter re-executes on tiny data. The
+// timings are reported as CDash measurements; the test fails only if the
+// pipeline executes filters it should not.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPassInputTypeAlgorithm.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTimerLog.h"
+
+#include <vector>
+
+// Shallow copy the input to the output and count executions.
+class vtkNoOpFilter : public vtkPassInputTypeAlgorithm
+{
+public:
+  static vtkNoOpFilter* New();
+  vtkTypeMacro(vtkNoOpFilter, vtkPassInputTypeAlgorithm);
+
+  int NumberOfExecutions;
+
+protected:
+  vtkNoOpFilter() : NumberOfExecutions(0) {}
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector) override
+  {
+    vtkDataObject* input = vtkDataObject::GetData(inputVector[0]);
+    vtkDataObject* output = vtkDataObject::GetData(outputVector);
+    output->ShallowCopy(input);
+    ++this->NumberOfExecutions;
+    return 1;
+  }
+
+private:
+  vtkNoOpFilter(const vtkNoOpFilter&) = delete;
+  void operator=(const vtkNoOpFilter&) = delete;
+};
+vtkStandardNewMacro(vtkNoOpFilter);
+
+int TestPipelineUpdateLatency(int, char*[])
+{
+  const int numFilters = 50;
+  const int numNoOpUpdates = 1000;
+  const int numModifiedUpdates = 100;
+
+  vtkNew<vtkSphereSource> source;
+  source->SetThetaResolution(4);
+  source->SetPhiResolution(4);
+  std::vector<vtkSmartPointer<vtkNoOpFilter> > filters;
+  vtkAlgorithm* last = source.GetPointer();
+  for (int i = 0; i < numFilters; ++i)
+  {
+    vtkSmartPointer<vtkNoOpFilter> filter = vtkSmartPointer<vtkNoOpFilter>::New();
+    filter->SetInputConnection(last->GetOutputPort());
+    filters.push_back(filter);
+    last = filter;
+  }
+  last->Update();
+
+  // Nothing changed: no filter may execute.
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (int i = 0; i < numNoOpUpdates; ++i)
+  {
+    last->Update();
+  }
+  timer->StopTimer();
+  double noOpLatency = 1.0e6 * timer->GetElapsedTime() / numNoOpUpdates;
+  for (int i = 0; i < numFilters; ++i)
+  {
+    if (filters[i]->NumberOfExecutions != 1)
+    {
+      cerr << "Filter " << i << " executed " << filters[i]->NumberOfExecutions
+           << " times on unchanged updates." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The source changed: every filter executes once per update.
+  timer->StartTimer();
+  for (int i = 0; i < numModifiedUpdates; ++i)
+  {
+    source->Modified();
+    last->Update();
+  }
+  timer->StopTimer();
+  double modifiedLatency = 1.0e6 * timer->GetElapsedTime() / numModifiedUpdates;
+  for (int i = 0; i < numFilters; ++i)
+  {
+    if (filters[i]->NumberOfExecutions != 1 + numModifiedUpdates)
+    {
+      cerr << "Filter " << i << " executed " << filters[i]->NumberOfExecutions
+           << " times, expected " << 1 + numModifiedUpdates << "." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  cout << "<DartMeasurement name=\"NoOpUpdateMicroseconds\" type=\"numeric/double\">"
+       << noOpLatency << "</DartMeasurement>" << endl;
+  cout << "<DartMeasurement name=\"ModifiedUpdateMicroseconds\" type=\"numeric/double\">"
+       << modifiedLatency << "</DartMeasurement>" << endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedBranchPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkThreadedBranchPipeline updates independent inputs of a
+// fan-in filter concurrently, that repeated concurrent updates give the same
+// result as serial ones, and that it falls back to serial updates when the
+// inputs share an algorithm or a data object.
+
+#include "vtkAppendPolyData.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkThreadedBranchPipeline.h"
+
+int TestThreadedBranchPipeline(int, char*[])
+{
+  const int numBranches = 4;
+  vtkNew<vtkSphereSource> spheres[numBranches];
+  vtkNew<vtkElevationFilter> elevations[numBranches];
+  vtkNew<vtkAppendPolyData> append;
+  vtkNew<vtkThreadedBranchPipeline> executive;
+  append->SetExecutive(executive.GetPointer());
+
+  vtkIdType expectedPoints = 0;
+  for (int i = 0; i < numBranches; ++i)
+  {
+    spheres[i]->SetThetaResolution(8 + 8 * i);
+    spheres[i]->SetPhiResolution(8 + 4 * i);
+    spheres[i]->Update();
+    expectedPoints += spheres[i]->GetOutput()->GetNumberOfPoints();
+    spheres[i]->Modified();
+    elevations[i]->SetInputConnection(spheres[i]->GetOutputPort());
+    append->AddInputConnection(elevations[i]->GetOutputPort());
+  }
+
+  append->Update();
+  if (append->GetOutput()->GetNumberOfPoints() != expectedPoints)
+  {
+    cerr << "Wrong number of points: " << append->GetOutput()->GetNumberOfPoints()
+         << " expected " << expectedPoints << endl;
+    return EXIT_FAILURE;
+  }
+  if (executive->GetNumberOfConcurrentBranches() != numBranches)
+  {
+    cerr << "Independent branches were not updated concurrently." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Modifying one branch re-executes only that branch.
+  spheres[1]->SetThetaResolution(40);
+  append->Update();
+  if (append->GetOutput()->GetNumberOfPoints() <= expectedPoints)
+  {
+    cerr << "Modified branch was not re-executed." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Two connections sharing the same source must be updated serially.
+  vtkNew<vtkAppendPolyData> shared;
+  vtkNew<vtkThreadedBranchPipeline> sharedExecutive;
+  shared->SetExecutive(sharedExecutive.GetPointer());
+  vtkNew<vtkElevationFilter> other;
+  other->SetInputConnection(spheres[0]->GetOutputPort());
+  shared->AddInputConnection(elevations[0]->GetOutputPort());
+  shared->AddInputConnection(other->GetOutputPort());
+  shared->Update();
+  if (sharedExecutive->GetNumberOfConcurrentBranches() != 0)
+  {
+    cerr << "Branches sharing a source were updated concurrently." << endl;
+    return EXIT_FAILURE;
+  }
+  if (shared->GetOutput()->GetNumberOfPoints() !=
+      2 * spheres[0]->GetOutput()->GetNumberOfPoints())
+  {
+    cerr << "Wrong number of points for shared branches." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // A filter consuming two of the branches links them.
+  vtkNew<vtkAppendPolyData> link;
+  link->AddInputConnection(spheres[2]->GetOutputPort());
+  link->AddInputConnection(spheres[3]->GetOutputPort());
+  spheres[2]->Modified();
+  append->Update();
+  if (executive->GetNumberOfConcurrentBranches() != 0)
+  {
+    cerr << "Branches linked by a consumer were updated concurrently." << endl;
+    return EXIT_FAILURE;
+  }
+  link->RemoveAllInputConnections(0);
+
+  // The same data set given to two filters is shared by both branches.
+  vtkNew<vtkAppendPolyData> sameData;
+  vtkNew<vtkThreadedBranchPipeline> sameDataExecutive;
+  sameData->SetExecutive(sameDataExecutive.GetPointer());
+  vtkNew<vtkElevationFilter> first;
+  vtkNew<vtkElevationFilter> second;
+  first->SetInputData(spheres[0]->GetOutput());
+  second->SetInputData(spheres[0]->GetOutput());
+  sameData->AddInputConnection(first->GetOutputPort());
+  sameData->AddInputConnection(second->GetOutputPort());
+  sameData->Update();
+  if (sameDataExecutive->GetNumberOfConcurrentBranches() != 0)
+  {
+    cerr << "Branches sharing a data set were updated concurrently." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Update all the branches concurrently many times, and compare with a
+  // serial update. With a threaded backend, the branches create and release
+  // pipeline objects concurrently at each update.
+  vtkNew<vtkPolyData> concurrent;
+  for (int iteration = 0; iteration < 20; ++iteration)
+  {
+    for (int i = 0; i < numBranches; ++i)
+    {
+      elevations[i]->SetHighPoint(0, 0, 1 + iteration + i);
+    }
+    executive->ConcurrentBranchesOn();
+    append->Update();
+    if (executive->GetNumberOfConcurrentBranches() != numBranches)
+    {
+      cerr << "Unlinked branches were not updated concurrently." << endl;
+      return EXIT_FAILURE;
+    }
+    concurrent->DeepCopy(append->GetOutput());
+
+    executive->ConcurrentBranchesOff();
+    for (int i = 0; i < numBranches; ++i)
+    {
+      elevations[i]->Modified();
+    }
+    append->Update();
+    vtkDataArray* result = concurrent->GetPointData()->GetArray("Elevation");
+    vtkDataArray* expected =
+      append->GetOutput()->GetPointData()->GetArray("Elevation");
+    if (!result || !expected ||
+        result->GetNumberOfTuples() != expected->GetNumberOfTuples())
+    {
+      cerr << "Wrong elevation at iteration " << iteration << endl;
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType j = 0; j < expected->GetNumberOfTuples(); ++j)
+    {
+      if (result->GetTuple1(j) != expected->GetTuple1(j))
+      {
+        cerr << "Wrong elevation at iteration " << iteration << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
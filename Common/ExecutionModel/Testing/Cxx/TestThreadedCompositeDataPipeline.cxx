@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedCompositeDataPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkThreadedCompositeDataPipeline processes every block, that
+// it schedules the largest blocks first, and that algorithms declared as
+// not re-entrant are executed serially in traversal order.
+
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSMPTools.h"
+#include "vtkSimpleCriticalSection.h"
+#include "vtkSphereSource.h"
+#include "vtkThreadedCompositeDataPipeline.h"
+
+#include <vector>
+
+namespace
+{
+vtkSimpleCriticalSection OrderLock;
+std::vector<vtkIdType> ExecutionOrder;
+}
+
+// Pass the input through and record the size of every block it executes on.
+class vtkRecordBlockOrderFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkRecordBlockOrderFilter* New();
+  vtkTypeMacro(vtkRecordBlockOrderFilter, vtkPolyDataAlgorithm);
+
+protected:
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector) override
+  {
+    vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    output->ShallowCopy(input);
+    OrderLock.Lock();
+    ExecutionOrder.push_back(input->GetNumberOfCells());
+    OrderLock.Unlock();
+    return 1;
+  }
+};
+vtkStandardNewMacro(vtkRecordBlockOrderFilter);
+
+int TestThreadedCompositeDataPipeline(int, char*[])
+{
+  // Blocks of increasing size, so traversal order is the reverse of the
+  // cost-aware order.
+  const unsigned int numBlocks = 5;
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetNumberOfBlocks(numBlocks);
+  std::vector<vtkIdType> sizes;
+  for (unsigned int i = 0; i < numBlocks; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetThetaResolution(4 + 4 * i);
+    sphere->SetPhiResolution(4 + 4 * i);
+    sphere->Update();
+    mb->SetBlock(i, sphere->GetOutput());
+    sizes.push_back(sphere->GetOutput()->GetNumberOfCells());
+  }
+
+  vtkNew<vtkThreadedCompositeDataPipeline> executive;
+  vtkNew<vtkRecordBlockOrderFilter> filter;
+  filter->SetExecutive(executive.GetPointer());
+  filter->SetInputData(mb.GetPointer());
+  filter->Update();
+
+  vtkMultiBlockDataSet* output =
+    vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfBlocks() != numBlocks)
+  {
+    cerr << "Wrong output structure." << endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned int i = 0; i < numBlocks; ++i)
+  {
+    vtkPolyData* block = vtkPolyData::SafeDownCast(output->GetBlock(i));
+    if (!block || block->GetNumberOfCells() != sizes[i])
+    {
+      cerr << "Block " << i << " was not processed correctly." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (ExecutionOrder.size() != numBlocks)
+  {
+    cerr << "Expected " << numBlocks << " executions, got "
+         << ExecutionOrder.size() << endl;
+    return EXIT_FAILURE;
+  }
+  // The processing order is only deterministic with a single thread.
+  if (vtkSMPTools::GetEstimatedNumberOfThreads() == 1)
+  {
+    for (unsigned int i = 0; i < numBlocks; ++i)
+    {
+      if (ExecutionOrder[i] != sizes[numBlocks - 1 - i])
+      {
+        cerr << "Blocks were not processed largest first." << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // A non re-entrant algorithm is executed serially, in traversal order.
+  ExecutionOrder.clear();
+  filter->GetInformation()->Set(
+    vtkThreadedCompositeDataPipeline::ALGORITHM_IS_REENTRANT(), 0);
+  filter->Modified();
+  filter->Update();
+  for (unsigned int i = 0; i < numBlocks; ++i)
+  {
+    if (ExecutionOrder.size() != numBlocks || ExecutionOrder[i] != sizes[i])
+    {
+      cerr << "Non re-entrant algorithm was not executed serially." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
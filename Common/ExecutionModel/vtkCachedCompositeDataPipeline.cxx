@@ -0,0 +1,377 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCachedCompositeDataPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCachedCompositeDataPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <list>
+#include <vector>
+
+vtkStandardNewMacro(vtkCachedCompositeDataPipeline);
+
+//----------------------------------------------------------------------------
+class vtkCachedCompositeDataPipelineInternals
+{
+public:
+  // What was requested from the algorithm.
+  struct Key
+  {
+    vtkMTimeType PipelineMTime;
+    int OutputPort;
+    bool HasTimeStep;
+    double TimeStep;
+    int Piece;
+    int NumberOfPieces;
+    int GhostLevels;
+    bool HasExtent;
+    int Extent[6];
+    bool HasCompositeIndices;
+    std::vector<int> CompositeIndices;
+
+    bool operator==(const Key& other) const
+    {
+      if (this->PipelineMTime != other.PipelineMTime ||
+          this->OutputPort != other.OutputPort ||
+          this->HasTimeStep != other.HasTimeStep ||
+          (this->HasTimeStep && this->TimeStep != other.TimeStep) ||
+          this->Piece != other.Piece ||
+          this->NumberOfPieces != other.NumberOfPieces ||
+          this->GhostLevels != other.GhostLevels ||
+          this->HasExtent != other.HasExtent ||
+          this->HasCompositeIndices != other.HasCompositeIndices ||
+          this->CompositeIndices != other.CompositeIndices)
+      {
+        return false;
+      }
+      for (int i = 0; this->HasExtent && i < 6; ++i)
+      {
+        if (this->Extent[i] != other.Extent[i])
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  // What the algorithm produced on one output port.
+  struct Output
+  {
+    vtkSmartPointer<vtkDataObject> Data;
+    int Piece;
+    int NumberOfPieces;
+    int GhostLevels;
+    bool HasCompositeIndices;
+    std::vector<int> CompositeIndices;
+  };
+
+  struct Entry
+  {
+    Key Request;
+    std::vector<Output> Outputs;
+    unsigned long Size;
+  };
+
+  // Most recently used first.
+  typedef std::list<Entry> EntriesType;
+  EntriesType Entries;
+
+  static void GetKey(vtkMTimeType pipelineMTime, int outputPort,
+                     vtkInformation* outInfo, Key& key)
+  {
+    typedef vtkStreamingDemandDrivenPipeline SDDP;
+    key.PipelineMTime = pipelineMTime;
+    key.OutputPort = outputPort;
+    key.HasTimeStep = outInfo->Has(SDDP::UPDATE_TIME_STEP()) != 0;
+    key.TimeStep = key.HasTimeStep ? outInfo->Get(SDDP::UPDATE_TIME_STEP()) : 0.0;
+    key.Piece = outInfo->Get(SDDP::UPDATE_PIECE_NUMBER());
+    key.NumberOfPieces = outInfo->Get(SDDP::UPDATE_NUMBER_OF_PIECES());
+    key.GhostLevels = outInfo->Get(SDDP::UPDATE_NUMBER_OF_GHOST_LEVELS());
+    key.HasExtent = outInfo->Has(SDDP::UPDATE_EXTENT()) != 0;
+    if (key.HasExtent)
+    {
+      outInfo->Get(SDDP::UPDATE_EXTENT(), key.Extent);
+    }
+    GetIndices(outInfo, vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES(),
+               key.HasCompositeIndices, key.CompositeIndices);
+  }
+
+  static void GetIndices(vtkInformation* info, vtkInformationIntegerVectorKey* key,
+                         bool& has, std::vector<int>& indices)
+  {
+    has = info->Has(key) != 0;
+    indices.clear();
+    if (has)
+    {
+      int* values = info->Get(key);
+      indices.assign(values, values + info->Length(key));
+    }
+  }
+
+  // Shallow copy from into to. The leaves of composite datasets are copied
+  // too, so that the algorithm replacing the blocks of its output does not
+  // change the cached copy, and the other way around.
+  static void ShallowCopy(vtkDataObject* to, vtkDataObject* from)
+  {
+    to->ShallowCopy(from);
+    vtkCompositeDataSet* input = vtkCompositeDataSet::SafeDownCast(from);
+    vtkCompositeDataSet* output = vtkCompositeDataSet::SafeDownCast(to);
+    if (!input || !output)
+    {
+      return;
+    }
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(input->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkDataObject* block = iter->GetCurrentDataObject();
+      vtkDataObject* copy = block->NewInstance();
+      copy->ShallowCopy(block);
+      output->SetDataSet(iter, copy);
+      copy->FastDelete();
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+vtkCachedCompositeDataPipeline::vtkCachedCompositeDataPipeline()
+{
+  this->CacheMemoryLimit = 262144;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->Internals = new vtkCachedCompositeDataPipelineInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkCachedCompositeDataPipeline::~vtkCachedCompositeDataPipeline()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << "\n";
+  os << indent << "NumberOfCachedResults: " << this->GetNumberOfCachedResults() << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::SetCacheMemoryLimit(unsigned long limit)
+{
+  if (this->CacheMemoryLimit == limit)
+  {
+    return;
+  }
+  this->CacheMemoryLimit = limit;
+  this->PruneCache();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkCachedCompositeDataPipeline::GetCacheMemorySize()
+{
+  unsigned long size = 0;
+  vtkCachedCompositeDataPipelineInternals::EntriesType::const_iterator it;
+  for (it = this->Internals->Entries.begin(); it != this->Internals->Entries.end(); ++it)
+  {
+    size += it->Size;
+  }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::GetNumberOfCachedResults()
+{
+  return static_cast<int>(this->Internals->Entries.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::ClearCache()
+{
+  this->Internals->Entries.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::PruneCache()
+{
+  typedef vtkCachedCompositeDataPipelineInternals::EntriesType EntriesType;
+  EntriesType& entries = this->Internals->Entries;
+
+  // The pipeline modified time only grows, so results computed before the
+  // last modification can never be requested again.
+  unsigned long size = 0;
+  for (EntriesType::iterator it = entries.begin(); it != entries.end();)
+  {
+    if (it->Request.PipelineMTime < this->PipelineMTime)
+    {
+      it = entries.erase(it);
+    }
+    else
+    {
+      size += it->Size;
+      ++it;
+    }
+  }
+
+  while (!entries.empty() && size > this->CacheMemoryLimit)
+  {
+    size -= entries.back().Size;
+    entries.pop_back();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::NeedToExecuteData(
+  int outputPort,
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec)
+{
+  if (!this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
+  {
+    return 0;
+  }
+  // If no port is specified we cannot tell which request to look for.
+  if (outputPort < 0 || this->ContinueExecuting || this->CacheMemoryLimit == 0)
+  {
+    return 1;
+  }
+
+  this->PruneCache();
+
+  typedef vtkCachedCompositeDataPipelineInternals Internals;
+  Internals::Key key;
+  Internals::GetKey(this->PipelineMTime, outputPort,
+                    outInfoVec->GetInformationObject(outputPort), key);
+  Internals::EntriesType& entries = this->Internals->Entries;
+  Internals::EntriesType::iterator it = entries.begin();
+  while (it != entries.end() && !(it->Request == key))
+  {
+    ++it;
+  }
+  if (it == entries.end())
+  {
+    return 1;
+  }
+
+  // Restore every output as if the algorithm had just produced it. This
+  // is the work MarkOutputsGenerated does after an execution.
+  int numPorts = outInfoVec->GetNumberOfInformationObjects();
+  for (int i = 0; i < numPorts && i < static_cast<int>(it->Outputs.size()); ++i)
+  {
+    const Internals::Output& cached = it->Outputs[i];
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (!data || !cached.Data)
+    {
+      continue;
+    }
+    Internals::ShallowCopy(data, cached.Data);
+    vtkInformation* dataInfo = data->GetInformation();
+    dataInfo->Set(vtkDataObject::DATA_PIECE_NUMBER(), cached.Piece);
+    dataInfo->Set(vtkDataObject::DATA_NUMBER_OF_PIECES(), cached.NumberOfPieces);
+    dataInfo->Set(vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS(), cached.GhostLevels);
+    if (cached.HasCompositeIndices)
+    {
+      outInfo->Set(DATA_COMPOSITE_INDICES(), cached.CompositeIndices.data(),
+                   static_cast<int>(cached.CompositeIndices.size()));
+    }
+    else
+    {
+      outInfo->Remove(DATA_COMPOSITE_INDICES());
+    }
+    if (key.HasTimeStep)
+    {
+      outInfo->Set(PREVIOUS_UPDATE_TIME_STEP(), key.TimeStep);
+    }
+    data->DataHasBeenGenerated();
+  }
+
+  // Move the entry to the front of the LRU list.
+  entries.splice(entries.begin(), entries, it);
+  this->NumberOfHits++;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::ExecuteData(
+  vtkInformation* request,
+  vtkInformationVector** inInfoVec,
+  vtkInformationVector* outInfoVec)
+{
+  int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  this->NumberOfMisses++;
+
+  // Streaming algorithms produce their result over several executions;
+  // only whole results are worth remembering.
+  int outputPort = request->Has(FROM_OUTPUT_PORT()) ? request->Get(FROM_OUTPUT_PORT()) : -1;
+  if (!result || outputPort < 0 || this->ContinueExecuting ||
+      request->Get(CONTINUE_EXECUTING()) || this->CacheMemoryLimit == 0)
+  {
+    return result;
+  }
+
+  typedef vtkCachedCompositeDataPipelineInternals Internals;
+  Internals::Entry entry;
+  Internals::GetKey(this->PipelineMTime, outputPort,
+                    outInfoVec->GetInformationObject(outputPort), entry.Request);
+  entry.Size = 0;
+  int numPorts = outInfoVec->GetNumberOfInformationObjects();
+  entry.Outputs.resize(numPorts);
+  for (int i = 0; i < numPorts; ++i)
+  {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (!data || outInfo->Get(DATA_NOT_GENERATED()))
+    {
+      continue;
+    }
+    Internals::Output& cached = entry.Outputs[i];
+    cached.Data.TakeReference(data->NewInstance());
+    Internals::ShallowCopy(cached.Data, data);
+    vtkInformation* dataInfo = data->GetInformation();
+    cached.Piece = dataInfo->Get(vtkDataObject::DATA_PIECE_NUMBER());
+    cached.NumberOfPieces = dataInfo->Get(vtkDataObject::DATA_NUMBER_OF_PIECES());
+    cached.GhostLevels = dataInfo->Get(vtkDataObject::DATA_NUMBER_OF_GHOST_LEVELS());
+    Internals::GetIndices(outInfo, DATA_COMPOSITE_INDICES(),
+                          cached.HasCompositeIndices, cached.CompositeIndices);
+    entry.Size += data->GetActualMemorySize();
+  }
+
+  // There is no entry for this request, otherwise NeedToExecuteData would
+  // have restored it.
+  this->Internals->Entries.push_front(entry);
+  this->PruneCache();
+  return result;
+}
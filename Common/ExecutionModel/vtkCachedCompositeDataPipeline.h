@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCachedCompositeDataPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCachedCompositeDataPipeline
+ * @brief   executive that remembers the outputs of previous requests
+ *
+ * vtkCachedCompositeDataPipeline keeps a shallow copy of the outputs
+ * produced for each distinct request. When a request is repeated, for
+ * example when scrubbing back and forth through time steps, the outputs are
+ * restored from the cache instead of executing the algorithm, and the
+ * request is not propagated upstream.
+ *
+ * A cached result is identified by the pipeline modified time of the
+ * executive, which covers both the parameters of the algorithm and
+ * everything upstream of it, together with the requested time step,
+ * piece, number of pieces, ghost levels, update extent and composite
+ * indices. Results computed before the pipeline was modified are
+ * discarded.
+ *
+ * Unlike vtkCachedStreamingDemandDrivenPipeline, any data type is cached,
+ * including composite datasets. Cached outputs share their arrays with the
+ * outputs they were copied from, so caching the latest result costs
+ * nothing until the algorithm executes again. The least recently used
+ * results are discarded when the cache grows larger than CacheMemoryLimit.
+ *
+ * @warning
+ * Algorithms that modify the arrays of their previous output in place
+ * instead of allocating new ones would also modify the cached copies.
+ *
+ * @sa
+ * vtkCachedStreamingDemandDrivenPipeline vtkPipelineMemoryBudget
+*/
+
+#ifndef vtkCachedCompositeDataPipeline_h
+#define vtkCachedCompositeDataPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class vtkCachedCompositeDataPipelineInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkCachedCompositeDataPipeline :
+  public vtkCompositeDataPipeline
+{
+public:
+  static vtkCachedCompositeDataPipeline* New();
+  vtkTypeMacro(vtkCachedCompositeDataPipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Maximum total size, in kibibytes, of the cached results. 0 disables
+   * the cache. The default is 262144 (256 MiB).
+   */
+  void SetCacheMemoryLimit(unsigned long limit);
+  vtkGetMacro(CacheMemoryLimit, unsigned long);
+  //@}
+
+  /**
+   * Total size, in kibibytes, of the cached results.
+   */
+  unsigned long GetCacheMemorySize();
+
+  /**
+   * Number of results currently cached.
+   */
+  int GetNumberOfCachedResults();
+
+  /**
+   * Discard all cached results.
+   */
+  void ClearCache();
+
+  //@{
+  /**
+   * Number of requests served from the cache, and number of requests that
+   * executed the algorithm, since the last ResetStatistics().
+   */
+  vtkGetMacro(NumberOfHits, vtkIdType);
+  vtkGetMacro(NumberOfMisses, vtkIdType);
+  void ResetStatistics();
+  //@}
+
+protected:
+  vtkCachedCompositeDataPipeline();
+  ~vtkCachedCompositeDataPipeline() override;
+
+  int NeedToExecuteData(int outputPort,
+                        vtkInformationVector** inInfoVec,
+                        vtkInformationVector* outInfoVec) override;
+  int ExecuteData(vtkInformation* request,
+                  vtkInformationVector** inInfoVec,
+                  vtkInformationVector* outInfoVec) override;
+
+  // Remove results computed before the last pipeline modification, then
+  // the least recently used ones until the cache fits in the limit.
+  void PruneCache();
+
+  unsigned long CacheMemoryLimit;
+  vtkIdType NumberOfHits;
+  vtkIdType NumberOfMisses;
+
+  vtkCachedCompositeDataPipelineInternals* Internals;
+
+private:
+  vtkCachedCompositeDataPipeline(const vtkCachedCompositeDataPipeline&) = delete;
+  void operator=(const vtkCachedCompositeDataPipeline&) = delete;
+};
+
+#endif
@@ -0,0 +1,498 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkExecutionProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the above copyright notice for more information.
+
+  =========================================================================*/
+#include "vtkExecutionProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkAtomic.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataObject.h"
+#include "vtkDataSet.h"
+#include "vtkDemandDrivenPipeline.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkInformationRequestKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSimpleCriticalSection.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkWeakPointer.h"
+
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkExecutionProfiler);
+
+// Read by the executives of every thread while recording. The active
+// profiler holds a reference to itself; changing it or taking a reference
+// to it is serialized by the critical section.
+static vtkAtomic<vtkExecutionProfiler*> vtkExecutionProfilerActiveProfiler(nullptr);
+static vtkSimpleCriticalSection vtkExecutionProfilerActiveLock;
+
+//----------------------------------------------------------------------------
+class vtkExecutionProfilerInternals
+{
+public:
+  struct Event
+  {
+    // The address identifies the algorithm even after it is deleted.
+    vtkAlgorithm* AlgorithmId;
+    vtkWeakPointer<vtkAlgorithm> Algorithm;
+    std::string ClassName;
+    std::string Request;
+    double Start;
+    double Duration;
+    int Thread;
+    unsigned long InputMemorySize;
+    unsigned long OutputMemorySize;
+    int NumberOfOutputArrays;
+  };
+
+  vtkExecutionProfilerInternals() : Origin(-1.0) {}
+
+  // Map the calling thread to a small index. Called with the lock held.
+  int GetThreadIndex()
+  {
+    vtkMultiThreaderIDType id = vtkMultiThreader::GetCurrentThreadID();
+    for (size_t i = 0; i < this->Threads.size(); ++i)
+    {
+      if (vtkMultiThreader::ThreadsEqual(this->Threads[i], id))
+      {
+        return static_cast<int>(i);
+      }
+    }
+    this->Threads.push_back(id);
+    return static_cast<int>(this->Threads.size()) - 1;
+  }
+
+  std::vector<Event> Events;
+  std::vector<vtkMultiThreaderIDType> Threads;
+  // Universal time of the first Start(); event times are relative to it.
+  double Origin;
+  vtkSimpleCriticalSection Lock;
+};
+
+namespace
+{
+//----------------------------------------------------------------------------
+int vtkExecutionProfilerCountArrays(vtkDataObject* dobj)
+{
+  if (!dobj)
+  {
+    return 0;
+  }
+  if (vtkCompositeDataSet* cds = vtkCompositeDataSet::SafeDownCast(dobj))
+  {
+    int count = 0;
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(cds->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      count += vtkExecutionProfilerCountArrays(iter->GetCurrentDataObject());
+    }
+    return count;
+  }
+  int count = dobj->GetFieldData() ? dobj->GetFieldData()->GetNumberOfArrays() : 0;
+  if (vtkDataSet* ds = vtkDataSet::SafeDownCast(dobj))
+  {
+    count += ds->GetPointData()->GetNumberOfArrays();
+    count += ds->GetCellData()->GetNumberOfArrays();
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfilerWriteString(ostream& os, const std::string& str)
+{
+  os << '"';
+  for (size_t i = 0; i < str.size(); ++i)
+  {
+    if (str[i] == '"' || str[i] == '\\')
+    {
+      os << '\\';
+    }
+    os << str[i];
+  }
+  os << '"';
+}
+}
+
+//----------------------------------------------------------------------------
+vtkExecutionProfiler::vtkExecutionProfiler()
+{
+  this->Internals = new vtkExecutionProfilerInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkExecutionProfiler::~vtkExecutionProfiler()
+{
+  this->Stop();
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Recording: " << (this->IsRecording() ? "On" : "Off") << endl;
+  os << indent << "NumberOfEvents: " << this->GetNumberOfEvents() << endl;
+  os << indent << "NumberOfThreads: " << this->GetNumberOfThreads() << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::Start()
+{
+  this->Internals->Lock.Lock();
+  if (this->Internals->Origin < 0.0)
+  {
+    this->Internals->Origin = vtkTimerLog::GetUniversalTime();
+  }
+  this->Internals->Lock.Unlock();
+
+  vtkExecutionProfilerActiveLock.Lock();
+  vtkExecutionProfiler* previous = vtkExecutionProfilerActiveProfiler.load();
+  if (previous != this)
+  {
+    this->Register(nullptr);
+    vtkExecutionProfilerActiveProfiler.store(this);
+  }
+  vtkExecutionProfilerActiveLock.Unlock();
+
+  // Released out of the lock: this may delete the previous profiler,
+  // whose destructor calls Stop().
+  if (previous && previous != this)
+  {
+    previous->UnRegister(nullptr);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::Stop()
+{
+  vtkExecutionProfilerActiveLock.Lock();
+  bool active = vtkExecutionProfilerActiveProfiler.load() == this;
+  if (active)
+  {
+    vtkExecutionProfilerActiveProfiler.store(nullptr);
+  }
+  vtkExecutionProfilerActiveLock.Unlock();
+
+  if (active)
+  {
+    this->UnRegister(nullptr);
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkExecutionProfiler::IsRecording()
+{
+  return vtkExecutionProfilerActiveProfiler.load() == this;
+}
+
+//----------------------------------------------------------------------------
+vtkExecutionProfiler* vtkExecutionProfiler::GetActiveProfiler()
+{
+  return vtkExecutionProfilerActiveProfiler.load();
+}
+
+//----------------------------------------------------------------------------
+vtkExecutionProfiler* vtkExecutionProfiler::NewActiveProfilerReference()
+{
+  if (!vtkExecutionProfilerActiveProfiler.load())
+  {
+    return nullptr;
+  }
+  vtkExecutionProfilerActiveLock.Lock();
+  vtkExecutionProfiler* profiler = vtkExecutionProfilerActiveProfiler.load();
+  if (profiler)
+  {
+    profiler->Register(nullptr);
+  }
+  vtkExecutionProfilerActiveLock.Unlock();
+  return profiler;
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::Clear()
+{
+  this->Internals->Lock.Lock();
+  this->Internals->Events.clear();
+  this->Internals->Threads.clear();
+  this->Internals->Origin =
+    this->IsRecording() ? vtkTimerLog::GetUniversalTime() : -1.0;
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::RecordRequest(vtkAlgorithm* algorithm,
+                                         vtkInformation* request,
+                                         vtkInformationVector** inInfo,
+                                         vtkInformationVector* outInfo,
+                                         double start)
+{
+  double end = vtkTimerLog::GetUniversalTime();
+
+  vtkExecutionProfilerInternals::Event event;
+  event.AlgorithmId = algorithm;
+  event.ClassName = algorithm->GetClassName();
+  vtkInformationRequestKey* requestKey = request->GetRequest();
+  event.Request = requestKey ? requestKey->GetName() : "UNKNOWN_REQUEST";
+  event.Duration = end - start;
+  event.InputMemorySize = 0;
+  event.OutputMemorySize = 0;
+  event.NumberOfOutputArrays = 0;
+
+  // Data sizes are only meaningful once the data has been produced.
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    for (int i = 0; inInfo && i < algorithm->GetNumberOfInputPorts(); ++i)
+    {
+      for (int j = 0; j < inInfo[i]->GetNumberOfInformationObjects(); ++j)
+      {
+        vtkDataObject* input =
+          inInfo[i]->GetInformationObject(j)->Get(vtkDataObject::DATA_OBJECT());
+        event.InputMemorySize += input ? input->GetActualMemorySize() : 0;
+      }
+    }
+    for (int i = 0; outInfo && i < outInfo->GetNumberOfInformationObjects(); ++i)
+    {
+      vtkDataObject* output =
+        outInfo->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+      event.OutputMemorySize += output ? output->GetActualMemorySize() : 0;
+      event.NumberOfOutputArrays += vtkExecutionProfilerCountArrays(output);
+    }
+  }
+
+  this->Internals->Lock.Lock();
+  event.Algorithm = algorithm;
+  event.Start = start - this->Internals->Origin;
+  event.Thread = this->Internals->GetThreadIndex();
+  this->Internals->Events.push_back(event);
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkExecutionProfiler::GetNumberOfEvents()
+{
+  this->Internals->Lock.Lock();
+  vtkIdType value = static_cast<vtkIdType>(this->Internals->Events.size());
+  this->Internals->Lock.Unlock();
+  return value;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkExecutionProfiler::GetEventAlgorithmClassName(vtkIdType event)
+{
+  this->Internals->Lock.Lock();
+  const char* value = this->Internals->Events[event].ClassName.c_str();
+  this->Internals->Lock.Unlock();
+  return value;
+}
+
+//----------------------------------------------------------------------------
+vtkAlgorithm* vtkExecutionProfiler::GetEventAlgorithm(vtkIdType event)
+{
+  this->Internals->Lock.Lock();
+  vtkAlgorithm* value = this->Internals->Events[event].Algorithm;
+  this->Internals->Lock.Unlock();
+  return value;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkExecutionProfiler::GetEventRequestName(vtkIdType event)
+{
+  this->Internals->Lock.Lock();
+  const char* value = this->Internals->Events[event].Request.c_str();
+  this->Internals->Lock.Unlock();
+  return value;
+}
+
+//----------------------------------------------------------------------------
+double vtkExecutionProfiler::GetEventStartTime(vtkIdType event)
+{
+  this->Internals->Lock.Lock();
+  double value = this->Internals->Events[event].Start;
+  this->Internals->Lock.Unlock();
+  return value;
+}
+
+//----------------------------------------------------------------------------
+double vtkExecutionProfiler::GetEventDuration(vtkIdType event)
+{
+  this->Internals->Lock.Lock();
+  double value = this->Internals->Events[event].Duration;
+  this->Internals->Lock.Unlock();
+  return value;
+}
+
+//----------------------------------------------------------------------------
+int vtkExecutionProfiler::GetEventThread(vtkIdType event)
+{
+  this->Internals->Lock.Lock();
+  int value = this->Internals->Events[event].Thread;
+  this->Internals->Lock.Unlock();
+  return value;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkExecutionProfiler::GetEventInputMemorySize(vtkIdType event)
+{
+  this->Internals->Lock.Lock();
+  unsigned long value = this->Internals->Events[event].InputMemorySize;
+  this->Internals->Lock.Unlock();
+  return value;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkExecutionProfiler::GetEventOutputMemorySize(vtkIdType event)
+{
+  this->Internals->Lock.Lock();
+  unsigned long value = this->Internals->Events[event].OutputMemorySize;
+  this->Internals->Lock.Unlock();
+  return value;
+}
+
+//----------------------------------------------------------------------------
+int vtkExecutionProfiler::GetEventNumberOfOutputArrays(vtkIdType event)
+{
+  this->Internals->Lock.Lock();
+  int value = this->Internals->Events[event].NumberOfOutputArrays;
+  this->Internals->Lock.Unlock();
+  return value;
+}
+
+//----------------------------------------------------------------------------
+int vtkExecutionProfiler::GetNumberOfThreads()
+{
+  this->Internals->Lock.Lock();
+  int value = static_cast<int>(this->Internals->Threads.size());
+  this->Internals->Lock.Unlock();
+  return value;
+}
+
+//----------------------------------------------------------------------------
+double vtkExecutionProfiler::GetTotalTime(vtkAlgorithm* algorithm,
+                                          const char* requestName)
+{
+  double total = 0.0;
+  this->Internals->Lock.Lock();
+  std::vector<vtkExecutionProfilerInternals::Event>::const_iterator it;
+  for (it = this->Internals->Events.begin(); it != this->Internals->Events.end(); ++it)
+  {
+    if (it->AlgorithmId == algorithm && (!requestName || it->Request == requestName))
+    {
+      total += it->Duration;
+    }
+  }
+  this->Internals->Lock.Unlock();
+  return total;
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::PrintSummary(ostream& os)
+{
+  // Per algorithm, in order of first appearance: request -> (count, time).
+  typedef std::map<std::string, std::pair<int, double> > RequestTimes;
+  std::vector<vtkAlgorithm*> order;
+  std::map<vtkAlgorithm*, std::string> names;
+  std::map<vtkAlgorithm*, RequestTimes> times;
+  this->Internals->Lock.Lock();
+  std::vector<vtkExecutionProfilerInternals::Event>::const_iterator it;
+  for (it = this->Internals->Events.begin(); it != this->Internals->Events.end(); ++it)
+  {
+    if (names.find(it->AlgorithmId) == names.end())
+    {
+      order.push_back(it->AlgorithmId);
+      names[it->AlgorithmId] = it->ClassName;
+    }
+    std::pair<int, double>& entry = times[it->AlgorithmId][it->Request];
+    entry.first++;
+    entry.second += it->Duration;
+  }
+  this->Internals->Lock.Unlock();
+
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    os << names[order[i]] << " (" << order[i] << ")\n";
+    RequestTimes& requests = times[order[i]];
+    for (RequestTimes::const_iterator r = requests.begin(); r != requests.end(); ++r)
+    {
+      os << "  " << r->first << ": " << r->second.first << " calls, "
+         << r->second.second << " s\n";
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkExecutionProfiler::WriteChromeTrace(const char* fileName)
+{
+  if (!fileName)
+  {
+    vtkErrorMacro("No file name given.");
+    return 0;
+  }
+  ofstream os(fileName);
+  if (!os)
+  {
+    vtkErrorMacro("Could not open " << fileName << " for writing.");
+    return 0;
+  }
+  this->WriteChromeTrace(os);
+  return os.good() ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkExecutionProfiler::WriteChromeTrace(ostream& os)
+{
+  // Complete ("X") events with microsecond timestamps, one lane per thread.
+  // Timestamps are written with a fixed nanosecond precision: the default
+  // six significant digits lose the sub-second part after a few seconds.
+  std::ios::fmtflags flags = os.flags();
+  std::streamsize precision = os.precision();
+  os << std::fixed << std::setprecision(3);
+  os << "{\"traceEvents\":[";
+  this->Internals->Lock.Lock();
+  const std::vector<vtkExecutionProfilerInternals::Event>& events =
+    this->Internals->Events;
+  for (size_t i = 0; i < events.size(); ++i)
+  {
+    const vtkExecutionProfilerInternals::Event& e = events[i];
+    os << (i ? ",\n" : "\n") << "{\"name\":";
+    vtkExecutionProfilerWriteString(os, e.ClassName);
+    os << ",\"cat\":";
+    vtkExecutionProfilerWriteString(os, e.Request);
+    os << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << e.Thread
+       << ",\"ts\":" << 1.0e6 * e.Start
+       << ",\"dur\":" << 1.0e6 * e.Duration
+       << ",\"args\":{\"algorithm\":\"" << static_cast<void*>(e.AlgorithmId) << "\"";
+    if (e.Request == "REQUEST_DATA")
+    {
+      os << ",\"input_kib\":" << e.InputMemorySize
+         << ",\"output_kib\":" << e.OutputMemorySize
+         << ",\"output_arrays\":" << e.NumberOfOutputArrays;
+    }
+    os << "}}";
+  }
+  this->Internals->Lock.Unlock();
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  os.flags(flags);
+  os.precision(precision);
+}
@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkExecutionProfiler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the above copyright notice for more information.
+
+  =========================================================================*/
+/**
+ * @class   vtkExecutionProfiler
+ * @brief   record the pipeline requests executed by every algorithm
+ *
+ * vtkExecutionProfiler collects one event for every pipeline request
+ * (REQUEST_DATA_OBJECT, REQUEST_INFORMATION, REQUEST_UPDATE_EXTENT,
+ * REQUEST_DATA, ...) that an executive passes to its algorithm while the
+ * profiler is recording. Each event holds the algorithm, the request, the
+ * start time and duration, the thread that executed it and, for
+ * REQUEST_DATA, the memory size of the inputs and outputs and the number
+ * of arrays in the outputs.
+ *
+ * Only one profiler records at a time. Call Start() to make it the
+ * active profiler and Stop() to end recording. The active profiler is
+ * referenced until it is stopped or replaced, and the executives hold a
+ * reference to it while the algorithm runs, so it may be stopped or
+ * deleted from another thread. When no profiler is active, executives
+ * only test a single pointer, so instrumentation costs nothing in normal
+ * use.
+ *
+ * Events are recorded from whatever thread executes the algorithm, so
+ * threaded executives such as vtkThreadedCompositeDataPipeline and
+ * vtkThreadedBranchPipeline show up as work spread over several threads.
+ * The events can be printed as a per-algorithm summary or written in the
+ * Chrome trace event format, to be loaded in chrome://tracing or Perfetto.
+ *
+ * @sa
+ * vtkExecutive vtkTimerLog
+*/
+
+#ifndef vtkExecutionProfiler_h
+#define vtkExecutionProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAlgorithm;
+class vtkExecutionProfilerInternals;
+class vtkInformation;
+class vtkInformationVector;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkExecutionProfiler : public vtkObject
+{
+public:
+  static vtkExecutionProfiler* New();
+  vtkTypeMacro(vtkExecutionProfiler, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Start and stop recording. Start() makes this profiler the active one,
+   * replacing any other profiler that was recording. The active profiler
+   * holds a reference to itself until Stop(). Events recorded earlier are
+   * kept; use Clear() to discard them.
+   */
+  void Start();
+  void Stop();
+  int IsRecording();
+  //@}
+
+  /**
+   * Return the profiler currently recording, or nullptr. This is called by
+   * the executives of every thread, and can be called while another thread
+   * starts or stops a profiler.
+   */
+  static vtkExecutionProfiler* GetActiveProfiler();
+
+  /**
+   * Return a new reference to the profiler currently recording, or
+   * nullptr. The caller must UnRegister() it. The executives use this to
+   * keep the profiler alive while the algorithm they record runs.
+   */
+  static vtkExecutionProfiler* NewActiveProfilerReference();
+
+  /**
+   * Discard all recorded events.
+   */
+  void Clear();
+
+  //@{
+  /**
+   * Access the recorded events. Times are in seconds, relative to the
+   * first call to Start() after construction or Clear(). Memory sizes are
+   * in kibibytes, as returned by vtkDataObject::GetActualMemorySize(), and
+   * are only recorded for REQUEST_DATA. Threads are numbered from 0 in the
+   * order in which they first executed a request.
+   * The strings returned are only valid while no event is recorded, that
+   * is after Stop() or with no pipeline running. GetEventAlgorithm()
+   * returns nullptr once the algorithm has been deleted.
+   */
+  vtkIdType GetNumberOfEvents();
+  const char* GetEventAlgorithmClassName(vtkIdType event);
+  vtkAlgorithm* GetEventAlgorithm(vtkIdType event);
+  const char* GetEventRequestName(vtkIdType event);
+  double GetEventStartTime(vtkIdType event);
+  double GetEventDuration(vtkIdType event);
+  int GetEventThread(vtkIdType event);
+  unsigned long GetEventInputMemorySize(vtkIdType event);
+  unsigned long GetEventOutputMemorySize(vtkIdType event);
+  int GetEventNumberOfOutputArrays(vtkIdType event);
+  //@}
+
+  /**
+   * Number of distinct threads that executed recorded requests.
+   */
+  int GetNumberOfThreads();
+
+  /**
+   * Total time spent by the given algorithm in requests with the given
+   * name (e.g. "REQUEST_DATA"), or in all requests if name is nullptr.
+   */
+  double GetTotalTime(vtkAlgorithm* algorithm, const char* requestName);
+
+  /**
+   * Print, for every algorithm, the number of executions and the time
+   * spent per request type.
+   */
+  void PrintSummary(ostream& os);
+
+  //@{
+  /**
+   * Write the events in the Chrome trace event JSON format. Returns 0 if
+   * the file could not be written.
+   */
+  int WriteChromeTrace(const char* fileName);
+  void WriteChromeTrace(ostream& os);
+  //@}
+
+  /**
+   * Record the execution of a request. Called by the executives after the
+   * algorithm returns; start is the vtkTimerLog::GetUniversalTime() value
+   * sampled before the algorithm was invoked.
+   */
+  void RecordRequest(vtkAlgorithm* algorithm, vtkInformation* request,
+                     vtkInformationVector** inInfo,
+                     vtkInformationVector* outInfo, double start);
+
+protected:
+  vtkExecutionProfiler();
+  ~vtkExecutionProfiler() override;
+
+  vtkExecutionProfilerInternals* Internals;
+
+private:
+  vtkExecutionProfiler(const vtkExecutionProfiler&) = delete;
+  void operator=(const vtkExecutionProfiler&) = delete;
+};
+
+#endif
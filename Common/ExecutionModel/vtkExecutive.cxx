@@ -17,6 +17,7 @@
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
 #include "vtkDataObject.h"
+#include "vtkExecutionProfiler.h"
 #include "vtkGarbageCollector.h"
 #include "vtkInformation.h"
 #include "vtkInformationExecutivePortKey.h"
@@ -27,6 +28,7 @@
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
 
 #include <vector>
 #include <sstream>
@@ -771,9 +773,17 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
   // Invoke the request on the algorithm.
+  // The reference keeps the profiler alive if it is stopped meanwhile.
+  vtkSmartPointer<vtkExecutionProfiler> profiler;
+  profiler.TakeReference(vtkExecutionProfiler::NewActiveProfilerReference());
+  double start = profiler ? vtkTimerLog::GetUniversalTime() : 0.0;
   this->InAlgorithm = 1;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
   this->InAlgorithm = 0;
+  if(profiler)
+  {
+    profiler->RecordRequest(this->Algorithm, request, inInfo, outInfo, start);
+  }
 
   // If the algorithm failed report it now.
   if(!result)
@@ -0,0 +1,306 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineMemoryBudget.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the above copyright notice for more information.
+
+  =========================================================================*/
+#include "vtkPipelineMemoryBudget.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkAtomic.h"
+#include "vtkDataObject.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortVectorKey.h"
+#include "vtkObjectFactory.h"
+#include "vtkSimpleCriticalSection.h"
+#include "vtkTrivialProducer.h"
+
+#include <map>
+#include <vector>
+
+vtkStandardNewMacro(vtkPipelineMemoryBudget);
+
+// Read by the executives of every thread.
+static vtkAtomic<vtkPipelineMemoryBudget*> vtkPipelineMemoryBudgetActiveBudget(nullptr);
+
+//----------------------------------------------------------------------------
+class vtkPipelineMemoryBudgetInternals
+{
+public:
+  struct Entry
+  {
+    Entry() : LastUse(0), Evicted(false) {}
+
+    // Size in KiB of each output port; 0 for outputs that are not held or
+    // do not feed another algorithm.
+    std::vector<unsigned long> Sizes;
+    vtkIdType LastUse;
+    // The outputs were released by the budget and not regenerated yet.
+    bool Evicted;
+
+    unsigned long GetSize() const
+    {
+      unsigned long size = 0;
+      for (size_t i = 0; i < this->Sizes.size(); ++i)
+      {
+        size += this->Sizes[i];
+      }
+      return size;
+    }
+  };
+  typedef std::map<vtkExecutive*, Entry> EntriesType;
+
+  vtkPipelineMemoryBudgetInternals() : Depth(0), Clock(0) {}
+
+  EntriesType Entries;
+  // Nesting level of REQUEST_DATA passes; the budget is enforced when the
+  // outermost one completes.
+  int Depth;
+  vtkIdType Clock;
+  vtkSimpleCriticalSection Lock;
+};
+
+//----------------------------------------------------------------------------
+vtkPipelineMemoryBudget::vtkPipelineMemoryBudget()
+{
+  this->MaximumMemorySize = 0;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+  this->Internals = new vtkPipelineMemoryBudgetInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineMemoryBudget::~vtkPipelineMemoryBudget()
+{
+  this->Deactivate();
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumMemorySize: " << this->MaximumMemorySize << endl;
+  os << indent << "Active: " << (this->IsActive() ? "On" : "Off") << endl;
+  os << indent << "TotalMemorySize: " << this->GetTotalMemorySize() << endl;
+  os << indent << "NumberOfHits: " << this->NumberOfHits << endl;
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << endl;
+  os << indent << "NumberOfEvictions: " << this->NumberOfEvictions << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::Activate()
+{
+  vtkPipelineMemoryBudget* active = vtkPipelineMemoryBudgetActiveBudget.load();
+  if (active == this)
+  {
+    return;
+  }
+  if (active)
+  {
+    active->Deactivate();
+  }
+  vtkPipelineMemoryBudgetActiveBudget.store(this);
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::Deactivate()
+{
+  if (vtkPipelineMemoryBudgetActiveBudget.load() != this)
+  {
+    return;
+  }
+  vtkPipelineMemoryBudgetActiveBudget.store(nullptr);
+  // Executives are not tracked while inactive, so the entries could
+  // become dangling.
+  this->Internals->Lock.Lock();
+  this->Internals->Entries.clear();
+  this->Internals->Depth = 0;
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineMemoryBudget::IsActive()
+{
+  return vtkPipelineMemoryBudgetActiveBudget.load() == this;
+}
+
+//----------------------------------------------------------------------------
+vtkPipelineMemoryBudget* vtkPipelineMemoryBudget::GetActiveBudget()
+{
+  return vtkPipelineMemoryBudgetActiveBudget.load();
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPipelineMemoryBudget::GetTotalMemorySize()
+{
+  unsigned long total = 0;
+  this->Internals->Lock.Lock();
+  vtkPipelineMemoryBudgetInternals::EntriesType::const_iterator it;
+  for (it = this->Internals->Entries.begin(); it != this->Internals->Entries.end(); ++it)
+  {
+    total += it->second.GetSize();
+  }
+  this->Internals->Lock.Unlock();
+  return total;
+}
+
+//----------------------------------------------------------------------------
+int vtkPipelineMemoryBudget::GetNumberOfCachedOutputs()
+{
+  int count = 0;
+  this->Internals->Lock.Lock();
+  vtkPipelineMemoryBudgetInternals::EntriesType::const_iterator it;
+  for (it = this->Internals->Entries.begin(); it != this->Internals->Entries.end(); ++it)
+  {
+    for (size_t i = 0; i < it->second.Sizes.size(); ++i)
+    {
+      count += it->second.Sizes[i] > 0 ? 1 : 0;
+    }
+  }
+  this->Internals->Lock.Unlock();
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::BeginRequestData()
+{
+  this->Internals->Lock.Lock();
+  this->Internals->Depth++;
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::EndRequestData(vtkExecutive* executive, int executed)
+{
+  this->Internals->Lock.Lock();
+  vtkPipelineMemoryBudgetInternals::Entry& entry = this->Internals->Entries[executive];
+  if (executed)
+  {
+    if (entry.Evicted)
+    {
+      this->NumberOfMisses++;
+      entry.Evicted = false;
+    }
+    // Only outputs consumed by another algorithm are intermediate results,
+    // and only the ones the algorithm regenerates from its inputs may be
+    // released: the data given to a vtkTrivialProducer with SetInputData(),
+    // or held by a source, could not be restored.
+    int numPorts = executive->GetNumberOfOutputPorts();
+    entry.Sizes.assign(numPorts, 0);
+    vtkAlgorithm* algorithm = executive->GetAlgorithm();
+    bool regenerable = algorithm && algorithm->GetNumberOfInputPorts() > 0 &&
+      !vtkTrivialProducer::SafeDownCast(algorithm);
+    for (int i = 0; i < numPorts && regenerable; ++i)
+    {
+      vtkInformation* outInfo = executive->GetOutputInformation(i);
+      vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+      if (data && vtkExecutive::CONSUMERS()->Length(outInfo) > 0)
+      {
+        entry.Sizes[i] = data->GetActualMemorySize();
+      }
+    }
+  }
+  else if (entry.GetSize() > 0)
+  {
+    this->NumberOfHits++;
+  }
+  entry.LastUse = ++this->Internals->Clock;
+
+  bool done = this->Internals->Depth <= 1;
+  if (this->Internals->Depth > 0)
+  {
+    this->Internals->Depth--;
+  }
+  this->Internals->Lock.Unlock();
+
+  if (done)
+  {
+    this->Enforce(executive);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::RemoveExecutive(vtkExecutive* executive)
+{
+  this->Internals->Lock.Lock();
+  this->Internals->Entries.erase(executive);
+  this->Internals->Lock.Unlock();
+}
+
+//----------------------------------------------------------------------------
+void vtkPipelineMemoryBudget::Enforce(vtkExecutive* keep)
+{
+  if (this->MaximumMemorySize == 0)
+  {
+    return;
+  }
+
+  typedef vtkPipelineMemoryBudgetInternals::EntriesType EntriesType;
+  this->Internals->Lock.Lock();
+  EntriesType& entries = this->Internals->Entries;
+  unsigned long total = 0;
+  for (EntriesType::const_iterator it = entries.begin(); it != entries.end(); ++it)
+  {
+    total += it->second.GetSize();
+  }
+
+  while (total > this->MaximumMemorySize)
+  {
+    // Find the least recently used executive still holding outputs.
+    EntriesType::iterator lru = entries.end();
+    for (EntriesType::iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+      if (it->first != keep && it->second.GetSize() > 0 &&
+          (lru == entries.end() || it->second.LastUse < lru->second.LastUse))
+      {
+        lru = it;
+      }
+    }
+    if (lru == entries.end())
+    {
+      break;
+    }
+
+    vtkExecutive* executive = lru->first;
+    vtkPipelineMemoryBudgetInternals::Entry& entry = lru->second;
+    for (size_t i = 0; i < entry.Sizes.size(); ++i)
+    {
+      if (entry.Sizes[i] == 0)
+      {
+        continue;
+      }
+      vtkDataObject* data = executive->GetOutputInformation(
+        static_cast<int>(i))->Get(vtkDataObject::DATA_OBJECT());
+      if (data)
+      {
+        // Same as the release data flag: the executive regenerates
+        // released outputs on the next request.
+        data->ReleaseData();
+      }
+      total -= entry.Sizes[i];
+      entry.Sizes[i] = 0;
+    }
+    entry.Evicted = true;
+    this->NumberOfEvictions++;
+  }
+  this->Internals->Lock.Unlock();
+}
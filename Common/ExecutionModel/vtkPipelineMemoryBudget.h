@@ -0,0 +1,140 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineMemoryBudget.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the above copyright notice for more information.
+
+  =========================================================================*/
+/**
+ * @class   vtkPipelineMemoryBudget
+ * @brief   bound the memory held by intermediate pipeline outputs
+ *
+ * By default every algorithm keeps its output until it re-executes. The
+ * only alternative is the release data flag, which releases an output as
+ * soon as it has been consumed. vtkPipelineMemoryBudget sits between the
+ * two: while it is active, vtkStreamingDemandDrivenPipeline reports the
+ * size of every intermediate output (an output that feeds another
+ * algorithm) after each REQUEST_DATA, and once an update completes the
+ * least recently used intermediate outputs are released until their total
+ * size fits in MaximumMemorySize. A released output is regenerated the
+ * next time a consumer needs it, exactly as with the release data flag.
+ *
+ * Outputs that do not feed any algorithm, and the outputs of the algorithm
+ * that was updated, are never released. Only the outputs of algorithms
+ * with input ports are tracked, since they are regenerated from their
+ * inputs: the outputs of sources and of vtkTrivialProducer (the data given
+ * with SetInputData()) are kept. Outputs of executives that are not
+ * vtkStreamingDemandDrivenPipeline (or a subclass) are not tracked either.
+ *
+ * The budget also counts cache hits (a consumer re-executed and found the
+ * intermediate output still valid), misses (an output released by the
+ * budget had to be regenerated) and evictions.
+ *
+ * Only one budget is active at a time.
+ *
+ * @sa
+ * vtkDemandDrivenPipeline::SetReleaseDataFlag vtkDataObject::GetActualMemorySize
+*/
+
+#ifndef vtkPipelineMemoryBudget_h
+#define vtkPipelineMemoryBudget_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkExecutive;
+class vtkPipelineMemoryBudgetInternals;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineMemoryBudget : public vtkObject
+{
+public:
+  static vtkPipelineMemoryBudget* New();
+  vtkTypeMacro(vtkPipelineMemoryBudget, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Maximum total size, in kibibytes, of the intermediate outputs kept
+   * after an update. 0 means no limit; sizes and statistics are still
+   * tracked. The default is 0.
+   */
+  vtkSetMacro(MaximumMemorySize, unsigned long);
+  vtkGetMacro(MaximumMemorySize, unsigned long);
+  //@}
+
+  //@{
+  /**
+   * Make this budget the active one, or stop tracking outputs. Activating
+   * a budget deactivates the previously active one.
+   */
+  void Activate();
+  void Deactivate();
+  int IsActive();
+  //@}
+
+  /**
+   * Return the active budget, or nullptr.
+   */
+  static vtkPipelineMemoryBudget* GetActiveBudget();
+
+  /**
+   * Total size, in kibibytes, of the intermediate outputs currently held.
+   */
+  unsigned long GetTotalMemorySize();
+
+  /**
+   * Number of intermediate outputs currently held.
+   */
+  int GetNumberOfCachedOutputs();
+
+  //@{
+  /**
+   * Statistics since activation or the last ResetStatistics().
+   */
+  vtkGetMacro(NumberOfHits, vtkIdType);
+  vtkGetMacro(NumberOfMisses, vtkIdType);
+  vtkGetMacro(NumberOfEvictions, vtkIdType);
+  void ResetStatistics();
+  //@}
+
+  /**
+   * Release least recently used intermediate outputs until the total size
+   * fits in MaximumMemorySize. The outputs of the given executive are
+   * kept. This is done automatically at the end of every update.
+   */
+  void Enforce(vtkExecutive* keep);
+
+  //@{
+  /**
+   * Called by vtkStreamingDemandDrivenPipeline around the processing of
+   * REQUEST_DATA. executed tells whether the algorithm executed.
+   */
+  void BeginRequestData();
+  void EndRequestData(vtkExecutive* executive, int executed);
+  void RemoveExecutive(vtkExecutive* executive);
+  //@}
+
+protected:
+  vtkPipelineMemoryBudget();
+  ~vtkPipelineMemoryBudget() override;
+
+  unsigned long MaximumMemorySize;
+  vtkIdType NumberOfHits;
+  vtkIdType NumberOfMisses;
+  vtkIdType NumberOfEvictions;
+
+  vtkPipelineMemoryBudgetInternals* Internals;
+
+private:
+  vtkPipelineMemoryBudget(const vtkPipelineMemoryBudget&) = delete;
+  void operator=(const vtkPipelineMemoryBudget&) = delete;
+};
+
+#endif
@@ -36,6 +36,7 @@
 #include "vtkInformationUnsignedLongKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineMemoryBudget.h"
 #include "vtkSmartPointer.h"
 #include "vtkNew.h"
 
@@ -95,16 +96,30 @@ vtkStreamingDemandDrivenPipeline::vtkStreamingDemandDrivenPipeline()
 {
   this->ContinueExecuting = 0;
   this->UpdateExtentRequest = nullptr;
+  this->UpdateTimeRequest = nullptr;
+  this->TimeDependentInformationRequest = nullptr;
   this->LastPropogateUpdateExtentShortCircuited = 0;
 }
 
 //----------------------------------------------------------------------------
 vtkStreamingDemandDrivenPipeline::~vtkStreamingDemandDrivenPipeline()
 {
+  if (vtkPipelineMemoryBudget* budget = vtkPipelineMemoryBudget::GetActiveBudget())
+  {
+    budget->RemoveExecutive(this);
+  }
   if (this->UpdateExtentRequest)
   {
     this->UpdateExtentRequest->Delete();
   }
+  if (this->UpdateTimeRequest)
+  {
+    this->UpdateTimeRequest->Delete();
+  }
+  if (this->TimeDependentInformationRequest)
+  {
+    this->TimeDependentInformationRequest->Delete();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -324,8 +339,18 @@ int vtkStreamingDemandDrivenPipeline
 
   if(request->Has(REQUEST_DATA()))
   {
+    // Report the outputs to the memory budget, if any. Whether the
+    // algorithm executed is told by the data time.
+    vtkPipelineMemoryBudget* budget = vtkPipelineMemoryBudget::GetActiveBudget();
+    vtkMTimeType dataTime = this->DataTime.GetMTime();
+    if(budget)
+    {
+      budget->BeginRequestData();
+    }
+
     // Let the superclass handle the request first.
-    if(this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec))
+    int result = this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+    if(result)
     {
       for(int i=0; i < outInfoVec->GetNumberOfInformationObjects(); ++i)
       {
@@ -344,9 +369,12 @@ int vtkStreamingDemandDrivenPipeline
           info->Set(COMBINED_UPDATE_EXTENT(), emptyExt, 6);
         }
       }
-      return 1;
     }
-    return 0;
+    if(budget)
+    {
+      budget->EndRequestData(this, this->DataTime.GetMTime() != dataTime);
+    }
+    return result ? 1 : 0;
   }
 
   // Let the superclass handle other requests.
@@ -737,22 +765,21 @@ int vtkStreamingDemandDrivenPipeline::PropagateTime(int outputPort)
     return 0;
   }
 
-  // Setup the request for update extent propagation.
-  vtkSmartPointer<vtkInformation> updateTimeRequest = vtkSmartPointer<vtkInformation>::New();
-
-  //if (!this->UpdateExtentRequest)
+  // Setup the request for update time propagation.
+  if (!this->UpdateTimeRequest)
   {
-    updateTimeRequest->Set(REQUEST_UPDATE_TIME());
+    this->UpdateTimeRequest = vtkInformation::New();
+    this->UpdateTimeRequest->Set(REQUEST_UPDATE_TIME());
     // The request is forwarded upstream through the pipeline.
-    updateTimeRequest->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
+    this->UpdateTimeRequest->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
     // Algorithms process this request before it is forwarded.
-    updateTimeRequest->Set(vtkExecutive::ALGORITHM_BEFORE_FORWARD(), 1);
+    this->UpdateTimeRequest->Set(vtkExecutive::ALGORITHM_BEFORE_FORWARD(), 1);
   }
 
-  updateTimeRequest->Set(FROM_OUTPUT_PORT(), outputPort);
+  this->UpdateTimeRequest->Set(FROM_OUTPUT_PORT(), outputPort);
 
   // Send the request.
-  return this->ProcessRequest(updateTimeRequest,
+  return this->ProcessRequest(this->UpdateTimeRequest,
                               this->GetInputInformation(),
                               this->GetOutputInformation());
 }
@@ -766,17 +793,20 @@ int vtkStreamingDemandDrivenPipeline::UpdateTimeDependentInformation(int port)
     return 0;
   }
   // Setup the request for information.
-  vtkSmartPointer<vtkInformation> timeRequest = vtkSmartPointer<vtkInformation>::New();
-  timeRequest->Set(REQUEST_TIME_DEPENDENT_INFORMATION());
-  // The request is forwarded upstream through the pipeline.
-  timeRequest->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
-  // Algorithms process this request after it is forwarded.
-  timeRequest->Set(vtkExecutive::ALGORITHM_AFTER_FORWARD(), 1);
+  if (!this->TimeDependentInformationRequest)
+  {
+    this->TimeDependentInformationRequest = vtkInformation::New();
+    this->TimeDependentInformationRequest->Set(REQUEST_TIME_DEPENDENT_INFORMATION());
+    // The request is forwarded upstream through the pipeline.
+    this->TimeDependentInformationRequest->Set(vtkExecutive::FORWARD_DIRECTION(), vtkExecutive::RequestUpstream);
+    // Algorithms process this request after it is forwarded.
+    this->TimeDependentInformationRequest->Set(vtkExecutive::ALGORITHM_AFTER_FORWARD(), 1);
+  }
 
-  timeRequest->Set(FROM_OUTPUT_PORT(), port);
+  this->TimeDependentInformationRequest->Set(FROM_OUTPUT_PORT(), port);
 
   // Send the request.
-  return this->ProcessRequest(timeRequest,
+  return this->ProcessRequest(this->TimeDependentInformationRequest,
                               this->GetInputInformation(),
                               this->GetOutputInformation());
 }
@@ -317,7 +317,10 @@ protected:
   // request.
   int ContinueExecuting;
 
+  // Requests reused by every update instead of being rebuilt each time.
   vtkInformation *UpdateExtentRequest;
+  vtkInformation *UpdateTimeRequest;
+  vtkInformation *TimeDependentInformationRequest;
 
   // did the most recent PUE do anything ?
   int LastPropogateUpdateExtentShortCircuited;
@@ -0,0 +1,233 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedBranchPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the above copyright notice for more information.
+
+  =========================================================================*/
+#include "vtkThreadedBranchPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkGarbageCollector.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationExecutivePortVectorKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <set>
+#include <vector>
+
+vtkStandardNewMacro(vtkThreadedBranchPipeline);
+
+namespace
+{
+// Collect the executive, the data objects it produces and everything
+// connected to it, upstream through its inputs and downstream through the
+// consumers of its outputs. The walk does not go through the executive
+// doing the fan-in, so that the branches it feeds can be compared.
+void vtkThreadedBranchPipelineCollect(vtkExecutive* e, vtkExecutive* fanIn,
+                                      std::set<vtkObjectBase*>& objects)
+{
+  if (!e || e == fanIn || !objects.insert(e).second)
+  {
+    return;
+  }
+  vtkAlgorithm* algorithm = e->GetAlgorithm();
+  for (int i = 0; i < e->GetNumberOfInputPorts(); ++i)
+  {
+    vtkInformationVector* inVector = e->GetInputInformation(i);
+    int nic = algorithm->GetNumberOfInputConnections(i);
+    for (int j = 0; j < nic && inVector; ++j)
+    {
+      vtkExecutive* producer;
+      int producerPort;
+      vtkExecutive::PRODUCER()->Get(inVector->GetInformationObject(j), producer, producerPort);
+      vtkThreadedBranchPipelineCollect(producer, fanIn, objects);
+    }
+  }
+  for (int i = 0; i < e->GetNumberOfOutputPorts(); ++i)
+  {
+    vtkInformation* outInfo = e->GetOutputInformation(i);
+    if (vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT()))
+    {
+      objects.insert(data);
+    }
+    vtkExecutive** consumers = vtkExecutive::CONSUMERS()->GetExecutives(outInfo);
+    int consumerCount = vtkExecutive::CONSUMERS()->Length(outInfo);
+    for (int j = 0; j < consumerCount; ++j)
+    {
+      vtkThreadedBranchPipelineCollect(consumers[j], fanIn, objects);
+    }
+  }
+}
+
+struct vtkThreadedBranchPipelineBranch
+{
+  vtkExecutive* Executive;
+  vtkSmartPointer<vtkInformation> Request;
+  int Result;
+};
+
+class vtkThreadedBranchPipelineFunctor
+{
+public:
+  std::vector<vtkThreadedBranchPipelineBranch>* Branches;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkThreadedBranchPipelineBranch& branch = (*this->Branches)[i];
+      vtkExecutive* e = branch.Executive;
+      branch.Result = e->ProcessRequest(branch.Request,
+                                        e->GetInputInformation(),
+                                        e->GetOutputInformation());
+    }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+vtkThreadedBranchPipeline::vtkThreadedBranchPipeline()
+{
+  this->ConcurrentBranches = 1;
+  this->NumberOfConcurrentBranches = 0;
+  this->UpdatingBranches = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkThreadedBranchPipeline::~vtkThreadedBranchPipeline()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedBranchPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ConcurrentBranches: " << this->ConcurrentBranches << endl;
+  os << indent << "NumberOfConcurrentBranches: "
+     << this->NumberOfConcurrentBranches << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkThreadedBranchPipeline::ReportReferences(vtkGarbageCollector* collector)
+{
+  if (this->UpdatingBranches)
+  {
+    vtkGarbageCollectorReport(collector, this->Algorithm, "Algorithm");
+    this->vtkObject::ReportReferences(collector);
+    return;
+  }
+  this->Superclass::ReportReferences(collector);
+}
+
+//----------------------------------------------------------------------------
+int vtkThreadedBranchPipeline::ForwardUpstream(vtkInformation* request)
+{
+  if (!this->ConcurrentBranches || this->SharedInputInformation ||
+      !request->Has(REQUEST_DATA()))
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  // Find the producers of all input connections and the sub-pipelines
+  // connected to them. Branches can only run concurrently if they share no
+  // executive and no data object, and if nothing but this executive links
+  // them: information objects are not thread safe, and a garbage collection
+  // check started in one branch walks every object reachable from it.
+  std::vector<vtkThreadedBranchPipelineBranch> branches;
+  std::vector<int> producerPorts;
+  bool independent = true;
+  std::set<vtkObjectBase*> seen;
+  for (int i = 0; i < this->GetNumberOfInputPorts(); ++i)
+  {
+    int nic = this->Algorithm->GetNumberOfInputConnections(i);
+    vtkInformationVector* inVector = this->GetInputInformation()[i];
+    for (int j = 0; j < nic; ++j)
+    {
+      vtkExecutive* e;
+      int producerPort;
+      vtkExecutive::PRODUCER()->Get(inVector->GetInformationObject(j), e, producerPort);
+      if (!e)
+      {
+        continue;
+      }
+      if (independent)
+      {
+        std::set<vtkObjectBase*> branchObjects;
+        vtkThreadedBranchPipelineCollect(e, this, branchObjects);
+        for (std::set<vtkObjectBase*>::iterator it = branchObjects.begin();
+             it != branchObjects.end() && independent; ++it)
+        {
+          independent = seen.insert(*it).second;
+        }
+      }
+      vtkThreadedBranchPipelineBranch branch;
+      branch.Executive = e;
+      branch.Result = 1;
+      branches.push_back(branch);
+      producerPorts.push_back(producerPort);
+    }
+  }
+
+  this->NumberOfConcurrentBranches = 0;
+  if (!independent || branches.size() < 2)
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  if (!this->Algorithm->ModifyRequest(request, BeforeForward))
+  {
+    return 0;
+  }
+
+  // Each branch gets its own request since executives record the port the
+  // request came from in it. The request key is not one of the copied
+  // entries and has to be set explicitly.
+  for (size_t b = 0; b < branches.size(); ++b)
+  {
+    branches[b].Request = vtkSmartPointer<vtkInformation>::New();
+    branches[b].Request->Copy(request);
+    branches[b].Request->SetRequest(request->GetRequest());
+    branches[b].Request->Set(FROM_OUTPUT_PORT(), producerPorts[b]);
+  }
+
+  // The branches are only linked through this executive now. Hide its
+  // information from the garbage collector while they run, so that a check
+  // started in one branch does not walk the information of the others.
+  // Not reporting references only makes the collector more conservative.
+  vtkThreadedBranchPipelineFunctor functor;
+  functor.Branches = &branches;
+  this->UpdatingBranches = 1;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(branches.size()), 1, functor);
+  this->UpdatingBranches = 0;
+  this->NumberOfConcurrentBranches = static_cast<int>(branches.size());
+
+  int result = 1;
+  for (size_t b = 0; b < branches.size(); ++b)
+  {
+    if (!branches[b].Result)
+    {
+      result = 0;
+    }
+  }
+
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+  {
+    return 0;
+  }
+
+  return result;
+}
@@ -0,0 +1,94 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedBranchPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even
+  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the above copyright notice for more information.
+
+  =========================================================================*/
+/**
+ * @class   vtkThreadedBranchPipeline
+ * @brief   Executive that updates independent inputs concurrently
+ *
+ * vtkThreadedBranchPipeline behaves like vtkCompositeDataPipeline except
+ * for the REQUEST_DATA pass. When an algorithm has several input
+ * connections, the executive collects the upstream sub-pipeline of every
+ * connection, with the consumers of their outputs. If these sub-pipelines
+ * share no executive and no data object, they cannot touch the same
+ * algorithm, information or data objects, and they are updated
+ * concurrently with vtkSMPTools, each with its own copy of the request.
+ * Branches that share an executive (for example two connections to the
+ * same reader, or a filter consuming the output of two branches) or a data
+ * object (for example the same data set given to two filters with
+ * SetInputData()) are updated one after the other as before. While the
+ * branches run, this executive only reports its algorithm to the garbage
+ * collector, so that a collection check started in one branch cannot walk
+ * the objects of the others.
+ *
+ * A fan-in filter such as vtkAppendPolyData fed by several readers then
+ * reads all its inputs at the same time. Only the executives of the
+ * fan-in algorithm need to be of this type; the branches themselves are
+ * executed by whatever executive they use, and can themselves be
+ * vtkThreadedBranchPipeline instances to expose nested parallelism.
+ *
+ * Algorithms in the branches must not rely on shared global state, and
+ * observers of their events are invoked from worker threads.
+ *
+ * @sa
+ * vtkThreadedCompositeDataPipeline vtkSMPTools
+*/
+
+#ifndef vtkThreadedBranchPipeline_h
+#define vtkThreadedBranchPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkThreadedBranchPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkThreadedBranchPipeline* New();
+  vtkTypeMacro(vtkThreadedBranchPipeline,vtkCompositeDataPipeline);
+  void PrintSelf(ostream &os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get whether independent branches are updated concurrently. When
+   * off, this executive behaves exactly like vtkCompositeDataPipeline.
+   * On by default.
+   */
+  vtkSetMacro(ConcurrentBranches, int);
+  vtkGetMacro(ConcurrentBranches, int);
+  vtkBooleanMacro(ConcurrentBranches, int);
+  //@}
+
+  /**
+   * Return the number of branches that were updated concurrently by the
+   * last REQUEST_DATA pass through this executive.
+   */
+  vtkGetMacro(NumberOfConcurrentBranches, int);
+
+protected:
+  vtkThreadedBranchPipeline();
+  ~vtkThreadedBranchPipeline() override;
+
+  int ForwardUpstream(vtkInformation* request) override;
+
+  void ReportReferences(vtkGarbageCollector*) override;
+
+  int ConcurrentBranches;
+  int NumberOfConcurrentBranches;
+  int UpdatingBranches;
+
+private:
+  vtkThreadedBranchPipeline(const vtkThreadedBranchPipeline&) = delete;
+  void operator=(const vtkThreadedBranchPipeline&) = delete;
+};
+
+#endif
@@ -17,6 +17,7 @@
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkExecutionProfiler.h"
 #include "vtkExecutive.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -29,6 +30,8 @@
 
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataSet.h"
+#include "vtkTable.h"
 #include "vtkTimerLog.h"
 #include "vtkNew.h"
 #include "vtkSmartPointer.h"
@@ -41,11 +44,13 @@
 #include "vtkSMPTools.h"
 #include "vtkSMPProgressObserver.h"
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkThreadedCompositeDataPipeline);
+vtkInformationKeyMacro(vtkThreadedCompositeDataPipeline, ALGORITHM_IS_REENTRANT, Integer);
 
 //----------------------------------------------------------------------------
 namespace
@@ -129,7 +134,8 @@ public:
       CompositePort(compositePort),
       Connection(connection),
       Request(request),
-      InObjs(inObjs)
+      InObjs(inObjs),
+      Order(nullptr)
   {
     int numInputPorts = this->Exec->GetNumberOfInputPorts();
     this->OutObjs = &outObjs[0];
@@ -183,8 +189,9 @@ public:
     vtkInformation* inInfo = inInfoVec[this->CompositePort]->GetInformationObject(this->Connection);
     vtkInformation* outInfo = outInfoVec->GetInformationObject(0);
 
-    for(vtkIdType i= begin; i<end; ++i)
+    for(vtkIdType k= begin; k<end; ++k)
     {
+      vtkIdType i = this->Order ? (*this->Order)[k] : k;
       vtkDataObject* outObj =
         this->Exec->ExecuteSimpleAlgorithmForBlock(&inInfoVec[0],
                                                    outInfoVec,
@@ -200,6 +207,12 @@ public:
   {
   }
 
+  // Optional permutation of InObjs giving the processing order.
+  void SetOrder(const std::vector<vtkIdType>* order)
+  {
+    this->Order = order;
+  }
+
 protected:
   vtkThreadedCompositeDataPipeline* Exec;
   vtkInformationVector** InInfoVec;
@@ -209,6 +222,7 @@ protected:
   int Connection;
   vtkInformation* Request;
   const std::vector<vtkDataObject*>& InObjs;
+  const std::vector<vtkIdType>* Order;
   vtkDataObject** OutObjs;
 
   vtkSMPThreadLocal<vtkInformationVector**> InInfoVecs;
@@ -220,6 +234,7 @@ protected:
 //----------------------------------------------------------------------------
 vtkThreadedCompositeDataPipeline::vtkThreadedCompositeDataPipeline()
 {
+  this->CostAwareScheduling = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -231,6 +246,21 @@ vtkThreadedCompositeDataPipeline::~vtkThreadedCompositeDataPipeline()
 void vtkThreadedCompositeDataPipeline::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CostAwareScheduling: " << this->CostAwareScheduling << endl;
+}
+
+//-------------------------------------------------------------------------
+vtkIdType vtkThreadedCompositeDataPipeline::EstimateBlockCost(vtkDataObject* block)
+{
+  if (vtkDataSet* ds = vtkDataSet::SafeDownCast(block))
+  {
+    return ds->GetNumberOfCells();
+  }
+  if (vtkTable* table = vtkTable::SafeDownCast(block))
+  {
+    return table->GetNumberOfRows();
+  }
+  return 1;
 }
 
 //-------------------------------------------------------------------------
@@ -242,6 +272,15 @@ void vtkThreadedCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* ite
                                                    vtkInformation* request,
                                                    vtkCompositeDataSet* compositeOutput)
 {
+  vtkInformation* algInfo = this->Algorithm->GetInformation();
+  if (algInfo->Has(ALGORITHM_IS_REENTRANT()) &&
+      !algInfo->Get(ALGORITHM_IS_REENTRANT()))
+  {
+    this->Superclass::ExecuteEach(iter, inInfoVec, outInfoVec, compositePort,
+                                  connection, request, compositeOutput);
+    return;
+  }
+
   // from input data objects  itr -> (inObjs, indices)
   // inObjs are the non-null objects that we will loop over.
   // indices map the input objects to inObjs
@@ -274,10 +313,32 @@ void vtkThreadedCompositeDataPipeline::ExecuteEach(vtkCompositeDataIterator* ite
                             request,
                             inObjs,outObjs);
 
+  // Start with the most expensive blocks; hand out one block at a time so
+  // that threads that finish early pick up the remaining smaller ones.
+  std::vector<vtkIdType> order;
+  vtkIdType grain = 0;
+  if (this->CostAwareScheduling && inObjs.size() > 1)
+  {
+    std::vector<std::pair<vtkIdType, vtkIdType> > costs(inObjs.size());
+    for (size_t i = 0; i < inObjs.size(); ++i)
+    {
+      costs[i].first = -EstimateBlockCost(inObjs[i]);
+      costs[i].second = static_cast<vtkIdType>(i);
+    }
+    std::stable_sort(costs.begin(), costs.end());
+    order.resize(costs.size());
+    for (size_t i = 0; i < costs.size(); ++i)
+    {
+      order[i] = costs[i].second;
+    }
+    processBlock.SetOrder(&order);
+    grain = 1;
+  }
+
   vtkSmartPointer<vtkProgressObserver> origPo(this->Algorithm->GetProgressObserver());
   vtkNew<vtkSMPProgressObserver> po;
   this->Algorithm->SetProgressObserver(po);
-  vtkSMPTools::For(0, static_cast<vtkIdType>(inObjs.size()), processBlock);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(inObjs.size()), grain, processBlock);
   this->Algorithm->SetProgressObserver(origPo);
 
   int i =0;
@@ -305,7 +366,15 @@ int vtkThreadedCompositeDataPipeline::CallAlgorithm(vtkInformation* request, int
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
   // Invoke the request on the algorithm.
+  // The reference keeps the profiler alive if it is stopped meanwhile.
+  vtkSmartPointer<vtkExecutionProfiler> profiler;
+  profiler.TakeReference(vtkExecutionProfiler::NewActiveProfilerReference());
+  double start = profiler ? vtkTimerLog::GetUniversalTime() : 0.0;
   int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
+  if(profiler)
+  {
+    profiler->RecordRequest(this->Algorithm, request, inInfo, outInfo, start);
+  }
 
   // If the algorithm failed report it now.
   if(!result)
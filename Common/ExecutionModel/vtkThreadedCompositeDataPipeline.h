@@ -23,6 +23,17 @@
  * algorithm implement all pipeline passes in a re-entrant way. It should
  * store/retrieve all state changes using input and output information
  * objects, which are unique to each thread.
+ *
+ * Blocks are scheduled largest first, using the number of cells (or rows
+ * for tables) as the estimated cost, so that a few large blocks do not end
+ * up being processed last while the other threads sit idle. Algorithms
+ * that are not re-entrant can opt out by setting ALGORITHM_IS_REENTRANT()
+ * to 0 in their vtkAlgorithm::GetInformation(); their blocks are then
+ * processed serially.
+ *
+ * To use this executive for all algorithms, pass an instance to
+ * vtkAlgorithm::SetDefaultExecutivePrototype(); for a single algorithm use
+ * vtkAlgorithm::SetExecutive().
 */
 
 #ifndef vtkThreadedCompositeDataPipeline_h
@@ -33,6 +44,7 @@
 
 class vtkInformationVector;
 class vtkInformation;
+class vtkInformationIntegerKey;
 
 class VTKCOMMONEXECUTIONMODEL_EXPORT vtkThreadedCompositeDataPipeline : public vtkCompositeDataPipeline
 {
@@ -49,6 +61,30 @@ class VTKCOMMONEXECUTIONMODEL_EXPORT vtkThreadedCompositeDataPipeline : public v
                             vtkInformationVector** inInfo,
                             vtkInformationVector* outInfo) override;
 
+  /**
+   * Key to set in the information of an algorithm (see
+   * vtkAlgorithm::GetInformation()) to state whether it may execute several
+   * blocks concurrently. Algorithms without the key are assumed re-entrant.
+   */
+  static vtkInformationIntegerKey* ALGORITHM_IS_REENTRANT();
+
+  //@{
+  /**
+   * When on (the default), blocks are processed in decreasing order of
+   * their estimated cost. When off, they are processed in traversal order.
+   */
+  vtkSetMacro(CostAwareScheduling, int);
+  vtkGetMacro(CostAwareScheduling, int);
+  vtkBooleanMacro(CostAwareScheduling, int);
+  //@}
+
+  /**
+   * Estimated cost of executing an algorithm on the given block: the
+   * number of cells of a dataset, the number of rows of a table, 1
+   * otherwise.
+   */
+  static vtkIdType EstimateBlockCost(vtkDataObject* block);
+
  protected:
   vtkThreadedCompositeDataPipeline();
   ~vtkThreadedCompositeDataPipeline() override;
@@ -60,6 +96,8 @@ class VTKCOMMONEXECUTIONMODEL_EXPORT vtkThreadedCompositeDataPipeline : public v
                            vtkInformation* request,
                            vtkCompositeDataSet* compositeOutput) override;
 
+  int CostAwareScheduling;
+
  private:
   vtkThreadedCompositeDataPipeline(const vtkThreadedCompositeDataPipeline&) = delete;
   void operator=(const vtkThreadedCompositeDataPipeline&) = delete;
@@ -0,0 +1,357 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConnectivityLabels.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the regions of vtkConnectivityFilter and
+// vtkPolyDataConnectivityFilter with a brute force traversal of the cells,
+// with and without scalar connectivity.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+const int RESOLUTION = 60;
+const double RANGE[2] = { 0.0, 0.6 };
+
+// Grow a region from each cell not yet labeled. Cells out of the mask form
+// regions of their own.
+vtkIdType BruteForceLabels(vtkPolyData* mesh, const std::vector<char>& mask,
+                           std::vector<vtkIdType>& labels)
+{
+  vtkIdType numCells = mesh->GetNumberOfCells();
+  labels.assign(numCells, -1);
+  vtkIdType numRegions = 0;
+  std::vector<vtkIdType> wave;
+  vtkNew<vtkIdList> ptIds;
+  vtkNew<vtkIdList> cellIds;
+  for (vtkIdType seed = 0; seed < numCells; ++seed)
+  {
+    if (labels[seed] >= 0)
+    {
+      continue;
+    }
+    labels[seed] = numRegions;
+    wave.assign(1, seed);
+    while (!wave.empty() && mask[seed])
+    {
+      vtkIdType cellId = wave.back();
+      wave.pop_back();
+      mesh->GetCellPoints(cellId, ptIds.GetPointer());
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+        mesh->GetPointCells(ptIds->GetId(i), cellIds.GetPointer());
+        for (vtkIdType j = 0; j < cellIds->GetNumberOfIds(); ++j)
+        {
+          vtkIdType neiId = cellIds->GetId(j);
+          if (labels[neiId] < 0 && mask[neiId])
+          {
+            labels[neiId] = numRegions;
+            wave.push_back(neiId);
+          }
+        }
+      }
+    }
+    numRegions++;
+  }
+  return numRegions;
+}
+
+// The points of the regions are output in input order, with the smallest
+// region of their cells.
+bool CheckPointRegions(vtkPolyData* mesh, const std::vector<vtkIdType>& labels,
+                       vtkDataArray* regionIds)
+{
+  std::vector<vtkIdType> expected(mesh->GetNumberOfPoints(), -1);
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    mesh->GetCellPoints(cellId, ptIds.GetPointer());
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+    {
+      vtkIdType& region = expected[ptIds->GetId(i)];
+      region = (region < 0 ? labels[cellId] : std::min(region, labels[cellId]));
+    }
+  }
+  vtkIdType newId = 0;
+  for (vtkIdType ptId = 0; ptId < mesh->GetNumberOfPoints(); ++ptId)
+  {
+    if (expected[ptId] < 0)
+    {
+      continue;
+    }
+    if (!regionIds || newId >= regionIds->GetNumberOfTuples() ||
+        regionIds->GetTuple1(newId++) != expected[ptId])
+    {
+      cerr << "Wrong region of point " << ptId << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckRegions(vtkPolyData* mesh, bool scalars, bool full)
+{
+  vtkDataArray* inScalars = mesh->GetPointData()->GetScalars();
+  vtkIdType numCells = mesh->GetNumberOfCells();
+  std::vector<char> mask(numCells, 1);
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; scalars && cellId < numCells; ++cellId)
+  {
+    mesh->GetCellPoints(cellId, ptIds.GetPointer());
+    int numIn = 0;
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+    {
+      double s = inScalars->GetTuple1(ptIds->GetId(i));
+      numIn += (s >= RANGE[0] && s <= RANGE[1]);
+    }
+    mask[cellId] = (full ? numIn == ptIds->GetNumberOfIds() : numIn > 0);
+  }
+  std::vector<vtkIdType> labels;
+  vtkIdType numRegions = BruteForceLabels(mesh, mask, labels);
+  std::vector<vtkIdType> sizes(numRegions, 0);
+  vtkIdType largest = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (++sizes[labels[cellId]] > sizes[largest] ||
+        (sizes[labels[cellId]] == sizes[largest] && labels[cellId] < largest))
+    {
+      largest = labels[cellId];
+    }
+  }
+
+  vtkNew<vtkPolyDataConnectivityFilter> polyConn;
+  polyConn->SetInputData(mesh);
+  polyConn->SetExtractionModeToAllRegions();
+  polyConn->ColorRegionsOn();
+  polyConn->SetScalarConnectivity(scalars);
+  polyConn->SetFullScalarConnectivity(full);
+  polyConn->SetScalarRange(RANGE[0], RANGE[1]);
+  polyConn->Update();
+  if (polyConn->GetNumberOfExtractedRegions() != numRegions ||
+      polyConn->GetOutput()->GetNumberOfCells() != numCells)
+  {
+    cerr << "Found " << polyConn->GetNumberOfExtractedRegions()
+         << " polydata regions instead of " << numRegions << endl;
+    return false;
+  }
+  for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+  {
+    if (polyConn->GetRegionSizes()->GetValue(regionId) != sizes[regionId])
+    {
+      cerr << "Wrong size of polydata region " << regionId << endl;
+      return false;
+    }
+  }
+  if (!CheckPointRegions(mesh, labels,
+        polyConn->GetOutput()->GetPointData()->GetArray("RegionId")))
+  {
+    return false;
+  }
+  polyConn->SetExtractionModeToLargestRegion();
+  polyConn->Update();
+  if (polyConn->GetOutput()->GetNumberOfCells() != sizes[largest])
+  {
+    cerr << "Wrong largest polydata region" << endl;
+    return false;
+  }
+
+  // Seed the region of the last cell, and the one of a cell out of the
+  // mask: the latter also extracts the regions of its neighbors.
+  vtkIdType seeds[2] = { numCells - 1, -1 };
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (!mask[cellId])
+    {
+      seeds[1] = cellId;
+      break;
+    }
+  }
+  std::vector<char> seeded(numRegions, 0);
+  for (int k = 0; k < 2; ++k)
+  {
+    if (seeds[k] < 0)
+    {
+      continue;
+    }
+    seeded[labels[seeds[k]]] = 1;
+    if (!mask[seeds[k]])
+    {
+      vtkNew<vtkIdList> cellIds;
+      mesh->GetCellPoints(seeds[k], ptIds.GetPointer());
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+        mesh->GetPointCells(ptIds->GetId(i), cellIds.GetPointer());
+        for (vtkIdType j = 0; j < cellIds->GetNumberOfIds(); ++j)
+        {
+          if (mask[cellIds->GetId(j)])
+          {
+            seeded[labels[cellIds->GetId(j)]] = 1;
+          }
+        }
+      }
+    }
+  }
+  vtkIdType numSeeded = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    numSeeded += seeded[labels[cellId]];
+  }
+
+  // The connectivity filter only supports scalar connectivity with any
+  // point in range.
+  vtkNew<vtkConnectivityFilter> conn;
+  conn->SetInputData(mesh);
+  conn->SetScalarConnectivity(scalars);
+  conn->SetScalarRange(RANGE[0], RANGE[1]);
+  conn->SetExtractionModeToCellSeededRegions();
+  for (int k = 0; k < 2; ++k)
+  {
+    if (seeds[k] >= 0)
+    {
+      conn->AddSeed(seeds[k]);
+      polyConn->AddSeed(seeds[k]);
+    }
+  }
+  polyConn->SetExtractionModeToCellSeededRegions();
+  polyConn->Update();
+  if (polyConn->GetOutput()->GetNumberOfCells() != numSeeded)
+  {
+    cerr << "Wrong seeded polydata regions" << endl;
+    return false;
+  }
+  if (full)
+  {
+    return true;
+  }
+  conn->Update();
+  vtkPolyData* output = vtkPolyData::SafeDownCast(conn->GetOutput());
+  if (!output || output->GetNumberOfCells() != numSeeded)
+  {
+    cerr << "Wrong seeded regions" << endl;
+    return false;
+  }
+
+  conn->SetExtractionModeToAllRegions();
+  conn->ColorRegionsOn();
+  conn->Update();
+  output = vtkPolyData::SafeDownCast(conn->GetOutput());
+  vtkDataArray* cellRegionIds = output->GetCellData()->GetArray("RegionId");
+  if (conn->GetNumberOfExtractedRegions() != numRegions || !cellRegionIds ||
+      output->GetNumberOfCells() != numCells)
+  {
+    cerr << "Found " << conn->GetNumberOfExtractedRegions()
+         << " regions instead of " << numRegions << endl;
+    return false;
+  }
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (cellRegionIds->GetTuple1(cellId) != labels[cellId])
+    {
+      cerr << "Wrong region of cell " << cellId << endl;
+      return false;
+    }
+  }
+  if (!CheckPointRegions(mesh, labels,
+        output->GetPointData()->GetArray("RegionId")))
+  {
+    return false;
+  }
+  conn->SetExtractionModeToLargestRegion();
+  conn->Update();
+  if (conn->GetOutput()->GetNumberOfCells() != sizes[largest])
+  {
+    cerr << "Wrong largest region" << endl;
+    return false;
+  }
+  return numRegions > 1;
+}
+
+}
+
+int TestConnectivityLabels(int, char*[])
+{
+  // A grid of quads with randomly removed cells, and random point scalars
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scalars;
+  for (int j = 0; j <= RESOLUTION; ++j)
+  {
+    for (int i = 0; i <= RESOLUTION; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.0);
+      scalars->InsertNextValue(random->GetValue());
+      random->Next();
+    }
+  }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < RESOLUTION; ++j)
+  {
+    for (int i = 0; i < RESOLUTION; ++i)
+    {
+      if (random->GetValue() < 0.45)
+      {
+        vtkIdType pts[4] = { j * (RESOLUTION + 1) + i,
+                             j * (RESOLUTION + 1) + i + 1,
+                             (j + 1) * (RESOLUTION + 1) + i + 1,
+                             (j + 1) * (RESOLUTION + 1) + i };
+        polys->InsertNextCell(4, pts);
+      }
+      random->Next();
+    }
+  }
+  vtkNew<vtkPolyData> mesh;
+  mesh->SetPoints(points.GetPointer());
+  mesh->SetPolys(polys.GetPointer());
+  mesh->GetPointData()->SetScalars(scalars.GetPointer());
+
+  // The filters build the cells of a copy of the input topology, the input
+  // itself is not modified.
+  vtkNew<vtkPolyDataConnectivityFilter> polyConn;
+  polyConn->SetInputData(mesh.GetPointer());
+  polyConn->Update();
+  vtkNew<vtkConnectivityFilter> conn;
+  conn->SetInputData(mesh.GetPointer());
+  conn->Update();
+  if (!mesh->NeedToBuildCells())
+  {
+    cerr << "The connectivity filters built the cells of their input" << endl;
+    return EXIT_FAILURE;
+  }
+
+  mesh->BuildLinks();
+
+  if (!CheckRegions(mesh.GetPointer(), false, false) ||
+      !CheckRegions(mesh.GetPointer(), true, false) ||
+      !CheckRegions(mesh.GetPointer(), true, true))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,355 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSpaceFillingCurveReorder.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkSpaceFillingCurveReorder permutes points, cells and their
+// attributes consistently and improves locality, and time cell location and
+// probing on a shuffled and on a reordered grid.
+
+#include "vtkSpaceFillingCurveReorder.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellLocator.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkProbeFilter.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+
+namespace
+{
+
+const int RESOLUTION = 40;
+
+// A grid of hexahedra with a point scalar equal to x + 2y + 3z and a cell
+// scalar equal to the cell id.
+void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  const int n = RESOLUTION + 1;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+        pointScalars->InsertNextValue(i + 2.0 * j + 3.0 * k);
+      }
+    }
+  }
+  grid->SetPoints(points.GetPointer());
+  grid->GetPointData()->SetScalars(pointScalars.GetPointer());
+
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  grid->Allocate(RESOLUTION * RESOLUTION * RESOLUTION);
+  for (int k = 0; k < RESOLUTION; ++k)
+  {
+    for (int j = 0; j < RESOLUTION; ++j)
+    {
+      for (int i = 0; i < RESOLUTION; ++i)
+      {
+        vtkIdType p = i + n * (j + n * k);
+        vtkIdType hex[8] = { p, p + 1, p + 1 + n, p + n,
+                             p + n * n, p + 1 + n * n, p + 1 + n + n * n, p + n + n * n };
+        cellScalars->InsertNextValue(grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex));
+      }
+    }
+  }
+  grid->GetCellData()->SetScalars(cellScalars.GetPointer());
+}
+
+void Shuffle(vtkIdList* ids, vtkIdType n, vtkMinimalStandardRandomSequence* random)
+{
+  ids->SetNumberOfIds(n);
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    ids->SetId(i, i);
+  }
+  for (vtkIdType i = n - 1; i > 0; --i)
+  {
+    random->Next();
+    vtkIdType j = static_cast<vtkIdType>(random->GetRangeValue(0, i + 1));
+    j = std::min(j, i);
+    vtkIdType tmp = ids->GetId(i);
+    ids->SetId(i, ids->GetId(j));
+    ids->SetId(j, tmp);
+  }
+}
+
+// Average distance between the smallest and largest point id of a cell.
+double MeanCellSpan(vtkPointSet* data)
+{
+  vtkNew<vtkIdList> pts;
+  double sum = 0.0;
+  for (vtkIdType c = 0; c < data->GetNumberOfCells(); ++c)
+  {
+    data->GetCellPoints(c, pts.GetPointer());
+    vtkIdType* begin = pts->GetPointer(0);
+    vtkIdType* end = begin + pts->GetNumberOfIds();
+    sum += *std::max_element(begin, end) - *std::min_element(begin, end);
+  }
+  return sum / data->GetNumberOfCells();
+}
+
+// Check that output is input renumbered with the original id arrays.
+bool CheckPermutation(vtkPointSet* input, vtkPointSet* output)
+{
+  vtkIdTypeArray* pointIds = vtkIdTypeArray::SafeDownCast(
+    output->GetPointData()->GetArray("vtkOriginalPointIds"));
+  vtkIdTypeArray* cellIds = vtkIdTypeArray::SafeDownCast(
+    output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  if (!pointIds || !cellIds ||
+      output->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+      output->GetNumberOfCells() != input->GetNumberOfCells())
+  {
+    std::cerr << "Wrong output size or missing original ids." << std::endl;
+    return false;
+  }
+  vtkDataArray* inScalars = input->GetPointData()->GetScalars();
+  vtkDataArray* outScalars = output->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    vtkIdType orig = pointIds->GetValue(i);
+    double x[3], y[3];
+    input->GetPoint(orig, x);
+    output->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+        inScalars->GetTuple1(orig) != outScalars->GetTuple1(i))
+    {
+      std::cerr << "Point " << i << " does not match input point " << orig << std::endl;
+      return false;
+    }
+  }
+  vtkDataArray* inCellScalars = input->GetCellData()->GetScalars();
+  vtkDataArray* outCellScalars = output->GetCellData()->GetScalars();
+  vtkNew<vtkIdList> inPts;
+  vtkNew<vtkIdList> outPts;
+  for (vtkIdType c = 0; c < output->GetNumberOfCells(); ++c)
+  {
+    vtkIdType orig = cellIds->GetValue(c);
+    input->GetCellPoints(orig, inPts.GetPointer());
+    output->GetCellPoints(c, outPts.GetPointer());
+    bool same = input->GetCellType(orig) == output->GetCellType(c) &&
+      inPts->GetNumberOfIds() == outPts->GetNumberOfIds() &&
+      inCellScalars->GetTuple1(orig) == outCellScalars->GetTuple1(c);
+    for (vtkIdType j = 0; same && j < inPts->GetNumberOfIds(); ++j)
+    {
+      same = pointIds->GetValue(outPts->GetId(j)) == inPts->GetId(j);
+    }
+    if (!same)
+    {
+      std::cerr << "Cell " << c << " does not match input cell " << orig << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+double TimeFindCell(vtkUnstructuredGrid* grid, vtkPoints* probes)
+{
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  vtkNew<vtkCellLocator> locator;
+  locator->SetDataSet(grid);
+  locator->BuildLocator();
+  vtkNew<vtkGenericCell> cell;
+  double pcoords[3], weights[8];
+  for (vtkIdType i = 0; i < probes->GetNumberOfPoints(); ++i)
+  {
+    locator->FindCell(probes->GetPoint(i), 0.0, cell.GetPointer(), pcoords, weights);
+  }
+  timer->StopTimer();
+  return timer->GetElapsedTime();
+}
+
+double TimeProbe(vtkUnstructuredGrid* grid, vtkPolyData* probes)
+{
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  vtkNew<vtkProbeFilter> probe;
+  probe->SetInputData(probes);
+  probe->SetSourceData(grid);
+  probe->Update();
+  timer->StopTimer();
+  return timer->GetElapsedTime();
+}
+
+int TestPolyData()
+{
+  // Two vertices and three triangles listed in reverse spatial order.
+  vtkNew<vtkPolyData> input;
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 6; ++i)
+  {
+    points->InsertNextPoint(5 - i, 0.0, 0.0);
+  }
+  input->SetPoints(points.GetPointer());
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell(1);
+  verts->InsertCellPoint(0);
+  verts->InsertNextCell(1);
+  verts->InsertCellPoint(5);
+  vtkNew<vtkCellArray> polys;
+  for (vtkIdType i = 0; i < 3; ++i)
+  {
+    vtkIdType tri[3] = { 2 * i, 2 * i + 1, (2 * i + 2) % 6 };
+    polys->InsertNextCell(3, tri);
+  }
+  input->SetVerts(verts.GetPointer());
+  input->SetPolys(polys.GetPointer());
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetNumberOfValues(6);
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetNumberOfValues(5);
+  for (int i = 0; i < 6; ++i)
+  {
+    scalars->SetValue(i, i);
+    if (i < 5)
+    {
+      cellScalars->SetValue(i, i);
+    }
+  }
+  input->GetPointData()->SetScalars(scalars.GetPointer());
+  input->GetCellData()->SetScalars(cellScalars.GetPointer());
+
+  vtkNew<vtkSpaceFillingCurveReorder> reorder;
+  reorder->SetCurveToMorton();
+  reorder->GenerateOriginalIdsOn();
+  reorder->SetInputData(input.GetPointer());
+  reorder->Update();
+  vtkPolyData* output = vtkPolyData::SafeDownCast(reorder->GetOutput());
+  if (!output || !CheckPermutation(input.GetPointer(), output))
+  {
+    return 0;
+  }
+  // Points are sorted along x, and vertices stay before polygons.
+  double x[3];
+  output->GetPoint(0, x);
+  if (x[0] != 0.0 || output->GetNumberOfVerts() != 2 ||
+      output->GetCellType(1) != VTK_VERTEX || output->GetCellType(2) != VTK_TRIANGLE)
+  {
+    std::cerr << "Wrong polydata order." << std::endl;
+    return 0;
+  }
+  return 1;
+}
+
+}
+
+int TestSpaceFillingCurveReorder(int, char*[])
+{
+  if (!TestPolyData())
+  {
+    std::cerr << "Failed with polydata." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid.GetPointer());
+
+  // Shuffle the grid to get the worst possible memory layout.
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkIdList> pointOrder;
+  vtkNew<vtkIdList> cellOrder;
+  Shuffle(pointOrder.GetPointer(), grid->GetNumberOfPoints(), random.GetPointer());
+  Shuffle(cellOrder.GetPointer(), grid->GetNumberOfCells(), random.GetPointer());
+  vtkNew<vtkUnstructuredGrid> shuffled;
+  if (!vtkSpaceFillingCurveReorder::ApplyOrder(grid.GetPointer(), pointOrder.GetPointer(),
+                                               cellOrder.GetPointer(), shuffled.GetPointer()))
+  {
+    std::cerr << "ApplyOrder failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  // An order that is not a permutation is rejected.
+  cellOrder->SetId(0, cellOrder->GetId(1));
+  vtkNew<vtkUnstructuredGrid> invalid;
+  if (vtkSpaceFillingCurveReorder::ApplyOrder(grid.GetPointer(), nullptr,
+                                              cellOrder.GetPointer(), invalid.GetPointer()))
+  {
+    std::cerr << "ApplyOrder accepted an invalid order." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  double shuffledSpan = MeanCellSpan(shuffled.GetPointer());
+  vtkSmartPointer<vtkUnstructuredGrid> reordered[2];
+  for (int curve = vtkSpaceFillingCurveReorder::MORTON;
+       curve <= vtkSpaceFillingCurveReorder::HILBERT; ++curve)
+  {
+    vtkNew<vtkSpaceFillingCurveReorder> reorder;
+    reorder->SetCurve(curve);
+    reorder->GenerateOriginalIdsOn();
+    reorder->SetInputData(shuffled.GetPointer());
+    reorder->Update();
+    reordered[curve] = vtkUnstructuredGrid::SafeDownCast(reorder->GetOutput());
+    if (!reordered[curve] || !CheckPermutation(shuffled.GetPointer(), reordered[curve]))
+    {
+      std::cerr << "Failed with curve " << curve << std::endl;
+      return EXIT_FAILURE;
+    }
+    double span = MeanCellSpan(reordered[curve]);
+    std::cout << (curve ? "Hilbert" : "Morton") << " mean cell span: " << span
+              << " (shuffled " << shuffledSpan << ")" << std::endl;
+    if (span * 10.0 > shuffledSpan)
+    {
+      std::cerr << "Reordering did not improve locality." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The same queries, in random order, against both layouts.
+  vtkNew<vtkPoints> probePoints;
+  for (int i = 0; i < 20000; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      random->Next();
+      x[j] = random->GetRangeValue(0.0, RESOLUTION);
+    }
+    probePoints->InsertNextPoint(x);
+  }
+  vtkNew<vtkPolyData> probes;
+  probes->SetPoints(probePoints.GetPointer());
+
+  vtkUnstructuredGrid* hilbert = reordered[vtkSpaceFillingCurveReorder::HILBERT];
+  double findShuffled = TimeFindCell(shuffled.GetPointer(), probePoints.GetPointer());
+  double findReordered = TimeFindCell(hilbert, probePoints.GetPointer());
+  double probeShuffled = TimeProbe(shuffled.GetPointer(), probes.GetPointer());
+  double probeReordered = TimeProbe(hilbert, probes.GetPointer());
+  std::cout << "<DartMeasurement name=\"FindCellShuffled\" type=\"numeric/double\">"
+            << findShuffled << "</DartMeasurement>" << std::endl;
+  std::cout << "<DartMeasurement name=\"FindCellReordered\" type=\"numeric/double\">"
+            << findReordered << "</DartMeasurement>" << std::endl;
+  std::cout << "<DartMeasurement name=\"ProbeShuffled\" type=\"numeric/double\">"
+            << probeShuffled << "</DartMeasurement>" << std::endl;
+  std::cout << "<DartMeasurement name=\"ProbeReordered\" type=\"numeric/double\">"
+            << probeReordered << "</DartMeasurement>" << std::endl;
+
+  return EXIT_SUCCESS;
+}
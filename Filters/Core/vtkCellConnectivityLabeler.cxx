@@ -0,0 +1,230 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCellConnectivityLabeler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellConnectivityLabeler.h"
+
+#include "vtkConcurrentUnionFind.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLinks.h"
+
+#include <algorithm>
+#include <vector>
+
+vtkStandardNewMacro(vtkCellConnectivityLabeler);
+
+//----------------------------------------------------------------------------
+// Helper classes to support efficient computing, and threaded execution.
+namespace {
+
+//----------------------------------------------------------------------------
+struct ScalarMask
+{
+  vtkDataSet *Input;
+  vtkDataArray *Scalars;
+  double Range[2];
+  bool AllPoints;
+  unsigned char *Mask;
+
+  vtkSMPThreadLocalObject<vtkIdList> PtIds;
+
+  ScalarMask(vtkDataSet *input, vtkDataArray *scalars, const double range[2],
+             bool allPoints, unsigned char *mask) :
+    Input(input), Scalars(scalars), AllPoints(allPoints), Mask(mask)
+  {
+    this->Range[0] = range[0];
+    this->Range[1] = range[1];
+  }
+
+  void Initialize()
+  {
+    this->PtIds.Local()->Allocate(8);
+  }
+
+  void operator() (vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdList *ptIds = this->PtIds.Local();
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for ( ; cellId < endCellId; ++cellId)
+    {
+      this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+      double range[2] = {VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX};
+      for (vtkIdType i=0; i < npts; ++i)
+      {
+        double s = this->Scalars->GetComponent(pts[i], 0);
+        range[0] = std::min(range[0], s);
+        range[1] = std::max(range[1], s);
+      }
+      if ( this->AllPoints )
+      {
+        this->Mask[cellId] = ( range[0] >= this->Range[0] &&
+                               range[1] <= this->Range[1] );
+      }
+      else
+      {
+        this->Mask[cellId] = ( range[1] >= this->Range[0] &&
+                               range[0] <= this->Range[1] );
+      }
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+//----------------------------------------------------------------------------
+// Merge the sets of the cells using each point
+struct UnionCells
+{
+  vtkConcurrentUnionFind *Sets;
+  vtkStaticCellLinks *Links;
+  const unsigned char *Mask;
+
+  UnionCells(vtkConcurrentUnionFind *sets, vtkStaticCellLinks *links,
+             const unsigned char *mask) :
+    Sets(sets), Links(links), Mask(mask)
+  {
+  }
+
+  void operator() (vtkIdType ptId, vtkIdType endPtId)
+  {
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      vtkIdType ncells = this->Links->GetNumberOfCells(ptId);
+      const vtkIdType *cells = this->Links->GetCells(ptId);
+      vtkIdType first = -1;
+      for (vtkIdType i=0; i < ncells; ++i)
+      {
+        vtkIdType cellId = cells[i];
+        if ( this->Mask && !this->Mask[cellId] )
+        {
+          continue;
+        }
+        if ( first < 0 )
+        {
+          first = cellId;
+          continue;
+        }
+        this->Sets->Union(first, cellId);
+      }
+    }
+  }
+};
+
+} //anonymous namespace
+
+//----------------------------------------------------------------------------
+void vtkCellConnectivityLabeler::
+ComputeScalarMask(vtkDataSet *input, vtkDataArray *scalars,
+                  const double range[2], bool allPoints, unsigned char *mask)
+{
+  ScalarMask scalarMask(input, scalars, range, allPoints, mask);
+  vtkSMPTools::For(0, input->GetNumberOfCells(), scalarMask);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellConnectivityLabeler::
+LabelCells(vtkDataSet *input, vtkStaticCellLinks *links,
+           const unsigned char *mask, vtkIdType *labels,
+           vtkIdTypeArray *regionSizes)
+{
+  vtkIdType numCells = input->GetNumberOfCells();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  regionSizes->Reset();
+  if ( numCells < 1 )
+  {
+    return 0;
+  }
+
+  vtkConcurrentUnionFind sets;
+  sets.Initialize(numCells);
+  UnionCells unionCells(&sets, links, mask);
+  vtkSMPTools::For(0, numPts, unionCells);
+
+  // The regions are numbered in the order of their smallest cell id, as a
+  // serial traversal of the cells would.
+  vtkIdType numRegions = sets.Label(labels);
+
+  regionSizes->SetNumberOfTuples(numRegions);
+  vtkIdType *sizes = regionSizes->GetPointer(0);
+  std::fill_n(sizes, numRegions, 0);
+  for (vtkIdType cellId=0; cellId < numCells; ++cellId)
+  {
+    sizes[labels[cellId]]++;
+  }
+
+  return numRegions;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkCellConnectivityLabeler::
+SelectSeededRegions(vtkDataSet *input, vtkStaticCellLinks *links,
+                    const unsigned char *mask, vtkIdList *seedCells,
+                    vtkIdType numRegions, vtkIdType *labels)
+{
+  std::vector<char> seeded(numRegions, 0);
+  vtkIdList *ptIds = vtkIdList::New();
+  vtkIdType npts;
+  const vtkIdType *pts;
+  for (vtkIdType i=0; i < seedCells->GetNumberOfIds(); ++i)
+  {
+    vtkIdType cellId = seedCells->GetId(i);
+    seeded[labels[cellId]] = 1;
+    if ( mask && !mask[cellId] )
+    {
+      input->GetCellPoints(cellId, npts, pts, ptIds);
+      for (vtkIdType j=0; j < npts; ++j)
+      {
+        vtkIdType ncells = links->GetNumberOfCells(pts[j]);
+        const vtkIdType *cells = links->GetCells(pts[j]);
+        for (vtkIdType k=0; k < ncells; ++k)
+        {
+          if ( mask[cells[k]] )
+          {
+            seeded[labels[cells[k]]] = 1;
+          }
+        }
+      }
+    }
+  }
+  ptIds->Delete();
+
+  vtkIdType numCells = input->GetNumberOfCells(), numSeeded = 0;
+  for (vtkIdType cellId=0; cellId < numCells; ++cellId)
+  {
+    if ( seeded[labels[cellId]] )
+    {
+      labels[cellId] = 0;
+      numSeeded++;
+    }
+    else
+    {
+      labels[cellId] = -1;
+    }
+  }
+  return numSeeded;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellConnectivityLabeler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+}
@@ -0,0 +1,101 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCellConnectivityLabeler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCellConnectivityLabeler
+ * @brief   label the connected regions of the cells of a dataset in parallel
+ *
+ * vtkCellConnectivityLabeler is a helper class of the connectivity filters
+ * (vtkConnectivityFilter, vtkPolyDataConnectivityFilter). Two cells are
+ * connected when they share a point and, optionally, when both are selected
+ * by a mask (for example the cells satisfying a scalar range, see
+ * ComputeScalarMask()). Cells rejected by the mask form regions of their
+ * own. The regions are labeled in order of their smallest cell id, as a
+ * serial traversal of the cells growing a region from each cell not yet
+ * labeled would do.
+ *
+ * The cells using each point are obtained from vtkStaticCellLinks, and the
+ * regions are merged with a vtkConcurrentUnionFind shared by the threads,
+ * processing the points in parallel.
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter vtkStaticCellLinks
+ * vtkConcurrentUnionFind
+ */
+
+#ifndef vtkCellConnectivityLabeler_h
+#define vtkCellConnectivityLabeler_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkDataArray;
+class vtkDataSet;
+class vtkIdList;
+class vtkIdTypeArray;
+class vtkStaticCellLinks;
+
+class VTKFILTERSCORE_EXPORT vtkCellConnectivityLabeler : public vtkObject
+{
+public:
+  //@{
+  /**
+   * Standard methods for instantiation, type information, and printing.
+   */
+  static vtkCellConnectivityLabeler *New();
+  vtkTypeMacro(vtkCellConnectivityLabeler,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  /**
+   * Select the cells whose point scalars (first component) lie in range:
+   * any point of the cell, or all of them when allPoints is true. On
+   * return mask holds one value per cell, non-zero for the selected cells.
+   * The dataset must be prepared for concurrent reads.
+   */
+  void ComputeScalarMask(vtkDataSet *input, vtkDataArray *scalars,
+                         const double range[2], bool allPoints,
+                         unsigned char *mask);
+
+  /**
+   * Label the connected regions of the cells. The links must be built on
+   * the input, and the input prepared for concurrent reads. The optional
+   * mask selects the cells that may be connected to other cells. On
+   * return, labels (one per cell) holds the region ids, and regionSizes the
+   * number of cells of each region. The number of regions is returned.
+   */
+  vtkIdType LabelCells(vtkDataSet *input, vtkStaticCellLinks *links,
+                       const unsigned char *mask, vtkIdType *labels,
+                       vtkIdTypeArray *regionSizes);
+
+  /**
+   * Keep the regions of the seed cells, given the labels of LabelCells().
+   * A seed cell rejected by the mask also keeps the regions of the selected
+   * cells sharing a point with it. On return, labels holds 0 for the cells
+   * kept and -1 for the other ones. The number of cells kept is returned.
+   */
+  vtkIdType SelectSeededRegions(vtkDataSet *input, vtkStaticCellLinks *links,
+                                const unsigned char *mask, vtkIdList *seedCells,
+                                vtkIdType numRegions, vtkIdType *labels);
+
+protected:
+  vtkCellConnectivityLabeler() {}
+  ~vtkCellConnectivityLabeler() override {}
+
+private:
+  vtkCellConnectivityLabeler(const vtkCellConnectivityLabeler&) = delete;
+  void operator=(const vtkCellConnectivityLabeler&) = delete;
+};
+
+#endif
@@ -15,10 +15,10 @@
 #include "vtkConnectivityFilter.h"
 
 #include "vtkCell.h"
+#include "vtkCellConnectivityLabeler.h"
 #include "vtkCellData.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
-#include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -28,9 +28,12 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkIdTypeArray.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkConnectivityFilter);
 
 // Construct with default extraction mode to extract largest regions.
@@ -46,12 +49,6 @@ vtkConnectivityFilter::vtkConnectivityFilter()
 
   this->ClosestPoint[0] = this->ClosestPoint[1] = this->ClosestPoint[2] = 0.0;
 
-  this->CellScalars = vtkFloatArray::New();
-  this->CellScalars->Allocate(8);
-
-  this->NeighborCellPointIds = vtkIdList::New();
-  this->NeighborCellPointIds->Allocate(8);
-
   this->Seeds = vtkIdList::New();
   this->SpecifiedRegionIds = vtkIdList::New();
 
@@ -64,8 +61,6 @@ vtkConnectivityFilter::vtkConnectivityFilter()
 vtkConnectivityFilter::~vtkConnectivityFilter()
 {
   this->RegionSizes->Delete();
-  this->CellScalars->Delete();
-  this->NeighborCellPointIds->Delete();
   this->Seeds->Delete();
   this->SpecifiedRegionIds->Delete();
 }
@@ -160,10 +155,10 @@ int vtkConnectivityFilter::RequestData(
 
   // See whether to consider scalar connectivity
   //
-  this->InScalars = input->GetPointData()->GetScalars();
+  vtkDataArray *inScalars = input->GetPointData()->GetScalars();
   if ( !this->ScalarConnectivity )
   {
-    this->InScalars = nullptr;
+    inScalars = nullptr;
   }
   else
   {
@@ -173,117 +168,64 @@ int vtkConnectivityFilter::RequestData(
     }
   }
 
-  // Initialize.  Keep track of points and cells visited.
+  // Label the regions of all cells. Cells are connected through their
+  // points; with scalar connectivity, only the cells whose scalars overlap
+  // the scalar range are connected, the other ones form regions of their
+  // own. The cell structure is built on a copy of the input topology, so
+  // that the input is left untouched; the static links serve the point to
+  // cell queries.
   //
-  this->RegionSizes->Reset();
-  this->Visited = new vtkIdType[numCells];
-  for ( i=0; i < numCells; i++ )
+  vtkDataSet *mesh = input->NewInstance();
+  mesh->CopyStructure(input);
+  mesh->PrepareForConcurrentReads();
+  vtkStaticCellLinks *links = vtkStaticCellLinks::New();
+  links->BuildLinks(mesh);
+  this->UpdateProgress (0.1);
+
+  vtkCellConnectivityLabeler *labeler = vtkCellConnectivityLabeler::New();
+  std::vector<unsigned char> mask;
+  if ( inScalars )
   {
-    this->Visited[i] = -1;
-  }
-  this->PointMap = new vtkIdType[numPts];
-  for ( i=0; i < numPts; i++ )
-  {
-    this->PointMap[i] = -1;
+    mask.resize(numCells);
+    labeler->ComputeScalarMask(mesh, inScalars, this->ScalarRange, false,
+                               &mask[0]);
   }
+  this->Visited = new vtkIdType[numCells];
+  vtkIdType numRegions = labeler->LabelCells(mesh, links,
+    (mask.empty() ? nullptr : &mask[0]), this->Visited, this->RegionSizes);
+  this->UpdateProgress (0.8);
 
-  this->NewScalars = vtkIdTypeArray::New();
-  this->NewScalars->SetName("RegionId");
-  this->NewScalars->SetNumberOfTuples(numPts);
-
-  this->NewCellScalars = vtkIdTypeArray::New();
-  this->NewCellScalars->SetName("RegionId");
-  this->NewCellScalars->SetNumberOfTuples(numCells);
-
-  newPts = vtkPoints::New();
-
-  // Set the desired precision for the points in the output.
-  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-  {
-    vtkPointSet *inputPointSet = vtkPointSet::SafeDownCast(input);
-    if(inputPointSet)
-    {
-      newPts->SetDataType(inputPointSet->GetPoints()->GetDataType());
-    }
-    else
-    {
-      newPts->SetDataType(VTK_FLOAT);
-    }
-  }
-  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_DOUBLE);
-  }
-
-  newPts->Allocate(numPts);
-
-  // Traverse all cells marking those visited.  Each new search
-  // starts a new connected region. Connected region grows
-  // using a connected wave propagation.
-  //
-  this->Wave = vtkIdList::New();
-  this->Wave->Allocate(numPts/4+1,numPts);
-  this->Wave2 = vtkIdList::New();
-  this->Wave2->Allocate(numPts/4+1,numPts);
-
-  this->PointNumber = 0;
-  this->RegionNumber = 0;
-  maxCellsInRegion = 0;
-
-  this->CellIds = vtkIdList::New();
-  this->CellIds->Allocate(8, VTK_CELL_SIZE);
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
+  this->CellIds = vtkIdList::New();
+  this->CellIds->Allocate(8, VTK_CELL_SIZE);
 
   if ( this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
   this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
   this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION )
-  { //visit all cells marking with region number
-    for (cellId=0; cellId < numCells; cellId++)
+  { // find the largest region
+    maxCellsInRegion = 0;
+    for (vtkIdType regionId=0; regionId < numRegions; regionId++)
     {
-      if ( cellId && !(cellId % 5000) )
-      {
-        this->UpdateProgress (0.1 + 0.8*cellId/numCells);
-      }
-
-      if ( this->Visited[cellId] < 0 )
+      if ( this->RegionSizes->GetValue(regionId) > maxCellsInRegion )
       {
-        this->NumCellsInRegion = 0;
-        this->Wave->InsertNextId(cellId);
-        this->TraverseAndMark (input);
-
-        if ( this->NumCellsInRegion > maxCellsInRegion )
-        {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
-        }
-
-        this->RegionSizes->InsertValue(this->RegionNumber++,
-                                       this->NumCellsInRegion);
-        this->Wave->Reset();
-        this->Wave2->Reset();
+        maxCellsInRegion = this->RegionSizes->GetValue(regionId);
+        largestRegionId = regionId;
       }
     }
   }
   else // regions have been seeded, everything considered in same region
   {
-    this->NumCellsInRegion = 0;
-
     if ( this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS )
     {
       for (i=0; i < this->Seeds->GetNumberOfIds(); i++)
       {
         pt = this->Seeds->GetId(i);
-        if ( pt >= 0 )
+        if ( pt >= 0 && pt < numPts )
         {
-          input->GetPointCells(pt,this->CellIds);
-          for (j=0; j < this->CellIds->GetNumberOfIds(); j++)
+          for (j=0; j < links->GetNumberOfCells(pt); j++)
           {
-            this->Wave->InsertNextId(this->CellIds->GetId(j));
+            this->CellIds->InsertNextId(links->GetCells(pt)[j]);
           }
         }
       }
@@ -293,9 +235,9 @@ int vtkConnectivityFilter::RequestData(
       for (i=0; i < this->Seeds->GetNumberOfIds(); i++)
       {
         cellId = this->Seeds->GetId(i);
-        if ( cellId >= 0 )
+        if ( cellId >= 0 && cellId < numCells )
         {
-          this->Wave->InsertNextId(cellId);
+          this->CellIds->InsertNextId(cellId);
         }
       }
     }
@@ -313,23 +255,98 @@ int vtkConnectivityFilter::RequestData(
           minDist2 = dist2;
         }
       }
-      input->GetPointCells(minId,this->CellIds);
-      for (j=0; j < this->CellIds->GetNumberOfIds(); j++)
+      for (j=0; j < links->GetNumberOfCells(minId); j++)
+      {
+        this->CellIds->InsertNextId(links->GetCells(minId)[j]);
+      }
+    }
+
+    // The seed cells are always extracted, with the regions of their
+    // connected neighbors.
+    vtkIdType numCellsInRegion = labeler->SelectSeededRegions(mesh, links,
+      (mask.empty() ? nullptr : &mask[0]), this->CellIds, numRegions,
+      this->Visited);
+    this->RegionSizes->Reset();
+    this->RegionSizes->InsertValue(0,numCellsInRegion);
+  }
+  labeler->Delete();
+  links->Delete();
+
+  vtkDebugMacro (<<"Extracted " << this->GetNumberOfExtractedRegions()
+                 << " region(s)");
+
+  // Map the points of the labeled cells in input order. The region of a
+  // point is the smallest region of its cells.
+  //
+  this->PointMap = new vtkIdType[numPts];
+  for ( i=0; i < numPts; i++ )
+  {
+    this->PointMap[i] = -1;
+  }
+  for (cellId=0; cellId < numCells; cellId++)
+  {
+    vtkIdType regionId = this->Visited[cellId];
+    if ( regionId >= 0 )
+    {
+      vtkIdType npts;
+      const vtkIdType *pts;
+      mesh->GetCellPoints(cellId, npts, pts, this->PointIds);
+      for (j=0; j < npts; j++)
       {
-        this->Wave->InsertNextId(this->CellIds->GetId(j));
+        if ( this->PointMap[pts[j]] < 0 || regionId < this->PointMap[pts[j]] )
+        {
+          this->PointMap[pts[j]] = regionId;
+        }
       }
     }
-    this->UpdateProgress (0.5);
+  }
 
-    //mark all seeded regions
-    this->TraverseAndMark (input);
-    this->RegionSizes->InsertValue(this->RegionNumber,this->NumCellsInRegion);
-    this->UpdateProgress (0.9);
+  this->NewScalars = vtkIdTypeArray::New();
+  this->NewScalars->SetName("RegionId");
+  this->NewScalars->Allocate(numPts);
+  vtkIdType numNewPts = 0;
+  for (i=0; i < numPts; i++)
+  {
+    if ( this->PointMap[i] >= 0 )
+    {
+      this->NewScalars->InsertValue(numNewPts, this->PointMap[i]);
+      this->PointMap[i] = numNewPts++;
+    }
   }
 
-  vtkDebugMacro (<<"Extracted " << this->RegionNumber << " region(s)");
-  this->Wave->Delete();
-  this->Wave2->Delete();
+  this->NewCellScalars = vtkIdTypeArray::New();
+  this->NewCellScalars->SetName("RegionId");
+  this->NewCellScalars->SetNumberOfTuples(numCells);
+  for (cellId=0; cellId < numCells; cellId++)
+  {
+    this->NewCellScalars->SetValue(cellId, this->Visited[cellId]);
+  }
+
+  newPts = vtkPoints::New();
+
+  // Set the desired precision for the points in the output.
+  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    vtkPointSet *inputPointSet = vtkPointSet::SafeDownCast(input);
+    if(inputPointSet)
+    {
+      newPts->SetDataType(inputPointSet->GetPoints()->GetDataType());
+    }
+    else
+    {
+      newPts->SetDataType(VTK_FLOAT);
+    }
+  }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+
+  newPts->Allocate(numNewPts);
 
   // Now that points and cells have been marked, traverse these lists pulling
   // everything that has been visited.
@@ -373,17 +390,17 @@ int vtkConnectivityFilter::RequestData(
       if ( this->Visited[cellId] >= 0 )
       {
         // special handling for polyhedron cells
-        if (vtkUnstructuredGrid::SafeDownCast(input) &&
-            input->GetCellType(cellId) == VTK_POLYHEDRON)
+        if (vtkUnstructuredGrid::SafeDownCast(mesh) &&
+            mesh->GetCellType(cellId) == VTK_POLYHEDRON)
         {
-          vtkUnstructuredGrid::SafeDownCast(input)->
+          vtkUnstructuredGrid::SafeDownCast(mesh)->
             GetFaceStream(cellId, this->PointIds);
           vtkUnstructuredGrid::ConvertFaceStreamPointIds(this->PointIds,
                                                          this->PointMap);
         }
         else
         {
-          input->GetCellPoints(cellId, this->PointIds);
+          mesh->GetCellPoints(cellId, this->PointIds);
           for (i=0; i < this->PointIds->GetNumberOfIds(); i++)
           {
             id = this->PointMap[this->PointIds->GetId(i)];
@@ -393,12 +410,12 @@ int vtkConnectivityFilter::RequestData(
         vtkIdType newCellId = -1;
         if (pdOutput)
         {
-          newCellId = pdOutput->InsertNextCell(input->GetCellType(cellId),
+          newCellId = pdOutput->InsertNextCell(mesh->GetCellType(cellId),
                                                this->PointIds);
         }
         else if (ugOutput)
         {
-          newCellId = ugOutput->InsertNextCell(input->GetCellType(cellId),
+          newCellId = ugOutput->InsertNextCell(mesh->GetCellType(cellId),
                                                this->PointIds);
         }
         if (newCellId >= 0)
@@ -426,17 +443,17 @@ int vtkConnectivityFilter::RequestData(
         if ( inReg )
         {
           // special handling for polyhedron cells
-          if (vtkUnstructuredGrid::SafeDownCast(input) &&
-              input->GetCellType(cellId) == VTK_POLYHEDRON)
+          if (vtkUnstructuredGrid::SafeDownCast(mesh) &&
+              mesh->GetCellType(cellId) == VTK_POLYHEDRON)
           {
-            vtkUnstructuredGrid::SafeDownCast(input)->
+            vtkUnstructuredGrid::SafeDownCast(mesh)->
               GetFaceStream(cellId, this->PointIds);
             vtkUnstructuredGrid::ConvertFaceStreamPointIds(this->PointIds,
                                                            this->PointMap);
           }
           else
           {
-            input->GetCellPoints(cellId, this->PointIds);
+            mesh->GetCellPoints(cellId, this->PointIds);
             for (i=0; i < this->PointIds->GetNumberOfIds(); i++)
             {
               id = this->PointMap[this->PointIds->GetId(i)];
@@ -446,12 +463,12 @@ int vtkConnectivityFilter::RequestData(
           vtkIdType newCellId = -1;
           if (pdOutput)
           {
-            newCellId = pdOutput->InsertNextCell(input->GetCellType(cellId),
+            newCellId = pdOutput->InsertNextCell(mesh->GetCellType(cellId),
                                                  this->PointIds);
           }
           else if (ugOutput)
           {
-            newCellId = ugOutput->InsertNextCell(input->GetCellType(cellId),
+            newCellId = ugOutput->InsertNextCell(mesh->GetCellType(cellId),
                                                  this->PointIds);
           }
           if (newCellId >= 0)
@@ -469,17 +486,17 @@ int vtkConnectivityFilter::RequestData(
       if ( this->Visited[cellId] == largestRegionId )
       {
         // special handling for polyhedron cells
-        if (vtkUnstructuredGrid::SafeDownCast(input) &&
-            input->GetCellType(cellId) == VTK_POLYHEDRON)
+        if (vtkUnstructuredGrid::SafeDownCast(mesh) &&
+            mesh->GetCellType(cellId) == VTK_POLYHEDRON)
         {
-          vtkUnstructuredGrid::SafeDownCast(input)->
+          vtkUnstructuredGrid::SafeDownCast(mesh)->
             GetFaceStream(cellId, this->PointIds);
           vtkUnstructuredGrid::ConvertFaceStreamPointIds(this->PointIds,
                                                          this->PointMap);
         }
         else
         {
-          input->GetCellPoints(cellId, this->PointIds);
+          mesh->GetCellPoints(cellId, this->PointIds);
           for (i=0; i < this->PointIds->GetNumberOfIds(); i++)
           {
             id = this->PointMap[this->PointIds->GetId(i)];
@@ -489,12 +506,12 @@ int vtkConnectivityFilter::RequestData(
         vtkIdType newCellId = -1;
         if (pdOutput)
         {
-          newCellId = pdOutput->InsertNextCell(input->GetCellType(cellId),
+          newCellId = pdOutput->InsertNextCell(mesh->GetCellType(cellId),
                                                this->PointIds);
         }
         else if (ugOutput)
         {
-          newCellId = ugOutput->InsertNextCell(input->GetCellType(cellId),
+          newCellId = ugOutput->InsertNextCell(mesh->GetCellType(cellId),
                                                this->PointIds);
         }
         if (newCellId >= 0)
@@ -507,6 +524,7 @@ int vtkConnectivityFilter::RequestData(
 
   delete [] this->Visited;
   delete [] this->PointMap;
+  mesh->Delete();
   this->PointIds->Delete();
   this->CellIds->Delete();
   output->Squeeze();
@@ -530,89 +548,6 @@ int vtkConnectivityFilter::RequestData(
 }
 
 
-// Mark current cell as visited and assign region number.  Note:
-// traversal occurs across shared vertices.
-//
-void vtkConnectivityFilter::TraverseAndMark (vtkDataSet *input)
-{
-  vtkIdType i, j, k, cellId, numIds, ptId, numPts, numCells;
-  vtkIdList *tmpWave;
-
-  while ( (numIds=this->Wave->GetNumberOfIds()) > 0 )
-  {
-    for ( i=0; i < numIds; i++ )
-    {
-      cellId = this->Wave->GetId(i);
-      if ( this->Visited[cellId] < 0 )
-      {
-        this->NewCellScalars->SetValue(cellId, this->RegionNumber);
-        this->Visited[cellId] = this->RegionNumber;
-        this->NumCellsInRegion++;
-        input->GetCellPoints(cellId, this->PointIds);
-
-        numPts = this->PointIds->GetNumberOfIds();
-        for (j=0; j < numPts; j++)
-        {
-          if ( this->PointMap[ptId=this->PointIds->GetId(j)] < 0 )
-          {
-            this->PointMap[ptId] = this->PointNumber++;
-            this->NewScalars->SetValue(this->PointMap[ptId],
-                                       this->RegionNumber);
-          }
-
-          input->GetPointCells(ptId,this->CellIds);
-
-          // check connectivity criterion (geometric + scalar)
-          numCells = this->CellIds->GetNumberOfIds();
-          for (k=0; k < numCells; k++)
-          {
-            cellId = this->CellIds->GetId(k);
-            if ( this->InScalars )
-            {
-              int numScalars, ii;
-              double s, range[2];
-
-              input->GetCellPoints(cellId, this->NeighborCellPointIds);
-              numScalars = this->NeighborCellPointIds->GetNumberOfIds();
-              this->CellScalars->SetNumberOfComponents(this->InScalars->GetNumberOfComponents());
-              this->CellScalars->SetNumberOfTuples(numScalars);
-              this->InScalars->GetTuples(this->NeighborCellPointIds,
-                                         this->CellScalars);
-              range[0] = VTK_DOUBLE_MAX; range[1] = -VTK_DOUBLE_MAX;
-              for (ii=0; ii < numScalars;  ii++)
-              {
-                s = this->CellScalars->GetComponent(ii,0);
-                if ( s < range[0] )
-                {
-                  range[0] = s;
-                }
-                if ( s > range[1] )
-                {
-                  range[1] = s;
-                }
-              }
-              if ( range[1] >= this->ScalarRange[0] &&
-                   range[0] <= this->ScalarRange[1] )
-              {
-                this->Wave2->InsertNextId(cellId);
-              }
-            }
-            else
-            {
-              this->Wave2->InsertNextId(cellId);
-            }
-          }//for all cells using this point
-        }//for all points of this cell
-      }//if cell not yet visited
-    }//for all cells in this wave
-
-    tmpWave = this->Wave;
-    this->Wave = this->Wave2;
-    this->Wave2 = tmpWave;
-    tmpWave->Reset();
-  } //while wave is not empty
-}
-
 // Obtain the number of connected regions.
 int vtkConnectivityFilter::GetNumberOfExtractedRegions()
 {
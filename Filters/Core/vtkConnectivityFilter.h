@@ -45,8 +45,15 @@
  * structure. These voxels can then be contoured or processed by other
  * visualization filters.
  *
+ * The regions are labeled in parallel with vtkCellConnectivityLabeler, using
+ * the links from points to cells (vtkStaticCellLinks). Region ids are
+ * ordered by the smallest cell id of each region, and the output points
+ * keep their input order. With ScalarConnectivity, two cells are connected
+ * when both of them satisfy the scalar range; a seed cell is always
+ * extracted, with the regions of its connected neighbors.
+ *
  * @sa
- * vtkPolyDataConnectivityFilter
+ * vtkPolyDataConnectivityFilter vtkCellConnectivityLabeler
 */
 
 #ifndef vtkConnectivityFilter_h
@@ -210,22 +217,12 @@ protected:
   int ScalarConnectivity;
   double ScalarRange[2];
 
-  void TraverseAndMark(vtkDataSet *input);
-
 private:
   // used to support algorithm execution
-  vtkFloatArray *CellScalars;
-  vtkIdList *NeighborCellPointIds;
   vtkIdType *Visited;
   vtkIdType *PointMap;
   vtkIdTypeArray *NewScalars;
   vtkIdTypeArray *NewCellScalars;
-  vtkIdType RegionNumber;
-  vtkIdType PointNumber;
-  vtkIdType NumCellsInRegion;
-  vtkDataArray *InScalars;
-  vtkIdList *Wave;
-  vtkIdList *Wave2;
   vtkIdList *PointIds;
   vtkIdList *CellIds;
 private:
@@ -15,9 +15,9 @@
 #include "vtkPolyDataConnectivityFilter.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellConnectivityLabeler.h"
 #include "vtkCellData.h"
 #include "vtkCell.h"
-#include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
@@ -26,8 +26,10 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkStaticCellLinks.h"
 
 #include <algorithm> // for fill_n
+#include <vector>
 
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
 
@@ -45,12 +47,6 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
 
   this->ClosestPoint[0] = this->ClosestPoint[1] = this->ClosestPoint[2] = 0.0;
 
-  this->CellScalars = vtkFloatArray::New();
-  this->CellScalars->Allocate(8);
-
-  this->NeighborCellPointIds = vtkIdList::New();
-  this->NeighborCellPointIds->Allocate(8);
-
   this->Seeds = vtkIdList::New();
   this->SpecifiedRegionIds = vtkIdList::New();
 
@@ -63,8 +59,6 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
 vtkPolyDataConnectivityFilter::~vtkPolyDataConnectivityFilter()
 {
   this->RegionSizes->Delete();
-  this->CellScalars->Delete();
-  this->NeighborCellPointIds->Delete();
   this->Seeds->Delete();
   this->SpecifiedRegionIds->Delete();
   this->VisitedPointIds->Delete();
@@ -88,8 +82,8 @@ int vtkPolyDataConnectivityFilter::RequestData(
   vtkIdType cellId, newCellId, i, pt;
   vtkPoints *inPts;
   vtkPoints *newPts;
-  vtkIdType *cells, *pts, npts, id, n;
-  unsigned short ncells;
+  vtkIdType *pts, npts, id, n, ncells;
+  const vtkIdType *cells;
   vtkIdType maxCellsInRegion;
   vtkIdType largestRegionId = 0;
   vtkPointData *pd=input->GetPointData(), *outputPD=output->GetPointData();
@@ -118,10 +112,10 @@ int vtkPolyDataConnectivityFilter::RequestData(
 
   // See whether to consider scalar connectivity
   //
-  this->InScalars = input->GetPointData()->GetScalars();
+  vtkDataArray *inScalars = input->GetPointData()->GetScalars();
   if ( !this->ScalarConnectivity )
   {
-    this->InScalars = nullptr;
+    inScalars = nullptr;
   }
   else
   {
@@ -131,55 +125,35 @@ int vtkPolyDataConnectivityFilter::RequestData(
     }
   }
 
-  // Build cell structure
+  // Build cell structure on a copy of the input topology, so that the input
+  // is left untouched. The static links serve the point to cell queries.
   //
-  this->Mesh = vtkPolyData::New();
-  this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  vtkPolyData *mesh = vtkPolyData::New();
+  mesh->CopyStructure(input);
+  mesh->PrepareForConcurrentReads();
+  vtkStaticCellLinks *links = vtkStaticCellLinks::New();
+  links->BuildLinks(mesh);
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
   this->VisitedPointIds->Reset();
 
-  // Initialize.  Keep track of points and cells visited.
+  // Label the regions of all cells. Cells are connected through their
+  // points; with scalar connectivity, only the cells satisfying the scalar
+  // range are connected, the other ones form regions of their own.
   //
-  this->RegionSizes->Reset();
-  this->Visited = new vtkIdType[numCells];
-  std::fill_n(this->Visited, numCells, -1);
-  this->PointMap = new vtkIdType[numPts];
-  std::fill_n(this->PointMap, numPts, -1);
-
-  this->NewScalars = vtkIdTypeArray::New();
-  this->NewScalars->SetName("RegionId");
-  this->NewScalars->SetNumberOfTuples(numPts);
-  newPts = vtkPoints::New();
-
-  // Set the desired precision for the points in the output.
-  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  vtkCellConnectivityLabeler *labeler = vtkCellConnectivityLabeler::New();
+  std::vector<unsigned char> mask;
+  if ( inScalars )
   {
-    newPts->SetDataType(inPts->GetDataType());
+    mask.resize(numCells);
+    labeler->ComputeScalarMask(mesh, inScalars, this->ScalarRange,
+                               this->FullScalarConnectivity != 0, &mask[0]);
   }
-  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_DOUBLE);
-  }
-
-  newPts->Allocate(numPts);
-
-  // Traverse all cells marking those visited.  Each new search
-  // starts a new connected region. Connected region grows
-  // using a connected wave propagation.
-  //
-  this->Wave.reserve(numPts);
-  this->Wave2.reserve(numPts);
-
-  this->PointNumber = 0;
-  this->RegionNumber = 0;
-  maxCellsInRegion = 0;
+  this->Visited = new vtkIdType[numCells];
+  vtkIdType numRegions = labeler->LabelCells(mesh, links,
+    (mask.empty() ? nullptr : &mask[0]), this->Visited, this->RegionSizes);
+  this->UpdateProgress(0.8);
 
   this->CellIds = vtkIdList::New();
   this->CellIds->Allocate(8, VTK_CELL_SIZE);
@@ -189,48 +163,31 @@ int vtkPolyDataConnectivityFilter::RequestData(
   if ( this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
   this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
   this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION )
-  { //visit all cells marking with region number
-    for (cellId=0; cellId < numCells; cellId++)
+  { // find the largest region
+    maxCellsInRegion = 0;
+    for (vtkIdType regionId=0; regionId < numRegions; regionId++)
     {
-      if ( cellId && !(cellId % 5000) )
-      {
-        this->UpdateProgress (0.1 + 0.8*cellId/numCells);
-      }
-
-      if ( this->Visited[cellId] < 0 )
+      if ( this->RegionSizes->GetValue(regionId) > maxCellsInRegion )
       {
-        this->NumCellsInRegion = 0;
-        this->Wave.push_back(cellId);
-        this->TraverseAndMark ();
-
-        if ( this->NumCellsInRegion > maxCellsInRegion )
-        {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
-        }
-
-        this->RegionSizes->InsertValue(this->RegionNumber++,
-                                       this->NumCellsInRegion);
-        this->Wave.clear();
-        this->Wave2.clear();
+        maxCellsInRegion = this->RegionSizes->GetValue(regionId);
+        largestRegionId = regionId;
       }
     }
   }
   else // regions have been seeded, everything considered in same region
   {
-    this->NumCellsInRegion = 0;
-
     if ( this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS )
     {
       for (i=0; i < this->Seeds->GetNumberOfIds(); i++)
       {
         pt = this->Seeds->GetId(i);
-        if ( pt >= 0 )
+        if ( pt >= 0 && pt < numPts )
         {
-          this->Mesh->GetPointCells(pt,ncells,cells);
-          for (unsigned short j = 0; j < ncells; ++j)
+          ncells = links->GetNumberOfCells(pt);
+          cells = links->GetCells(pt);
+          for (vtkIdType j=0; j < ncells; ++j)
           {
-            this->Wave.push_back(cells[j]);
+            this->CellIds->InsertNextId(cells[j]);
           }
         }
       }
@@ -240,16 +197,16 @@ int vtkPolyDataConnectivityFilter::RequestData(
       for (i=0; i < this->Seeds->GetNumberOfIds(); i++)
       {
         cellId = this->Seeds->GetId(i);
-        if ( cellId >= 0 )
+        if ( cellId >= 0 && cellId < numCells )
         {
-          this->Wave.push_back(cellId);
+          this->CellIds->InsertNextId(cellId);
         }
       }
     }
     else if ( this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION )
     {//loop over points, find closest one
       double minDist2, dist2, x[3];
-      int minId = 0;
+      vtkIdType minId = 0;
       for (minDist2=VTK_DOUBLE_MAX, i=0; i<numPts; i++)
       {
         inPts->GetPoint(i,x);
@@ -260,21 +217,80 @@ int vtkPolyDataConnectivityFilter::RequestData(
           minDist2 = dist2;
         }
       }
-      this->Mesh->GetPointCells(minId,ncells,cells);
-      for (unsigned short j=0; j < ncells; ++j)
+      ncells = links->GetNumberOfCells(minId);
+      cells = links->GetCells(minId);
+      for (vtkIdType j=0; j < ncells; ++j)
       {
-        this->Wave.push_back(cells[j]);
+        this->CellIds->InsertNextId(cells[j]);
       }
     }
-    this->UpdateProgress (0.5);
 
-    //mark all seeded regions
-    this->TraverseAndMark ();
-    this->RegionSizes->InsertValue(this->RegionNumber,this->NumCellsInRegion);
-    this->UpdateProgress (0.9);
+    // The seed cells are always extracted, with the regions of their
+    // connected neighbors.
+    vtkIdType numCellsInRegion = labeler->SelectSeededRegions(mesh, links,
+      (mask.empty() ? nullptr : &mask[0]), this->CellIds, numRegions,
+      this->Visited);
+    this->RegionSizes->Reset();
+    this->RegionSizes->InsertValue(0,numCellsInRegion);
   }//else extracted seeded cells
+  labeler->Delete();
+  links->Delete();
+  this->UpdateProgress(0.9);
 
-  vtkDebugMacro (<<"Extracted " << this->RegionNumber << " region(s)");
+  vtkDebugMacro (<<"Extracted " << this->GetNumberOfExtractedRegions()
+                 << " region(s)");
+
+  // Map the points of the labeled cells in input order. The region of a
+  // point is the smallest region of its cells.
+  //
+  this->PointMap = new vtkIdType[numPts];
+  std::fill_n(this->PointMap, numPts, -1);
+  for (cellId=0; cellId < numCells; cellId++)
+  {
+    vtkIdType regionId = this->Visited[cellId];
+    if ( regionId >= 0 )
+    {
+      mesh->GetCellPoints(cellId, npts, pts);
+      for (i=0; i < npts; i++)
+      {
+        if ( this->PointMap[pts[i]] < 0 || regionId < this->PointMap[pts[i]] )
+        {
+          this->PointMap[pts[i]] = regionId;
+        }
+      }
+    }
+  }
+
+  this->NewScalars = vtkIdTypeArray::New();
+  this->NewScalars->SetName("RegionId");
+  this->NewScalars->Allocate(numPts);
+  vtkIdType numNewPts = 0;
+  for (i=0; i < numPts; i++)
+  {
+    if ( this->PointMap[i] >= 0 )
+    {
+      this->NewScalars->InsertValue(numNewPts, this->PointMap[i]);
+      this->PointMap[i] = numNewPts++;
+    }
+  }
+
+  newPts = vtkPoints::New();
+
+  // Set the desired precision for the points in the output.
+  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+
+  newPts->Allocate(numNewPts);
 
   // Now that points and cells have been marked, traverse these lists pulling
   // everything that has been visited.
@@ -305,28 +321,28 @@ int vtkPolyDataConnectivityFilter::RequestData(
 
   // Create output cells. Have to allocate storage first.
   //
-  if ( (n=input->GetVerts()->GetNumberOfCells()) > 0 )
+  if ( (n=mesh->GetVerts()->GetNumberOfCells()) > 0 )
   {
     vtkCellArray *newVerts = vtkCellArray::New();
     newVerts->Allocate(n,n);
     output->SetVerts(newVerts);
     newVerts->Delete();
   }
-  if ( (n=input->GetLines()->GetNumberOfCells()) > 0 )
+  if ( (n=mesh->GetLines()->GetNumberOfCells()) > 0 )
   {
     vtkCellArray *newLines = vtkCellArray::New();
     newLines->Allocate(2*n,n);
     output->SetLines(newLines);
     newLines->Delete();
   }
-  if ( (n=input->GetPolys()->GetNumberOfCells()) > 0 )
+  if ( (n=mesh->GetPolys()->GetNumberOfCells()) > 0 )
   {
     vtkCellArray *newPolys = vtkCellArray::New();
     newPolys->Allocate(3*n,n);
     output->SetPolys(newPolys);
     newPolys->Delete();
   }
-  if ( (n=input->GetStrips()->GetNumberOfCells()) > 0 )
+  if ( (n=mesh->GetStrips()->GetNumberOfCells()) > 0 )
   {
     vtkCellArray *newStrips = vtkCellArray::New();
     newStrips->Allocate(5*n,n);
@@ -343,7 +359,7 @@ int vtkPolyDataConnectivityFilter::RequestData(
     {
       if ( this->Visited[cellId] >= 0 )
       {
-        this->Mesh->GetCellPoints(cellId, npts, pts);
+        mesh->GetCellPoints(cellId, npts, pts);
         this->PointIds->Reset();
         for (i=0; i < npts; i++)
         {
@@ -356,7 +372,7 @@ int vtkPolyDataConnectivityFilter::RequestData(
             this->VisitedPointIds->InsertUniqueId(id);
           }
         }
-        newCellId = output->InsertNextCell(this->Mesh->GetCellType(cellId),
+        newCellId = output->InsertNextCell(mesh->GetCellType(cellId),
                                            this->PointIds);
         outputCD->CopyData(cd,cellId,newCellId);
       }
@@ -379,7 +395,7 @@ int vtkPolyDataConnectivityFilter::RequestData(
         }
         if ( inReg )
         {
-          this->Mesh->GetCellPoints(cellId, npts, pts);
+          mesh->GetCellPoints(cellId, npts, pts);
           this->PointIds->Reset ();
           for (i=0; i < npts; i++)
           {
@@ -393,7 +409,7 @@ int vtkPolyDataConnectivityFilter::RequestData(
             }
 
           }
-          newCellId = output->InsertNextCell(this->Mesh->GetCellType(cellId),
+          newCellId = output->InsertNextCell(mesh->GetCellType(cellId),
                                              this->PointIds);
           outputCD->CopyData(cd,cellId,newCellId);
         }
@@ -406,7 +422,7 @@ int vtkPolyDataConnectivityFilter::RequestData(
     {
       if ( this->Visited[cellId] == largestRegionId )
       {
-        this->Mesh->GetCellPoints(cellId, npts, pts);
+        mesh->GetCellPoints(cellId, npts, pts);
         this->PointIds->Reset ();
         for (i=0; i < npts; i++)
         {
@@ -419,7 +435,7 @@ int vtkPolyDataConnectivityFilter::RequestData(
             this->VisitedPointIds->InsertUniqueId(id);
           }
         }
-        newCellId = output->InsertNextCell(this->Mesh->GetCellType(cellId),
+        newCellId = output->InsertNextCell(mesh->GetCellType(cellId),
                                            this->PointIds);
         outputCD->CopyData(cd,cellId,newCellId);
       }
@@ -428,7 +444,7 @@ int vtkPolyDataConnectivityFilter::RequestData(
 
   delete [] this->Visited;
   delete [] this->PointMap;
-  this->Mesh->Delete();
+  mesh->Delete();
   output->Squeeze();
   this->CellIds->Delete();
   this->PointIds->Delete();
@@ -446,121 +462,6 @@ int vtkPolyDataConnectivityFilter::RequestData(
   return 1;
 }
 
-// Mark current cell as visited and assign region number.  Note:
-// traversal occurs across shared vertices.
-//
-void vtkPolyDataConnectivityFilter::TraverseAndMark ()
-{
-  vtkIdType cellId, ptId, numIds, i;
-  int j, k;
-  vtkIdType *pts, *cells, npts;
-  unsigned short ncells;
-  const vtkIdType numCells = this->Mesh->GetNumberOfCells();
-
-  while ( (numIds=static_cast<vtkIdType>(this->Wave.size())) > 0 )
-  {
-    for ( i=0; i < numIds; i++ )
-    {
-      cellId = this->Wave[i];
-      if ( this->Visited[cellId] < 0 )
-      {
-        this->Visited[cellId] = this->RegionNumber;
-        this->NumCellsInRegion++;
-        this->Mesh->GetCellPoints(cellId, npts, pts);
-
-        for (j=0; j < npts; j++)
-        {
-          if ( this->PointMap[ptId=pts[j]] < 0 )
-          {
-            this->PointMap[ptId] = this->PointNumber++;
-            vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars)->SetValue(
-              this->PointMap[ptId], this->RegionNumber);
-
-            this->Mesh->GetPointCells(ptId,ncells,cells);
-
-            // check connectivity criterion (geometric + scalar)
-            if ( this->InScalars )
-            {
-              for (k = 0; k < ncells; ++k)
-              {
-                if (this->IsScalarConnected(cells[k]))
-                {
-                  this->Wave2.push_back(cells[k]);
-                }
-              }
-            }
-            else
-            {
-              for (k = 0; k < ncells; ++k)
-              {
-                this->Wave2.push_back(cells[k]);
-              }
-            }
-          }
-        }//for all points of this cell
-      }//if cell not yet visited
-    }//for all cells in this wave
-
-    this->Wave = this->Wave2;
-    this->Wave2.clear();
-    this->Wave2.reserve(numCells);
-  } //while wave is not empty
-}
-
-// --------------------------------------------------------------------------
-int vtkPolyDataConnectivityFilter::IsScalarConnected( vtkIdType cellId )
-{
-  double s;
-
-  this->Mesh->GetCellPoints(cellId, this->NeighborCellPointIds);
-  const int numScalars = this->NeighborCellPointIds->GetNumberOfIds();
-
-  this->CellScalars->SetNumberOfTuples(numScalars);
-  this->InScalars->GetTuples(this->NeighborCellPointIds,
-                             this->CellScalars);
-
-  double range[2] = {VTK_DOUBLE_MAX, VTK_DOUBLE_MIN};
-
-  // Loop through the cell points.
-  for (int ii=0; ii < numScalars;  ii++)
-  {
-    s = this->CellScalars->GetComponent(ii, 0);
-    if ( s < range[0] )
-    {
-      range[0] = s;
-    }
-    if ( s > range[1] )
-    {
-      range[1] = s;
-    }
-  }
-
-  // Check if the scalars lie within the user supplied scalar range.
-
-  if ( this->FullScalarConnectivity )
-  {
-    // All points in this cell must lie in the user supplied scalar range
-    // for this cell to qualify as being connected.
-    if (range[0] >= this->ScalarRange[0] &&
-        range[1] <= this->ScalarRange[1])
-    {
-      return 1;
-    }
-  }
-  else
-  {
-    // Any point from this cell must lie is the user supplied scalar range
-    // for this cell to qualify as being connected
-    if ( range[1] >= this->ScalarRange[0] &&
-         range[0] <= this->ScalarRange[1] )
-    {
-      return 1;
-    }
-  }
-
-  return 0;
-}
-
 // --------------------------------------------------------------------------
 // Obtain the number of connected regions.
 int vtkPolyDataConnectivityFilter::GetNumberOfExtractedRegions()
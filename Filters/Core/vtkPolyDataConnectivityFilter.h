@@ -43,8 +43,14 @@
  * This use of ScalarConnectivity is particularly useful for selecting cells
  * for later processing.
  *
+ * The regions are labeled in parallel with vtkCellConnectivityLabeler.
+ * Region ids are ordered by the smallest cell id of each region, and the
+ * output points keep their input order. With ScalarConnectivity, two cells
+ * are connected when both of them qualify; a seed cell is always extracted,
+ * with the regions of its connected neighbors.
+ *
  * @sa
- * vtkConnectivityFilter
+ * vtkConnectivityFilter vtkCellConnectivityLabeler
 */
 
 #ifndef vtkPolyDataConnectivityFilter_h
@@ -239,26 +245,12 @@ protected:
   int ScalarConnectivity;
   int FullScalarConnectivity;
 
-  // Does this cell qualify as being scalar connected ?
-  int IsScalarConnected( vtkIdType cellId );
-
   double ScalarRange[2];
 
-  void TraverseAndMark();
-
   // used to support algorithm execution
-  vtkDataArray *CellScalars;
-  vtkIdList *NeighborCellPointIds;
   vtkIdType *Visited;
   vtkIdType *PointMap;
-  vtkDataArray *NewScalars;
-  vtkIdType RegionNumber;
-  vtkIdType PointNumber;
-  vtkIdType NumCellsInRegion;
-  vtkDataArray *InScalars;
-  vtkPolyData *Mesh;
-  std::vector<vtkIdType> Wave;
-  std::vector<vtkIdType> Wave2;
+  vtkIdTypeArray *NewScalars;
   vtkIdList *PointIds;
   vtkIdList *CellIds;
   vtkIdList *VisitedPointIds;
@@ -16,7 +16,6 @@
 
 #include "vtkCharArray.h"
 #include "vtkCompositeDataProbeFilter.h"
-#include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
@@ -396,27 +395,6 @@ void vtkResampleToImage::ComputeDataBounds(vtkDataObject* data, double bounds[6]
   }
   else
   {
-    vtkCompositeDataSet *cdata = vtkCompositeDataSet::SafeDownCast(data);
-    bounds[0] = bounds[2] = bounds[4] = VTK_DOUBLE_MAX;
-    bounds[1] = bounds[3] = bounds[5] = -VTK_DOUBLE_MAX;
-
-    vtkCompositeDataIterator *iter = cdata->NewIterator();
-    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
-    {
-      vtkDataSet *ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
-      if (!ds)
-      {
-        vtkGenericWarningMacro("vtkCompositeDataSet leaf not vtkDataSet. Skipping.");
-        continue;
-      }
-      double b[6];
-      ds->GetBounds(b);
-      for (int i = 0; i < 3; ++i)
-      {
-        bounds[2*i] = vtkMath::Min(bounds[2*i], b[2*i]);
-        bounds[2*i + 1] = vtkMath::Max(bounds[2*i + 1], b[2*i + 1]);
-      }
-    }
-    iter->Delete();
+    vtkCompositeDataSet::SafeDownCast(data)->GetBounds(bounds);
   }
 }
@@ -0,0 +1,690 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpaceFillingCurveReorder.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSpaceFillingCurveReorder.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkSpaceFillingCurveReorder);
+
+namespace
+{
+
+typedef std::pair<vtkTypeUInt64, vtkIdType> CodeType;
+
+const int CURVE_BITS = 21;
+
+// Spread the lower 21 bits of x so that there are two zero bits between
+// consecutive bits.
+inline vtkTypeUInt64 SpreadBits(vtkTypeUInt64 x)
+{
+  x &= 0x1fffff;
+  x = (x | x << 32) & 0x1f00000000ffffULL;
+  x = (x | x << 16) & 0x1f0000ff0000ffULL;
+  x = (x | x << 8) & 0x100f00f00f00f00fULL;
+  x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+  x = (x | x << 2) & 0x1249249249249249ULL;
+  return x;
+}
+
+inline vtkTypeUInt64 Interleave(const unsigned int q[3])
+{
+  return (SpreadBits(q[0]) << 2) | (SpreadBits(q[1]) << 1) | SpreadBits(q[2]);
+}
+
+// Convert grid coordinates to the transposed Hilbert index, see J. Skilling,
+// "Programming the Hilbert curve", AIP Conf. Proc. 707 (2004).
+inline void AxesToTranspose(unsigned int x[3])
+{
+  const unsigned int m = 1u << (CURVE_BITS - 1);
+  for (unsigned int q = m; q > 1; q >>= 1)
+  {
+    const unsigned int p = q - 1;
+    for (int i = 0; i < 3; ++i)
+    {
+      if (x[i] & q)
+      {
+        x[0] ^= p;
+      }
+      else
+      {
+        unsigned int t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+  x[1] ^= x[0];
+  x[2] ^= x[1];
+  unsigned int t = 0;
+  for (unsigned int q = m; q > 1; q >>= 1)
+  {
+    if (x[2] & q)
+    {
+      t ^= q - 1;
+    }
+  }
+  x[0] ^= t;
+  x[1] ^= t;
+  x[2] ^= t;
+}
+
+// Quantize points in a bounding box and compute their curve index.
+class vtkCurveEncoder
+{
+public:
+  vtkCurveEncoder(const double bounds[6], int curve) : Curve(curve)
+  {
+    const double maxCoord = static_cast<double>((1u << CURVE_BITS) - 1);
+    for (int i = 0; i < 3; ++i)
+    {
+      double length = bounds[2 * i + 1] - bounds[2 * i];
+      this->Origin[i] = bounds[2 * i];
+      this->Scale[i] = length > 0.0 ? maxCoord / length : 0.0;
+    }
+  }
+
+  vtkTypeUInt64 operator()(const double x[3]) const
+  {
+    const double maxCoord = static_cast<double>((1u << CURVE_BITS) - 1);
+    unsigned int q[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      double c = (x[i] - this->Origin[i]) * this->Scale[i];
+      c = c < 0.0 ? 0.0 : (c > maxCoord ? maxCoord : c);
+      q[i] = static_cast<unsigned int>(c);
+    }
+    if (this->Curve == vtkSpaceFillingCurveReorder::HILBERT)
+    {
+      AxesToTranspose(q);
+    }
+    return Interleave(q);
+  }
+
+private:
+  double Origin[3];
+  double Scale[3];
+  int Curve;
+};
+
+class vtkPointCodesFunctor
+{
+public:
+  vtkPoints* Points;
+  const vtkCurveEncoder& Encoder;
+  CodeType* Codes;
+
+  vtkPointCodesFunctor(vtkPoints* points, const vtkCurveEncoder& encoder, CodeType* codes)
+    : Points(points), Encoder(encoder), Codes(codes) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Points->GetPoint(i, x);
+      this->Codes[i] = CodeType(this->Encoder(x), i);
+    }
+  }
+};
+
+// Encode the centers of cells stored in a legacy connectivity array
+// (npts, id0, id1, ...) with the given locations. Ids of the codes start at
+// Offset.
+class vtkCellCodesFunctor
+{
+public:
+  vtkPoints* Points;
+  const vtkCurveEncoder& Encoder;
+  const vtkIdType* Connectivity;
+  const vtkIdType* Locations;
+  vtkIdType Offset;
+  CodeType* Codes;
+
+  vtkCellCodesFunctor(vtkPoints* points, const vtkCurveEncoder& encoder,
+                      const vtkIdType* conn, const vtkIdType* locs,
+                      vtkIdType offset, CodeType* codes)
+    : Points(points), Encoder(encoder), Connectivity(conn), Locations(locs),
+      Offset(offset), Codes(codes) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3], center[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType* cell = this->Connectivity + this->Locations[i];
+      vtkIdType npts = cell[0];
+      center[0] = center[1] = center[2] = 0.0;
+      for (vtkIdType j = 1; j <= npts; ++j)
+      {
+        this->Points->GetPoint(cell[j], x);
+        center[0] += x[0];
+        center[1] += x[1];
+        center[2] += x[2];
+      }
+      if (npts > 0)
+      {
+        center[0] /= npts;
+        center[1] /= npts;
+        center[2] /= npts;
+      }
+      this->Codes[i] = CodeType(this->Encoder(center), this->Offset + i);
+    }
+  }
+};
+
+// Copy the cells of a legacy connectivity array in the given order,
+// renumbering their points with PointMap unless it is empty. The new
+// locations must already hold the prefix sum of the new cell sizes.
+class vtkGatherCellsFunctor
+{
+public:
+  const vtkIdType* Connectivity;
+  const vtkIdType* Locations;
+  const vtkIdType* Order;
+  vtkIdType Offset;
+  const std::vector<vtkIdType>& PointMap;
+  const vtkIdType* NewLocations;
+  vtkIdType* NewConnectivity;
+
+  vtkGatherCellsFunctor(const vtkIdType* conn, const vtkIdType* locs,
+                        const vtkIdType* order, vtkIdType offset,
+                        const std::vector<vtkIdType>& pointMap,
+                        const vtkIdType* newLocs, vtkIdType* newConn)
+    : Connectivity(conn), Locations(locs), Order(order), Offset(offset),
+      PointMap(pointMap), NewLocations(newLocs), NewConnectivity(newConn) {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const bool renumber = !this->PointMap.empty();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType oldId = this->Order ? this->Order[i] - this->Offset : i;
+      const vtkIdType* cell = this->Connectivity + this->Locations[oldId];
+      vtkIdType* newCell = this->NewConnectivity + this->NewLocations[i];
+      vtkIdType npts = cell[0];
+      newCell[0] = npts;
+      for (vtkIdType j = 1; j <= npts; ++j)
+      {
+        newCell[j] = renumber ? this->PointMap[cell[j]] : cell[j];
+      }
+    }
+  }
+};
+
+// Locations of the cells of a legacy cell array.
+void ComputeLocations(vtkCellArray* cells, std::vector<vtkIdType>& locations)
+{
+  vtkIdType numCells = cells->GetNumberOfCells();
+  const vtkIdType* conn = cells->GetPointer();
+  locations.resize(numCells);
+  vtkIdType loc = 0;
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    locations[i] = loc;
+    loc += conn[loc] + 1;
+  }
+}
+
+// Gather numCells cells of conn, in the given order (ids shifted by
+// offset), into a new connectivity array.
+vtkSmartPointer<vtkIdTypeArray> GatherCells(const vtkIdType* conn, const vtkIdType* locs,
+                                            const vtkIdType* order, vtkIdType offset,
+                                            vtkIdType numCells,
+                                            const std::vector<vtkIdType>& pointMap,
+                                            vtkIdType* newLocs)
+{
+  vtkIdType size = 0;
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    vtkIdType oldId = order ? order[i] - offset : i;
+    newLocs[i] = size;
+    size += conn[locs[oldId]] + 1;
+  }
+  vtkSmartPointer<vtkIdTypeArray> newConn = vtkSmartPointer<vtkIdTypeArray>::New();
+  newConn->SetNumberOfValues(size);
+  vtkGatherCellsFunctor gather(conn, locs, order, offset, pointMap, newLocs,
+                               newConn->GetPointer(0));
+  vtkSMPTools::For(0, numCells, gather);
+  return newConn;
+}
+
+bool IsPermutation(vtkIdList* order, vtkIdType n)
+{
+  if (!order)
+  {
+    return true;
+  }
+  if (order->GetNumberOfIds() != n)
+  {
+    return false;
+  }
+  std::vector<char> seen(n, 0);
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    vtkIdType id = order->GetId(i);
+    if (id < 0 || id >= n || seen[id])
+    {
+      return false;
+    }
+    seen[id] = 1;
+  }
+  return true;
+}
+
+void SortCodes(std::vector<CodeType>& codes, vtkIdList* order)
+{
+  vtkSMPTools::Sort(codes.begin(), codes.end());
+  vtkIdType n = static_cast<vtkIdType>(codes.size());
+  order->SetNumberOfIds(n);
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    order->SetId(i, codes[i].second);
+  }
+}
+
+void CopyAttributes(vtkDataSetAttributes* in, vtkDataSetAttributes* out,
+                    vtkIdList* order, vtkIdType n)
+{
+  if (!order)
+  {
+    out->PassData(in);
+    return;
+  }
+  vtkNew<vtkIdList> toIds;
+  toIds->SetNumberOfIds(n);
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    toIds->SetId(i, i);
+  }
+  out->CopyAllocate(in, n);
+  out->CopyData(in, order, toIds.GetPointer());
+}
+
+vtkIdTypeArray* NewOriginalIds(const char* name, vtkIdList* order, vtkIdType n)
+{
+  vtkIdTypeArray* ids = vtkIdTypeArray::New();
+  ids->SetName(name);
+  ids->SetNumberOfValues(n);
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    ids->SetValue(i, order ? order->GetId(i) : i);
+  }
+  return ids;
+}
+
+}
+
+//----------------------------------------------------------------------------
+vtkSpaceFillingCurveReorder::vtkSpaceFillingCurveReorder()
+{
+  this->Curve = HILBERT;
+  this->ReorderPoints = 1;
+  this->ReorderCells = 1;
+  this->GenerateOriginalIds = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkSpaceFillingCurveReorder::~vtkSpaceFillingCurveReorder()
+{
+}
+
+//----------------------------------------------------------------------------
+void vtkSpaceFillingCurveReorder::ComputePointOrder(vtkPoints* points, int curve,
+                                                    vtkIdList* order)
+{
+  order->Reset();
+  if (!points || points->GetNumberOfPoints() == 0)
+  {
+    return;
+  }
+  vtkIdType numPts = points->GetNumberOfPoints();
+  vtkCurveEncoder encoder(points->GetBounds(), curve);
+  std::vector<CodeType> codes(numPts);
+  vtkPointCodesFunctor functor(points, encoder, &codes[0]);
+  vtkSMPTools::For(0, numPts, functor);
+  SortCodes(codes, order);
+}
+
+//----------------------------------------------------------------------------
+void vtkSpaceFillingCurveReorder::ComputeCellOrder(vtkPointSet* input, int curve,
+                                                   vtkIdList* order)
+{
+  order->Reset();
+  vtkIdType numCells = input ? input->GetNumberOfCells() : 0;
+  vtkPoints* points = input ? input->GetPoints() : nullptr;
+  if (numCells == 0 || !points)
+  {
+    return;
+  }
+  vtkCurveEncoder encoder(points->GetBounds(), curve);
+  std::vector<CodeType> codes(numCells);
+
+  if (vtkUnstructuredGrid* ugrid = vtkUnstructuredGrid::SafeDownCast(input))
+  {
+    vtkCellCodesFunctor functor(points, encoder, ugrid->GetCells()->GetPointer(),
+                                ugrid->GetCellLocationsArray()->GetPointer(0),
+                                0, &codes[0]);
+    vtkSMPTools::For(0, numCells, functor);
+    SortCodes(codes, order);
+    return;
+  }
+
+  vtkPolyData* polyData = vtkPolyData::SafeDownCast(input);
+  if (!polyData)
+  {
+    return;
+  }
+  // Sort each cell array separately so that the cells keep the vertex,
+  // line, polygon, strip numbering of vtkPolyData.
+  vtkCellArray* arrays[4] = { polyData->GetVerts(), polyData->GetLines(),
+                              polyData->GetPolys(), polyData->GetStrips() };
+  order->SetNumberOfIds(numCells);
+  vtkIdType offset = 0;
+  std::vector<vtkIdType> locations;
+  for (int a = 0; a < 4; ++a)
+  {
+    vtkIdType n = arrays[a] ? arrays[a]->GetNumberOfCells() : 0;
+    if (n == 0)
+    {
+      continue;
+    }
+    ComputeLocations(arrays[a], locations);
+    codes.resize(n);
+    vtkCellCodesFunctor functor(points, encoder, arrays[a]->GetPointer(),
+                                &locations[0], offset, &codes[0]);
+    vtkSMPTools::For(0, n, functor);
+    vtkSMPTools::Sort(codes.begin(), codes.end());
+    for (vtkIdType i = 0; i < n; ++i)
+    {
+      order->SetId(offset + i, codes[i].second);
+    }
+    offset += n;
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkSpaceFillingCurveReorder::ApplyOrder(vtkPointSet* input, vtkIdList* pointOrder,
+                                            vtkIdList* cellOrder, vtkPointSet* output)
+{
+  vtkPolyData* inPoly = vtkPolyData::SafeDownCast(input);
+  vtkPolyData* outPoly = vtkPolyData::SafeDownCast(output);
+  vtkUnstructuredGrid* inGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  vtkUnstructuredGrid* outGrid = vtkUnstructuredGrid::SafeDownCast(output);
+  if (!(inPoly && outPoly) && !(inGrid && outGrid))
+  {
+    return 0;
+  }
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+  if (!IsPermutation(pointOrder, numPts) || !IsPermutation(cellOrder, numCells))
+  {
+    return 0;
+  }
+  if (numPts == 0)
+  {
+    pointOrder = nullptr;
+  }
+  if (numCells == 0)
+  {
+    cellOrder = nullptr;
+  }
+
+  output->Initialize();
+  output->GetFieldData()->PassData(input->GetFieldData());
+
+  // Points, and the map from input to output point ids.
+  std::vector<vtkIdType> pointMap;
+  if (pointOrder)
+  {
+    vtkPoints* inPts = input->GetPoints();
+    vtkNew<vtkPoints> newPts;
+    newPts->SetDataType(inPts->GetDataType());
+    newPts->SetNumberOfPoints(numPts);
+    inPts->GetData()->GetTuples(pointOrder, newPts->GetData());
+    output->SetPoints(newPts.GetPointer());
+    pointMap.resize(numPts);
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      pointMap[pointOrder->GetId(i)] = i;
+    }
+  }
+  else
+  {
+    output->SetPoints(input->GetPoints());
+  }
+  CopyAttributes(input->GetPointData(), output->GetPointData(), pointOrder, numPts);
+
+  if (inGrid)
+  {
+    if (numCells == 0)
+    {
+      // Nothing to renumber.
+    }
+    else if (!cellOrder && !pointOrder)
+    {
+      outGrid->SetCells(inGrid->GetCellTypesArray(), inGrid->GetCellLocationsArray(),
+                        inGrid->GetCells(), inGrid->GetFaceLocations(),
+                        inGrid->GetFaces());
+    }
+    else
+    {
+      const vtkIdType* order = cellOrder ? cellOrder->GetPointer(0) : nullptr;
+      const vtkIdType* locs = inGrid->GetCellLocationsArray()->GetPointer(0);
+      const unsigned char* types = inGrid->GetCellTypesArray()->GetPointer(0);
+
+      vtkNew<vtkIdTypeArray> newLocs;
+      newLocs->SetNumberOfValues(numCells);
+      vtkSmartPointer<vtkIdTypeArray> newConn =
+        GatherCells(inGrid->GetCells()->GetPointer(), locs, order, 0, numCells,
+                    pointMap, newLocs->GetPointer(0));
+      vtkNew<vtkCellArray> newCells;
+      newCells->SetCells(numCells, newConn);
+      vtkNew<vtkUnsignedCharArray> newTypes;
+      newTypes->SetNumberOfValues(numCells);
+      for (vtkIdType i = 0; i < numCells; ++i)
+      {
+        newTypes->SetValue(i, types[order ? order[i] : i]);
+      }
+
+      vtkIdTypeArray* faces = inGrid->GetFaces();
+      vtkIdTypeArray* faceLocs = inGrid->GetFaceLocations();
+      if (faces && faceLocs)
+      {
+        // Face streams: nfaces, then npts and the point ids of each face.
+        vtkNew<vtkIdTypeArray> newFaces;
+        vtkNew<vtkIdTypeArray> newFaceLocs;
+        newFaceLocs->SetNumberOfValues(numCells);
+        for (vtkIdType i = 0; i < numCells; ++i)
+        {
+          vtkIdType loc = faceLocs->GetValue(order ? order[i] : i);
+          if (loc < 0)
+          {
+            newFaceLocs->SetValue(i, -1);
+            continue;
+          }
+          newFaceLocs->SetValue(i, newFaces->GetNumberOfValues());
+          const vtkIdType* face = faces->GetPointer(loc);
+          vtkIdType numFaces = *face++;
+          newFaces->InsertNextValue(numFaces);
+          for (vtkIdType f = 0; f < numFaces; ++f)
+          {
+            vtkIdType npts = *face++;
+            newFaces->InsertNextValue(npts);
+            for (vtkIdType j = 0; j < npts; ++j, ++face)
+            {
+              newFaces->InsertNextValue(pointMap.empty() ? *face : pointMap[*face]);
+            }
+          }
+        }
+        outGrid->SetCells(newTypes.GetPointer(), newLocs.GetPointer(),
+                          newCells.GetPointer(), newFaceLocs.GetPointer(),
+                          newFaces.GetPointer());
+      }
+      else
+      {
+        outGrid->SetCells(newTypes.GetPointer(), newLocs.GetPointer(),
+                          newCells.GetPointer());
+      }
+    }
+    CopyAttributes(input->GetCellData(), output->GetCellData(), cellOrder, numCells);
+    return 1;
+  }
+
+  // vtkPolyData numbers vertices, lines, polygons then strips, so the cells
+  // are first (stably) grouped by cell array.
+  vtkCellArray* arrays[4] = { inPoly->GetVerts(), inPoly->GetLines(),
+                              inPoly->GetPolys(), inPoly->GetStrips() };
+  vtkIdType start[5] = { 0, 0, 0, 0, 0 };
+  for (int a = 0; a < 4; ++a)
+  {
+    start[a + 1] = start[a] + (arrays[a] ? arrays[a]->GetNumberOfCells() : 0);
+  }
+  vtkNew<vtkIdList> groupedOrder;
+  if (cellOrder)
+  {
+    groupedOrder->SetNumberOfIds(numCells);
+    vtkIdType next = 0;
+    for (int a = 0; a < 4; ++a)
+    {
+      for (vtkIdType i = 0; i < numCells; ++i)
+      {
+        vtkIdType id = cellOrder->GetId(i);
+        if (id >= start[a] && id < start[a + 1])
+        {
+          groupedOrder->SetId(next++, id);
+        }
+      }
+    }
+    cellOrder = groupedOrder.GetPointer();
+  }
+
+  std::vector<vtkIdType> locations;
+  std::vector<vtkIdType> newLocs;
+  for (int a = 0; a < 4; ++a)
+  {
+    vtkIdType n = start[a + 1] - start[a];
+    vtkSmartPointer<vtkCellArray> newCells = arrays[a];
+    if (n > 0 && (cellOrder || pointOrder))
+    {
+      ComputeLocations(arrays[a], locations);
+      newLocs.resize(n);
+      const vtkIdType* order = cellOrder ? cellOrder->GetPointer(start[a]) : nullptr;
+      vtkSmartPointer<vtkIdTypeArray> newConn =
+        GatherCells(arrays[a]->GetPointer(), &locations[0], order, start[a], n,
+                    pointMap, &newLocs[0]);
+      newCells = vtkSmartPointer<vtkCellArray>::New();
+      newCells->SetCells(n, newConn);
+    }
+    if (n == 0)
+    {
+      continue;
+    }
+    switch (a)
+    {
+      case 0: outPoly->SetVerts(newCells); break;
+      case 1: outPoly->SetLines(newCells); break;
+      case 2: outPoly->SetPolys(newCells); break;
+      default: outPoly->SetStrips(newCells); break;
+    }
+  }
+  CopyAttributes(input->GetCellData(), output->GetCellData(), cellOrder, numCells);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkSpaceFillingCurveReorder::RequestData(vtkInformation*,
+                                             vtkInformationVector** inputVector,
+                                             vtkInformationVector* outputVector)
+{
+  vtkPointSet* input = vtkPointSet::GetData(inputVector[0]);
+  vtkPointSet* output = vtkPointSet::GetData(outputVector);
+  if (!input || !output)
+  {
+    return 0;
+  }
+
+  vtkNew<vtkIdList> pointOrder;
+  vtkNew<vtkIdList> cellOrder;
+  vtkIdList* pointIds = nullptr;
+  vtkIdList* cellIds = nullptr;
+  if (this->ReorderPoints && input->GetNumberOfPoints() > 0)
+  {
+    this->ComputePointOrder(input->GetPoints(), this->Curve, pointOrder.GetPointer());
+    pointIds = pointOrder.GetPointer();
+  }
+  this->UpdateProgress(0.3);
+  if (this->ReorderCells && input->GetNumberOfCells() > 0)
+  {
+    this->ComputeCellOrder(input, this->Curve, cellOrder.GetPointer());
+    cellIds = cellOrder.GetPointer();
+  }
+  this->UpdateProgress(0.6);
+
+  if (!this->ApplyOrder(input, pointIds, cellIds, output))
+  {
+    vtkErrorMacro("Cannot reorder a " << input->GetClassName());
+    return 0;
+  }
+
+  if (this->GenerateOriginalIds)
+  {
+    vtkIdTypeArray* ids = NewOriginalIds("vtkOriginalPointIds", pointIds,
+                                         input->GetNumberOfPoints());
+    output->GetPointData()->AddArray(ids);
+    ids->Delete();
+    ids = NewOriginalIds("vtkOriginalCellIds", cellIds, input->GetNumberOfCells());
+    output->GetCellData()->AddArray(ids);
+    ids->Delete();
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkSpaceFillingCurveReorder::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkSpaceFillingCurveReorder::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Curve: " << (this->Curve == HILBERT ? "Hilbert" : "Morton") << endl;
+  os << indent << "Reorder Points: " << (this->ReorderPoints ? "On" : "Off") << endl;
+  os << indent << "Reorder Cells: " << (this->ReorderCells ? "On" : "Off") << endl;
+  os << indent << "Generate Original Ids: "
+     << (this->GenerateOriginalIds ? "On" : "Off") << endl;
+}
@@ -0,0 +1,141 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpaceFillingCurveReorder.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSpaceFillingCurveReorder
+ * @brief   renumber points and cells along a space filling curve
+ *
+ * vtkSpaceFillingCurveReorder produces a copy of its input in which points,
+ * cells, or both, are renumbered in the order they are visited by a
+ * Morton (Z-order) or Hilbert curve. Points and cells close in space end
+ * up close in memory, which reduces cache misses in locators, probing,
+ * rendering and any algorithm that visits the neighbors of a cell. The
+ * geometry is unchanged: the connectivity is remapped to the new point ids,
+ * and all point and cell attributes are permuted accordingly.
+ *
+ * The curve codes are computed from the point coordinates and the cell
+ * centers (average of the cell points) quantized to 21 bits per axis over
+ * the bounds of the input. Codes are computed and sorted with vtkSMPTools.
+ *
+ * The cells of a vtkPolyData are reordered within each of the vertex,
+ * line, polygon and strip arrays, since vtkPolyData numbers cells in that
+ * order. Polyhedral cells of a vtkUnstructuredGrid are supported.
+ *
+ * The static methods can be used to compute and apply an order without
+ * running the filter, or to apply any other permutation.
+ *
+ * @sa
+ * vtkCellLocator vtkProbeFilter
+*/
+
+#ifndef vtkSpaceFillingCurveReorder_h
+#define vtkSpaceFillingCurveReorder_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkPointSetAlgorithm.h"
+
+class vtkIdList;
+class vtkPoints;
+
+class VTKFILTERSCORE_EXPORT vtkSpaceFillingCurveReorder : public vtkPointSetAlgorithm
+{
+public:
+  static vtkSpaceFillingCurveReorder* New();
+  vtkTypeMacro(vtkSpaceFillingCurveReorder, vtkPointSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum CurveType
+  {
+    MORTON = 0,
+    HILBERT = 1
+  };
+
+  //@{
+  /**
+   * Space filling curve used to order points and cells. The Hilbert curve
+   * has better locality, the Morton curve is cheaper to compute. The
+   * default is HILBERT.
+   */
+  vtkSetClampMacro(Curve, int, MORTON, HILBERT);
+  vtkGetMacro(Curve, int);
+  void SetCurveToMorton() { this->SetCurve(MORTON); }
+  void SetCurveToHilbert() { this->SetCurve(HILBERT); }
+  //@}
+
+  //@{
+  /**
+   * Turn on/off the renumbering of points and of cells. Both are on by
+   * default.
+   */
+  vtkSetMacro(ReorderPoints, int);
+  vtkGetMacro(ReorderPoints, int);
+  vtkBooleanMacro(ReorderPoints, int);
+  vtkSetMacro(ReorderCells, int);
+  vtkGetMacro(ReorderCells, int);
+  vtkBooleanMacro(ReorderCells, int);
+  //@}
+
+  //@{
+  /**
+   * If on, the input id of every point and cell is stored in the
+   * "vtkOriginalPointIds" and "vtkOriginalCellIds" arrays. Off by default.
+   */
+  vtkSetMacro(GenerateOriginalIds, int);
+  vtkGetMacro(GenerateOriginalIds, int);
+  vtkBooleanMacro(GenerateOriginalIds, int);
+  //@}
+
+  /**
+   * Fill order with the ids of the points sorted along the given curve:
+   * order->GetId(newId) is the id of the point that becomes newId.
+   */
+  static void ComputePointOrder(vtkPoints* points, int curve, vtkIdList* order);
+
+  /**
+   * Same as ComputePointOrder() for the cells of a vtkPolyData or a
+   * vtkUnstructuredGrid, using the cell centers. The cells of a vtkPolyData
+   * stay grouped by vertex, line, polygon and strip.
+   */
+  static void ComputeCellOrder(vtkPointSet* input, int curve, vtkIdList* order);
+
+  /**
+   * Copy input into output, an instance of the same type, with the points
+   * and cells permuted so that output point i is input point
+   * pointOrder->GetId(i), and likewise for cells. A nullptr order keeps
+   * the input order. For a vtkPolyData the cell order is made stable
+   * within each cell array. Return 0 if the type of input is not
+   * supported, or if an order is not a permutation of the right size.
+   */
+  static int ApplyOrder(vtkPointSet* input, vtkIdList* pointOrder,
+                        vtkIdList* cellOrder, vtkPointSet* output);
+
+protected:
+  vtkSpaceFillingCurveReorder();
+  ~vtkSpaceFillingCurveReorder() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int RequestData(vtkInformation*, vtkInformationVector**,
+                  vtkInformationVector*) override;
+
+  int Curve;
+  int ReorderPoints;
+  int ReorderCells;
+  int GenerateOriginalIds;
+
+private:
+  vtkSpaceFillingCurveReorder(const vtkSpaceFillingCurveReorder&) = delete;
+  void operator=(const vtkSpaceFillingCurveReorder&) = delete;
+};
+
+#endif
@@ -18,6 +18,8 @@
 #include "vtkPolyData.h"
 #include "vtkGenericCell.h"
 #include "vtkIdListCollection.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
 #include <stack>
 #include <vector>
@@ -47,6 +49,8 @@ vtkModifiedBSPTree::vtkModifiedBSPTree(void)
   this->LazyEvaluation             = 1;
   //
   this->npn = this->nln = this->tot_depth = 0;
+  this->Subtrees                   = nullptr;
+  this->SubtreeSize                = 0;
 }
 //---------------------------------------------------------------------------
 vtkModifiedBSPTree::~vtkModifiedBSPTree(void)
@@ -75,8 +79,9 @@ public:
 };
 
 typedef cell_extents *cell_extents_List;
+typedef std::stack<BSPNode*, std::vector<BSPNode*> > nodestack;
 
-static int global_list_count = 0;
+static vtkAtomicInt32 global_list_count(0);
 
 class Sorted_cell_extents_Lists
 {
@@ -104,33 +109,87 @@ public:
   }
 };
 
-extern "C" int __compareMin(const void *pA, const void *B )
+static bool __compareMin(const cell_extents &tA, const cell_extents &tB)
 {
-  const cell_extents *tA = static_cast<const cell_extents *>(pA);
-  const cell_extents *tB = static_cast<const cell_extents *>(B);
-  if ( tA->min == tB->min )
-  {
-    return 0;
-  }
-  else
-  {
-    return tA->min < tB->min ? -1 : 1 ;
+  return tA.min < tB.min;
+}
+
+static bool __compareMax(const cell_extents &tA, const cell_extents &tB)
+{
+  return tA.max > tB.max;
+}
+
+//
+// Sort the given cells (all of them if cellIds is nullptr) into the 6
+// lists used for subdividing, with vtkSMPTools::Sort
+//
+static Sorted_cell_extents_Lists *BuildSortedLists(double (*cellBounds)[6],
+                                                   const vtkIdType *cellIds,
+                                                   vtkIdType nCells)
+{
+  Sorted_cell_extents_Lists *lists = new Sorted_cell_extents_Lists(nCells);
+  for (int i=0; i<3; i++)
+  { // loop over each axis
+    for (vtkIdType j=0; j<nCells; j++)
+    { // loop over each cell
+      vtkIdType cell_ID = cellIds ? cellIds[j] : j;
+      lists->Mins[i][j].min   = cellBounds[cell_ID][i*2];   // i=0 xmin, i=1 ymin, i=2 zmin
+      lists->Mins[i][j].max   = cellBounds[cell_ID][i*2+1]; // i=0 xmax, i=1 ymax, i=2 zmax
+      lists->Mins[i][j].cell_ID = cell_ID;
+      //
+      lists->Maxs[i][j] = lists->Mins[i][j];
+    }
+    // Sort
+    vtkSMPTools::Sort(lists->Mins[i], lists->Mins[i] + nCells, __compareMin);
+    vtkSMPTools::Sort(lists->Maxs[i], lists->Maxs[i] + nCells, __compareMax);
   }
+  return lists;
 }
 
-extern "C" int __compareMax(const void *pA, const void *B )
+//
+// Nodes left by the top of the tree, subdivided concurrently
+//
+class BSPSubtree
 {
-  const cell_extents *tA = static_cast<const cell_extents *>(pA);
-  const cell_extents *tB = static_cast<const cell_extents *>(B);
-  if ( tA->max == tB->max )
+public:
+  BSPNode                   *node;
+  Sorted_cell_extents_Lists *lists;
+  vtkIdType                  nCells;
+  int                        depth;
+};
+
+class BSPSubtreeList : public std::vector<BSPSubtree>
+{
+};
+
+class BSPSubtreeFunctor
+{
+public:
+  vtkModifiedBSPTree     *Tree;
+  BSPSubtreeList         *Subtrees;
+  vtkSMPThreadLocal<int>  MaxDepth;
+  //
+  void Initialize()
   {
-    return 0;
+    this->MaxDepth.Local() = 0;
   }
-  else
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    int &maxDepth = this->MaxDepth.Local();
+    for (vtkIdType i=begin; i<end; i++)
+    {
+      BSPSubtree &subtree = (*this->Subtrees)[i];
+      this->Tree->Subdivide(subtree.node, subtree.lists, this->Tree->DataSet,
+                            subtree.nCells, subtree.depth, this->Tree->MaxLevel,
+                            this->Tree->NumberOfCellsPerNode, maxDepth);
+      delete subtree.lists;
+      subtree.lists = nullptr;
+    }
+  }
+  void Reduce()
   {
-    return tA->max > tB->max ? -1 : 1;
   }
-}
+};
 
 //---------------------------------------------------------------------------
 //---------------------------------------------------------------------------
@@ -174,6 +233,13 @@ void vtkModifiedBSPTree::ForceBuildLocator()
     vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
     return;
   }
+  // only update the boxes if RefitSearchStructure is ON and the cells are the same
+  if ( (this->mRoot) && (this->mRoot->Bounds[0] <= this->mRoot->Bounds[1]) &&
+       this->RefitSearchStructure && this->RefitLocatorInternal())
+  {
+    vtkDebugMacro(<< "BuildLocator exited - RefitSearchStructure");
+    return;
+  }
   this->BuildLocatorInternal();
 }
 //---------------------------------------------------------------------------
@@ -208,42 +274,44 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
   this->StoreCellBounds();
   //
   // sort the cells into 6 lists using structure for subdividing tests
-  Sorted_cell_extents_Lists *lists = new Sorted_cell_extents_Lists(numCells);
-  for (int i=0; i<3; i++)
-  { // loop over each axis
-    for (vtkIdType j=0; j<numCells; j++)
-    { // loop over each cell
-      lists->Mins[i][j].min   = CellBounds[j][i*2];   // i=0 xmin, i=1 ymin, i=2 zmin
-      lists->Mins[i][j].max   = CellBounds[j][i*2+1]; // i=0 xmax, i=1 ymax, i=2 zmax
-      lists->Mins[i][j].cell_ID = j;
-      //
-      lists->Maxs[i][j].min   = CellBounds[j][i*2];
-      lists->Maxs[i][j].max   = CellBounds[j][i*2+1];
-      lists->Maxs[i][j].cell_ID = j;
-    }
-    // Sort
-    qsort( lists->Mins[i], numCells, sizeof(cell_extents), __compareMin) ;
-    qsort( lists->Maxs[i], numCells, sizeof(cell_extents), __compareMax) ;
-  }
+  Sorted_cell_extents_Lists *lists = BuildSortedLists(this->CellBounds, nullptr, numCells);
   //
   // call the recursive subdivision routine
   //
   vtkDebugMacro( << "Beginning Subdivision" );
   //
-  if (numCells>0)
-  {
-    Subdivide(this->mRoot, lists, this->DataSet, numCells, 0,
-              this->MaxLevel, this->NumberOfCellsPerNode, this->Level);
-  }
+  // The top of the tree is subdivided here, it leaves the nodes with
+  // fewer than SubtreeSize cells to be subdivided concurrently afterwards
+  BSPSubtreeList subtrees;
+  this->SubtreeSize = std::max(static_cast<vtkIdType>(4096),
+    numCells / (4 * vtkSMPTools::GetEstimatedNumberOfThreads()));
+  this->Subtrees = (numCells > this->SubtreeSize) ? &subtrees : nullptr;
+  Subdivide(this->mRoot, lists, this->DataSet, numCells, 0,
+            this->MaxLevel, this->NumberOfCellsPerNode, this->Level);
+  this->Subtrees = nullptr;
   delete lists;
   // Child nodes are responsible for freeing the temporary sorted lists
   //
+  if (!subtrees.empty())
+  {
+    vtkDebugMacro( << "Subdividing " << subtrees.size() << " subtrees" );
+    BSPSubtreeFunctor functor;
+    functor.Tree = this;
+    functor.Subtrees = &subtrees;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1, functor);
+    vtkSMPThreadLocal<int>::iterator itr;
+    for (itr = functor.MaxDepth.begin(); itr != functor.MaxDepth.end(); ++itr)
+    {
+      this->Level = std::max(this->Level, *itr);
+    }
+  }
+  //
   this->BuildTime.Modified();
   //
-  double av_depth = (double)tot_depth/nln; (void)av_depth;
+  double av_depth = (double)tot_depth/(int)nln; (void)av_depth;
   vtkDebugMacro( << "BSP Tree Statistics \n"
-                 << "Num Parent/Leaf Nodes " << npn
-                 << "/" << nln << "\n"
+                 << "Num Parent/Leaf Nodes " << (int)npn
+                 << "/" << (int)nln << "\n"
                  << "Average Depth " << av_depth
                  << " Original : " << numCells);
 }
@@ -278,6 +346,25 @@ void vtkModifiedBSPTree::Subdivide(BSPNode *node,
   // Make sure child nodes are clear to start with
   node->mChild[2] = node->mChild[1] = node->mChild[0] = nullptr;
   //
+  // Leave small enough nodes to the concurrent part of the build, the
+  // lists passed to us are deleted by the caller so keep a copy
+  if (this->Subtrees && (nCells < this->SubtreeSize) &&
+      (nCells > maxCells) && (depth < maxlevel))
+  {
+    BSPSubtree subtree;
+    subtree.node   = node;
+    subtree.lists  = new Sorted_cell_extents_Lists(nCells);
+    subtree.nCells = nCells;
+    subtree.depth  = depth;
+    for (int i=0; i<3; i++)
+    {
+      std::copy(lists->Mins[i], lists->Mins[i] + nCells, subtree.lists->Mins[i]);
+      std::copy(lists->Maxs[i], lists->Maxs[i] + nCells, subtree.lists->Maxs[i]);
+    }
+    this->Subtrees->push_back(subtree);
+    return;
+  }
+  //
   // Do we want to subdivide this node ?
   //
   double pDiv = 0.0;
@@ -324,7 +411,7 @@ void vtkModifiedBSPTree::Subdivide(BSPNode *node,
       {
         node->mChild[i]    = new BSPNode();
         node->mChild[i]->depth = node->depth+1;
-        node->mChild[i]->mAxis = rand() % 3;
+        node->mChild[i]->mAxis = (node->mAxis + i + 1) % 3;
       }
       Daxis = node->mAxis;
       Sorted_cell_extents_Lists *left  = new Sorted_cell_extents_Lists(nCells);
@@ -526,6 +613,242 @@ void vtkModifiedBSPTree::Subdivide(BSPNode *node,
   // Thank buggery that's all over.
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Refit the tree to deformed cells
+//////////////////////////////////////////////////////////////////////////////
+// Sort the cells of a leaf for one of the 6 dominant axes
+class BSPCellOrder
+{
+public:
+  double (*CellBounds)[6];
+  int     Side;
+  bool operator()(vtkIdType a, vtkIdType b) const
+  {
+    return (this->Side%2) ? (this->CellBounds[a][this->Side] > this->CellBounds[b][this->Side])
+                          : (this->CellBounds[a][this->Side] < this->CellBounds[b][this->Side]);
+  }
+};
+
+// Recompute the box of the leaves and sort their cells again, the ray
+// intersection relies on the order to stop early
+class BSPLeafRefitFunctor
+{
+public:
+  double               (*CellBounds)[6];
+  std::vector<BSPNode*> *Leaves;
+  //
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType l=begin; l<end; l++)
+    {
+      BSPNode *node = (*this->Leaves)[l];
+      for (int i=0; i<3; i++)
+      {
+        node->Bounds[i*2]   =  VTK_DOUBLE_MAX;
+        node->Bounds[i*2+1] = -VTK_DOUBLE_MAX;
+      }
+      for (int j=0; j<node->num_cells; j++)
+      {
+        const double *bounds = this->CellBounds[node->sorted_cell_lists[0][j]];
+        for (int i=0; i<3; i++)
+        {
+          node->Bounds[i*2]   = std::min(node->Bounds[i*2], bounds[i*2]);
+          node->Bounds[i*2+1] = std::max(node->Bounds[i*2+1], bounds[i*2+1]);
+        }
+      }
+      BSPCellOrder order;
+      order.CellBounds = this->CellBounds;
+      for (order.Side=0; order.Side<6; order.Side++)
+      {
+        vtkIdType *list = node->sorted_cell_lists[order.Side];
+        std::sort(list, list + node->num_cells, order);
+      }
+    }
+  }
+};
+
+bool vtkModifiedBSPTree::RefitLocatorInternal()
+{
+  std::vector<BSPNode*> nodes, leaves;
+  for (int pass=0; ; pass++)
+  {
+    //
+    // gather the nodes, parents before their children
+    vtkIdType numCells = 0;
+    nodes.clear();
+    nodes.push_back(this->mRoot);
+    for (size_t n=0; n<nodes.size(); n++)
+    {
+      BSPNode *node = nodes[n];
+      if (node->mChild[0])
+      {
+        for (int i=0; i<3; i++)
+        {
+          if (node->mChild[i])
+          {
+            nodes.push_back(node->mChild[i]);
+          }
+        }
+      }
+      else if (pass==0)
+      {
+        leaves.push_back(node);
+        numCells += node->num_cells;
+      }
+    }
+    if (pass==0)
+    {
+      if (numCells != this->DataSet->GetNumberOfCells())
+      {
+        return false;
+      }
+      vtkDebugMacro( << "Refitting BSPTree for " << numCells << " cells");
+      //
+      this->FreeCellBounds();
+      this->StoreCellBounds();
+      //
+      BSPLeafRefitFunctor functor;
+      functor.CellBounds = this->CellBounds;
+      functor.Leaves = &leaves;
+      vtkSMPTools::For(0, static_cast<vtkIdType>(leaves.size()), functor);
+    }
+    //
+    // now the parents, a parent box encloses its children
+    for (size_t n=nodes.size(); n-- > 0; )
+    {
+      BSPNode *node = nodes[n];
+      if (!node->mChild[0])
+      {
+        continue;
+      }
+      for (int i=0; i<3; i++)
+      {
+        node->Bounds[i*2]   =  VTK_DOUBLE_MAX;
+        node->Bounds[i*2+1] = -VTK_DOUBLE_MAX;
+        for (int c=0; c<3; c++)
+        {
+          if (node->mChild[c])
+          {
+            node->Bounds[i*2]   = std::min(node->Bounds[i*2], node->mChild[c]->Bounds[i*2]);
+            node->Bounds[i*2+1] = std::max(node->Bounds[i*2+1], node->mChild[c]->Bounds[i*2+1]);
+          }
+        }
+      }
+    }
+    if (pass==1)
+    {
+      break;
+    }
+    //
+    // If the cells moved across the split plane of a parent, the near/far
+    // classification of rays would miss some of them : find the highest
+    // of these parents and subdivide them again.
+    BSPSubtreeList subtrees;
+    nodestack ns;
+    ns.push(this->mRoot);
+    while (!ns.empty())
+    {
+      BSPNode *node = ns.top();
+      ns.pop();
+      if (!node->mChild[0])
+      {
+        continue;
+      }
+      int axis = node->mAxis;
+      if (node->mChild[0]->Bounds[axis*2+1] <= node->mChild[2]->Bounds[axis*2])
+      {
+        for (int c=0; c<3; c++)
+        {
+          if (node->mChild[c])
+          {
+            ns.push(node->mChild[c]);
+          }
+        }
+        continue;
+      }
+      if (node==this->mRoot)
+      {
+        vtkDebugMacro( << "Root split plane invalid, rebuilding");
+        return false;
+      }
+      // collect the cells of the leaves below
+      std::vector<vtkIdType> cellIds;
+      nodestack sub;
+      sub.push(node);
+      while (!sub.empty())
+      {
+        BSPNode *leaf = sub.top();
+        sub.pop();
+        if (leaf->mChild[0])
+        {
+          for (int c=0; c<3; c++)
+          {
+            if (leaf->mChild[c])
+            {
+              sub.push(leaf->mChild[c]);
+            }
+          }
+        }
+        else
+        {
+          cellIds.insert(cellIds.end(), leaf->sorted_cell_lists[0],
+                         leaf->sorted_cell_lists[0] + leaf->num_cells);
+        }
+      }
+      for (int c=0; c<3; c++)
+      {
+        delete node->mChild[c];
+        node->mChild[c] = nullptr;
+      }
+      BSPSubtree subtree;
+      subtree.node   = node;
+      subtree.nCells = static_cast<vtkIdType>(cellIds.size());
+      subtree.lists  = BuildSortedLists(this->CellBounds, &cellIds[0], subtree.nCells);
+      subtree.depth  = node->depth;
+      subtrees.push_back(subtree);
+    }
+    if (subtrees.empty())
+    {
+      break;
+    }
+    vtkDebugMacro( << "Subdividing " << subtrees.size() << " subtrees again" );
+    BSPSubtreeFunctor functor;
+    functor.Tree = this;
+    functor.Subtrees = &subtrees;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1, functor);
+  }
+  //
+  // update the statistics, the subdivisions above changed them
+  this->npn = this->nln = this->tot_depth = 0;
+  this->Level = 0;
+  nodestack ns;
+  ns.push(this->mRoot);
+  while (!ns.empty())
+  {
+    BSPNode *node = ns.top();
+    ns.pop();
+    this->Level = std::max(this->Level, node->depth);
+    if (node->mChild[0])
+    {
+      this->npn += 1;
+      for (int c=0; c<3; c++)
+      {
+        if (node->mChild[c])
+        {
+          ns.push(node->mChild[c]);
+        }
+      }
+    }
+    else
+    {
+      this->nln += 1;
+      this->tot_depth += node->depth;
+    }
+  }
+  this->BuildTime.Modified();
+  return true;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Generate representation for viewing structure
 //////////////////////////////////////////////////////////////////////////////
@@ -546,7 +869,6 @@ public:
 };
 
 typedef std::vector<_box> boxlist;
-typedef std::stack<BSPNode*, std::vector<BSPNode*> > nodestack;
 
 void vtkModifiedBSPTree::GenerateRepresentation(int level, vtkPolyData *pd)
 {
@@ -662,17 +984,6 @@ int vtkModifiedBSPTree::IntersectWithLine(double p1[3],
                                           int &subId,
                                           vtkIdType &cellId,
                                           vtkGenericCell *cell)
-{
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-  {
-    this->DataSet->GetCell(cellId, cell);
-  }
-  return hit;
-}
-//---------------------------------------------------------------------------
-int vtkModifiedBSPTree::IntersectWithLine(double p1[3], double p2[3], double tol,
-                                          double &t, double x[3], double pcoords[3], int &subId, vtkIdType &cellId)
 {
   //
   BSPNode  *node, *Near, *Mid, *Far;
@@ -776,7 +1087,7 @@ int vtkModifiedBSPTree::IntersectWithLine(double p1[3], double p2[3], double tol
       ctmin = _tmin; ctmax = _tmax;
       if (BSPNode::RayMinMaxT(CellBounds[cell_ID], p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, cell))
         {
           if (t_hit<closest_intersection)
           {
@@ -795,11 +1106,25 @@ int vtkModifiedBSPTree::IntersectWithLine(double p1[3], double p2[3], double tol
   if (HIT)
   {
     t = closest_intersection;
+    this->DataSet->GetCell(cellId, cell);
   }
   //
   return HIT;
 }
 //---------------------------------------------------------------------------
+int vtkModifiedBSPTree::IntersectWithLine(double p1[3], double p2[3], double tol,
+                                          double &t, double x[3], double pcoords[3], int &subId, vtkIdType &cellId)
+{
+  return this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, this->GenericCell);
+}
+//---------------------------------------------------------------------------
+bool vtkModifiedBSPTree::PrepareForConcurrentQueries()
+{
+  this->Superclass::PrepareForConcurrentQueries();
+  this->BuildLocatorIfNeeded();
+  return this->mRoot != nullptr;
+}
+//---------------------------------------------------------------------------
 typedef std::pair<double, int> Intersection;
 //
 struct Isort : public std::binary_function<Intersection, Intersection, bool> {
@@ -986,8 +1311,22 @@ int vtkModifiedBSPTree::IntersectCellInternal(
   double pcoords[3],
   int &subId)
 {
-  this->DataSet->GetCell(cell_ID, this->GenericCell);
-  return this->GenericCell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
+  return this->IntersectCellInternal(cell_ID, p1, p2, tol, t, ipt, pcoords, subId, this->GenericCell);
+}
+//---------------------------------------------------------------------------
+int vtkModifiedBSPTree::IntersectCellInternal(
+  vtkIdType cell_ID,
+  const double p1[3],
+  const double p2[3],
+  const double tol,
+  double &t,
+  double ipt[3],
+  double pcoords[3],
+  int &subId,
+  vtkGenericCell *cell)
+{
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
 //////////////////////////////////////////////////////////////////////////////
 // FindCell stuff
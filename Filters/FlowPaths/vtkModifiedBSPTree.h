@@ -146,9 +146,11 @@
 #include "vtkFiltersFlowPathsModule.h" // For export macro
 #include "vtkAbstractCellLocator.h"
 #include "vtkSmartPointer.h"     // required because it is nice
+#include "vtkAtomicTypes.h"      // for the statistics of the parallel build
 
 class Sorted_cell_extents_Lists;
 class BSPNode;
+class BSPSubtreeList;
 class vtkGenericCell;
 class vtkIdList;
 class vtkIdListCollection;
@@ -241,9 +243,14 @@ class VTKFILTERSFLOWPATHS_EXPORT vtkModifiedBSPTree : public vtkAbstractCellLoca
   ~vtkModifiedBSPTree() override;
   //
   BSPNode  *mRoot;               // bounding box root node
-  int       npn;
-  int       nln;
-  int       tot_depth;
+  vtkAtomicInt32 npn;
+  vtkAtomicInt32 nln;
+  vtkAtomicInt32 tot_depth;
+  //
+  // During the build, nodes with fewer cells than SubtreeSize are not
+  // subdivided but added to Subtrees, to be subdivided concurrently
+  BSPSubtreeList *Subtrees;
+  vtkIdType       SubtreeSize;
 
   //
   // The main subdivision routine
@@ -257,9 +264,25 @@ class VTKFILTERSFLOWPATHS_EXPORT vtkModifiedBSPTree : public vtkAbstractCellLoca
   virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
     const double tol, double &t, double ipt[3], double pcoords[3], int &subId);
 
+  // Same as above, using the given cell instead of this->GenericCell.
+  // IntersectWithLine() calls this version, so that concurrent queries
+  // with different cells are thread safe once the tree is built.
+  virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
+    const double tol, double &t, double ipt[3], double pcoords[3], int &subId,
+    vtkGenericCell *cell);
+
+  bool PrepareForConcurrentQueries() override;
+
   void BuildLocatorIfNeeded();
   void ForceBuildLocator();
   void BuildLocatorInternal();
+  // Update the boxes of the existing tree from the current cell bounds,
+  // see RefitSearchStructure. Subtrees whose split became invalid are
+  // subdivided again. Returns false if the number of cells changed.
+  bool RefitLocatorInternal();
+  //
+  friend class BSPSubtreeFunctor;
+  friend class BSPLeafRefitFunctor;
 private:
   vtkModifiedBSPTree(const vtkModifiedBSPTree&) = delete;
   void operator=(const vtkModifiedBSPTree&) = delete;
@@ -316,6 +339,7 @@ class BSPNode {
     //
     friend class vtkModifiedBSPTree;
     friend class vtkParticleBoxTree;
+    friend class BSPLeafRefitFunctor;
   public:
   static bool VTKFILTERSFLOWPATHS_EXPORT RayMinMaxT(
     const double bounds[6], const double origin[3], const double dir[3], double &rTmin, double &rTmax);
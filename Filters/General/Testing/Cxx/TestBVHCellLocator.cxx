@@ -0,0 +1,235 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Intersect segments with a triangulated sphere and a quad mesh using
+// vtkBVHCellLocator, one at a time and batched, and compare the results
+// with vtkModifiedBSPTree. Also check the batched FindCell() queries.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTimerLog.h"
+
+#include <cmath>
+
+namespace
+{
+
+const vtkIdType NUMBER_OF_SEGMENTS = 5000;
+const double TOLERANCE = 1.0e-9;
+
+void RandomPoints(vtkMinimalStandardRandomSequence* random, vtkPoints* points)
+{
+  points->SetNumberOfPoints(NUMBER_OF_SEGMENTS);
+  for (vtkIdType i = 0; i < NUMBER_OF_SEGMENTS; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(-1.0, 1.0);
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+bool Close(const double* a, const double* b, int n, double tol)
+{
+  for (int i = 0; i < n; ++i)
+  {
+    if (std::abs(a[i] - b[i]) > tol)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckIntersections(vtkPolyData* pd, vtkPoints* p1, vtkPoints* p2)
+{
+  vtkNew<vtkBVHCellLocator> bvh;
+  bvh->SetDataSet(pd);
+  bvh->BuildLocator();
+  vtkNew<vtkModifiedBSPTree> bsp;
+  bsp->SetDataSet(pd);
+  bsp->BuildLocator();
+  if (bvh->GetNumberOfNodes() < 3)
+  {
+    cerr << "The hierarchy was not split." << endl;
+    return false;
+  }
+
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> ts;
+  vtkNew<vtkPoints> xs;
+  vtkNew<vtkDoubleArray> pcs;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  bvh->IntersectWithLines(p1, p2, 0.0, cellIds.GetPointer(), ts.GetPointer(),
+                          xs.GetPointer(), pcs.GetPointer());
+  timer->StopTimer();
+  double batched = timer->GetElapsedTime();
+
+  vtkNew<vtkGenericCell> cell;
+  vtkIdType hits = 0;
+  double single = 0.0, reference = 0.0;
+  for (vtkIdType i = 0; i < NUMBER_OF_SEGMENTS; ++i)
+  {
+    double a[3], b[3], t, x[3], pc[3], tRef, xRef[3], pcRef[3];
+    int subId, subIdRef;
+    vtkIdType cellId = -1, cellIdRef = -1;
+    p1->GetPoint(i, a);
+    p2->GetPoint(i, b);
+
+    timer->StartTimer();
+    int hit = bvh->IntersectWithLine(a, b, 0.0, t, x, pc, subId, cellId,
+                                     cell.GetPointer());
+    timer->StopTimer();
+    single += timer->GetElapsedTime();
+    timer->StartTimer();
+    int hitRef = bsp->IntersectWithLine(a, b, 0.0, tRef, xRef, pcRef, subIdRef,
+                                        cellIdRef, cell.GetPointer());
+    timer->StopTimer();
+    reference += timer->GetElapsedTime();
+
+    // vtkModifiedBSPTree may return the parametric coordinates of another
+    // hit of the same leaf, evaluate them in the cell instead.
+    if (hitRef)
+    {
+      double closest[3], dist2, weights[4];
+      pd->GetCell(cellIdRef, cell.GetPointer());
+      cell->EvaluatePosition(xRef, closest, subIdRef, pcRef, dist2, weights);
+    }
+    if (hit != hitRef || (hit && (cellId != cellIdRef ||
+        std::abs(t - tRef) > TOLERANCE || !Close(x, xRef, 3, TOLERANCE) ||
+        !Close(pc, pcRef, 3, TOLERANCE))))
+    {
+      cerr << "Segment " << i << ": hit " << hit << " cell " << cellId << " t "
+           << t << ", expected hit " << hitRef << " cell " << cellIdRef << " t "
+           << tRef << endl;
+      return false;
+    }
+    if (!hit)
+    {
+      t = 0.0;
+      x[0] = x[1] = x[2] = pc[0] = pc[1] = pc[2] = 0.0;
+      cellId = -1;
+    }
+    if (cellIds->GetId(i) != cellId || ts->GetValue(i) != t ||
+        !Close(xs->GetPoint(i), x, 3, 0.0) || !Close(pcs->GetTuple3(i), pc, 3, 0.0))
+    {
+      cerr << "Segment " << i << ": batched result differs" << endl;
+      return false;
+    }
+    hits += hit;
+  }
+
+  cout << bvh->GetNumberOfTriangles() << " triangles, " << bvh->GetNumberOfNodes()
+       << " nodes, " << hits << " hits: " << single << "s single, " << batched
+       << "s batched, " << reference << "s vtkModifiedBSPTree" << endl;
+  if (hits == 0)
+  {
+    cerr << "No segment hit the surface." << endl;
+    return false;
+  }
+
+  vtkNew<vtkPolyData> boxes;
+  bvh->GenerateRepresentation(-1, boxes.GetPointer());
+  if (boxes->GetNumberOfPolys() == 0 || boxes->GetNumberOfPolys() % 6 != 0)
+  {
+    cerr << "Wrong representation." << endl;
+    return false;
+  }
+  return true;
+}
+
+}
+
+int TestBVHCellLocator(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> p1;
+  vtkNew<vtkPoints> p2;
+  RandomPoints(random.GetPointer(), p1.GetPointer());
+  RandomPoints(random.GetPointer(), p2.GetPointer());
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(0.8);
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+  if (!CheckIntersections(sphere->GetOutput(), p1.GetPointer(), p2.GetPointer()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Quads are split into triangles, their parametric coordinates are
+  // evaluated in the quads.
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetOrigin(-0.9, -0.9, -0.3);
+  plane->SetPoint1(0.9, -0.9, 0.1);
+  plane->SetPoint2(-0.9, 0.9, 0.2);
+  plane->SetResolution(30, 20);
+  plane->Update();
+  if (!CheckIntersections(plane->GetOutput(), p1.GetPointer(), p2.GetPointer()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // FindCell() is not accelerated: the batched queries go through
+  // vtkDataSet::FindCell() from a single thread. The queries use no
+  // tolerance, so the quads lie in the z = 0 plane.
+  vtkNew<vtkPlaneSource> flat;
+  flat->SetResolution(30, 20);
+  flat->Update();
+  vtkPolyData* quads = flat->GetOutput();
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(quads);
+  locator->BuildLocator();
+  vtkNew<vtkPoints> centers;
+  vtkNew<vtkIdList> expected;
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType i = 0; i < quads->GetNumberOfCells(); i += 7)
+  {
+    double pcoords[3], x[3], weights[4];
+    int subId = 0;
+    quads->GetCell(i, cell.GetPointer());
+    cell->GetParametricCenter(pcoords);
+    cell->EvaluateLocation(subId, pcoords, x, weights);
+    centers->InsertNextPoint(x);
+    expected->InsertNextId(i);
+  }
+  vtkNew<vtkIdList> cellIds;
+  locator->FindCells(centers.GetPointer(), cellIds.GetPointer());
+  for (vtkIdType i = 0; i < expected->GetNumberOfIds(); ++i)
+  {
+    if (cellIds->GetId(i) != expected->GetId(i))
+    {
+      cerr << "FindCells() returned cell " << cellIds->GetId(i)
+           << " instead of " << expected->GetId(i) << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,220 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellLocatorBatchedQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the batched FindCells() and IntersectWithLines() of the cell
+// locators with the same queries made one at a time.
+
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+
+const vtkIdType NUMBER_OF_QUERIES = 5000;
+
+void RandomPoints(vtkMinimalStandardRandomSequence* random, const double bounds[6],
+                  vtkPoints* points)
+{
+  points->SetNumberOfPoints(NUMBER_OF_QUERIES);
+  for (vtkIdType i = 0; i < NUMBER_OF_QUERIES; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(bounds[2 * j], bounds[2 * j + 1]);
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+bool CheckFindCells(vtkAbstractCellLocator* locator, vtkPoints* points)
+{
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> pcoords;
+  vtkNew<vtkDoubleArray> weights;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  locator->FindCells(points, cellIds.GetPointer(), pcoords.GetPointer(),
+                     weights.GetPointer());
+  timer->StopTimer();
+  double batched = timer->GetElapsedTime();
+
+  vtkNew<vtkGenericCell> cell;
+  double pc[3], w[4];
+  vtkIdType found = 0;
+  timer->StartTimer();
+  for (vtkIdType i = 0; i < NUMBER_OF_QUERIES; ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    vtkIdType cellId = locator->FindCell(x, 0.0, cell.GetPointer(), pc, w);
+    if (cellId != cellIds->GetId(i))
+    {
+      cerr << locator->GetClassName() << ": point " << i << " found in cell "
+           << cellIds->GetId(i) << " instead of " << cellId << endl;
+      return false;
+    }
+    if (cellId < 0)
+    {
+      continue;
+    }
+    ++found;
+    for (int j = 0; j < 3; ++j)
+    {
+      if (std::fabs(pc[j] - pcoords->GetComponent(i, j)) > 1.0e-12)
+      {
+        cerr << locator->GetClassName() << ": wrong parametric coordinates" << endl;
+        return false;
+      }
+    }
+    for (int j = 0; j < 4; ++j)
+    {
+      if (std::fabs(w[j] - weights->GetComponent(i, j)) > 1.0e-12)
+      {
+        cerr << locator->GetClassName() << ": wrong weights" << endl;
+        return false;
+      }
+    }
+  }
+  timer->StopTimer();
+  cout << locator->GetClassName() << " FindCell: " << found << " found, "
+       << timer->GetElapsedTime() << "s single, " << batched << "s batched" << endl;
+  return found > 0;
+}
+
+bool CheckIntersectWithLines(vtkAbstractCellLocator* locator, vtkPoints* p1, vtkPoints* p2)
+{
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> t;
+  vtkNew<vtkPoints> x;
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  locator->IntersectWithLines(p1, p2, 0.0, cellIds.GetPointer(), t.GetPointer(),
+                              x.GetPointer());
+  timer->StopTimer();
+  double batched = timer->GetElapsedTime();
+
+  vtkNew<vtkGenericCell> cell;
+  vtkIdType hits = 0;
+  timer->StartTimer();
+  for (vtkIdType i = 0; i < NUMBER_OF_QUERIES; ++i)
+  {
+    double a0[3], a1[3], hitT, hitX[3], pc[3];
+    int subId;
+    vtkIdType cellId = -1;
+    p1->GetPoint(i, a0);
+    p2->GetPoint(i, a1);
+    if (!locator->IntersectWithLine(a0, a1, 0.0, hitT, hitX, pc, subId, cellId,
+                                    cell.GetPointer()))
+    {
+      cellId = -1;
+    }
+    if (cellId != cellIds->GetId(i))
+    {
+      cerr << locator->GetClassName() << ": segment " << i << " hit cell "
+           << cellIds->GetId(i) << " instead of " << cellId << endl;
+      return false;
+    }
+    if (cellId < 0)
+    {
+      continue;
+    }
+    ++hits;
+    double* batchedX = x->GetPoint(i);
+    if (std::fabs(hitT - t->GetValue(i)) > 1.0e-12 ||
+        std::fabs(hitX[0] - batchedX[0]) > 1.0e-12 ||
+        std::fabs(hitX[1] - batchedX[1]) > 1.0e-12 ||
+        std::fabs(hitX[2] - batchedX[2]) > 1.0e-12)
+    {
+      cerr << locator->GetClassName() << ": wrong intersection for segment " << i << endl;
+      return false;
+    }
+  }
+  timer->StopTimer();
+  cout << locator->GetClassName() << " IntersectWithLine: " << hits << " hits, "
+       << timer->GetElapsedTime() << "s single, " << batched << "s batched" << endl;
+  return hits > 0;
+}
+
+}
+
+int TestCellLocatorBatchedQueries(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(21, 21, 21);
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputData(image.GetPointer());
+  tetrahedralize->Update();
+  vtkUnstructuredGrid* grid = tetrahedralize->GetOutput();
+
+  // Query points and segments cover the grid and some space around it.
+  const double bounds[6] = { -2.0, 22.0, -2.0, 22.0, -2.0, 22.0 };
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkPoints> p1;
+  vtkNew<vtkPoints> p2;
+  points->SetDataTypeToDouble();
+  p1->SetDataTypeToDouble();
+  p2->SetDataTypeToDouble();
+  RandomPoints(random.GetPointer(), bounds, points.GetPointer());
+  RandomPoints(random.GetPointer(), bounds, p1.GetPointer());
+  RandomPoints(random.GetPointer(), bounds, p2.GetPointer());
+
+  vtkSmartPointer<vtkAbstractCellLocator> locators[4] = {
+    vtkSmartPointer<vtkCellLocator>::New(),
+    vtkSmartPointer<vtkStaticCellLocator>::New(),
+    vtkSmartPointer<vtkCellTreeLocator>::New(),
+    vtkSmartPointer<vtkModifiedBSPTree>::New()
+  };
+  for (int i = 0; i < 4; ++i)
+  {
+    vtkAbstractCellLocator* locator = locators[i];
+    locator->SetDataSet(grid);
+    locator->CacheCellBoundsOn();
+    locator->BuildLocator();
+    if (!CheckFindCells(locator, points.GetPointer()) ||
+        !CheckIntersectWithLines(locator, p1.GetPointer(), p2.GetPointer()))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Lazily built locators are built by the batched queries.
+  vtkNew<vtkCellTreeLocator> lazy;
+  lazy->SetDataSet(grid);
+  lazy->LazyEvaluationOn();
+  if (!CheckFindCells(lazy.GetPointer(), points.GetPointer()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
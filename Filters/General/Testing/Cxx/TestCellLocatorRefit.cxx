@@ -0,0 +1,201 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellLocatorRefit.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Deform a tetrahedral mesh, refit the search structure of the cell
+// locators supporting RefitSearchStructure and compare their queries with
+// a locator of the same type built from scratch.
+
+#include "vtkCellTreeLocator.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkGenericCell.h"
+#include "vtkImageData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+
+const vtkIdType NUMBER_OF_QUERIES = 200;
+
+void RandomPoints(vtkMinimalStandardRandomSequence* random, const double bounds[6],
+                  vtkPoints* points)
+{
+  points->SetNumberOfPoints(NUMBER_OF_QUERIES);
+  for (vtkIdType i = 0; i < NUMBER_OF_QUERIES; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(bounds[2 * j], bounds[2 * j + 1]);
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+// A smooth displacement keeping the cells in place, or a rotation of the
+// top of the mesh by a quarter turn around z, that invalidates some of the
+// split planes of the trees.
+void Deform(vtkPoints* original, vtkPoints* points, bool rotate)
+{
+  for (vtkIdType i = 0; i < original->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    original->GetPoint(i, x);
+    if (rotate)
+    {
+      y[0] = x[2] > 5.0 ? 10.0 - x[1] : x[0];
+      y[1] = x[2] > 5.0 ? x[0] : x[1];
+      y[2] = x[2];
+    }
+    else
+    {
+      y[0] = x[0] + 0.5 * std::sin(0.3 * x[1]);
+      y[1] = x[1] + 0.5 * std::sin(0.3 * x[2]);
+      y[2] = x[2] + 0.5 * std::sin(0.3 * x[0]);
+    }
+    points->SetPoint(i, y);
+  }
+  points->Modified();
+}
+
+bool CheckQueries(vtkAbstractCellLocator* locator, vtkUnstructuredGrid* grid,
+                  vtkPoints* points, vtkPoints* p1, vtkPoints* p2)
+{
+  vtkSmartPointer<vtkAbstractCellLocator> reference;
+  reference.TakeReference(locator->NewInstance());
+  reference->SetDataSet(grid);
+  reference->LazyEvaluationOff();
+  reference->BuildLocator();
+
+  vtkNew<vtkGenericCell> cell;
+  vtkIdType found = 0, hits = 0;
+  for (vtkIdType i = 0; i < NUMBER_OF_QUERIES; ++i)
+  {
+    double x[3], pc[3], w[4];
+    points->GetPoint(i, x);
+    // Points close to a face are inside both of its cells, the locators
+    // may return either one.
+    vtkIdType cellId = locator->FindCell(x, 0.0, cell.GetPointer(), pc, w);
+    vtkIdType cellIdRef = reference->FindCell(x, 0.0, cell.GetPointer(), pc, w);
+    double closest[3], dist2;
+    int subId;
+    if ((cellId < 0) != (cellIdRef < 0) || (cellId >= 0 &&
+        grid->GetCell(cellId)->EvaluatePosition(x, closest, subId, pc, dist2, w) != 1))
+    {
+      cerr << locator->GetClassName() << ": point " << i << " found in cell " << cellId
+           << " instead of " << cellIdRef << endl;
+      return false;
+    }
+    found += (cellId >= 0);
+
+    // Segments may hit cells sharing a face, only compare the distances.
+    double a0[3], a1[3], t, tRef, hitX[3];
+    p1->GetPoint(i, a0);
+    p2->GetPoint(i, a1);
+    int hit = locator->IntersectWithLine(a0, a1, 0.0, t, hitX, pc, subId, cellId,
+                                         cell.GetPointer());
+    int hitRef = reference->IntersectWithLine(a0, a1, 0.0, tRef, hitX, pc, subId,
+                                              cellIdRef, cell.GetPointer());
+    if (hit != hitRef || (hit && std::fabs(t - tRef) > 1.0e-9))
+    {
+      cerr << locator->GetClassName() << ": segment " << i << " hit " << hit << " at "
+           << t << " instead of " << hitRef << " at " << tRef << endl;
+      return false;
+    }
+    hits += hit;
+  }
+  return found > 0 && hits > 0;
+}
+
+}
+
+int TestCellLocatorRefit(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(11, 11, 11);
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputData(image.GetPointer());
+  tetrahedralize->Update();
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->DeepCopy(tetrahedralize->GetOutput());
+  vtkNew<vtkPoints> original;
+  original->DeepCopy(grid->GetPoints());
+
+  const double bounds[6] = { -2.0, 12.0, -2.0, 12.0, -2.0, 12.0 };
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkPoints> p1;
+  vtkNew<vtkPoints> p2;
+  RandomPoints(random.GetPointer(), bounds, points.GetPointer());
+  RandomPoints(random.GetPointer(), bounds, p1.GetPointer());
+  RandomPoints(random.GetPointer(), bounds, p2.GetPointer());
+
+  vtkSmartPointer<vtkAbstractCellLocator> locators[2] = {
+    vtkSmartPointer<vtkCellTreeLocator>::New(),
+    vtkSmartPointer<vtkModifiedBSPTree>::New()
+  };
+  vtkNew<vtkTimerLog> timer;
+  for (int i = 0; i < 2; ++i)
+  {
+    vtkAbstractCellLocator* locator = locators[i];
+    locator->SetDataSet(grid.GetPointer());
+    locator->LazyEvaluationOff();
+    locator->RefitSearchStructureOn();
+    timer->StartTimer();
+    locator->BuildLocator();
+    timer->StopTimer();
+    double build = timer->GetElapsedTime();
+    if (!CheckQueries(locator, grid.GetPointer(), points.GetPointer(), p1.GetPointer(),
+                      p2.GetPointer()))
+    {
+      return EXIT_FAILURE;
+    }
+
+    // Refit to a deformation, then to a rotation, and back to the
+    // original mesh.
+    for (int step = 0; step < 3; ++step)
+    {
+      if (step == 2)
+      {
+        grid->GetPoints()->DeepCopy(original.GetPointer());
+        grid->GetPoints()->Modified();
+      }
+      else
+      {
+        Deform(original.GetPointer(), grid->GetPoints(), step == 1);
+      }
+      timer->StartTimer();
+      locator->BuildLocator();
+      timer->StopTimer();
+      cout << locator->GetClassName() << " step " << step << ": " << build
+           << "s build, " << timer->GetElapsedTime() << "s refit" << endl;
+      if (!CheckQueries(locator, grid.GetPointer(), points.GetPointer(), p1.GetPointer(),
+                        p2.GetPointer()))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
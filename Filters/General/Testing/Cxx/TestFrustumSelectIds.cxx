@@ -0,0 +1,214 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFrustumSelectIds.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the ids selected by vtkExtractSelectedFrustum::SelectIds() and
+// the cells extracted by the filter with a serial test of every point and
+// cell of the input.
+
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkExtractSelectedFrustum.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPlanes.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vector>
+
+namespace
+{
+
+// Exposes the exact cell test of the filter
+class FrustumTester : public vtkExtractSelectedFrustum
+{
+public:
+  static FrustumTester* New();
+  vtkTypeMacro(FrustumTester, vtkExtractSelectedFrustum);
+
+  int CellIsect(double bounds[6], vtkCell* cell)
+  {
+    return this->ABoxFrustumIsect(bounds, cell);
+  }
+};
+vtkStandardNewMacro(FrustumTester);
+
+bool CheckIds(FrustumTester* frustum, vtkDataSet* input, bool cells)
+{
+  double bounds[6];
+  input->GetBounds(bounds);
+  frustum->OverallBoundsTest(bounds);
+  std::vector<vtkIdType> expected;
+  vtkIdType num = cells ? input->GetNumberOfCells() : input->GetNumberOfPoints();
+  for (vtkIdType id = 0; id < num; ++id)
+  {
+    int in;
+    if (cells)
+    {
+      input->GetCellBounds(id, bounds);
+      in = frustum->CellIsect(bounds, input->GetCell(id));
+    }
+    else
+    {
+      double x[3];
+      input->GetPoint(id, x);
+      in = frustum->GetFrustum()->EvaluateFunction(x) < 0.0;
+    }
+    if (in != frustum->GetInsideOut())
+    {
+      expected.push_back(id);
+    }
+  }
+
+  frustum->SetFieldType(cells ? vtkSelectionNode::CELL : vtkSelectionNode::POINT);
+  vtkNew<vtkSelection> selection;
+  frustum->SelectIds(input, selection.GetPointer());
+  vtkSelectionNode* node = selection->GetNode(0);
+  vtkIdTypeArray* ids = vtkArrayDownCast<vtkIdTypeArray>(node->GetSelectionList());
+  if (selection->GetNumberOfNodes() != 1 ||
+      node->GetContentType() != vtkSelectionNode::INDICES || !ids ||
+      ids->GetNumberOfTuples() != static_cast<vtkIdType>(expected.size()))
+  {
+    cerr << "Selected " << (ids ? ids->GetNumberOfTuples() : 0) << " ids instead of "
+         << expected.size() << endl;
+    return false;
+  }
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    if (ids->GetValue(i) != expected[i])
+    {
+      cerr << "Wrong selected id " << ids->GetValue(i) << endl;
+      return false;
+    }
+  }
+
+  // The extracted cells are the selected ones
+  if (cells && !frustum->GetInsideOut())
+  {
+    frustum->SetInputData(input);
+    frustum->PreserveTopologyOff();
+    frustum->Update();
+    vtkIdTypeArray* originalIds = vtkArrayDownCast<vtkIdTypeArray>(
+      vtkDataSet::SafeDownCast(frustum->GetOutput())
+        ->GetCellData()->GetArray("vtkOriginalCellIds"));
+    if (!originalIds || originalIds->GetNumberOfTuples() != ids->GetNumberOfTuples())
+    {
+      cerr << "Wrong number of extracted cells" << endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < ids->GetNumberOfTuples(); ++i)
+    {
+      if (originalIds->GetValue(i) != ids->GetValue(i))
+      {
+        cerr << "Wrong extracted cell " << originalIds->GetValue(i) << endl;
+        return false;
+      }
+    }
+  }
+  return !expected.empty() && expected.size() < static_cast<size_t>(num);
+}
+
+bool CheckDataSet(FrustumTester* frustum, vtkDataSet* input)
+{
+  for (int insideOut = 0; insideOut < 2; ++insideOut)
+  {
+    frustum->SetInsideOut(insideOut);
+    if (!CheckIds(frustum, input, true) || !CheckIds(frustum, input, false))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+int TestFrustumSelectIds(int, char*[])
+{
+  // A perspective frustum looking down -z, its apex near (0.3, 0.4, 3)
+  double verts[32];
+  for (int i = 0; i < 8; ++i)
+  {
+    double scale = (i & 1) ? 2.0 : 0.5;
+    verts[4 * i] = 0.3 + scale * ((i & 4) ? 0.25 : -0.2);
+    verts[4 * i + 1] = 0.4 + scale * ((i & 2) ? 0.15 : -0.3);
+    verts[4 * i + 2] = (i & 1) ? -1.0 : 2.0;
+    verts[4 * i + 3] = 1.0;
+  }
+  vtkNew<FrustumTester> frustum;
+  frustum->CreateFrustum(verts);
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(25, 25, 25);
+  image->SetSpacing(1.0 / 24, 1.0 / 24, 1.0 / 24);
+
+  // Random triangles, lines and vertices
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 6000; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetValue();
+      random->Next();
+    }
+    points->InsertNextPoint(x);
+  }
+  vtkNew<vtkCellArray> verts0;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    vtkIdType pts[3] = { 3 * i, 3 * i + 1, 3 * i + 2 };
+    polys->InsertNextCell(3, pts);
+    vtkIdType ends[2] = { 3000 + 2 * i, 3000 + 2 * i + 1 };
+    lines->InsertNextCell(2, ends);
+    verts0->InsertNextCell(1, &pts[0]);
+  }
+  vtkNew<vtkPolyData> poly;
+  poly->SetPoints(points.GetPointer());
+  poly->SetVerts(verts0.GetPointer());
+  poly->SetLines(lines.GetPointer());
+  poly->SetPolys(polys.GetPointer());
+
+  if (!CheckDataSet(frustum.GetPointer(), image.GetPointer()) ||
+      !CheckDataSet(frustum.GetPointer(), poly.GetPointer()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The culling bounds follow the changes of the points
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    points->SetPoint(i, x[1], x[2], x[0]);
+  }
+  points->Modified();
+  if (!CheckDataSet(frustum.GetPointer(), poly.GetPointer()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
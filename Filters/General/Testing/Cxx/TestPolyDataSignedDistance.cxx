@@ -0,0 +1,340 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataSignedDistance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the closest points and winding numbers of vtkBVHCellLocator with
+// vtkCellLocator and the exact ones of a sphere, and the signed distances
+// of vtkPolyDataSignedDistance with the ones of a sphere and a box, and the
+// signs with the inside of a concave prism.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellLocator.h"
+#include "vtkCellArray.h"
+#include "vtkCubeSource.h"
+#include "vtkDataArray.h"
+#include "vtkGenericCell.h"
+#include "vtkImageData.h"
+#include "vtkLinearExtrusionFilter.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkPolyDataSignedDistance.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+const double CENTER[3] = { 0.1, 0.2, 0.3 };
+const double RADIUS = 1.0;
+// Larger than the distance between the sphere and its tessellation
+const double SHELL = 0.01;
+
+double SphereDistance(const double x[3])
+{
+  return sqrt(vtkMath::Distance2BetweenPoints(x, CENTER)) - RADIUS;
+}
+
+// The signed distance to the box [-0.5,0.5] x [-1,1] x [-1.5,1.5]
+double BoxDistance(const double x[3])
+{
+  const double half[3] = { 0.5, 1.0, 1.5 };
+  double outside = 0.0, inside = -VTK_DOUBLE_MAX;
+  for (int i = 0; i < 3; ++i)
+  {
+    double d = fabs(x[i]) - half[i];
+    outside += std::max(d, 0.0) * std::max(d, 0.0);
+    inside = std::max(inside, d);
+  }
+  return ( inside > 0.0 ? sqrt(outside) : inside );
+}
+
+// A dart with a sharp tip and a concave vertex, extruded along z
+const int NUMBER_OF_CORNERS = 4;
+const double DART[NUMBER_OF_CORNERS][2] = { { 0.0, 0.0 }, { 3.0, 0.4 },
+                                            { 0.0, 0.8 }, { 1.0, 0.4 } };
+
+bool InsidePrism(const double x[3])
+{
+  bool inside = false;
+  for (int i = 0, j = NUMBER_OF_CORNERS - 1; i < NUMBER_OF_CORNERS; j = i++)
+  {
+    if ((DART[i][1] > x[1]) != (DART[j][1] > x[1]) &&
+        x[0] < DART[j][0] + (x[1] - DART[j][1]) * (DART[i][0] - DART[j][0]) /
+          (DART[i][1] - DART[j][1]))
+    {
+      inside = !inside;
+    }
+  }
+  return inside && x[2] > 0.0 && x[2] < 1.0;
+}
+
+bool CheckLocator(vtkPolyData* sphere, vtkPolyData* strips)
+{
+  vtkNew<vtkBVHCellLocator> bvh;
+  bvh->SetDataSet(sphere);
+  bvh->BuildLocator();
+  vtkNew<vtkBVHCellLocator> stripBVH;
+  stripBVH->SetDataSet(strips);
+  stripBVH->BuildLocator();
+  vtkNew<vtkCellLocator> reference;
+  reference->SetDataSet(sphere);
+  reference->BuildLocator();
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkGenericCell> cell;
+  for (int n = 0; n < 2000; ++n)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(CENTER[j] - 2.0, CENTER[j] + 2.0);
+      random->Next();
+    }
+    double closest[3], refClosest[3], dist2, refDist2;
+    vtkIdType cellId, refCellId;
+    int subId;
+    bvh->FindClosestPoint(x, closest, cell.GetPointer(), cellId, subId, dist2);
+    reference->FindClosestPoint(x, refClosest, refCellId, subId, refDist2);
+    if (cellId < 0 || fabs(dist2 - refDist2) > 1.0e-9 ||
+        fabs(dist2 - vtkMath::Distance2BetweenPoints(x, closest)) > 1.0e-9)
+    {
+      cerr << "Wrong closest point of (" << x[0] << ", " << x[1] << ", "
+           << x[2] << "): " << dist2 << " instead of " << refDist2 << endl;
+      return false;
+    }
+
+    // Within a radius smaller than the distance, nothing is found
+    int inside;
+    if (bvh->FindClosestPointWithinRadius(x, 0.9 * sqrt(refDist2), closest,
+          cell.GetPointer(), cellId, subId, dist2, inside) ||
+        !bvh->FindClosestPointWithinRadius(x, 1.1 * sqrt(refDist2), closest,
+          cell.GetPointer(), cellId, subId, dist2, inside))
+    {
+      cerr << "Wrong closest point within radius" << endl;
+      return false;
+    }
+
+    double distance = SphereDistance(x);
+    if (fabs(distance) < SHELL)
+    {
+      continue;
+    }
+    double expected = (distance < 0.0 ? 1.0 : 0.0);
+    if (fabs(bvh->GetWindingNumber(x) - expected) > 0.05 ||
+        fabs(stripBVH->GetWindingNumber(x) - expected) > 0.05)
+    {
+      cerr << "Wrong winding number " << bvh->GetWindingNumber(x) << ", "
+           << stripBVH->GetWindingNumber(x) << " instead of " << expected
+           << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compare the volume with a signed distance function. In narrow band mode,
+// the voxels out of the band are set to the width of the band.
+bool CheckVolume(vtkPolyDataSignedDistance* filter,
+                 double (*expected)(const double*), double tol)
+{
+  filter->Update();
+  vtkImageData* volume = filter->GetOutput();
+  vtkDataArray* scalars = volume->GetPointData()->GetArray("SignedDistance");
+  if (!scalars || scalars->GetNumberOfTuples() != volume->GetNumberOfPoints() ||
+      volume->GetNumberOfPoints() != 24 * 24 * 24)
+  {
+    cerr << "Missing signed distance" << endl;
+    return false;
+  }
+  double* spacing = volume->GetSpacing();
+  double width = filter->GetNarrowBandWidth() *
+    std::max(spacing[0], std::max(spacing[1], spacing[2]));
+  bool sign = filter->GetSignMethod() != vtkPolyDataSignedDistance::UNSIGNED;
+  for (vtkIdType ptId = 0; ptId < volume->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    volume->GetPoint(ptId, x);
+    double value = scalars->GetTuple1(ptId);
+    double distance = expected(x);
+    if (!sign)
+    {
+      distance = fabs(distance);
+    }
+    if (filter->GetNarrowBand() && fabs(distance) > width + tol)
+    {
+      distance = (distance < 0.0 ? -width : width);
+    }
+    if (fabs(value - distance) > tol &&
+        !(filter->GetNarrowBand() && fabs(fabs(distance) - width) < tol &&
+          fabs(fabs(value) - width) < tol))
+    {
+      cerr << "Wrong distance at (" << x[0] << ", " << x[1] << ", " << x[2]
+           << "): " << value << " instead of " << distance << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The sign of the voxels not on the surface is the one of the inside test
+bool CheckSigns(vtkPolyDataSignedDistance* filter)
+{
+  filter->Update();
+  vtkImageData* volume = filter->GetOutput();
+  vtkDataArray* scalars = volume->GetPointData()->GetArray("SignedDistance");
+  vtkIdType numInside = 0;
+  for (vtkIdType ptId = 0; ptId < volume->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    volume->GetPoint(ptId, x);
+    double value = scalars->GetTuple1(ptId);
+    if (fabs(value) < 1.0e-5)
+    {
+      continue;
+    }
+    numInside += InsidePrism(x);
+    if ((value < 0.0) != InsidePrism(x))
+    {
+      cerr << "Wrong sign at (" << x[0] << ", " << x[1] << ", " << x[2]
+           << "): " << value << endl;
+      return false;
+    }
+  }
+  return numInside > 0;
+}
+
+}
+
+int TestPolyDataSignedDistance(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(CENTER[0], CENTER[1], CENTER[2]);
+  sphere->SetRadius(RADIUS);
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+
+  // The triangle strips must keep the orientation of the triangles
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputConnection(sphere->GetOutputPort());
+  stripper->Update();
+  if (stripper->GetOutput()->GetNumberOfStrips() < 1 ||
+      !CheckLocator(sphere->GetOutput(), stripper->GetOutput()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPolyDataSignedDistance> filter;
+  filter->SetInputConnection(sphere->GetOutputPort());
+  filter->SetDimensions(24, 24, 24);
+  if (!CheckVolume(filter.GetPointer(), SphereDistance, SHELL))
+  {
+    return EXIT_FAILURE;
+  }
+  double* bounds = filter->GetOutput()->GetBounds();
+  if (bounds[0] >= CENTER[0] - RADIUS || bounds[1] <= CENTER[0] + RADIUS)
+  {
+    cerr << "Wrong automatic bounds" << endl;
+    return EXIT_FAILURE;
+  }
+  filter->SetSignMethodToWindingNumber();
+  if (!CheckVolume(filter.GetPointer(), SphereDistance, SHELL))
+  {
+    return EXIT_FAILURE;
+  }
+  filter->SetSignMethodToUnsigned();
+  if (!CheckVolume(filter.GetPointer(), SphereDistance, SHELL))
+  {
+    return EXIT_FAILURE;
+  }
+  filter->SetSignMethodToPseudoNormals();
+  filter->NarrowBandOn();
+  filter->SetNarrowBandWidth(2.0);
+  if (!CheckVolume(filter.GetPointer(), SphereDistance, SHELL))
+  {
+    return EXIT_FAILURE;
+  }
+  filter->SetInputConnection(stripper->GetOutputPort());
+  filter->SetSignMethodToWindingNumber();
+  if (!CheckVolume(filter.GetPointer(), SphereDistance, SHELL))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The quads of a box are triangulated, and its distance is exact: the
+  // pseudo normals of its edges and vertices give the sign around them.
+  vtkNew<vtkCubeSource> cube;
+  cube->SetXLength(1.0);
+  cube->SetYLength(2.0);
+  cube->SetZLength(3.0);
+  filter->SetInputConnection(cube->GetOutputPort());
+  filter->SetBounds(-1.3, 1.4, -1.7, 1.8, -2.2, 2.1);
+  filter->SetSignMethodToPseudoNormals();
+  filter->NarrowBandOff();
+  if (!CheckVolume(filter.GetPointer(), BoxDistance, 1.0e-5))
+  {
+    return EXIT_FAILURE;
+  }
+  filter->NarrowBandOn();
+  if (!CheckVolume(filter.GetPointer(), BoxDistance, 1.0e-5))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Around the sharp edges of a concave prism, the closest points of the
+  // voxels are on the edges and vertices: the sign is given by their pseudo
+  // normals, the ones of the faces are wrong.
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  polys->InsertNextCell(NUMBER_OF_CORNERS);
+  for (int i = 0; i < NUMBER_OF_CORNERS; ++i)
+  {
+    polys->InsertCellPoint(points->InsertNextPoint(DART[i][0], DART[i][1], 0.0));
+  }
+  vtkNew<vtkPolyData> dart;
+  dart->SetPoints(points.GetPointer());
+  dart->SetPolys(polys.GetPointer());
+  vtkNew<vtkLinearExtrusionFilter> extrusion;
+  extrusion->SetInputData(dart.GetPointer());
+  extrusion->SetExtrusionTypeToVectorExtrusion();
+  extrusion->SetVector(0.0, 0.0, 1.0);
+  extrusion->CappingOn();
+  vtkNew<vtkPolyDataNormals> orient;
+  orient->SetInputConnection(extrusion->GetOutputPort());
+  orient->SplittingOff();
+  orient->AutoOrientNormalsOn();
+  filter->SetInputConnection(orient->GetOutputPort());
+  filter->SetBounds(-0.37, 3.81, -1.29, 2.07, -0.43, 1.31);
+  filter->NarrowBandOff();
+  if (!CheckSigns(filter.GetPointer()))
+  {
+    return EXIT_FAILURE;
+  }
+  filter->SetSignMethodToWindingNumber();
+  if (!CheckSigns(filter.GetPointer()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -29,6 +29,8 @@
 #include "vtkPolyData.h"
 #include "vtkBoundingBox.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
 vtkStandardNewMacro(vtkCellTreeLocator);
 
@@ -250,6 +252,111 @@ class vtkCellTreeBuilder
     };
 
 
+    // A range of cells left by the top of the tree, built on its own
+    struct Subtree
+    {
+      unsigned int Index; // leaf of the top of the tree replaced by the subtree
+      float Min[3];
+      float Max[3];
+      std::vector<vtkCellTreeLocator::vtkCellTreeNode> Nodes;
+    };
+
+    // Fill the bounds of the cells and compute the bounds of the dataset
+    struct CellBoundsFunctor
+    {
+      vtkCellTreeLocator* Locator;
+      vtkDataSet* DataSet;
+      PerCell* Cells;
+      vtkSMPThreadLocal<std::vector<float> > LocalBounds;
+      float Min[3];
+      float Max[3];
+
+      CellBoundsFunctor( vtkCellTreeLocator* ctl, vtkDataSet* ds, PerCell* cells ) :
+        Locator(ctl), DataSet(ds), Cells(cells)
+      {
+        for( int d=0; d<3; ++d )
+        {
+          this->Min[d] =  std::numeric_limits<float>::max();
+          this->Max[d] = -std::numeric_limits<float>::max();
+        }
+      }
+
+      void Initialize()
+      {
+        std::vector<float>& b = this->LocalBounds.Local();
+        b.resize(6);
+        std::copy( this->Min, this->Min+3, b.begin() );
+        std::copy( this->Max, this->Max+3, b.begin()+3 );
+      }
+
+      void operator()( vtkIdType begin, vtkIdType end )
+      {
+        std::vector<float>& b = this->LocalBounds.Local();
+        double cellBounds[6];
+        for( vtkIdType i=begin; i<end; ++i )
+        {
+          PerCell& pc = this->Cells[i];
+          pc.Ind = i;
+
+          double *boundsPtr = cellBounds;
+          if (this->Locator->CellBounds)
+          {
+            boundsPtr = this->Locator->CellBounds[i];
+          }
+          else
+          {
+            this->DataSet->GetCellBounds(i, boundsPtr);
+          }
+
+          for( int d=0; d<3; ++d )
+          {
+            pc.Min[d] = boundsPtr[2*d+0];
+            pc.Max[d] = boundsPtr[2*d+1];
+            b[d] = std::min( b[d], pc.Min[d] );
+            b[d+3] = std::max( b[d+3], pc.Max[d] );
+          }
+        }
+      }
+
+      void Reduce()
+      {
+        vtkSMPThreadLocal<std::vector<float> >::iterator itr;
+        for( itr = this->LocalBounds.begin(); itr != this->LocalBounds.end(); ++itr )
+        {
+          for( int d=0; d<3; ++d )
+          {
+            this->Min[d] = std::min( this->Min[d], (*itr)[d] );
+            this->Max[d] = std::max( this->Max[d], (*itr)[d+3] );
+          }
+        }
+      }
+    };
+
+    // Build the subtrees with one builder each, sharing the cells
+    struct SubtreeFunctor
+    {
+      const vtkCellTreeBuilder& Parent;
+      std::vector<Subtree>& Subtrees;
+
+      SubtreeFunctor( const vtkCellTreeBuilder& parent, std::vector<Subtree>& subtrees ) :
+        Parent(parent), Subtrees(subtrees) {}
+
+      void operator()( vtkIdType begin, vtkIdType end )
+      {
+        for( vtkIdType i=begin; i<end; ++i )
+        {
+          Subtree& subtree = this->Subtrees[i];
+          vtkCellTreeBuilder builder;
+          builder.m_buckets = this->Parent.m_buckets;
+          builder.m_leafsize = this->Parent.m_leafsize;
+          builder.m_cells = this->Parent.m_cells;
+          builder.m_nodes.push_back( this->Parent.m_nodes[subtree.Index] );
+          builder.Split( 0, subtree.Min, subtree.Max );
+          subtree.Nodes.swap( builder.m_nodes );
+        }
+      }
+    };
+
     // -------------------------------------------------------------------------
 
     void FindMinMax( const PerCell* begin, const PerCell* end,
@@ -289,8 +396,19 @@ class vtkCellTreeBuilder
         return;
       }
 
-      PerCell* begin = &(this->m_pc[start]);
-      PerCell* end   = &(this->m_pc[0])+start + size;
+      // Leave the smaller ranges to be built concurrently
+      if( this->m_subtrees && size < this->m_subtreesize )
+      {
+        Subtree subtree;
+        subtree.Index = index;
+        std::copy( min, min+3, subtree.Min );
+        std::copy( max, max+3, subtree.Max );
+        this->m_subtrees->push_back( subtree );
+        return;
+      }
+
+      PerCell* begin = this->m_cells + start;
+      PerCell* end   = this->m_cells + start + size;
       PerCell* mid = begin;
 
       const int nbuckets = 6;
@@ -396,8 +514,8 @@ class vtkCellTreeBuilder
       float clip[2] = { lmax[dim], rmin[dim]};
 
       vtkCellTreeLocator::vtkCellTreeNode child[2];
-      child[0].MakeLeaf( begin - &(this->m_pc[0]), mid-begin );
-      child[1].MakeLeaf( mid   - &(this->m_pc[0]), end-mid );
+      child[0].MakeLeaf( begin - this->m_cells, mid-begin );
+      child[1].MakeLeaf( mid   - this->m_cells, end-mid );
 
       this->m_nodes[index].MakeNode( (int)m_nodes.size(), dim, clip );
       this->m_nodes.insert( m_nodes.end(), child, child+2 );
@@ -412,58 +530,27 @@ class vtkCellTreeBuilder
     {
       this->m_buckets =  5;
       this->m_leafsize = 8;
+      this->m_cells = nullptr;
+      this->m_subtreesize = 0;
+      this->m_subtrees = nullptr;
     }
 
     void Build( vtkCellTreeLocator *ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds )
     {
       const vtkIdType size = ds->GetNumberOfCells();
-      double cellBounds[6];
       this->m_pc.resize(size);
+      this->m_cells = &this->m_pc[0];
 
-      float min[3] =
-        {
-        std::numeric_limits<float>::max(),
-        std::numeric_limits<float>::max(),
-        std::numeric_limits<float>::max()
-        };
-
-      float max[3] =
-        {
-        -std::numeric_limits<float>::max(),
-        -std::numeric_limits<float>::max(),
-        -std::numeric_limits<float>::max(),
-        };
-
-      for( vtkIdType i=0; i<size; ++i )
+      // The first call builds the cells of the dataset if needed
+      double cellBounds[6];
+      if (!ctl->CellBounds)
       {
-        this->m_pc[i].Ind = i;
-
-        double *boundsPtr = cellBounds;
-        if (ctl->CellBounds)
-        {
-          boundsPtr = ctl->CellBounds[i];
-        }
-        else
-        {
-          ds->GetCellBounds(i, boundsPtr);
-        }
-
-        for( int d=0; d<3; ++d )
-        {
-          this->m_pc[i].Min[d] = boundsPtr[2*d+0];
-          this->m_pc[i].Max[d] = boundsPtr[2*d+1];
-
-          if( this->m_pc[i].Min[d] < min[d] )
-          {
-            min[d] = this->m_pc[i].Min[d];
-          }
-
-          if( this->m_pc[i].Max[d] > max[d] )  /// This can be m_pc[i].max[d] instead of min
-          {
-            max[d] = this->m_pc[i].Max[d];
-          }
-        }
+        ds->GetCellBounds(0, cellBounds);
       }
+      CellBoundsFunctor functor( ctl, ds, this->m_cells );
+      vtkSMPTools::For( 0, size, functor );
+      const float* min = functor.Min;
+      const float* max = functor.Max;
 
       ct.DataBBox[0] = min[0];
       ct.DataBBox[1] = max[0];
@@ -476,7 +563,42 @@ class vtkCellTreeBuilder
       root.MakeLeaf( 0, size );
       this->m_nodes.push_back( root );
 
-      Split( 0, min, max );
+      // Split the top of the tree until there are enough subtrees to keep
+      // the threads busy, then build the subtrees concurrently and append
+      // them to the top.
+      std::vector<Subtree> subtrees;
+      unsigned int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+      this->m_subtreesize = std::max( 4096u, static_cast<unsigned int>(size) / (4*numThreads) );
+      this->m_subtrees = &subtrees;
+      float rootMin[3] = { min[0], min[1], min[2] };
+      float rootMax[3] = { max[0], max[1], max[2] };
+      Split( 0, rootMin, rootMax );
+      this->m_subtrees = nullptr;
+
+      SubtreeFunctor subtreeFunctor( *this, subtrees );
+      vtkSMPTools::For( 0, static_cast<vtkIdType>(subtrees.size()), 1, subtreeFunctor );
+      for( std::vector<Subtree>::iterator st = subtrees.begin(); st != subtrees.end(); ++st )
+      {
+        // The root of the subtree replaces its leaf, the other nodes are
+        // appended and their children renumbered.
+        unsigned int offset = static_cast<unsigned int>(this->m_nodes.size()) - 1;
+        for( size_t i=0; i<st->Nodes.size(); ++i )
+        {
+          vtkCellTreeLocator::vtkCellTreeNode node = st->Nodes[i];
+          if( node.IsNode() )
+          {
+            node.SetChildren( node.GetLeftChildIndex() + offset );
+          }
+          if( i == 0 )
+          {
+            this->m_nodes[st->Index] = node;
+          }
+          else
+          {
+            this->m_nodes.push_back( node );
+          }
+        }
+      }
 
       ct.Nodes.resize( this->m_nodes.size() );
       ct.Nodes[0] = this->m_nodes[0];
@@ -514,6 +636,9 @@ class vtkCellTreeBuilder
     unsigned int     m_leafsize;
     std::vector<PerCell>   m_pc;
     std::vector<vtkCellTreeLocator::vtkCellTreeNode>    m_nodes;
+    PerCell*         m_cells; // cells being split, shared by the subtree builders
+    unsigned int     m_subtreesize;
+    std::vector<Subtree>*  m_subtrees;
 };
 
 //----------------------------------------------------------------------------
@@ -570,9 +695,115 @@ void vtkCellTreeLocator::ForceBuildLocator()
     vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
     return;
   }
+  // only update the bounds if RefitSearchStructure is ON and the cells are the same
+  if ( (this->Tree) && this->RefitSearchStructure &&
+    (static_cast<vtkIdType>(this->Tree->Leaves.size()) == this->DataSet->GetNumberOfCells()))
+  {
+    this->RefitLocatorInternal();
+    return;
+  }
   this->BuildLocatorInternal();
 }
 //----------------------------------------------------------------------------
+namespace
+{
+// Compute the bounds of the cells of each leaf
+struct vtkCellTreeLeafBounds
+{
+  vtkCellTreeLocator::vtkCellTree* Tree;
+  double (*CellBounds)[6];
+  vtkDataSet* DataSet;
+  float* Bounds;
+
+  void operator()( vtkIdType begin, vtkIdType end )
+  {
+    double cellBounds[6];
+    for( vtkIdType n=begin; n<end; ++n )
+    {
+      const vtkCellTreeLocator::vtkCellTreeNode& node = this->Tree->Nodes[n];
+      if( !node.IsLeaf() )
+      {
+        continue;
+      }
+      float* b = this->Bounds + 6*n;
+      for( int d=0; d<3; ++d )
+      {
+        b[2*d] =  std::numeric_limits<float>::max();
+        b[2*d+1] = -std::numeric_limits<float>::max();
+      }
+      const unsigned int* cell = &this->Tree->Leaves.front() + node.Start();
+      const unsigned int* cellEnd = cell + node.Size();
+      for( ; cell!=cellEnd; ++cell )
+      {
+        double *boundsPtr = cellBounds;
+        if( this->CellBounds )
+        {
+          boundsPtr = this->CellBounds[*cell];
+        }
+        else
+        {
+          this->DataSet->GetCellBounds(*cell, boundsPtr);
+        }
+        for( int d=0; d<3; ++d )
+        {
+          b[2*d] = std::min( b[2*d], static_cast<float>(boundsPtr[2*d]) );
+          b[2*d+1] = std::max( b[2*d+1], static_cast<float>(boundsPtr[2*d+1]) );
+        }
+      }
+    }
+  }
+};
+}
+//----------------------------------------------------------------------------
+void vtkCellTreeLocator::RefitLocatorInternal()
+{
+  vtkDebugMacro(<< "Refitting cell tree");
+  if (this->CellBounds)
+  {
+    this->FreeCellBounds();
+    this->StoreCellBounds();
+  }
+  else
+  {
+    // The first call builds the cells of the dataset if needed
+    double cellBounds[6];
+    this->DataSet->GetCellBounds(0, cellBounds);
+  }
+
+  // Leaves first, then the nodes from the last one since the children of
+  // a node are stored after it
+  vtkIdType numNodes = static_cast<vtkIdType>(this->Tree->Nodes.size());
+  std::vector<float> bounds(6*numNodes);
+  vtkCellTreeLeafBounds functor;
+  functor.Tree = this->Tree;
+  functor.CellBounds = this->CellBounds;
+  functor.DataSet = this->DataSet;
+  functor.Bounds = &bounds[0];
+  vtkSMPTools::For( 0, numNodes, functor );
+
+  for( vtkIdType n=numNodes-1; n>=0; --n )
+  {
+    vtkCellTreeNode& node = this->Tree->Nodes[n];
+    if( node.IsLeaf() )
+    {
+      continue;
+    }
+    const float* lb = &bounds[6*node.GetLeftChildIndex()];
+    const float* rb = &bounds[6*node.GetRightChildIndex()];
+    float* b = &bounds[6*n];
+    for( int d=0; d<3; ++d )
+    {
+      b[2*d] = std::min( lb[2*d], rb[2*d] );
+      b[2*d+1] = std::max( lb[2*d+1], rb[2*d+1] );
+    }
+    unsigned int dim = node.GetDimension();
+    float clip[2] = { lb[2*dim+1], rb[2*dim] };
+    node.MakeNode( node.GetLeftChildIndex(), dim, clip );
+  }
+  std::copy( bounds.begin(), bounds.begin()+6, this->Tree->DataBBox );
+  this->BuildTime.Modified();
+}
+//----------------------------------------------------------------------------
 void vtkCellTreeLocator::BuildLocatorInternal()
 {
   this->FreeSearchStructure();
@@ -681,18 +912,6 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3],
                                           int &subId,
                                           vtkIdType &cellId,
                                           vtkGenericCell *cell)
-{
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-  {
-    this->DataSet->GetCell(cellId, cell);
-  }
-  return hit;
-}
-
-int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol,
-  double& t, double x[3], double pcoords[3],
-  int &subId, vtkIdType &cellIds)
 {
   //
   vtkCellTreeNode  *node, *near, *far;
@@ -797,21 +1016,22 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
       {
         this->DataSet->GetCellBounds(cell_ID, cellBounds);
       }
+      // the cells of a leaf are not sorted along the ray, skip rather than stop
       if (_getMinDist(p1, ray_vec, boundsPtr) > closest_intersection)
       {
-        break;
+        continue;
       }
       //
       ctmin = _tmin; ctmax = _tmax;
       if (this->RayMinMaxT(boundsPtr, p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, cell))
         {
           if (t_hit<closest_intersection)
           {
             HIT = true;
             closest_intersection = t_hit;
-            cellIds = cell_ID;
+            cellId = cell_ID;
             x[0] = ipt[0];
             x[1] = ipt[1];
             x[2] = ipt[2];
@@ -826,11 +1046,29 @@ int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol
   if (HIT)
   {
     t = closest_intersection;
+    this->DataSet->GetCell(cellId, cell);
   }
   //
   return HIT;
 
 }
+
+//----------------------------------------------------------------------------
+int vtkCellTreeLocator::IntersectWithLine(double p1[3], double p2[3], double tol,
+  double& t, double x[3], double pcoords[3],
+  int &subId, vtkIdType &cellId)
+{
+  return this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId,
+                                 this->GenericCell);
+}
+
+//----------------------------------------------------------------------------
+bool vtkCellTreeLocator::PrepareForConcurrentQueries()
+{
+  this->Superclass::PrepareForConcurrentQueries();
+  this->BuildLocatorIfNeeded();
+  return this->Tree != nullptr;
+}
 //----------------------------------------------------------------------------
 bool vtkCellTreeLocator::RayMinMaxT(const double origin[3],
   const double dir[3],
@@ -1222,8 +1460,23 @@ int vtkCellTreeLocator::IntersectCellInternal(
   double pcoords[3],
   int &subId)
 {
-  this->DataSet->GetCell(cell_ID, this->GenericCell);
-  return this->GenericCell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
+  return this->IntersectCellInternal(cell_ID, p1, p2, tol, t, ipt, pcoords, subId,
+                                     this->GenericCell);
+}
+//----------------------------------------------------------------------------
+int vtkCellTreeLocator::IntersectCellInternal(
+  vtkIdType cell_ID,
+  const double p1[3],
+  const double p2[3],
+  const double tol,
+  double &t,
+  double ipt[3],
+  double pcoords[3],
+  int &subId,
+  vtkGenericCell *cell)
+{
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
 //----------------------------------------------------------------------------
 void vtkCellTreeLocator::FreeSearchStructure(void)
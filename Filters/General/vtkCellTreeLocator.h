@@ -237,6 +237,24 @@ protected:
     double pcoords[3],
     int &subId);
 
+  // Same as above, using the given cell instead of this->GenericCell.
+  // IntersectWithLine() calls this version, so that concurrent queries
+  // with different cells are thread safe once the tree is built.
+  virtual int IntersectCellInternal( vtkIdType cell_ID,  const double p1[3],
+    const double p2[3],
+    const double tol,
+    double &t,
+    double ipt[3],
+    double pcoords[3],
+    int &subId,
+    vtkGenericCell *cell);
+
+  bool PrepareForConcurrentQueries() override;
+
+  // Update the split planes of the existing tree from the current cell
+  // bounds, see RefitSearchStructure.
+  virtual void RefitLocatorInternal();
+
 
     int NumberOfBuckets;
 
@@ -16,7 +16,9 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImplicitFunction.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -35,6 +37,11 @@
 #include "vtkLine.h"
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
 
 vtkStandardNewMacro(vtkExtractSelectedFrustum);
 vtkCxxSetObjectMacro(vtkExtractSelectedFrustum,Frustum,vtkPlanes);
@@ -42,6 +49,165 @@ vtkCxxSetObjectMacro(vtkExtractSelectedFrustum,Frustum,vtkPlanes);
 //set to 4 to ignore the near and far planes which are almost always passed
 #define MAXPLANE 6
 
+namespace
+{
+// Number of consecutive cells whose bounds are grouped for culling
+const vtkIdType BLOCK_SIZE = 64;
+}
+
+//----------------------------------------------------------------------------
+// Bounds of the blocks of cells of the last input, and the functors
+// classifying the points and cells in parallel.
+class vtkExtractSelectedFrustum::vtkInternals
+{
+public:
+  vtkInternals() : BlockInput(nullptr) {}
+
+  std::vector<double> BlockBounds;
+  vtkDataSet *BlockInput; // only used to detect a new input
+  vtkTimeStamp BlockTime;
+
+  //--------------------------------------------------------------------------
+  struct ComputeBlockBounds
+  {
+    vtkDataSet *Input;
+    double *Bounds;
+    vtkIdType NumCells;
+    vtkSMPThreadLocalObject<vtkIdList> PtIds;
+
+    ComputeBlockBounds(vtkDataSet *input, double *bounds) :
+      Input(input), Bounds(bounds), NumCells(input->GetNumberOfCells())
+    {
+    }
+
+    void Initialize()
+    {
+      this->PtIds.Local()->Allocate(VTK_CELL_SIZE);
+    }
+
+    void operator() (vtkIdType block, vtkIdType endBlock)
+    {
+      vtkIdList *ptIds = this->PtIds.Local();
+      vtkIdType npts;
+      const vtkIdType *pts;
+      double x[3];
+      for ( ; block < endBlock; ++block)
+      {
+        double *bounds = this->Bounds + 6*block;
+        bounds[0] = bounds[2] = bounds[4] = VTK_DOUBLE_MAX;
+        bounds[1] = bounds[3] = bounds[5] = -VTK_DOUBLE_MAX;
+        vtkIdType cellId = block*BLOCK_SIZE;
+        vtkIdType endCellId = std::min(cellId + BLOCK_SIZE, this->NumCells);
+        for ( ; cellId < endCellId; ++cellId)
+        {
+          this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            this->Input->GetPoint(pts[i], x);
+            for (int j = 0; j < 3; ++j)
+            {
+              bounds[2*j] = std::min(bounds[2*j], x[j]);
+              bounds[2*j+1] = std::max(bounds[2*j+1], x[j]);
+            }
+          }
+        }
+      }
+    }
+
+    void Reduce()
+    {
+    }
+  };
+
+  //--------------------------------------------------------------------------
+  struct ClassifyPoints
+  {
+    vtkExtractSelectedFrustum *Self;
+    vtkDataSet *Input;
+    signed char *Signs;
+
+    ClassifyPoints(vtkExtractSelectedFrustum *self, vtkDataSet *input,
+                   signed char *signs) :
+      Self(self), Input(input), Signs(signs)
+    {
+    }
+
+    void operator() (vtkIdType ptId, vtkIdType endPtId)
+    {
+      double x[3];
+      for ( ; ptId < endPtId; ++ptId)
+      {
+        this->Input->GetPoint(ptId, x);
+        double val = -VTK_DOUBLE_MAX;
+        for (int pid = 0; pid < 6; ++pid)
+        {
+          val = std::max(val, vtkPlane::Evaluate(this->Self->PlaneNormals[pid],
+            this->Self->PlaneOrigins[pid], x));
+        }
+        this->Signs[ptId] = (val < 0.0 ? -1 : (val > 0.0 ? 1 : 0));
+      }
+    }
+  };
+
+  //--------------------------------------------------------------------------
+  // Cells of blocks entirely inside or outside the frustum are classified
+  // with their block, the other ones are tested exactly.
+  struct ClassifyCells
+  {
+    vtkExtractSelectedFrustum *Self;
+    vtkDataSet *Input;
+    const double *BlockBounds;
+    vtkIdType NumCells;
+    signed char *CellsIn;
+    vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+    ClassifyCells(vtkExtractSelectedFrustum *self, vtkDataSet *input,
+                  const double *blockBounds, signed char *cellsIn) :
+      Self(self), Input(input), BlockBounds(blockBounds),
+      NumCells(input->GetNumberOfCells()), CellsIn(cellsIn)
+    {
+    }
+
+    void Initialize()
+    {
+    }
+
+    void operator() (vtkIdType block, vtkIdType endBlock)
+    {
+      vtkGenericCell *cell = this->Cell.Local();
+      double bounds[6];
+      for ( ; block < endBlock; ++block)
+      {
+        const double *blockBounds = this->BlockBounds + 6*block;
+        vtkIdType cellId = block*BLOCK_SIZE;
+        vtkIdType endCellId = std::min(cellId + BLOCK_SIZE, this->NumCells);
+        int rc = -1;
+        if (blockBounds[0] <= blockBounds[1])
+        {
+          rc = this->Self->BoundsFrustumTest(blockBounds);
+        }
+        if (rc >= 0)
+        {
+          std::fill(this->CellsIn + cellId, this->CellsIn + endCellId,
+                    static_cast<signed char>(rc));
+          continue;
+        }
+        for ( ; cellId < endCellId; ++cellId)
+        {
+          this->Input->GetCell(cellId, cell);
+          cell->GetBounds(bounds);
+          this->CellsIn[cellId] = static_cast<signed char>(
+            this->Self->ABoxFrustumIsect(bounds, cell));
+        }
+      }
+    }
+
+    void Reduce()
+    {
+    }
+  };
+};
+
 //----------------------------------------------------------------------------
 vtkExtractSelectedFrustum::vtkExtractSelectedFrustum(vtkPlanes *f)
 {
@@ -80,6 +246,8 @@ vtkExtractSelectedFrustum::vtkExtractSelectedFrustum(vtkPlanes *f)
     this->Frustum = vtkPlanes::New();
     this->CreateFrustum(verts);
   }
+
+  this->Internals = new vtkInternals;
 }
 
 //----------------------------------------------------------------------------
@@ -87,6 +255,7 @@ vtkExtractSelectedFrustum::~vtkExtractSelectedFrustum()
 {
   this->Frustum->Delete();
   this->ClipPoints->Delete();
+  delete this->Internals;
 }
 
 //----------------------------------------------------------------------------
@@ -438,6 +607,14 @@ int vtkExtractSelectedFrustum::RequestData(
 
   flag = -flag;
 
+  //classify the points, and the cells when needed, in parallel
+  std::vector<signed char> pointSigns(numPts);
+  std::vector<signed char> cellsIn(
+    this->FieldType == vtkSelectionNode::CELL ? numCells : 0);
+  this->ClassifyInput(input, (pointSigns.empty() ? nullptr : &pointSigns[0]),
+                      (cellsIn.empty() ? nullptr : &cellsIn[0]));
+  this->UpdateProgress(0.5);
+
   vtkIdType updateInterval;
 
   if (this->FieldType == vtkSelectionNode::CELL)
@@ -464,19 +641,17 @@ int vtkExtractSelectedFrustum::RequestData(
     {
       if ( ! (cellId % updateInterval) ) //manage progress reports
       {
-          this->UpdateProgress (static_cast<double>(cellId) / numCells);
+          this->UpdateProgress (0.5 + 0.5*cellId / numCells);
       }
 
-      input->GetCellBounds(cellId, bounds);
-
-      cell = input->GetCell(cellId);
-      cellPts = cell->GetPointIds();
-      numCellPts = cell->GetNumberOfPoints();
-      newCellPts->Reset();
-
-      isect = this->ABoxFrustumIsect(bounds, cell);
+      isect = cellsIn[cellId];
       if ((isect == 1 && flag == 1) || (isect == 0 && flag == -1))
       {
+        cell = input->GetCell(cellId);
+        cellPts = cell->GetPointIds();
+        numCellPts = cell->GetNumberOfPoints();
+        newCellPts->Reset();
+
         /*
         NUMCELLS++;
         */
@@ -554,7 +729,7 @@ int vtkExtractSelectedFrustum::RequestData(
       if (pointMap[ptId] == -1) //point wasn't attached to a cell
       {
         input->GetPoint(ptId,x);
-        if ((this->Frustum->EvaluateFunction(x) * flag) < 0.0)
+        if (pointSigns[ptId] * flag < 0)
         {
           /*
           NUMPTS++;
@@ -586,12 +761,12 @@ int vtkExtractSelectedFrustum::RequestData(
 
       if ( ! (ptId % updateInterval) ) //manage progress reports
       {
-          this->UpdateProgress (static_cast<double>(ptId) / numPts);
+          this->UpdateProgress (0.5 + 0.5*ptId / numPts);
       }
 
       input->GetPoint(ptId,x);
       pointMap[ptId] = -1;
-      if ((this->Frustum->EvaluateFunction(x) * flag) < 0.0)
+      if (pointSigns[ptId] * flag < 0)
       {
         /*
         NUMPTS++;
@@ -753,19 +928,7 @@ int vtkExtractSelectedFrustum::RequestData(
 //--------------------------------------------------------------------------
 int vtkExtractSelectedFrustum::OverallBoundsTest(double *bounds)
 {
-  vtkIdType i;
-  double x[3];
-
-  //find the near and far vertices to each plane for quick in/out tests
-  for (i = 0; i < MAXPLANE; i++)
-  {
-    this->Frustum->GetNormals()->GetTuple(i, x);
-    int xside = (x[0] > 0) ? 1:0;
-    int yside = (x[1] > 0) ? 1:0;
-    int zside = (x[2] > 0) ? 1:0;
-    this->np_vertids[i][0] = (1-xside)*4+(1-yside)*2+(1-zside);
-    this->np_vertids[i][1] = xside*4+yside*2+zside;
-  }
+  this->ComputePlanes();
 
   vtkVoxel *vox = vtkVoxel::New();
   vtkPoints *p = vox->GetPoints();
@@ -785,79 +948,71 @@ int vtkExtractSelectedFrustum::OverallBoundsTest(double *bounds)
 }
 
 //--------------------------------------------------------------------------
-//Intersect the cell (with its associated bounds) with the clipping frustum.
-//Return 1 if at least partially inside, 0 otherwise.
-//Also return a distance to the near plane.
-int vtkExtractSelectedFrustum::ABoxFrustumIsect(double *bounds, vtkCell *cell)
+void vtkExtractSelectedFrustum::ComputePlanes()
 {
-  if (bounds[0] > bounds[1] ||
-      bounds[2] > bounds[3] ||
-      bounds[4] > bounds[5])
+  //find the near and far vertices to each plane for quick in/out tests
+  for (int i = 0; i < MAXPLANE; i++)
   {
-    return this->IsectDegenerateCell(cell);
+    double *x = this->PlaneNormals[i];
+    this->Frustum->GetNormals()->GetTuple(i, x);
+    this->Frustum->GetPoints()->GetPoint(i, this->PlaneOrigins[i]);
+    int xside = (x[0] > 0) ? 1:0;
+    int yside = (x[1] > 0) ? 1:0;
+    int zside = (x[2] > 0) ? 1:0;
+    this->np_vertids[i][0] = (1-xside)*4+(1-yside)*2+(1-zside);
+    this->np_vertids[i][1] = xside*4+yside*2+zside;
   }
+}
 
-  //convert bounds to 8 vertices
+//--------------------------------------------------------------------------
+int vtkExtractSelectedFrustum::BoundsFrustumTest(const double bounds[6])
+{
+  //convert bounds to 8 vertices, vertex i is at bounds[(i>>2)&1],
+  //bounds[2+((i>>1)&1)], bounds[4+(i&1)]
   double verts[8][3];
-  verts[0][0] = bounds[0];
-  verts[0][1] = bounds[2];
-  verts[0][2] = bounds[4];
-  verts[1][0] = bounds[0];
-  verts[1][1] = bounds[2];
-  verts[1][2] = bounds[5];
-  verts[2][0] = bounds[0];
-  verts[2][1] = bounds[3];
-  verts[2][2] = bounds[4];
-  verts[3][0] = bounds[0];
-  verts[3][1] = bounds[3];
-  verts[3][2] = bounds[5];
-  verts[4][0] = bounds[1];
-  verts[4][1] = bounds[2];
-  verts[4][2] = bounds[4];
-  verts[5][0] = bounds[1];
-  verts[5][1] = bounds[2];
-  verts[5][2] = bounds[5];
-  verts[6][0] = bounds[1];
-  verts[6][1] = bounds[3];
-  verts[6][2] = bounds[4];
-  verts[7][0] = bounds[1];
-  verts[7][1] = bounds[3];
-  verts[7][2] = bounds[5];
+  for (int i = 0; i < 8; i++)
+  {
+    verts[i][0] = bounds[(i>>2)&1];
+    verts[i][1] = bounds[2+((i>>1)&1)];
+    verts[i][2] = bounds[4+(i&1)];
+  }
 
+  //reject if any plane rejects the entire bbox, accept if the entire bbox
+  //is inside all planes
   int intersect = 0;
-
-  //reject if any plane rejects the entire bbox
   for (int pid = 0; pid < MAXPLANE; pid++)
   {
-    vtkPlane *plane = this->Frustum->GetPlane(pid);
-    double dist;
-    int nvid;
-    int pvid;
-    nvid = this->np_vertids[pid][0];
-    dist = plane->EvaluateFunction(verts[nvid]);
-    if (dist > 0.0)
+    double *n = this->PlaneNormals[pid];
+    double *o = this->PlaneOrigins[pid];
+    if (vtkPlane::Evaluate(n, o, verts[this->np_vertids[pid][0]]) > 0.0)
     {
-      /*
-      this->NumRejects++;
-      */
       return 0;
     }
-    pvid = this->np_vertids[pid][1];
-    dist = plane->EvaluateFunction(verts[pvid]);
-    if (dist > 0.0)
+    if (vtkPlane::Evaluate(n, o, verts[this->np_vertids[pid][1]]) > 0.0)
     {
       intersect = 1;
-      break;
     }
   }
+  return (intersect ? -1 : 1);
+}
 
-  //accept if entire bbox is inside all planes
-  if (!intersect)
+//--------------------------------------------------------------------------
+//Intersect the cell (with its associated bounds) with the clipping frustum.
+//Return 1 if at least partially inside, 0 otherwise.
+//Also return a distance to the near plane.
+int vtkExtractSelectedFrustum::ABoxFrustumIsect(double *bounds, vtkCell *cell)
+{
+  if (bounds[0] > bounds[1] ||
+      bounds[2] > bounds[3] ||
+      bounds[4] > bounds[5])
   {
-    /*
-    this->NumAccepts++;
-    */
-    return 1;
+    return this->IsectDegenerateCell(cell);
+  }
+
+  int rc = this->BoundsFrustumTest(bounds);
+  if (rc >= 0)
+  {
+    return rc;
   }
 
   //otherwise we have to do clipping tests to decide if actually insects
@@ -1137,10 +1292,7 @@ void vtkExtractSelectedFrustum::PlaneClipEdge(double *V0, double *V1, int pid,
   double t = 0.0;
   double ISECT[3];
   int rc = vtkPlane::IntersectWithLine(
-    V0, V1,
-    this->Frustum->GetNormals()->GetTuple(pid),
-    this->Frustum->GetPoints()->GetPoint(pid),
-    t, ISECT);
+    V0, V1, this->PlaneNormals[pid], this->PlaneOrigins[pid], t, ISECT);
 
   if (rc)
   {
@@ -1150,9 +1302,8 @@ void vtkExtractSelectedFrustum::PlaneClipEdge(double *V0, double *V1, int pid,
     noverts++;
   }
 
-  vtkPlane *plane = this->Frustum->GetPlane(pid);
-
-  if (plane->EvaluateFunction(V1) < 0.0)
+  if (vtkPlane::Evaluate(this->PlaneNormals[pid], this->PlaneOrigins[pid],
+                         V1) < 0.0)
   {
     overts[noverts*3+0] = V1[0];
     overts[noverts*3+1] = V1[1];
@@ -1161,6 +1312,96 @@ void vtkExtractSelectedFrustum::PlaneClipEdge(double *V0, double *V1, int pid,
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkExtractSelectedFrustum::ClassifyInput(vtkDataSet *input,
+                                              signed char *pointSigns,
+                                              signed char *cellsIn)
+{
+  input->PrepareForConcurrentReads();
+
+  if (pointSigns)
+  {
+    vtkInternals::ClassifyPoints classifyPoints(this, input, pointSigns);
+    vtkSMPTools::For(0, input->GetNumberOfPoints(), classifyPoints);
+  }
+
+  vtkIdType numCells = input->GetNumberOfCells();
+  if (cellsIn && numCells > 0)
+  {
+    vtkIdType numBlocks = (numCells - 1) / BLOCK_SIZE + 1;
+    vtkInternals *internals = this->Internals;
+    if (internals->BlockInput != input ||
+        input->GetMTime() > internals->BlockTime ||
+        static_cast<vtkIdType>(internals->BlockBounds.size()) != 6*numBlocks)
+    {
+      internals->BlockBounds.resize(6*numBlocks);
+      vtkInternals::ComputeBlockBounds computeBounds(input,
+        &internals->BlockBounds[0]);
+      vtkSMPTools::For(0, numBlocks, computeBounds);
+      internals->BlockInput = input;
+      internals->BlockTime.Modified();
+    }
+
+    vtkInternals::ClassifyCells classifyCells(this, input,
+      &internals->BlockBounds[0], cellsIn);
+    vtkSMPTools::For(0, numBlocks, classifyCells);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkExtractSelectedFrustum::SelectIds(vtkDataSet *input,
+                                          vtkSelection *selection)
+{
+  selection->RemoveAllNodes();
+  vtkSelectionNode *node = vtkSelectionNode::New();
+  node->SetContentType(vtkSelectionNode::INDICES);
+  vtkIdTypeArray *ids = vtkIdTypeArray::New();
+  node->SetSelectionList(ids);
+  ids->Delete();
+  selection->AddNode(node);
+  node->Delete();
+
+  bool cells = (this->FieldType == vtkSelectionNode::CELL);
+  node->SetFieldType(cells ? vtkSelectionNode::CELL : vtkSelectionNode::POINT);
+  if (!cells && this->ContainingCells)
+  {
+    node->GetProperties()->Set(vtkSelectionNode::CONTAINING_CELLS(), 1);
+  }
+
+  if (!this->Frustum || this->Frustum->GetNumberOfPlanes() != 6)
+  {
+    vtkErrorMacro(<<"Frustum must have six planes.");
+    return;
+  }
+
+  double bounds[6];
+  input->GetBounds(bounds);
+  if (!this->OverallBoundsTest(bounds) && !this->InsideOut)
+  {
+    return;
+  }
+
+  vtkIdType num = (cells ? input->GetNumberOfCells() :
+                   input->GetNumberOfPoints());
+  std::vector<signed char> flags(num);
+  if (num > 0)
+  {
+    this->ClassifyInput(input, (cells ? nullptr : &flags[0]),
+                        (cells ? &flags[0] : nullptr));
+  }
+
+  // cells are in when they intersect, points when they are strictly inside
+  signed char in = (cells ? 1 : -1);
+  signed char out = (cells ? 0 : 1);
+  for (vtkIdType id = 0; id < num; id++)
+  {
+    if (flags[id] == (this->InsideOut ? out : in))
+    {
+      ids->InsertNextValue(id);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkExtractSelectedFrustum::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -29,6 +29,15 @@
  * input cell produced each output cell. This is an example of a Pedigree ID
  * which helps to trace back results.
  *
+ * The points and cells are classified in parallel with vtkSMPTools. The
+ * cells are first culled with the bounds of blocks of consecutive cells,
+ * computed once per input and reused while it is not modified, so that
+ * only the cells of the blocks crossing the frustum boundary are tested
+ * exactly. The culling is most effective when the cell ids are spatially
+ * coherent (see vtkSpaceFillingCurveReorder). SelectIds() runs the same
+ * classification and returns the selected ids as a vtkSelection suitable
+ * for vtkExtractSelection, without building an output dataset.
+ *
  * @sa
  * vtkExtractGeometry, vtkAreaPicker, vtkExtractSelection, vtkSelection
 */
@@ -45,6 +54,7 @@ class vtkInformationVector;
 class vtkCell;
 class vtkPoints;
 class vtkDoubleArray;
+class vtkSelection;
 
 class VTKFILTERSGENERAL_EXPORT vtkExtractSelectedFrustum : public vtkExtractSelectionBase
 {
@@ -107,6 +117,17 @@ public:
    */
   int OverallBoundsTest(double *bounds);
 
+  /**
+   * Select the ids of the cells (FieldType is vtkSelectionNode::CELL) or of
+   * the points of the input inside the frustum, taking InsideOut into
+   * account. The selection is replaced by one node of INDICES content, with
+   * the ids in increasing order; the CONTAINING_CELLS property is set for
+   * points when ContainingCells is on. Such a selection can be given to
+   * vtkExtractSelection. The cells and points are classified as in
+   * RequestData(), in parallel.
+   */
+  void SelectIds(vtkDataSet *input, vtkSelection *selection);
+
   //@{
   /**
    * When On, this returns an unstructured grid that outlines selection area.
@@ -147,6 +168,19 @@ protected:
                      int pid, int &noverts, double *overts);
   int IsectDegenerateCell(vtkCell *cell);
 
+  // Copy the frustum planes, and find the near and far box vertices of
+  // each plane. Called by OverallBoundsTest().
+  void ComputePlanes();
+
+  // Return 0 if the box is outside the frustum, 1 if it is inside, and -1
+  // if it crosses the boundary of the frustum.
+  int BoundsFrustumTest(const double bounds[6]);
+
+  // Classify the points (sign of the frustum function) and the cells (1 if
+  // they intersect the frustum, else 0) of the input; either may be null.
+  void ClassifyInput(vtkDataSet *input, signed char *pointSigns,
+                     signed char *cellsIn);
+
 
   //used in CreateFrustum
   void ComputePlane(int idx,
@@ -161,6 +195,11 @@ protected:
   //used internally
   vtkPlanes *Frustum;
   int np_vertids[6][2];
+  double PlaneNormals[6][3];
+  double PlaneOrigins[6][3];
+
+  class vtkInternals;
+  vtkInternals *Internals;
 
   //for debugging
   vtkPoints *ClipPoints;
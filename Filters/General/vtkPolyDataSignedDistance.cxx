@@ -0,0 +1,650 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPolyDataSignedDistance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPolyDataSignedDistance.h"
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkGenericCell.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTriangle.h"
+#include "vtkTriangleFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+vtkStandardNewMacro(vtkPolyDataSignedDistance);
+
+namespace
+{
+
+// Barycentric coordinates below this value put the closest point on an edge
+// or a vertex of its triangle.
+const double VTK_FEATURE_TOLERANCE = 1.0e-8;
+
+//----------------------------------------------------------------------------
+// An edge of a triangle, identified by its sorted end points. Id is
+// 3*triangle + e for the edge (pts[e], pts[(e+1)%3]).
+struct vtkMeshEdge
+{
+  vtkIdType V0;
+  vtkIdType V1;
+  vtkIdType Id;
+
+  bool operator<(const vtkMeshEdge& other) const
+  {
+    return this->V0 < other.V0 ||
+      (this->V0 == other.V0 && this->V1 < other.V1);
+  }
+};
+
+//----------------------------------------------------------------------------
+// The angle weighted pseudo normals of a triangle mesh: the normals of the
+// faces, the sums of the normals of the faces sharing each edge, and the
+// sums of the normals of the faces around each vertex weighted by their
+// angle at the vertex. The sign of the distance is the one of the dot
+// product of the vector from the closest point with the pseudo normal of
+// the feature it lies on.
+struct vtkPseudoNormals
+{
+  vtkPoints *Points;
+  std::vector<vtkIdType> Triangles;
+  std::vector<double> FaceNormals;
+  std::vector<double> EdgeNormals;
+  std::vector<double> VertexNormals;
+
+  void Build(vtkPolyData *mesh);
+
+  int Sign(const double x[3], const double closest[3], vtkIdType tri,
+           int inside) const
+  {
+    const double *n = &this->FaceNormals[3 * tri];
+    if ( ! inside )
+    {
+      const vtkIdType *pts = &this->Triangles[3 * tri];
+      double p[3][3], v0[3], v1[3], v2[3];
+      for (int i = 0; i < 3; ++i)
+      {
+        this->Points->GetPoint(pts[i], p[i]);
+      }
+      for (int i = 0; i < 3; ++i)
+      {
+        v0[i] = p[1][i] - p[0][i];
+        v1[i] = p[2][i] - p[0][i];
+        v2[i] = closest[i] - p[0][i];
+      }
+      double d00 = vtkMath::Dot(v0, v0), d01 = vtkMath::Dot(v0, v1);
+      double d11 = vtkMath::Dot(v1, v1), d20 = vtkMath::Dot(v2, v0);
+      double d21 = vtkMath::Dot(v2, v1);
+      double denom = d00 * d11 - d01 * d01;
+      double w[3];
+      if ( denom > 0.0 )
+      {
+        w[1] = (d11 * d20 - d01 * d21) / denom;
+        w[2] = (d00 * d21 - d01 * d20) / denom;
+        w[0] = 1.0 - w[1] - w[2];
+      }
+      else
+      {
+        // Degenerate triangle: use the vertex nearest to the closest point
+        for (int i = 0; i < 3; ++i)
+        {
+          w[i] = -vtkMath::Distance2BetweenPoints(closest, p[i]);
+        }
+        int k = static_cast<int>(std::max_element(w, w + 3) - w);
+        w[0] = w[1] = w[2] = 0.0;
+        w[k] = 1.0;
+      }
+
+      int numZeros = 0, zero = 0, largest = 0;
+      for (int i = 0; i < 3; ++i)
+      {
+        if ( w[i] < VTK_FEATURE_TOLERANCE )
+        {
+          numZeros++;
+          zero = i;
+        }
+        if ( w[i] > w[largest] )
+        {
+          largest = i;
+        }
+      }
+      if ( numZeros == 1 )
+      {
+        // The edge opposite to the vertex of zero weight
+        n = &this->EdgeNormals[3 * (3 * tri + (zero + 1) % 3)];
+      }
+      else if ( numZeros > 1 )
+      {
+        n = &this->VertexNormals[3 * pts[largest]];
+      }
+    }
+    double d[3] = { x[0] - closest[0], x[1] - closest[1], x[2] - closest[2] };
+    return ( vtkMath::Dot(d, n) < 0.0 ? -1 : 1 );
+  }
+};
+
+//----------------------------------------------------------------------------
+// Compute the normals of the faces and collect their edges in parallel.
+struct vtkComputeFaceNormals
+{
+  vtkPseudoNormals *Normals;
+  std::vector<vtkMeshEdge> *Edges;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType tri = begin; tri < end; ++tri)
+    {
+      vtkIdType *pts = &this->Normals->Triangles[3 * tri];
+      vtkTriangle::ComputeNormal(this->Normals->Points, 3, pts,
+                                 &this->Normals->FaceNormals[3 * tri]);
+      for (int e = 0; e < 3; ++e)
+      {
+        vtkMeshEdge &edge = (*this->Edges)[3 * tri + e];
+        edge.V0 = std::min(pts[e], pts[(e + 1) % 3]);
+        edge.V1 = std::max(pts[e], pts[(e + 1) % 3]);
+        edge.Id = 3 * tri + e;
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+void vtkPseudoNormals::Build(vtkPolyData *mesh)
+{
+  this->Points = mesh->GetPoints();
+  vtkIdType numTris = mesh->GetNumberOfPolys();
+  this->Triangles.resize(3 * numTris);
+  vtkCellArray *polys = mesh->GetPolys();
+  vtkIdType npts, *pts, tri = 0;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); ++tri)
+  {
+    std::copy(pts, pts + 3, &this->Triangles[3 * tri]);
+  }
+
+  this->FaceNormals.resize(3 * numTris);
+  std::vector<vtkMeshEdge> edges(3 * numTris);
+  vtkComputeFaceNormals faces = { this, &edges };
+  vtkSMPTools::For(0, numTris, faces);
+
+  // The faces sharing an edge are adjacent once the edges are sorted
+  vtkSMPTools::Sort(edges.begin(), edges.end());
+  this->EdgeNormals.assign(9 * numTris, 0.0);
+  for (size_t first = 0, last; first < edges.size(); first = last)
+  {
+    double n[3] = { 0.0, 0.0, 0.0 };
+    for (last = first; last < edges.size() &&
+         edges[last].V0 == edges[first].V0 && edges[last].V1 == edges[first].V1;
+         ++last)
+    {
+      vtkMath::Add(n, &this->FaceNormals[3 * (edges[last].Id / 3)], n);
+    }
+    for (size_t i = first; i < last; ++i)
+    {
+      std::copy(n, n + 3, &this->EdgeNormals[3 * edges[i].Id]);
+    }
+  }
+
+  this->VertexNormals.assign(3 * mesh->GetNumberOfPoints(), 0.0);
+  for (tri = 0; tri < numTris; ++tri)
+  {
+    const vtkIdType *ids = &this->Triangles[3 * tri];
+    const double *n = &this->FaceNormals[3 * tri];
+    double p[3][3];
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Points->GetPoint(ids[i], p[i]);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      double e0[3], e1[3];
+      vtkMath::Subtract(p[(i + 1) % 3], p[i], e0);
+      vtkMath::Subtract(p[(i + 2) % 3], p[i], e1);
+      if ( vtkMath::Normalize(e0) == 0.0 || vtkMath::Normalize(e1) == 0.0 )
+      {
+        continue;
+      }
+      double angle = acos(std::max(-1.0, std::min(1.0, vtkMath::Dot(e0, e1))));
+      double *vn = &this->VertexNormals[3 * ids[i]];
+      for (int j = 0; j < 3; ++j)
+      {
+        vn[j] += angle * n[j];
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Compute the distance of the voxels one row at a time. The distance of the
+// previous voxel of the row plus the spacing bounds the distance of the
+// next one, which limits the search of its closest triangle. In narrow
+// band mode, the voxels farther than the band are set to the width of the
+// band, with the sign of the adjacent voxel of the band in the row: a
+// voxel out of the band cannot be separated from its neighbor by the
+// surface since it is farther from it than the spacing.
+struct vtkComputeSignedDistance
+{
+  vtkBVHCellLocator *Locator;
+  const vtkPseudoNormals *Normals;
+  int SignMethod;
+  int Dimensions[3];
+  double Origin[3];
+  double Spacing[3];
+  double MaxDistance;
+  bool NarrowBand;
+  float *Scalars;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<signed char> > Signs;
+
+  int ComputeSign(double x[3], const double closest[3], vtkIdType cellId,
+                  int inside)
+  {
+    switch (this->SignMethod)
+    {
+      case vtkPolyDataSignedDistance::PSEUDO_NORMALS:
+        return this->Normals->Sign(x, closest, cellId, inside);
+      case vtkPolyDataSignedDistance::WINDING_NUMBER:
+        return ( this->Locator->GetWindingNumber(x) >= 0.5 ? -1 : 1 );
+      default:
+        return 1;
+    }
+  }
+
+  // The sign of a voxel far from the surface
+  int ComputeFarSign(double x[3], vtkGenericCell *cell)
+  {
+    if ( this->SignMethod != vtkPolyDataSignedDistance::PSEUDO_NORMALS )
+    {
+      return this->ComputeSign(x, x, -1, 0);
+    }
+    double closest[3], dist2;
+    vtkIdType cellId;
+    int subId, inside;
+    if ( ! this->Locator->FindClosestPointWithinRadius(
+           x, VTK_DOUBLE_MAX, closest, cell, cellId, subId, dist2, inside) )
+    {
+      return 1;
+    }
+    return this->ComputeSign(x, closest, cellId, inside);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell *cell = this->Cell.Local();
+    std::vector<signed char> &signs = this->Signs.Local();
+    const vtkIdType numX = this->Dimensions[0];
+    signs.resize(numX);
+
+    double x[3], closest[3], dist2;
+    vtkIdType cellId;
+    int subId, inside;
+    for (vtkIdType row = begin; row < end; ++row)
+    {
+      x[1] = this->Origin[1] + (row % this->Dimensions[1]) * this->Spacing[1];
+      x[2] = this->Origin[2] + (row / this->Dimensions[1]) * this->Spacing[2];
+      float *s = this->Scalars + row * numX;
+
+      double previous = -1.0;
+      for (vtkIdType i = 0; i < numX; ++i)
+      {
+        x[0] = this->Origin[0] + i * this->Spacing[0];
+        double radius = this->MaxDistance;
+        if ( previous >= 0.0 )
+        {
+          radius = std::min(previous + this->Spacing[0], this->MaxDistance);
+        }
+        vtkIdType found = this->Locator->FindClosestPointWithinRadius(
+          x, radius, closest, cell, cellId, subId, dist2, inside);
+        if ( ! found && radius < this->MaxDistance )
+        {
+          found = this->Locator->FindClosestPointWithinRadius(
+            x, this->MaxDistance, closest, cell, cellId, subId, dist2, inside);
+        }
+        if ( ! found )
+        {
+          signs[i] = 0;
+          previous = -1.0;
+          continue;
+        }
+        previous = sqrt(dist2);
+        signs[i] = static_cast<signed char>(
+          this->ComputeSign(x, closest, cellId, inside));
+        s[i] = static_cast<float>(signs[i] * previous);
+      }
+
+      if ( ! this->NarrowBand )
+      {
+        continue;
+      }
+      for (vtkIdType i = 0; i < numX;)
+      {
+        if ( signs[i] != 0 )
+        {
+          ++i;
+          continue;
+        }
+        vtkIdType first = i;
+        while ( i < numX && signs[i] == 0 )
+        {
+          ++i;
+        }
+        int sign;
+        if ( first > 0 )
+        {
+          sign = signs[first - 1];
+        }
+        else if ( i < numX )
+        {
+          sign = signs[i];
+        }
+        else
+        {
+          x[0] = this->Origin[0];
+          sign = this->ComputeFarSign(x, cell);
+        }
+        std::fill(s + first, s + i, static_cast<float>(sign * this->MaxDistance));
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkPolyDataSignedDistance::vtkPolyDataSignedDistance()
+{
+  this->Dimensions[0] = 64;
+  this->Dimensions[1] = 64;
+  this->Dimensions[2] = 64;
+
+  this->Bounds[0] = 0.0;
+  this->Bounds[1] = 0.0;
+  this->Bounds[2] = 0.0;
+  this->Bounds[3] = 0.0;
+  this->Bounds[4] = 0.0;
+  this->Bounds[5] = 0.0;
+
+  this->SignMethod = PSEUDO_NORMALS;
+  this->NarrowBand = 0;
+  this->NarrowBandWidth = 3.0;
+
+  this->Locator = vtkBVHCellLocator::New();
+}
+
+//----------------------------------------------------------------------------
+vtkPolyDataSignedDistance::~vtkPolyDataSignedDistance()
+{
+  this->Locator->Delete();
+}
+
+//----------------------------------------------------------------------------
+// Set the i-j-k dimensions on which to sample the distance function.
+void vtkPolyDataSignedDistance::SetDimensions(int i, int j, int k)
+{
+  int dim[3];
+
+  dim[0] = i;
+  dim[1] = j;
+  dim[2] = k;
+
+  this->SetDimensions(dim);
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyDataSignedDistance::SetDimensions(int dim[3])
+{
+  vtkDebugMacro(<< " setting Dimensions to (" << dim[0] << "," << dim[1]
+                << "," << dim[2] << ")");
+
+  if ( dim[0] != this->Dimensions[0] ||
+       dim[1] != this->Dimensions[1] ||
+       dim[2] != this->Dimensions[2] )
+  {
+    if ( dim[0]<1 || dim[1]<1 || dim[2]<1 )
+    {
+      vtkErrorMacro (<< "Bad Sample Dimensions, retaining previous values");
+      return;
+    }
+
+    for (int i=0; i<3; i++)
+    {
+      this->Dimensions[i] = dim[i];
+    }
+
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyDataSignedDistance::ComputeBounds(vtkPolyData *input,
+                                              double bounds[6])
+{
+  if ( this->Bounds[0] < this->Bounds[1] &&
+       this->Bounds[2] < this->Bounds[3] &&
+       this->Bounds[4] < this->Bounds[5] )
+  {
+    std::copy(this->Bounds, this->Bounds + 6, bounds);
+    return;
+  }
+  if ( !input || input->GetNumberOfPoints() < 1 )
+  {
+    std::copy(this->Bounds, this->Bounds + 6, bounds);
+    return;
+  }
+
+  input->GetBounds(bounds);
+  double diagonal = sqrt((bounds[1] - bounds[0]) * (bounds[1] - bounds[0]) +
+                         (bounds[3] - bounds[2]) * (bounds[3] - bounds[2]) +
+                         (bounds[5] - bounds[4]) * (bounds[5] - bounds[4]));
+  double pad = ( diagonal > 0.0 ? 0.05 * diagonal : 1.0 );
+  for (int i = 0; i < 3; ++i)
+  {
+    bounds[2 * i] -= pad;
+    bounds[2 * i + 1] += pad;
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPolyDataSignedDistance::RequestInformation (
+  vtkInformation * vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  // get the info objects
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkPolyData *input = vtkPolyData::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  double bounds[6], ar[3], origin[3];
+  this->ComputeBounds(input, bounds);
+
+  vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_FLOAT, 1);
+
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(),
+               0, this->Dimensions[0]-1,
+               0, this->Dimensions[1]-1,
+               0, this->Dimensions[2]-1);
+
+  for (int i=0; i < 3; i++)
+  {
+    origin[i] = bounds[2*i];
+    if ( this->Dimensions[i] <= 1 )
+    {
+      ar[i] = 1;
+    }
+    else
+    {
+      ar[i] = (bounds[2*i+1] - bounds[2*i]) / (this->Dimensions[i] - 1);
+    }
+  }
+  outInfo->Set(vtkDataObject::ORIGIN(),origin,3);
+  outInfo->Set(vtkDataObject::SPACING(),ar,3);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPolyDataSignedDistance::RequestData(
+  vtkInformation* vtkNotUsed( request ),
+  vtkInformationVector** inputVector,
+  vtkInformationVector* outputVector)
+{
+  // get the input and output
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkPolyData *input = vtkPolyData::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkImageData *output = vtkImageData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  vtkDebugMacro(<< "Computing signed distance");
+
+  if ( !input || input->GetNumberOfPolys() + input->GetNumberOfStrips() < 1 )
+  {
+    vtkWarningMacro(<< "No polygons to compute the distance to");
+    return 1;
+  }
+
+  // The locator and the pseudo normals work on the triangles of the input
+  bool triangles = ( input->GetNumberOfVerts() == 0 &&
+                     input->GetNumberOfLines() == 0 &&
+                     input->GetNumberOfStrips() == 0 );
+  vtkCellArray *polys = input->GetPolys();
+  vtkIdType npts, *pts;
+  for (polys->InitTraversal(); triangles && polys->GetNextCell(npts, pts); )
+  {
+    triangles = ( npts == 3 );
+  }
+  vtkPolyData *mesh = vtkPolyData::New();
+  if ( triangles )
+  {
+    mesh->SetPoints(input->GetPoints());
+    mesh->SetPolys(polys);
+  }
+  else
+  {
+    vtkPolyData *copy = vtkPolyData::New();
+    copy->ShallowCopy(input);
+    vtkTriangleFilter *triangulate = vtkTriangleFilter::New();
+    triangulate->SetInputData(copy);
+    triangulate->PassVertsOff();
+    triangulate->PassLinesOff();
+    triangulate->Update();
+    mesh->SetPoints(triangulate->GetOutput()->GetPoints());
+    mesh->SetPolys(triangulate->GetOutput()->GetPolys());
+    triangulate->Delete();
+    copy->Delete();
+  }
+  if ( mesh->GetNumberOfPolys() < 1 )
+  {
+    vtkWarningMacro(<< "No polygons to compute the distance to");
+    mesh->Delete();
+    return 1;
+  }
+  mesh->PrepareForConcurrentReads();
+  this->Locator->SetDataSet(mesh);
+  this->Locator->BuildLocator();
+
+  vtkPseudoNormals normals;
+  if ( this->SignMethod == PSEUDO_NORMALS )
+  {
+    normals.Build(mesh);
+  }
+
+  // Allocate the whole volume
+  double bounds[6], spacing[3];
+  this->ComputeBounds(input, bounds);
+  for (int i = 0; i < 3; i++)
+  {
+    spacing[i] = ( this->Dimensions[i] <= 1 ? 1.0 :
+                   (bounds[2*i+1] - bounds[2*i]) / (this->Dimensions[i] - 1) );
+  }
+  output->SetExtent(
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()));
+  output->AllocateScalars(VTK_FLOAT, 1);
+  output->SetOrigin(bounds[0], bounds[2], bounds[4]);
+  output->SetSpacing(spacing);
+  vtkDataArray *scalars = output->GetPointData()->GetScalars();
+  scalars->SetName("SignedDistance");
+
+  vtkComputeSignedDistance distance;
+  distance.Locator = this->Locator;
+  distance.Normals = &normals;
+  distance.SignMethod = this->SignMethod;
+  distance.NarrowBand = ( this->NarrowBand != 0 );
+  distance.MaxDistance = VTK_DOUBLE_MAX;
+  if ( this->NarrowBand )
+  {
+    distance.MaxDistance = this->NarrowBandWidth *
+      std::max(spacing[0], std::max(spacing[1], spacing[2]));
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    distance.Dimensions[i] = this->Dimensions[i];
+    distance.Origin[i] = bounds[2 * i];
+    distance.Spacing[i] = spacing[i];
+  }
+  distance.Scalars = static_cast<float*>(scalars->GetVoidPointer(0));
+  vtkSMPTools::For(0, static_cast<vtkIdType>(this->Dimensions[1]) *
+                   this->Dimensions[2], distance);
+
+  this->Locator->SetDataSet(nullptr);
+  this->Locator->FreeSearchStructure();
+  mesh->Delete();
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPolyDataSignedDistance::FillInputPortInformation(
+  int vtkNotUsed( port ), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyDataSignedDistance::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Dimensions: (" << this->Dimensions[0] << ", "
+               << this->Dimensions[1] << ", "
+               << this->Dimensions[2] << ")\n";
+  os << indent << "Bounds: \n";
+  os << indent << "  Xmin,Xmax: (" << this->Bounds[0] << ", "
+     << this->Bounds[1] << ")\n";
+  os << indent << "  Ymin,Ymax: (" << this->Bounds[2] << ", "
+     << this->Bounds[3] << ")\n";
+  os << indent << "  Zmin,Zmax: (" << this->Bounds[4] << ", "
+     << this->Bounds[5] << ")\n";
+  os << indent << "Sign Method: " << this->SignMethod << "\n";
+  os << indent << "Narrow Band: " << (this->NarrowBand ? "On\n" : "Off\n");
+  os << indent << "Narrow Band Width: " << this->NarrowBandWidth << "\n";
+}
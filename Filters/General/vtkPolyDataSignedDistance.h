@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPolyDataSignedDistance.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPolyDataSignedDistance
+ * @brief   sample the signed distance to a surface mesh on a volume
+ *
+ * vtkPolyDataSignedDistance computes the distance from each point of a
+ * volume to the polygons of the input vtkPolyData, and outputs it as float
+ * scalars named "SignedDistance". The distance is negative inside the
+ * surface, and positive outside of it. The volume is defined by its
+ * dimensions and its bounds; by default the bounds are the ones of the
+ * input, padded by 5% of their diagonal on each side.
+ *
+ * The polygons are triangulated if needed, and organized in a
+ * vtkBVHCellLocator. The closest triangle of each voxel is searched in
+ * parallel with vtkSMPTools, one row of voxels at a time: the distance of
+ * the previous voxel of the row bounds the search of the next one.
+ *
+ * The sign is computed with one of two methods. The angle weighted pseudo
+ * normals (Baerentzen and Aanaes) give the exact sign for closed,
+ * consistently oriented, manifold surfaces: the sign is the one of the dot
+ * product of the vector from the closest point with the normal of the
+ * face, edge or vertex the closest point lies on. The generalized winding
+ * number (Jacobson et al.) is slower but robust to holes, self
+ * intersections and non manifold surfaces: a point is inside if the
+ * winding number of the surface around it is larger than 1/2. The sign can
+ * also be omitted to compute unsigned distances.
+ *
+ * In narrow band mode, the distance is only computed for the voxels within
+ * NarrowBandWidth voxels of the surface. The other voxels are set to plus
+ * or minus the width of the band, with the sign of the nearest voxel of
+ * the band in their row of voxels, which is much faster for large volumes.
+ *
+ * @warning
+ * The normals of the polygons must point outward for the sign to be
+ * correct. Use vtkPolyDataNormals to orient them consistently if needed.
+ *
+ * @warning
+ * This class has been threaded with vtkSMPTools. Using TBB or other
+ * non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
+ * @sa
+ * vtkImplicitPolyDataDistance vtkDistancePolyDataFilter vtkSignedDistance
+ * vtkBVHCellLocator
+ */
+
+#ifndef vtkPolyDataSignedDistance_h
+#define vtkPolyDataSignedDistance_h
+
+#include "vtkFiltersGeneralModule.h" // For export macro
+#include "vtkImageAlgorithm.h"
+
+class vtkBVHCellLocator;
+class vtkPolyData;
+
+class VTKFILTERSGENERAL_EXPORT vtkPolyDataSignedDistance : public vtkImageAlgorithm
+{
+public:
+  //@{
+  /**
+   * Standard methods for instantiating the class, providing type information,
+   * and printing.
+   */
+  static vtkPolyDataSignedDistance *New();
+  vtkTypeMacro(vtkPolyDataSignedDistance,vtkImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  /**
+   * Methods used to compute the sign of the distance.
+   */
+  enum SignMethods
+  {
+    UNSIGNED = 0,
+    PSEUDO_NORMALS = 1,
+    WINDING_NUMBER = 2
+  };
+
+  //@{
+  /**
+   * Set/Get the i-j-k dimensions of the volume. The default is 64^3.
+   */
+  vtkGetVectorMacro(Dimensions,int,3);
+  void SetDimensions(int i, int j, int k);
+  void SetDimensions(int dim[3]);
+  //@}
+
+  //@{
+  /**
+   * Set / get the region in space in which to perform the sampling. If
+   * not specified, the bounds of the input padded by 5% of their diagonal
+   * are used.
+   */
+  vtkSetVector6Macro(Bounds,double);
+  vtkGetVectorMacro(Bounds,double,6);
+  //@}
+
+  //@{
+  /**
+   * Specify how the sign of the distance is computed: from the angle
+   * weighted pseudo normals of the surface (the default), from its winding
+   * number, or not at all.
+   */
+  vtkSetClampMacro(SignMethod,int,UNSIGNED,WINDING_NUMBER);
+  vtkGetMacro(SignMethod,int);
+  void SetSignMethodToUnsigned()
+    { this->SetSignMethod(UNSIGNED); }
+  void SetSignMethodToPseudoNormals()
+    { this->SetSignMethod(PSEUDO_NORMALS); }
+  void SetSignMethodToWindingNumber()
+    { this->SetSignMethod(WINDING_NUMBER); }
+  //@}
+
+  //@{
+  /**
+   * Turn on/off the narrow band mode, in which the distance is only computed
+   * near the surface. Off by default.
+   */
+  vtkSetMacro(NarrowBand,int);
+  vtkGetMacro(NarrowBand,int);
+  vtkBooleanMacro(NarrowBand,int);
+  //@}
+
+  //@{
+  /**
+   * Set / get the half width of the narrow band, as a number of voxels of
+   * the largest spacing of the volume. The default is 3.
+   */
+  vtkSetClampMacro(NarrowBandWidth,double,1.0,VTK_DOUBLE_MAX);
+  vtkGetMacro(NarrowBandWidth,double);
+  //@}
+
+protected:
+  vtkPolyDataSignedDistance();
+  ~vtkPolyDataSignedDistance() override;
+
+  int Dimensions[3];
+  double Bounds[6];
+  int SignMethod;
+  int NarrowBand;
+  double NarrowBandWidth;
+  vtkBVHCellLocator *Locator;
+
+  // Compute the bounds of the volume from the ones of the input if needed
+  void ComputeBounds(vtkPolyData *input, double bounds[6]);
+
+  int RequestInformation (vtkInformation *,
+                          vtkInformationVector **,
+                          vtkInformationVector *) override;
+  int RequestData (vtkInformation *,
+                   vtkInformationVector **, vtkInformationVector *) override;
+  int FillInputPortInformation(int, vtkInformation*) override;
+
+private:
+  vtkPolyDataSignedDistance(const vtkPolyDataSignedDistance&) = delete;
+  void operator=(const vtkPolyDataSignedDistance&) = delete;
+};
+
+#endif
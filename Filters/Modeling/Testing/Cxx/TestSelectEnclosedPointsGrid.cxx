@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSelectEnclosedPointsGrid.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Classify random points against a sphere with and without the voxel grid
+// of vtkSelectEnclosedPoints, and compare with the exact classification of
+// the points that are not too close to the sphere.
+
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSelectEnclosedPoints.h"
+#include "vtkSphereSource.h"
+
+#include <vector>
+
+namespace
+{
+
+const double CENTER[3] = { 0.1, 0.2, 0.3 };
+const double RADIUS = 1.0;
+const double SHELL = 0.03;
+
+// 1 inside, 0 outside, -1 too close to the sphere to tell
+int ExpectedInside(const double x[3], int insideOut)
+{
+  double dist = sqrt(vtkMath::Distance2BetweenPoints(x, CENTER));
+  if (fabs(dist - RADIUS) < SHELL)
+  {
+    return -1;
+  }
+  return (dist < RADIUS) != (insideOut != 0);
+}
+
+bool Classify(vtkSelectEnclosedPoints* select, vtkPolyData* points,
+              std::vector<int>& marks)
+{
+  select->Update();
+  vtkDataArray* selected =
+    vtkDataSet::SafeDownCast(select->GetOutput())->GetPointData()->GetArray("SelectedPoints");
+  vtkIdType numPts = points->GetNumberOfPoints();
+  if (!selected || selected->GetNumberOfTuples() != numPts)
+  {
+    cerr << "Missing selection array" << endl;
+    return false;
+  }
+  marks.resize(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    marks[ptId] = static_cast<int>(selected->GetTuple1(ptId));
+    double x[3];
+    points->GetPoint(ptId, x);
+    int expected = ExpectedInside(x, select->GetInsideOut());
+    if (marks[ptId] != select->IsInside(ptId) ||
+        (expected >= 0 && marks[ptId] != expected))
+    {
+      cerr << "Wrong classification of point " << ptId << " (" << x[0] << ", "
+           << x[1] << ", " << x[2] << ")" << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+int TestSelectEnclosedPointsGrid(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(CENTER[0], CENTER[1], CENTER[2]);
+  sphere->SetRadius(RADIUS);
+  sphere->SetThetaResolution(48);
+  sphere->SetPhiResolution(32);
+  sphere->Update();
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 20000; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(CENTER[j] - 1.3, CENTER[j] + 1.3);
+      random->Next();
+    }
+    points->InsertNextPoint(x);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points.GetPointer());
+
+  vtkNew<vtkSelectEnclosedPoints> select;
+  select->SetInputData(input.GetPointer());
+  select->SetSurfaceConnection(sphere->GetOutputPort());
+
+  // Ray casting only, then with the grid: the points are classified the same
+  std::vector<int> marks, gridMarks;
+  if (!Classify(select.GetPointer(), input.GetPointer(), marks))
+  {
+    return EXIT_FAILURE;
+  }
+  select->UseVoxelGridOn();
+  select->SetVoxelGridResolution(24);
+  if (!Classify(select.GetPointer(), input.GetPointer(), gridMarks))
+  {
+    return EXIT_FAILURE;
+  }
+  if (gridMarks != marks)
+  {
+    cerr << "The voxel grid changes the classification" << endl;
+    return EXIT_FAILURE;
+  }
+  select->InsideOutOn();
+  if (!Classify(select.GetPointer(), input.GetPointer(), gridMarks))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The backdoor uses the grid as well
+  select->Initialize(sphere->GetOutput());
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    input->GetPoint(ptId, x);
+    int expected = ExpectedInside(x, 0);
+    if (expected >= 0 && select->IsInsideSurface(x) != expected)
+    {
+      cerr << "Wrong backdoor classification of point " << ptId << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  select->Complete();
+
+  return EXIT_SUCCESS;
+}
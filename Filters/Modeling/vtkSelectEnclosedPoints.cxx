@@ -25,13 +25,162 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkExecutive.h"
 #include "vtkFeatureEdges.h"
-#include "vtkCellLocator.h"
+#include "vtkStaticCellLocator.h"
 #include "vtkGenericCell.h"
 #include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
 #include "vtkGarbageCollector.h"
+#include "vtkSMPTools.h"
+#include "vtkSMPThreadLocalObject.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkSelectEnclosedPoints);
 
+// The voxels of the inside/outside grid are either outside, inside, or
+// touched by the surface (in which case the points they contain are
+// classified by ray casting).
+#define VTK_OUTSIDE_VOXEL 0
+#define VTK_INSIDE_VOXEL 1
+#define VTK_SURFACE_VOXEL 2
+
+namespace {
+
+// Seeds the random sequence of a query point, so that the rays fired from a
+// point do not depend on the thread classifying it.
+void SeedSequence(vtkRandomSequence *sequence, vtkIdType id)
+{
+  static_cast<vtkMinimalStandardRandomSequence*>(sequence)->
+    SetSeed(static_cast<int>(id % VTK_INT_MAX));
+}
+
+// Per-thread scratch objects for the ray casting
+struct vtkRayCastScratch
+{
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkMinimalStandardRandomSequence> Sequence;
+
+  void Initialize()
+  {
+    this->CellIds.Local()->Allocate(512);
+    this->Cell.Local();
+    this->Sequence.Local();
+  }
+};
+
+// Classify the input points
+struct vtkSelectInOutCheck
+{
+  vtkRayCastScratch Scratch;
+  vtkSelectEnclosedPoints *Self;
+  vtkDataSet *Input;
+  unsigned char *Marks;
+  unsigned char InsideValue;
+
+  vtkSelectInOutCheck(vtkSelectEnclosedPoints *self, vtkDataSet *input,
+                      unsigned char *marks) :
+    Self(self), Input(input), Marks(marks)
+  {
+    this->InsideValue = (self->GetInsideOut() ? 0 : 1);
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkIdList *cellIds = this->Scratch.CellIds.Local();
+    vtkGenericCell *cell = this->Scratch.Cell.Local();
+    vtkRandomSequence *sequence = this->Scratch.Sequence.Local();
+    double x[3];
+
+    for ( ; ptId < endPtId; ++ptId )
+    {
+      this->Input->GetPoint(ptId, x);
+      SeedSequence(sequence, ptId);
+      this->Marks[ptId] =
+        ( this->Self->IsInsideSurface(x, cellIds, cell, sequence) ?
+          this->InsideValue : 1 - this->InsideValue );
+    }
+  }
+
+  void Initialize()
+  {
+    this->Scratch.Initialize();
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+// Classify the runs of voxels untouched by the surface along the x rows of
+// the grid. The surface does not cross a run, so all of its voxels are on
+// the same side of the surface and a single (voting) ray cast from the
+// center of its first voxel classifies the whole run.
+struct vtkClassifyVoxelRuns
+{
+  vtkRayCastScratch Scratch;
+  vtkSelectEnclosedPoints *Self;
+  unsigned char *Voxels;
+  const int *Dims;
+  double Origin[3];
+  double Spacing[3];
+
+  vtkClassifyVoxelRuns(vtkSelectEnclosedPoints *self, unsigned char *voxels,
+                       const int dims[3], const double bounds[6]) :
+    Self(self), Voxels(voxels), Dims(dims)
+  {
+    for (int i=0; i < 3; i++)
+    {
+      this->Origin[i] = bounds[2*i];
+      this->Spacing[i] = (bounds[2*i+1] - bounds[2*i]) / dims[i];
+    }
+  }
+
+  void operator()(vtkIdType row, vtkIdType endRow)
+  {
+    vtkIdList *cellIds = this->Scratch.CellIds.Local();
+    vtkGenericCell *cell = this->Scratch.Cell.Local();
+    vtkRandomSequence *sequence = this->Scratch.Sequence.Local();
+    double x[3];
+
+    for ( ; row < endRow; ++row )
+    {
+      unsigned char *voxels = this->Voxels + row*this->Dims[0];
+      x[1] = this->Origin[1] + ((row % this->Dims[1]) + 0.5) * this->Spacing[1];
+      x[2] = this->Origin[2] + ((row / this->Dims[1]) + 0.5) * this->Spacing[2];
+      for ( int i=0; i < this->Dims[0]; )
+      {
+        if ( voxels[i] == VTK_SURFACE_VOXEL )
+        {
+          ++i;
+          continue;
+        }
+        x[0] = this->Origin[0] + (i + 0.5) * this->Spacing[0];
+        SeedSequence(sequence, row*this->Dims[0] + i);
+        unsigned char state = ( this->Self->IsInsideSurface(x, cellIds, cell,
+                                  sequence) ? VTK_INSIDE_VOXEL : VTK_OUTSIDE_VOXEL );
+        for ( ; i < this->Dims[0] && voxels[i] != VTK_SURFACE_VOXEL; ++i )
+        {
+          voxels[i] = state;
+        }
+      }
+    }
+  }
+
+  void Initialize()
+  {
+    this->Scratch.Initialize();
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+} //anonymous namespace
+
 //----------------------------------------------------------------------------
 // Construct object.
 vtkSelectEnclosedPoints::vtkSelectEnclosedPoints()
@@ -44,9 +193,18 @@ vtkSelectEnclosedPoints::vtkSelectEnclosedPoints()
 
   this->InsideOutsideArray = nullptr;
 
-  this->CellLocator = vtkCellLocator::New();
+  this->CellLocator = vtkStaticCellLocator::New();
   this->CellIds = vtkIdList::New();
   this->Cell = vtkGenericCell::New();
+  this->Sequence = vtkMinimalStandardRandomSequence::New();
+  this->Surface = nullptr;
+
+  this->UseVoxelGrid = 0;
+  this->VoxelGridResolution = 64;
+  this->Voxels = nullptr;
+  this->VoxelDimensions[0] = this->VoxelDimensions[1] =
+    this->VoxelDimensions[2] = 0;
+  this->VoxelFactors[0] = this->VoxelFactors[1] = this->VoxelFactors[2] = 0.0;
 }
 
 //----------------------------------------------------------------------------
@@ -59,13 +217,15 @@ vtkSelectEnclosedPoints::~vtkSelectEnclosedPoints()
 
   if ( this->CellLocator )
   {
-    vtkCellLocator *loc = this->CellLocator;
+    vtkStaticCellLocator *loc = this->CellLocator;
     this->CellLocator = nullptr;
     loc->Delete();
   }
 
   this->CellIds->Delete();
   this->Cell->Delete();
+  this->Sequence->Delete();
+  delete [] this->Voxels;
 }
 
 //----------------------------------------------------------------------------
@@ -110,30 +270,11 @@ int vtkSelectEnclosedPoints::RequestData(
   // Loop over all input points determining inside/outside
   vtkIdType numPts = input->GetNumberOfPoints();
   marks->SetNumberOfValues(numPts);
-  vtkIdType ptId;
-  double x[3];
-
-  int abort=0;
-  vtkIdType progressInterval=numPts/20+1;
-  for ( ptId=0; ptId < numPts && !abort; ptId++ )
-  {
-    if ( ! (ptId % progressInterval) ) //manage progress / early abort
-    {
-      this->UpdateProgress ((double)ptId / numPts);
-      abort = this->GetAbortExecute();
-    }
+  this->UpdateProgress(0.1);
 
-    input->GetPoint(ptId,x);
-
-    if ( this->IsInsideSurface(x) )
-    {
-      marks->SetValue(ptId,(this->InsideOut?0:1));
-    }
-    else
-    {
-      marks->SetValue(ptId,(this->InsideOut?1:0));
-    }
-  }
+  vtkSelectInOutCheck inOutCheck(this, input, marks->GetPointer(0));
+  vtkSMPTools::For(0, numPts, inOutCheck);
+  this->UpdateProgress(0.9);
 
   // Copy all the input geometry and data to the output.
   output->CopyStructure(input);
@@ -183,16 +324,115 @@ void vtkSelectEnclosedPoints::Initialize(vtkPolyData *surface)
 {
   if ( ! this->CellLocator )
   {
-    this->CellLocator = vtkCellLocator::New();
+    this->CellLocator = vtkStaticCellLocator::New();
   }
 
   this->Surface = surface;
   surface->GetBounds(this->Bounds);
   this->Length = surface->GetLength();
 
-  // Set up structures for acceleration ray casting
+  // Set up structures for acceleration ray casting. Once built, they can
+  // be queried concurrently.
+  surface->PrepareForConcurrentReads();
   this->CellLocator->SetDataSet(surface);
   this->CellLocator->BuildLocator();
+  SeedSequence(this->Sequence, 1);
+
+  delete [] this->Voxels;
+  this->Voxels = nullptr;
+  if ( this->UseVoxelGrid )
+  {
+    this->BuildVoxelGrid();
+  }
+}
+
+//----------------------------------------------------------------------------
+// The grid covers the bounds of the surface with voxels of about the same
+// size along each axis. The voxels touched by the (tolerance padded) bounds
+// of a surface cell are marked first. The other voxels are then classified
+// by runs along the x rows, in parallel.
+void vtkSelectEnclosedPoints::BuildVoxelGrid()
+{
+  double *bds = this->Bounds, sides[3], maxSide = 0.0;
+  int i;
+  for (i=0; i < 3; i++)
+  {
+    sides[i] = bds[2*i+1] - bds[2*i];
+    maxSide = std::max(maxSide, sides[i]);
+  }
+  if ( maxSide <= 0.0 )
+  {
+    return;
+  }
+
+  vtkIdType numVoxels = 1;
+  for (i=0; i < 3; i++)
+  {
+    this->VoxelDimensions[i] = std::max(1, static_cast<int>(
+      ceil(this->VoxelGridResolution * sides[i] / maxSide)));
+    this->VoxelFactors[i] = ( sides[i] > 0.0 ?
+                              this->VoxelDimensions[i] / sides[i] : 0.0 );
+    numVoxels *= this->VoxelDimensions[i];
+  }
+  unsigned char *voxels = new unsigned char [numVoxels];
+  std::fill_n(voxels, numVoxels, VTK_OUTSIDE_VOXEL);
+
+  // Mark the voxels touched by the surface
+  double tol = this->Tolerance*this->Length, cellBds[6], x[3];
+  int ijkMin[3], ijkMax[3];
+  vtkIdType numCells = this->Surface->GetNumberOfCells();
+  const int *dims = this->VoxelDimensions;
+  for (vtkIdType cellId=0; cellId < numCells; cellId++)
+  {
+    this->Surface->GetCellBounds(cellId, cellBds);
+    for (i=0; i < 3; i++)
+    {
+      x[i] = cellBds[2*i] - tol;
+    }
+    vtkIdType voxelId = this->GetVoxelId(x);
+    ijkMin[0] = voxelId % dims[0];
+    ijkMin[1] = (voxelId / dims[0]) % dims[1];
+    ijkMin[2] = voxelId / (dims[0]*dims[1]);
+    for (i=0; i < 3; i++)
+    {
+      x[i] = cellBds[2*i+1] + tol;
+    }
+    voxelId = this->GetVoxelId(x);
+    ijkMax[0] = voxelId % dims[0];
+    ijkMax[1] = (voxelId / dims[0]) % dims[1];
+    ijkMax[2] = voxelId / (dims[0]*dims[1]);
+    for (int k=ijkMin[2]; k <= ijkMax[2]; k++)
+    {
+      for (int j=ijkMin[1]; j <= ijkMax[1]; j++)
+      {
+        unsigned char *row = voxels + (static_cast<vtkIdType>(k)*dims[1] + j)*dims[0];
+        std::fill(row + ijkMin[0], row + ijkMax[0] + 1, VTK_SURFACE_VOXEL);
+      }
+    }
+  }
+
+  // Classify the other voxels. The grid is not in use yet, so the runs are
+  // classified by ray casting.
+  vtkClassifyVoxelRuns classifyRuns(this, voxels, dims, bds);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dims[1])*dims[2], classifyRuns);
+  this->Voxels = voxels;
+}
+
+//----------------------------------------------------------------------------
+// The point is assumed to be within the surface bounds (up to the
+// tolerance); the indices are clamped to the grid.
+vtkIdType vtkSelectEnclosedPoints::GetVoxelId(double x[3])
+{
+  vtkIdType voxelId = 0, stride = 1;
+  for (int i=0; i < 3; i++)
+  {
+    int idx = static_cast<int>((x[i] - this->Bounds[2*i]) * this->VoxelFactors[i]);
+    idx = ( idx < 0 ? 0 : (idx >= this->VoxelDimensions[i] ?
+                           this->VoxelDimensions[i]-1 : idx) );
+    voxelId += idx*stride;
+    stride *= this->VoxelDimensions[i];
+  }
+  return voxelId;
 }
 
 //----------------------------------------------------------------------------
@@ -224,6 +464,14 @@ int vtkSelectEnclosedPoints::IsInsideSurface(double x, double y, double z)
 #define VTK_VOTE_THRESHOLD 3
 //----------------------------------------------------------------------------
 int vtkSelectEnclosedPoints::IsInsideSurface(double x[3])
+{
+  return this->IsInsideSurface(x, this->CellIds, this->Cell, this->Sequence);
+}
+
+//----------------------------------------------------------------------------
+int vtkSelectEnclosedPoints::IsInsideSurface(double x[3], vtkIdList *cellIds,
+                                             vtkGenericCell *cell,
+                                             vtkRandomSequence *sequence)
 {
   // do a quick bounds check
   if ( x[0] < this->Bounds[0] || x[0] > this->Bounds[1] ||
@@ -233,6 +481,24 @@ int vtkSelectEnclosedPoints::IsInsideSurface(double x[3])
     return 0;
   }
 
+  // Points away from the surface are classified by the voxel grid
+  if ( this->Voxels )
+  {
+    unsigned char state = this->Voxels[this->GetVoxelId(x)];
+    if ( state != VTK_SURFACE_VOXEL )
+    {
+      return state;
+    }
+  }
+
+  return this->CastRays(x, cellIds, cell, sequence);
+}
+
+//----------------------------------------------------------------------------
+int vtkSelectEnclosedPoints::CastRays(double x[3], vtkIdList *cellIds,
+                                      vtkGenericCell *cell,
+                                      vtkRandomSequence *sequence)
+{
   //  Perform in/out by shooting random rays. Multiple rays are fired
   //  to improve accuracy of the result.
   //
@@ -246,10 +512,16 @@ int vtkSelectEnclosedPoints::IsInsideSurface(double x[3])
   //  equals the defined variable VTK_VOTE_THRESHOLD, then the
   //  appropriate "in" or "out" status is returned.
   //
+  //  A ray passing within the tolerance of an edge (or a vertex) shared by
+  //  several cells intersects each of them at about the same location. The
+  //  intersections closer than the tolerance along the ray are counted once.
+  //
   double rayMag, ray[3], xray[3], t, pcoords[3], xint[3];
   int i, numInts, iterNumber, deltaVotes, subId;
   vtkIdType idx, numCells;
   double tol = this->Tolerance*this->Length;
+  double tTol = ( this->Length > 0.0 ? tol / this->Length : 0.0 );
+  std::vector<double> ts;
 
   for (deltaVotes = 0, iterNumber = 1;
        (iterNumber < VTK_MAX_ITER) && (abs(deltaVotes) < VTK_VOTE_THRESHOLD);
@@ -261,7 +533,8 @@ int vtkSelectEnclosedPoints::IsInsideSurface(double x[3])
     {
       for (i=0; i<3; i++)
       {
-        ray[i] = vtkMath::Random(-1.0,1.0);
+        ray[i] = 2.0*sequence->GetValue() - 1.0;
+        sequence->Next();
       }
       rayMag = vtkMath::Norm(ray);
     }
@@ -274,20 +547,30 @@ int vtkSelectEnclosedPoints::IsInsideSurface(double x[3])
     }
 
     // Retrieve the candidate cells from the locator
-    this->CellLocator->FindCellsAlongLine(x,xray,tol,this->CellIds);
+    this->CellLocator->FindCellsAlongLine(x,xray,tol,cellIds);
 
     // Intersect the line with each of the candidate cells
-    numInts = 0;
-    numCells = this->CellIds->GetNumberOfIds();
+    ts.clear();
+    numCells = cellIds->GetNumberOfIds();
     for ( idx=0; idx < numCells; idx++ )
     {
-      this->Surface->GetCell(this->CellIds->GetId(idx), this->Cell);
-      if ( this->Cell->IntersectWithLine(x, xray, tol, t, xint, pcoords, subId) )
+      this->Surface->GetCell(cellIds->GetId(idx), cell);
+      if ( cell->IntersectWithLine(x, xray, tol, t, xint, pcoords, subId) )
       {
-        numInts++;
+        ts.push_back(t);
       }
     } //for all candidate cells
 
+    // Merge the intersections closer than the tolerance
+    std::sort(ts.begin(), ts.end());
+    numInts = 0;
+    for ( size_t ii=0; ii < ts.size(); ii++ )
+    {
+      if ( ii == 0 || (ts[ii] - ts[ii-1]) > tTol )
+      {
+        numInts++;
+      }
+    }
     // Count the result
     if ( (numInts % 2) == 0)
     {
@@ -362,6 +645,8 @@ int vtkSelectEnclosedPoints::FillInputPortInformation(int port, vtkInformation *
 void vtkSelectEnclosedPoints::Complete()
 {
   this->CellLocator->FreeSearchStructure();
+  delete [] this->Voxels;
+  this->Voxels = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -385,5 +670,10 @@ void vtkSelectEnclosedPoints::PrintSelf(ostream& os, vtkIndent indent)
      << (this->InsideOut ? "On\n" : "Off\n");
 
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+
+  os << indent << "Use Voxel Grid: "
+     << (this->UseVoxelGrid ? "On\n" : "Off\n");
+
+  os << indent << "Voxel Grid Resolution: " << this->VoxelGridResolution << "\n";
 }
 
@@ -25,6 +25,14 @@
  * After running the filter, it is possible to query it as to whether a point
  * is inside/outside by invoking the IsInside(ptId) method.
  *
+ * The points are classified in parallel (via vtkSMPTools). The rays fired
+ * from a point are generated from a random sequence seeded with the point
+ * id, so the result does not depend on the number of threads. Optionally, a
+ * voxel grid covering the surface bounds can be built first: the voxels that
+ * no surface cell touches are classified once per run of such voxels, and
+ * the points they contain are then classified without casting any ray. This
+ * greatly speeds up the classification of large numbers of points.
+ *
  * @warning
  * The filter assumes that the surface is closed and manifold. A boolean flag
  * can be set to force the filter to first check whether this is true. If false,
@@ -47,9 +55,10 @@
 #include "vtkDataSetAlgorithm.h"
 
 class vtkUnsignedCharArray;
-class vtkCellLocator;
+class vtkStaticCellLocator;
 class vtkIdList;
 class vtkGenericCell;
+class vtkRandomSequence;
 
 
 class VTKFILTERSMODELING_EXPORT vtkSelectEnclosedPoints : public vtkDataSetAlgorithm
@@ -122,6 +131,29 @@ public:
   vtkGetMacro(Tolerance,double);
   //@}
 
+  //@{
+  /**
+   * Specify whether to build an inside/outside voxel grid over the bounds
+   * of the surface. Points located in voxels away from the surface are then
+   * classified without casting rays; only the points in voxels touched by
+   * the surface are classified by ray casting. This pays off when many
+   * points are tested against the same surface. Off by default.
+   */
+  vtkSetMacro(UseVoxelGrid,int);
+  vtkBooleanMacro(UseVoxelGrid,int);
+  vtkGetMacro(UseVoxelGrid,int);
+  //@}
+
+  //@{
+  /**
+   * Specify the number of voxels along the longest side of the surface
+   * bounds when UseVoxelGrid is on. The other sides are divided into voxels
+   * of about the same size. The default is 64.
+   */
+  vtkSetClampMacro(VoxelGridResolution,int,1,4096);
+  vtkGetMacro(VoxelGridResolution,int);
+  //@}
+
   //@{
   /**
    * This is a backdoor that can be used to test many points for containment.
@@ -135,6 +167,15 @@ public:
   void Complete();
   //@}
 
+  /**
+   * A version of IsInsideSurface() that can be called concurrently from
+   * several threads after Initialize(). Each thread provides its own cell
+   * ids, generic cell and random sequence (used to generate the directions
+   * of the rays).
+   */
+  int IsInsideSurface(double x[3], vtkIdList *cellIds, vtkGenericCell *cell,
+                      vtkRandomSequence *sequence);
+
 protected:
   vtkSelectEnclosedPoints();
   ~vtkSelectEnclosedPoints() override;
@@ -147,12 +188,25 @@ protected:
   vtkUnsignedCharArray *InsideOutsideArray;
 
   // Internal structures for accelerating the intersection test
-  vtkCellLocator *CellLocator;
-  vtkIdList      *CellIds;
-  vtkGenericCell *Cell;
-  vtkPolyData    *Surface;
-  double          Bounds[6];
-  double          Length;
+  vtkStaticCellLocator *CellLocator;
+  vtkIdList            *CellIds;
+  vtkGenericCell       *Cell;
+  vtkRandomSequence    *Sequence;
+  vtkPolyData          *Surface;
+  double                Bounds[6];
+  double                Length;
+
+  // The inside/outside voxel grid
+  int            UseVoxelGrid;
+  int            VoxelGridResolution;
+  unsigned char *Voxels;
+  int            VoxelDimensions[3];
+  double         VoxelFactors[3];
+
+  void BuildVoxelGrid();
+  vtkIdType GetVoxelId(double x[3]);
+  int CastRays(double x[3], vtkIdList *cellIds, vtkGenericCell *cell,
+               vtkRandomSequence *sequence);
 
   int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *) override;
   int FillInputPortInformation(int, vtkInformation *) override;
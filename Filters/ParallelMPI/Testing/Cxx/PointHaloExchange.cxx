@@ -0,0 +1,184 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    PointHaloExchange.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Tests vtkPointHaloExchange.
+
+/*
+** This test only builds if MPI is in use. Each process generates the same
+** random point cloud and keeps a slab of it. The neighbor queries of the
+** local points, answered with the local points and the halo, must match a
+** brute force search in the whole point cloud.
+*/
+#include "vtkDataSetAttributes.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointHaloExchange.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+const vtkIdType NUMBER_OF_POINTS = 2000;
+const double RADIUS = 0.1;
+const int NUMBER_OF_NEIGHBORS = 8;
+
+// The sorted squared distances from x to the points
+void Distances2(vtkPoints* points, vtkIdType numPts, const double x[3],
+                std::vector<double>& dist2)
+{
+  dist2.resize(numPts);
+  double y[3];
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    points->GetPoint(i, y);
+    dist2[i] = vtkMath::Distance2BetweenPoints(x, y);
+  }
+  std::sort(dist2.begin(), dist2.end());
+}
+
+bool CheckHalo(vtkPointHaloExchange* halo, vtkPoints* global, int me)
+{
+  vtkPolyData* output = halo->GetOutput();
+  vtkIdType numLocal = halo->GetNumberOfLocalPoints();
+  vtkUnsignedCharArray* ghosts = vtkArrayDownCast<vtkUnsignedCharArray>(
+    output->GetPointData()->GetArray(vtkDataSetAttributes::GhostArrayName()));
+  if (!ghosts || ghosts->GetNumberOfTuples() != output->GetNumberOfPoints())
+  {
+    cerr << "Process " << me << ": missing ghost array" << endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    if ((ghosts->GetValue(i) != 0) != (i >= numLocal))
+    {
+      cerr << "Process " << me << ": wrong ghost flag for point " << i << endl;
+      return false;
+    }
+  }
+
+  std::vector<double> dist2, dist2Ref;
+  double x[3];
+  for (vtkIdType i = 0; i < numLocal; ++i)
+  {
+    output->GetPoint(i, x);
+    Distances2(output->GetPoints(), output->GetNumberOfPoints(), x, dist2);
+    Distances2(global, global->GetNumberOfPoints(), x, dist2Ref);
+    if (halo->GetHaloStyle() == vtkPointHaloExchange::RADIUS)
+    {
+      double r2 = RADIUS * RADIUS;
+      if (std::upper_bound(dist2.begin(), dist2.end(), r2) - dist2.begin() !=
+          std::upper_bound(dist2Ref.begin(), dist2Ref.end(), r2) - dist2Ref.begin())
+      {
+        cerr << "Process " << me << ": wrong points within radius of point " << i << endl;
+        return false;
+      }
+    }
+    else if (dist2[NUMBER_OF_NEIGHBORS - 1] != dist2Ref[NUMBER_OF_NEIGHBORS - 1])
+    {
+      cerr << "Process " << me << ": wrong closest points of point " << i << endl;
+      return false;
+    }
+  }
+
+  if (halo->GetNumberOfPointsSent() == 0 || halo->GetNumberOfPointsReceived() == 0 ||
+      halo->GetNumberOfBytesSent() == 0 || halo->GetNumberOfBytesReceived() == 0 ||
+      output->GetNumberOfPoints() != numLocal + halo->GetNumberOfPointsReceived())
+  {
+    cerr << "Process " << me << ": wrong communication statistics" << endl;
+    return false;
+  }
+  cout << "Process " << me << ": " << numLocal << " local points, "
+       << halo->GetNumberOfPointsSent() << " sent, "
+       << halo->GetNumberOfPointsReceived() << " received" << endl;
+  return true;
+}
+
+}
+
+int PointHaloExchange(int argc, char *argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  vtkMPIController *contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv, 1);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  int me = contr->GetLocalProcessId();
+  if (!contr->IsA("vtkMPIController"))
+  {
+    if (me == 0)
+    {
+      cout << "PointHaloExchange test requires MPI" << endl;
+    }
+    contr->Delete();
+    return EXIT_FAILURE;
+  }
+  int numProcs = contr->GetNumberOfProcesses();
+
+  // The whole point cloud, and the slab of this process
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> global;
+  global->SetDataTypeToDouble();
+  vtkNew<vtkPoints> local;
+  local->SetDataTypeToDouble();
+  for (vtkIdType i = 0; i < NUMBER_OF_POINTS; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetValue();
+      random->Next();
+    }
+    global->InsertNextPoint(x);
+    if (std::min(static_cast<int>(x[0] * numProcs), numProcs - 1) == me)
+    {
+      local->InsertNextPoint(x);
+    }
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(local.GetPointer());
+
+  int retVal = EXIT_SUCCESS;
+  vtkNew<vtkPointHaloExchange> halo;
+  halo->SetInputData(input.GetPointer());
+  halo->SetRadius(RADIUS);
+  halo->SetNumberOfNeighbors(NUMBER_OF_NEIGHBORS);
+  for (int style = vtkPointHaloExchange::RADIUS;
+       style <= vtkPointHaloExchange::N_CLOSEST; ++style)
+  {
+    halo->SetHaloStyle(style);
+    halo->Update();
+    if (!CheckHalo(halo.GetPointer(), global.GetPointer(), me))
+    {
+      retVal = EXIT_FAILURE;
+    }
+  }
+
+  contr->Finalize();
+  contr->Delete();
+
+  return retVal;
+}
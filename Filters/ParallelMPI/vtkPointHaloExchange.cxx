@@ -0,0 +1,523 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPointHaloExchange.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPointHaloExchange.h"
+
+#include "vtkCellArray.h"
+#include "vtkCharArray.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMPICommunicator.h"
+#include "vtkMPIController.h"
+#include "vtkObjectFactory.h"
+#include "vtkPKdTree.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+vtkStandardNewMacro(vtkPointHaloExchange);
+vtkCxxSetObjectMacro(vtkPointHaloExchange, Controller, vtkMultiProcessController);
+
+namespace
+{
+
+const int HALO_SIZE_TAG = 47210;
+const int HALO_EXCHANGE_TAG = 47211;
+
+// Each region of the k-d tree is described by the bounds of the points of
+// a process in the region, and by the reach of their queries (negative
+// when the process has no point in the region).
+const int REGION_TUPLE_SIZE = 7;
+
+double Distance2ToBounds(const double x[3], const double *bounds)
+{
+  double dist2 = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    double d = 0.0;
+    if (x[i] < bounds[2*i])
+    {
+      d = bounds[2*i] - x[i];
+    }
+    else if (x[i] > bounds[2*i+1])
+    {
+      d = x[i] - bounds[2*i+1];
+    }
+    dist2 += d * d;
+  }
+  return dist2;
+}
+
+bool BoundsOverlap(const double *a, const double *b, double reach)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    if (a[2*i] > b[2*i+1] + reach || a[2*i+1] < b[2*i] - reach)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether the regions of two processes are within reach of each other,
+// with the largest of the reaches of the two regions compared. The test is
+// symmetric, and true whenever one process has points within reach of the
+// other's regions.
+bool ProcessesOverlap(const double *a, const double *b, int numRegions)
+{
+  for (int i = 0; i < numRegions; ++i)
+  {
+    const double *regionA = a + REGION_TUPLE_SIZE*i;
+    if ( regionA[6] < 0.0 )
+    {
+      continue;
+    }
+    for (int j = 0; j < numRegions; ++j)
+    {
+      const double *regionB = b + REGION_TUPLE_SIZE*j;
+      if ( regionB[6] >= 0.0 &&
+           BoundsOverlap(regionA, regionB, std::max(regionA[6], regionB[6])) )
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool IsGhost(vtkUnsignedCharArray *ghosts, vtkIdType ptId)
+{
+  return ghosts &&
+    (ghosts->GetValue(ptId) & vtkDataSetAttributes::DUPLICATEPOINT) != 0;
+}
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkPointHaloExchange::vtkPointHaloExchange()
+{
+  this->Controller = nullptr;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->HaloStyle = vtkPointHaloExchange::RADIUS;
+  this->Radius = 1.0;
+  this->NumberOfNeighbors = 8;
+  this->NumberOfRegionsPerProcess = 8;
+
+  this->NumberOfLocalPoints = 0;
+  this->NumberOfPointsSent = 0;
+  this->NumberOfPointsReceived = 0;
+  this->NumberOfBytesSent = 0;
+  this->NumberOfBytesReceived = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkPointHaloExchange::~vtkPointHaloExchange()
+{
+  this->SetController(nullptr);
+}
+
+//----------------------------------------------------------------------------
+int vtkPointHaloExchange::RequestData(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkInformation *inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  vtkPointSet *input = vtkPointSet::SafeDownCast(
+    inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkPolyData *output = vtkPolyData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+  if ( !input || !output )
+  {
+    return 0;
+  }
+
+  this->NumberOfPointsSent = 0;
+  this->NumberOfPointsReceived = 0;
+  this->NumberOfBytesSent = 0;
+  this->NumberOfBytesReceived = 0;
+
+  vtkIdType numPts = input->GetNumberOfPoints();
+  this->NumberOfLocalPoints = numPts;
+  vtkPointData *inPD = input->GetPointData();
+  vtkPointData *outPD = output->GetPointData();
+  vtkUnsignedCharArray *inGhosts = vtkArrayDownCast<vtkUnsignedCharArray>(
+    inPD->GetArray(vtkDataSetAttributes::GhostArrayName()));
+  vtkPoints *inPts = input->GetPoints();
+  vtkPoints *localPts = vtkPoints::New();
+  if ( inPts )
+  {
+    localPts->SetDataType(inPts->GetDataType());
+    localPts->ShallowCopy(inPts);
+  }
+
+  int numProcs = ( this->Controller ?
+                   this->Controller->GetNumberOfProcesses() : 1 );
+  if ( numProcs < 2 )
+  {
+    output->SetPoints(localPts);
+    localPts->Delete();
+    outPD->PassData(inPD);
+    if ( !inGhosts )
+    {
+      vtkUnsignedCharArray *ghosts = vtkUnsignedCharArray::New();
+      ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+      ghosts->SetNumberOfTuples(numPts);
+      ghosts->FillComponent(0, 0);
+      outPD->AddArray(ghosts);
+      ghosts->Delete();
+    }
+    return 1;
+  }
+  vtkMPIController *mpiController =
+    vtkMPIController::SafeDownCast(this->Controller);
+  if ( !mpiController )
+  {
+    localPts->Delete();
+    vtkErrorMacro("A vtkMPIController is required to exchange the halos");
+    return 0;
+  }
+  int myId = this->Controller->GetLocalProcessId();
+
+  // Build the spatial decomposition of the point cloud. vtkPKdTree
+  // decomposes cell centroids, the points are given as vertices.
+  vtkPolyData *cloud = vtkPolyData::New();
+  cloud->SetPoints(localPts);
+  vtkCellArray *verts = vtkCellArray::New();
+  verts->Allocate(2*numPts);
+  for (vtkIdType ptId=0; ptId < numPts; ++ptId)
+  {
+    verts->InsertNextCell(1, &ptId);
+  }
+  cloud->SetVerts(verts);
+  verts->Delete();
+
+  vtkPKdTree *kdtree = vtkPKdTree::New();
+  kdtree->SetController(this->Controller);
+  kdtree->SetNumberOfRegionsOrMore(this->NumberOfRegionsPerProcess * numProcs);
+  kdtree->SetMinCells(0);
+  kdtree->SetDataSet(cloud);
+  kdtree->BuildLocator();
+  int numRegions = kdtree->GetNumberOfRegions();
+
+  // The reach of the queries of each local point: the radius, or the
+  // distance to the farthest of its closest local points, within which
+  // all of its closest points in the whole point cloud lie.
+  std::vector<double> reach(numPts, this->Radius);
+  if ( this->HaloStyle == vtkPointHaloExchange::N_CLOSEST && numPts > 0 )
+  {
+    vtkStaticPointLocator *locator = vtkStaticPointLocator::New();
+    locator->SetDataSet(cloud);
+    vtkIdTypeArray *offsets = vtkIdTypeArray::New();
+    vtkIdTypeArray *neighbors = vtkIdTypeArray::New();
+    vtkDoubleArray *dist2 = vtkDoubleArray::New();
+    locator->FindAllClosestNPoints(this->NumberOfNeighbors, nullptr, offsets,
+                                   neighbors, dist2);
+    for (vtkIdType ptId=0; ptId < numPts; ++ptId)
+    {
+      vtkIdType end = offsets->GetValue(ptId+1);
+      reach[ptId] = ( end - offsets->GetValue(ptId) < this->NumberOfNeighbors ?
+                      VTK_DOUBLE_MAX : sqrt(dist2->GetValue(end-1)) );
+    }
+    locator->Delete();
+    offsets->Delete();
+    neighbors->Delete();
+    dist2->Delete();
+  }
+
+  // Bin the local points in the regions, and describe the regions. Points
+  // outside of the tree are put in the first region, the bounds of the
+  // regions are the bounds of the points they contain anyway.
+  std::vector<int> pointRegions(numPts, 0);
+  std::vector<vtkIdType> regionOffsets(numRegions+1, 0);
+  std::vector<double> localTable(REGION_TUPLE_SIZE*numRegions);
+  for (int regionId=0; regionId < numRegions; ++regionId)
+  {
+    double *tuple = &localTable[REGION_TUPLE_SIZE*regionId];
+    tuple[0] = tuple[2] = tuple[4] = VTK_DOUBLE_MAX;
+    tuple[1] = tuple[3] = tuple[5] = -VTK_DOUBLE_MAX;
+    tuple[6] = -1.0;
+  }
+  double x[3];
+  for (vtkIdType ptId=0; ptId < numPts && numRegions > 0; ++ptId)
+  {
+    localPts->GetPoint(ptId, x);
+    int regionId = kdtree->GetRegionContainingPoint(x[0], x[1], x[2]);
+    regionId = ( regionId < 0 ? 0 : regionId );
+    pointRegions[ptId] = regionId;
+    regionOffsets[regionId+1]++;
+    double *tuple = &localTable[REGION_TUPLE_SIZE*regionId];
+    for (int i=0; i < 3; ++i)
+    {
+      tuple[2*i] = std::min(tuple[2*i], x[i]);
+      tuple[2*i+1] = std::max(tuple[2*i+1], x[i]);
+    }
+    tuple[6] = std::max(tuple[6], reach[ptId]);
+  }
+  kdtree->Delete();
+  cloud->Delete();
+
+  std::vector<vtkIdType> regionPoints(numPts);
+  for (int regionId=0; regionId < numRegions; ++regionId)
+  {
+    regionOffsets[regionId+1] += regionOffsets[regionId];
+  }
+  std::vector<vtkIdType> insert(regionOffsets.begin(), regionOffsets.end());
+  for (vtkIdType ptId=0; ptId < numPts; ++ptId)
+  {
+    regionPoints[insert[pointRegions[ptId]]++] = ptId;
+  }
+
+  // Gather the regions of all the processes
+  std::vector<double> table(REGION_TUPLE_SIZE*numRegions*numProcs);
+  if ( numRegions > 0 )
+  {
+    this->Controller->AllGather(&localTable[0], &table[0],
+                                REGION_TUPLE_SIZE*numRegions);
+  }
+
+  // Select the halos of the processes whose regions are within reach of
+  // the local ones, and marshal them.
+  std::vector<int> linkedProcs;
+  std::vector<vtkCharArray*> sendBuffers;
+  std::vector<char> selected(numPts);
+  std::vector<vtkIdType> haloIds;
+  for (int procId=0; procId < numProcs; ++procId)
+  {
+    if ( procId == myId || numRegions == 0 ||
+         !ProcessesOverlap(&table[REGION_TUPLE_SIZE*myId*numRegions],
+                           &table[REGION_TUPLE_SIZE*procId*numRegions],
+                           numRegions) )
+    {
+      continue;
+    }
+
+    // The local points within reach of the regions of the other process
+    std::fill(selected.begin(), selected.end(), 0);
+    haloIds.clear();
+    for (int regionId=0; regionId < numRegions; ++regionId)
+    {
+      const double *remote =
+        &table[REGION_TUPLE_SIZE*(procId*numRegions + regionId)];
+      double reach2 = remote[6] * remote[6];
+      if ( remote[6] < 0.0 )
+      {
+        continue;
+      }
+      for (int localId=0; localId < numRegions; ++localId)
+      {
+        if ( regionOffsets[localId] == regionOffsets[localId+1] ||
+             !BoundsOverlap(&localTable[REGION_TUPLE_SIZE*localId], remote,
+                            remote[6]) )
+        {
+          continue;
+        }
+        for (vtkIdType i=regionOffsets[localId]; i < regionOffsets[localId+1]; ++i)
+        {
+          vtkIdType ptId = regionPoints[i];
+          if ( selected[ptId] || IsGhost(inGhosts, ptId) )
+          {
+            continue;
+          }
+          localPts->GetPoint(ptId, x);
+          if ( Distance2ToBounds(x, remote) <= reach2 )
+          {
+            selected[ptId] = 1;
+            haloIds.push_back(ptId);
+          }
+        }
+      }
+    }
+    std::sort(haloIds.begin(), haloIds.end());
+
+    vtkIdType numHaloPts = static_cast<vtkIdType>(haloIds.size());
+    vtkPolyData *sendHalo = vtkPolyData::New();
+    vtkPoints *sendPts = vtkPoints::New();
+    sendPts->SetDataType(localPts->GetDataType());
+    sendPts->SetNumberOfPoints(numHaloPts);
+    sendHalo->GetPointData()->CopyAllocate(inPD, numHaloPts);
+    for (vtkIdType i=0; i < numHaloPts; ++i)
+    {
+      sendPts->SetPoint(i, localPts->GetPoint(haloIds[i]));
+      sendHalo->GetPointData()->CopyData(inPD, haloIds[i], i);
+    }
+    sendHalo->SetPoints(sendPts);
+    sendPts->Delete();
+
+    vtkCharArray *buffer = vtkCharArray::New();
+    vtkCommunicator::MarshalDataObject(sendHalo, buffer);
+    sendHalo->Delete();
+    linkedProcs.push_back(procId);
+    sendBuffers.push_back(buffer);
+    this->NumberOfPointsSent += numHaloPts;
+    this->NumberOfBytesSent += buffer->GetNumberOfTuples();
+  }
+
+  // Exchange the sizes of the halos, then the halos, with the linked
+  // processes. The test of the regions is symmetric, so both processes of a
+  // pair agree on the exchange.
+  int numLinked = static_cast<int>(linkedProcs.size());
+  std::vector<int> sendSizes(numLinked);
+  std::vector<int> recvSizes(numLinked);
+  std::vector<vtkMPICommunicator::Request> requests(2*numLinked);
+  for (int i=0; i < numLinked; ++i)
+  {
+    sendSizes[i] = static_cast<int>(sendBuffers[i]->GetNumberOfTuples());
+    mpiController->NoBlockReceive(&recvSizes[i], 1, linkedProcs[i],
+                                  HALO_SIZE_TAG, requests[i]);
+    mpiController->NoBlockSend(&sendSizes[i], 1, linkedProcs[i],
+                               HALO_SIZE_TAG, requests[numLinked+i]);
+  }
+  if ( numLinked > 0 )
+  {
+    mpiController->WaitAll(2*numLinked, &requests[0]);
+  }
+
+  std::vector<vtkCharArray*> recvBuffers(numLinked);
+  for (int i=0; i < numLinked; ++i)
+  {
+    recvBuffers[i] = vtkCharArray::New();
+    recvBuffers[i]->SetNumberOfTuples(recvSizes[i]);
+    mpiController->NoBlockReceive(recvBuffers[i]->GetPointer(0), recvSizes[i],
+                                  linkedProcs[i], HALO_EXCHANGE_TAG,
+                                  requests[i]);
+    mpiController->NoBlockSend(sendBuffers[i]->GetPointer(0), sendSizes[i],
+                               linkedProcs[i], HALO_EXCHANGE_TAG,
+                               requests[numLinked+i]);
+  }
+  if ( numLinked > 0 )
+  {
+    mpiController->WaitAll(2*numLinked, &requests[0]);
+  }
+
+  std::vector<vtkPolyData*> halos(numProcs, nullptr);
+  for (int i=0; i < numLinked; ++i)
+  {
+    vtkPolyData *recvHalo = vtkPolyData::New();
+    vtkCommunicator::UnMarshalDataObject(recvBuffers[i], recvHalo);
+    this->NumberOfPointsReceived += recvHalo->GetNumberOfPoints();
+    this->NumberOfBytesReceived += recvSizes[i];
+    halos[linkedProcs[i]] = recvHalo;
+    sendBuffers[i]->Delete();
+    recvBuffers[i]->Delete();
+  }
+
+  // The output is made of the local points followed by the halos in the
+  // order of the processes.
+  vtkDataSetAttributes::FieldList fieldList(numProcs);
+  fieldList.InitializeFieldList(inPD);
+  vtkIdType numOutPts = numPts;
+  for (int procId=0; procId < numProcs; ++procId)
+  {
+    if ( halos[procId] && halos[procId]->GetNumberOfPoints() > 0 )
+    {
+      fieldList.IntersectFieldList(halos[procId]->GetPointData());
+      numOutPts += halos[procId]->GetNumberOfPoints();
+    }
+  }
+
+  vtkPoints *outPts = vtkPoints::New();
+  outPts->SetDataType(localPts->GetDataType());
+  outPts->SetNumberOfPoints(numOutPts);
+  outPD->CopyAllocate(fieldList, numOutPts);
+  for (vtkIdType ptId=0; ptId < numPts; ++ptId)
+  {
+    outPts->SetPoint(ptId, localPts->GetPoint(ptId));
+    outPD->CopyData(fieldList, inPD, 0, ptId, ptId);
+  }
+  vtkIdType outPtId = numPts;
+  int listIdx = 1;
+  for (int procId=0; procId < numProcs; ++procId)
+  {
+    vtkPolyData *halo = halos[procId];
+    if ( halo && halo->GetNumberOfPoints() > 0 )
+    {
+      vtkPointData *haloPD = halo->GetPointData();
+      for (vtkIdType ptId=0; ptId < halo->GetNumberOfPoints(); ++ptId, ++outPtId)
+      {
+        outPts->SetPoint(outPtId, halo->GetPoint(ptId));
+        outPD->CopyData(fieldList, haloPD, listIdx, ptId, outPtId);
+      }
+      listIdx++;
+    }
+    if ( halo )
+    {
+      halo->Delete();
+    }
+  }
+  output->SetPoints(outPts);
+  outPts->Delete();
+  localPts->Delete();
+
+  // Flag the halo points as ghosts
+  vtkUnsignedCharArray *ghosts = vtkArrayDownCast<vtkUnsignedCharArray>(
+    outPD->GetArray(vtkDataSetAttributes::GhostArrayName()));
+  if ( !ghosts )
+  {
+    ghosts = vtkUnsignedCharArray::New();
+    ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+    ghosts->SetNumberOfTuples(numOutPts);
+    ghosts->FillComponent(0, 0);
+    outPD->AddArray(ghosts);
+    ghosts->Delete();
+  }
+  for (vtkIdType ptId=numPts; ptId < numOutPts; ++ptId)
+  {
+    ghosts->SetValue(ptId, ghosts->GetValue(ptId) |
+                     vtkDataSetAttributes::DUPLICATEPOINT);
+  }
+
+  vtkDebugMacro(<< "Sent " << this->NumberOfPointsSent << " and received "
+                << this->NumberOfPointsReceived << " halo points");
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPointHaloExchange::FillInputPortInformation(int, vtkInformation *info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPointSet");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPointHaloExchange::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Controller: " << this->Controller << "\n";
+  os << indent << "Halo Style: " << this->HaloStyle << "\n";
+  os << indent << "Radius: " << this->Radius << "\n";
+  os << indent << "Number Of Neighbors: " << this->NumberOfNeighbors << "\n";
+  os << indent << "Number Of Regions Per Process: "
+     << this->NumberOfRegionsPerProcess << "\n";
+  os << indent << "Number Of Local Points: " << this->NumberOfLocalPoints << "\n";
+  os << indent << "Number Of Points Sent: " << this->NumberOfPointsSent << "\n";
+  os << indent << "Number Of Points Received: "
+     << this->NumberOfPointsReceived << "\n";
+  os << indent << "Number Of Bytes Sent: " << this->NumberOfBytesSent << "\n";
+  os << indent << "Number Of Bytes Received: "
+     << this->NumberOfBytesReceived << "\n";
+}
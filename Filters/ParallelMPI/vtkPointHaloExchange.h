@@ -0,0 +1,189 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPointHaloExchange.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPointHaloExchange
+ * @brief   gather the points of other processes needed by neighbor queries
+ *
+ * vtkPointHaloExchange takes as input the local piece of a point cloud
+ * distributed across processes, and produces a vtkPolyData made of the
+ * local points followed by a halo of points of the other processes. The
+ * halo contains all the remote points needed to answer the neighbor queries
+ * of the local points exactly: the points within Radius of a local point
+ * (RADIUS style), or the points that may be among the NumberOfNeighbors
+ * closest points of a local point (N_CLOSEST style). Serial filters
+ * executed on the output, such as vtkPointInterpolator (using the output
+ * as source), vtkRadiusOutlierRemoval or vtkPCANormalEstimation, then
+ * return for the local points the same results as a single process run on
+ * the whole point cloud.
+ *
+ * The processes first build a vtkPKdTree of the point cloud. For each of
+ * its regions, each process computes the bounds of its points in the
+ * region and the reach of their queries: the radius, or the distance to the
+ * farthest of the NumberOfNeighbors closest local points. These tables are
+ * gathered on all processes. Two processes exchange points only if the
+ * bounds of their regions are within reach of each other, and each one then
+ * sends only its points within reach of the bounds of the other's regions.
+ * The halos are exchanged with non-blocking communications, so the
+ * processes do not wait for each other pair after pair.
+ *
+ * The halo points are flagged as vtkDataSetAttributes::DUPLICATEPOINT in
+ * the vtkGhostType point array of the output, and their point data is
+ * copied from their process. Points already flagged as ghosts in the input
+ * are not sent. The communication volume of the last execution is
+ * available with GetNumberOfPointsSent() and related methods.
+ *
+ * @warning
+ * The controller must be a vtkMPIController when there are several
+ * processes.
+ *
+ * @warning
+ * The halo is a superset of the points needed by the queries, so it may
+ * contain points that are not neighbors of any local point.
+ *
+ * @warning
+ * The results of the filters executed on the output are only meaningful
+ * for the local points, the first GetNumberOfLocalPoints() output points;
+ * results computed for the halo points should be discarded.
+ *
+ * @warning
+ * vtkEuclideanClusterExtraction is not supported: its clusters may span
+ * several processes, and labeling them would require merging the cluster
+ * labels across the processes, which this filter does not do.
+ *
+ * @sa
+ * vtkPKdTree vtkDistributedDataFilter vtkStaticPointLocator
+ */
+
+#ifndef vtkPointHaloExchange_h
+#define vtkPointHaloExchange_h
+
+#include "vtkFiltersParallelMPIModule.h" // For export macro
+#include "vtkPolyDataAlgorithm.h"
+
+class vtkMultiProcessController;
+
+class VTKFILTERSPARALLELMPI_EXPORT vtkPointHaloExchange : public vtkPolyDataAlgorithm
+{
+public:
+  //@{
+  /**
+   * Standard methods for instantiation, type information, and printing.
+   */
+  static vtkPointHaloExchange *New();
+  vtkTypeMacro(vtkPointHaloExchange,vtkPolyDataAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Set/Get the controller. By default the global controller is used.
+   */
+  virtual void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  //@}
+
+  enum HaloStyle
+  {
+    RADIUS=0,
+    N_CLOSEST=1
+  };
+
+  //@{
+  /**
+   * Specify which neighbor queries the halo supports: the points within
+   * Radius (RADIUS), or the NumberOfNeighbors closest points (N_CLOSEST).
+   * The default is RADIUS.
+   */
+  vtkSetClampMacro(HaloStyle,int,RADIUS,N_CLOSEST);
+  vtkGetMacro(HaloStyle,int);
+  void SetHaloStyleToRadius()
+    { this->SetHaloStyle(RADIUS); }
+  void SetHaloStyleToNClosest()
+    { this->SetHaloStyle(N_CLOSEST); }
+  //@}
+
+  //@{
+  /**
+   * Specify the query radius of the RADIUS style. The default is 1.0.
+   */
+  vtkSetClampMacro(Radius,double,0.0,VTK_DOUBLE_MAX);
+  vtkGetMacro(Radius,double);
+  //@}
+
+  //@{
+  /**
+   * Specify the number of closest points of the N_CLOSEST style, including
+   * the query point itself. The default is 8.
+   */
+  vtkSetClampMacro(NumberOfNeighbors,int,1,VTK_INT_MAX);
+  vtkGetMacro(NumberOfNeighbors,int);
+  //@}
+
+  //@{
+  /**
+   * Specify the minimum number of regions of the k-d tree per process.
+   * More regions give a tighter halo at the price of larger tables. The
+   * default is 8.
+   */
+  vtkSetClampMacro(NumberOfRegionsPerProcess,int,1,VTK_INT_MAX);
+  vtkGetMacro(NumberOfRegionsPerProcess,int);
+  //@}
+
+  /**
+   * Return the number of local points of the last execution, they are the
+   * first points of the output.
+   */
+  vtkGetMacro(NumberOfLocalPoints,vtkIdType);
+
+  //@{
+  /**
+   * Return the communication volume of the last execution on this process:
+   * the number of halo points sent to and received from the other
+   * processes, and the size in bytes of the messages carrying them (points
+   * and point data). The tables of the k-d tree regions gathered on all
+   * processes and the message sizes are not included.
+   */
+  vtkGetMacro(NumberOfPointsSent,vtkIdType);
+  vtkGetMacro(NumberOfPointsReceived,vtkIdType);
+  vtkGetMacro(NumberOfBytesSent,vtkIdType);
+  vtkGetMacro(NumberOfBytesReceived,vtkIdType);
+  //@}
+
+protected:
+  vtkPointHaloExchange();
+  ~vtkPointHaloExchange() override;
+
+  int RequestData(vtkInformation *, vtkInformationVector **,
+                  vtkInformationVector *) override;
+  int FillInputPortInformation(int port, vtkInformation *info) override;
+
+  vtkMultiProcessController *Controller;
+  int HaloStyle;
+  double Radius;
+  int NumberOfNeighbors;
+  int NumberOfRegionsPerProcess;
+
+  vtkIdType NumberOfLocalPoints;
+  vtkIdType NumberOfPointsSent;
+  vtkIdType NumberOfPointsReceived;
+  vtkIdType NumberOfBytesSent;
+  vtkIdType NumberOfBytesReceived;
+
+private:
+  vtkPointHaloExchange(const vtkPointHaloExchange&) = delete;
+  void operator=(const vtkPointHaloExchange&) = delete;
+};
+
+#endif
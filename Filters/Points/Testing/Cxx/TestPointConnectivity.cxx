@@ -0,0 +1,217 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPointConnectivity.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the clusters of vtkEuclideanClusterExtraction and the regions of
+// vtkConnectedPointsFilter with a brute force traversal of the points, with
+// and without scalar connectivity.
+
+#include "vtkConnectedPointsFilter.h"
+#include "vtkEuclideanClusterExtraction.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <vector>
+
+namespace
+{
+
+const vtkIdType NUMBER_OF_POINTS = 3000;
+const double RADIUS = 0.07;
+
+// Grow a region from each point not yet labeled, points out of the mask
+// are not labeled.
+vtkIdType BruteForceLabels(vtkPoints* points, const std::vector<char>& mask,
+                           std::vector<vtkIdType>& labels)
+{
+  vtkIdType numPts = points->GetNumberOfPoints();
+  labels.assign(numPts, -1);
+  vtkIdType numRegions = 0;
+  std::vector<vtkIdType> wave;
+  double x[3], y[3];
+  for (vtkIdType seed = 0; seed < numPts; ++seed)
+  {
+    if (labels[seed] >= 0 || !mask[seed])
+    {
+      continue;
+    }
+    labels[seed] = numRegions;
+    wave.assign(1, seed);
+    while (!wave.empty())
+    {
+      vtkIdType ptId = wave.back();
+      wave.pop_back();
+      points->GetPoint(ptId, x);
+      for (vtkIdType i = 0; i < numPts; ++i)
+      {
+        points->GetPoint(i, y);
+        if (labels[i] < 0 && mask[i] &&
+            vtkMath::Distance2BetweenPoints(x, y) <= RADIUS * RADIUS)
+        {
+          labels[i] = numRegions;
+          wave.push_back(i);
+        }
+      }
+    }
+    numRegions++;
+  }
+  return numRegions;
+}
+
+bool CheckClusters(vtkPolyData* input, const std::vector<char>& mask, bool scalars)
+{
+  std::vector<vtkIdType> labels;
+  vtkIdType numRegions = BruteForceLabels(input->GetPoints(), mask, labels);
+
+  vtkNew<vtkEuclideanClusterExtraction> clusters;
+  clusters->SetInputData(input);
+  clusters->SetRadius(RADIUS);
+  clusters->SetExtractionModeToAllClusters();
+  clusters->ColorClustersOn();
+  clusters->SetScalarConnectivity(scalars);
+  clusters->SetScalarRange(0.0, 0.7);
+  clusters->Update();
+  vtkIdTypeArray* clusterIds = vtkArrayDownCast<vtkIdTypeArray>(
+    clusters->GetOutput()->GetPointData()->GetArray("ClusterId"));
+  if (clusters->GetNumberOfExtractedClusters() != numRegions || !clusterIds)
+  {
+    cerr << "Found " << clusters->GetNumberOfExtractedClusters()
+         << " clusters instead of " << numRegions << endl;
+    return false;
+  }
+  vtkIdType newId = 0, largest = 0;
+  std::vector<vtkIdType> sizes(numRegions, 0);
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    if (labels[ptId] < 0)
+    {
+      continue;
+    }
+    if (clusterIds->GetValue(newId++) != labels[ptId])
+    {
+      cerr << "Wrong cluster of point " << ptId << endl;
+      return false;
+    }
+    if (++sizes[labels[ptId]] > sizes[largest])
+    {
+      largest = labels[ptId];
+    }
+  }
+  if (newId != clusterIds->GetNumberOfTuples())
+  {
+    cerr << "Wrong number of extracted points" << endl;
+    return false;
+  }
+
+  clusters->SetExtractionModeToLargestCluster();
+  clusters->Update();
+  if (clusters->GetOutput()->GetNumberOfPoints() != sizes[largest])
+  {
+    cerr << "Wrong largest cluster" << endl;
+    return false;
+  }
+
+  // The connected points filter labels the points out of the scalar range
+  // as regions of their own.
+  vtkNew<vtkConnectedPointsFilter> regions;
+  regions->SetInputData(input);
+  regions->SetRadius(RADIUS);
+  regions->SetScalarConnectivity(scalars);
+  regions->SetScalarRange(0.0, 0.7);
+  regions->Update();
+  vtkIdTypeArray* regionLabels = vtkArrayDownCast<vtkIdTypeArray>(
+    regions->GetOutput()->GetPointData()->GetArray("RegionLabels"));
+  // Regions are numbered in order of their smallest point id
+  std::vector<vtkIdType> expected(input->GetNumberOfPoints(), -1);
+  std::vector<vtkIdType> regionMap(numRegions, -1);
+  vtkIdType numExpected = 0;
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    if (labels[ptId] < 0)
+    {
+      expected[ptId] = numExpected++;
+    }
+    else
+    {
+      if (regionMap[labels[ptId]] < 0)
+      {
+        regionMap[labels[ptId]] = numExpected++;
+      }
+      expected[ptId] = regionMap[labels[ptId]];
+    }
+  }
+  if (!regionLabels || regions->GetNumberOfExtractedRegions() != numExpected)
+  {
+    cerr << "Found " << regions->GetNumberOfExtractedRegions()
+         << " regions instead of " << numExpected << endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    if (regionLabels->GetValue(ptId) != expected[ptId])
+    {
+      cerr << "Wrong region of point " << ptId << endl;
+      return false;
+    }
+  }
+  return numRegions > 1;
+}
+
+}
+
+int TestPointConnectivity(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scalars;
+  points->SetNumberOfPoints(NUMBER_OF_POINTS);
+  scalars->SetNumberOfTuples(NUMBER_OF_POINTS);
+  for (vtkIdType i = 0; i < NUMBER_OF_POINTS; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetValue();
+      random->Next();
+    }
+    points->SetPoint(i, x);
+    scalars->SetValue(i, random->GetValue());
+    random->Next();
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points.GetPointer());
+  input->GetPointData()->SetScalars(scalars.GetPointer());
+
+  std::vector<char> mask(NUMBER_OF_POINTS, 1);
+  if (!CheckClusters(input.GetPointer(), mask, false))
+  {
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < NUMBER_OF_POINTS; ++i)
+  {
+    mask[i] = scalars->GetValue(i) <= 0.7;
+  }
+  if (!CheckClusters(input.GetPointer(), mask, true))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -27,6 +27,9 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkIdTypeArray.h"
+#include "vtkPointConnectivityLabeler.h"
+
+#include <vector>
 
 vtkStandardNewMacro(vtkConnectedPointsFilter);
 vtkCxxSetObjectMacro(vtkConnectedPointsFilter,Locator,vtkAbstractPointLocator);
@@ -61,18 +64,8 @@ vtkConnectedPointsFilter::vtkConnectedPointsFilter()
   // Perform local operations efficiently
   this->Locator = vtkStaticPointLocator::New();
 
-  // The labeling of points (i.e., their associated regions)
-  this->CurrentRegionNumber = 0;
-  this->RegionLabels = nullptr;
-
   // Keep track of region sizes
-  this->NumPointsInRegion = 0;
   this->RegionSizes = vtkIdTypeArray::New();
-
-  // Processing waves
-  this->NeighborPointIds = vtkIdList::New();
-  this->Wave = nullptr;
-  this->Wave2 = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -81,12 +74,7 @@ vtkConnectedPointsFilter::~vtkConnectedPointsFilter()
   this->Seeds->Delete();
   this->SpecifiedRegionIds->Delete();
 
-  if ( this->RegionLabels != nullptr )
-  {
-    this->RegionLabels->Delete();
-  }
   this->RegionSizes->Delete();
-  this->NeighborPointIds->Delete();
 
   this->SetLocator(nullptr);
 }
@@ -159,127 +147,92 @@ int vtkConnectedPointsFilter::RequestData(
     }
   }
 
-  // Initialize.  Keep track of points and cells visited.
+  // Label the regions of all points. Points out of the scalar range are
+  // not connected to other points and form regions of their own.
   //
-  this->RegionSizes->Reset();
-  this->RegionLabels = vtkIdTypeArray::New();
-  this->RegionLabels->SetName("RegionLabels");
-  this->RegionLabels->SetNumberOfTuples(numPts);
-  vtkIdType *labels = static_cast<vtkIdType*>(this->RegionLabels->GetVoidPointer(0));
-  std::fill_n(labels, numPts, -1);
-
-  // This is an incremental (propagating wave) traveral of the points. The
-  // traversal is a function of proximity, planarity, and/or position on a
-  // plane
-  vtkIdType ptId;
-  this->Wave = vtkIdList::New();
-  this->Wave->Allocate(numPts/4+1,numPts);
-  this->Wave2 = vtkIdList::New();
-  this->Wave2->Allocate(numPts/4+1,numPts);
-
-  // Traverse all points, and label all points
-  if ( this->ExtractionMode == VTK_EXTRACT_ALL_REGIONS ||
-       this->ExtractionMode == VTK_EXTRACT_LARGEST_REGION ||
-       this->ExtractionMode == VTK_EXTRACT_SPECIFIED_REGIONS )
+  std::vector<unsigned char> mask;
+  if ( inScalars )
   {
-    this->CurrentRegionNumber = 0;
-
-    for (ptId=0; ptId < numPts; ++ptId)
-    {
-      if ( labels[ptId] < 0 ) //not yet visited
-      {
-        this->Wave->InsertNextId(ptId); //begin next connected wave
-        this->NumPointsInRegion = 1;
-        labels[ptId] = this->CurrentRegionNumber;
-        this->TraverseAndMark(inPts, inScalars, n, labels);
-        this->RegionSizes->InsertValue(this->CurrentRegionNumber++,this->NumPointsInRegion);
-        this->Wave->Reset();
-        this->Wave2->Reset();
-      }
-    }//for all points
-
-    if ( this->ExtractionMode == VTK_EXTRACT_ALL_REGIONS )
+    mask.resize(numPts);
+    for (vtkIdType ptId=0; ptId < numPts; ++ptId)
     {
-      // Can just copy input to output, add label array
-      output->CopyStructure(input);
-      outputPD->PassData(pd);
-      outputCD->PassData(cd);
-
-      outputPD->AddArray(this->RegionLabels);
-      outputPD->SetActiveScalars("RegionLabels");
-      this->RegionLabels->Delete();
-      this->RegionLabels = nullptr;
+      double s = inScalars->GetComponent(ptId,0);
+      mask[ptId] = ( s >= this->ScalarRange[0] && s <= this->ScalarRange[1] );
     }
+  }
 
-    else if ( this->ExtractionMode == VTK_EXTRACT_LARGEST_REGION )
-    {
-      vtkIdType regionSize, largestRegion=0, largestRegionSize=0;
-      vtkIdType numRegions = this->RegionSizes->GetNumberOfTuples();
-      for (vtkIdType regNum=0; regNum < numRegions; ++regNum)
-      {
-        regionSize = this->RegionSizes->GetValue(regNum);
-        if ( regionSize > largestRegionSize )
-        {
-          largestRegionSize = regionSize;
-          largestRegion = regNum;
-        }
-      }
+  vtkIdTypeArray *regionLabels = vtkIdTypeArray::New();
+  regionLabels->SetName("RegionLabels");
+  regionLabels->SetNumberOfTuples(numPts);
+  vtkIdType *labels = regionLabels->GetPointer(0);
 
-      // Now create output: loop over points and find those that are in largest
-      // region
-      vtkPoints *outPts = vtkPoints::New(inPts->GetDataType());
-      outputPD->CopyAllocate(pd);
+  vtkPointConnectivityLabeler *labeler = vtkPointConnectivityLabeler::New();
+  labeler->SetRadius(this->Radius);
+  labeler->SetNormalThreshold(this->NormalThreshold);
+  labeler->LabelMaskedPointsOn();
+  vtkIdType numRegions = labeler->LabelPoints(this->Locator, inPts,
+    (mask.empty() ? nullptr : &mask[0]), n, labels, this->RegionSizes);
+  labeler->Delete();
 
-      vtkIdType newId;
-      for (ptId=0; ptId < numPts; ++ptId)
+  // Extract the requested regions
+  vtkIdType ptId;
+  if ( this->ExtractionMode == VTK_EXTRACT_ALL_REGIONS )
+  {
+    // Can just copy input to output, add label array
+    output->CopyStructure(input);
+    outputPD->PassData(pd);
+    outputCD->PassData(cd);
+
+    outputPD->AddArray(regionLabels);
+    outputPD->SetActiveScalars("RegionLabels");
+  }
+
+  else if ( this->ExtractionMode == VTK_EXTRACT_LARGEST_REGION ||
+            this->ExtractionMode == VTK_EXTRACT_SPECIFIED_REGIONS )
+  {
+    vtkIdType regionSize, largestRegion=0, largestRegionSize=0;
+    for (vtkIdType regNum=0; regNum < numRegions; ++regNum)
+    {
+      regionSize = this->RegionSizes->GetValue(regNum);
+      if ( regionSize > largestRegionSize )
       {
-        // valid region ids (non-negative) are output.
-        if ( labels[ptId] == largestRegion )
-        {
-          newId = outPts->InsertNextPoint(inPts->GetPoint(ptId));
-          outputPD->CopyData(pd, ptId, newId);
-        }
+        largestRegionSize = regionSize;
+        largestRegion = regNum;
       }
-      output->SetPoints(outPts);
-      outPts->Delete();
     }
 
-    else //if ( this->ExtractionMode == VTK_EXTRACT_SPECIFIED_REGIONS )
-    {
-      vtkPoints *outPts = vtkPoints::New(inPts->GetDataType());
-      outputPD->CopyAllocate(pd);
+    // Now create output: loop over points and find those that are in the
+    // extracted regions
+    vtkPoints *outPts = vtkPoints::New(inPts->GetDataType());
+    outputPD->CopyAllocate(pd);
 
-      vtkIdType newId;
-      for (ptId=0; ptId < numPts; ++ptId)
+    vtkIdType newId;
+    for (ptId=0; ptId < numPts; ++ptId)
+    {
+      if ( this->ExtractionMode == VTK_EXTRACT_LARGEST_REGION ?
+           labels[ptId] == largestRegion :
+           this->SpecifiedRegionIds->IsId(labels[ptId]) >= 0 )
       {
-        // valid region ids (non-negative) are output.
-        if ( labels[ptId] >= 0 &&
-             this->SpecifiedRegionIds->IsId(labels[ptId]) >= 0 )
-        {
-          newId = outPts->InsertNextPoint(inPts->GetPoint(ptId));
-          outputPD->CopyData(pd, ptId, newId);
-        }
+        newId = outPts->InsertNextPoint(inPts->GetPoint(ptId));
+        outputPD->CopyData(pd, ptId, newId);
       }
-      output->SetPoints(outPts);
-      outPts->Delete();
     }
-  }//need to process all regions
+    output->SetPoints(outPts);
+    outPts->Delete();
+  }
 
-  // Otherwise just a subset of points is extracted and labeled
+  // Otherwise just the seeded regions are extracted and labeled
   else
   {
-    this->CurrentRegionNumber = 0;
-    this->NumPointsInRegion = 0;
+    std::vector<char> seeded(numRegions, 0);
     if ( this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS )
     {
       for (int i=0; i < this->Seeds->GetNumberOfIds(); i++)
       {
         ptId = this->Seeds->GetId(i);
-        if ( ptId >= 0 )
+        if ( ptId >= 0 && ptId < numPts )
         {
-          labels[ptId] = this->CurrentRegionNumber;
-          this->NumPointsInRegion++;
-          this->Wave->InsertNextId(ptId);
+          seeded[labels[ptId]] = 1;
         }
       }
     }
@@ -288,16 +241,10 @@ int vtkConnectedPointsFilter::RequestData(
       ptId = this->Locator->FindClosestPoint(this->ClosestPoint);
       if ( ptId >= 0 )
       {
-        labels[ptId] = this->CurrentRegionNumber;
-        this->NumPointsInRegion++;
-        this->Wave->InsertNextId(ptId);
+        seeded[labels[ptId]] = 1;
       }
     }
 
-    // Mark all seeded regions
-    this->TraverseAndMark(inPts, inScalars, n, labels);
-    this->RegionSizes->InsertValue(this->CurrentRegionNumber,this->NumPointsInRegion);
-
     // Now create output: loop over points and find those that are marked.
     vtkPoints *outPts = vtkPoints::New(inPts->GetDataType());
     outputPD->CopyAllocate(pd);
@@ -305,8 +252,7 @@ int vtkConnectedPointsFilter::RequestData(
     vtkIdType newId;
     for (ptId=0; ptId < numPts; ++ptId)
     {
-      // valid region ids (non-negative) are output.
-      if ( labels[ptId] >= 0 )
+      if ( seeded[labels[ptId]] )
       {
         newId = outPts->InsertNextPoint(inPts->GetPoint(ptId));
         outputPD->CopyData(pd, ptId, newId);
@@ -314,90 +260,20 @@ int vtkConnectedPointsFilter::RequestData(
     }
     output->SetPoints(outPts);
     outPts->Delete();
+
+    // All the seeded regions form region 0
+    this->RegionSizes->Reset();
+    this->RegionSizes->InsertValue(0,output->GetNumberOfPoints());
   }
 
   vtkDebugMacro (<< "Extracted " << output->GetNumberOfPoints() << " points");
 
   // Clean up
-  this->Wave->Delete();
-  this->Wave2->Delete();
+  regionLabels->Delete();
 
   return 1;
 }
 
-
-//----------------------------------------------------------------------------
-// Mark current points as visited and assign region number.  Note:
-// traversal occurs across neighboring points.
-//
-void vtkConnectedPointsFilter::
-TraverseAndMark (vtkPoints *inPts, vtkDataArray *inScalars, float *normals, vtkIdType *labels)
-{
-  vtkIdType i, j, numPts, numIds, ptId, neiId;
-  vtkIdList *tmpWave;
-  double x[3];
-  float *n, *n2;
-  this->NeighborPointIds->Reset();
-  vtkIdList *wave = this->Wave;
-  vtkIdList *wave2 = this->Wave2;
-  bool connectedPoint;
-
-  while ( (numIds=wave->GetNumberOfIds()) > 0 )
-  {
-    for ( i=0; i < numIds; i++ ) //for all points in this wave
-    {
-      ptId = wave->GetId(i);
-      inPts->GetPoint(ptId,x);
-      this->Locator->FindPointsWithinRadius(this->Radius,x,this->NeighborPointIds);
-
-      numPts = this->NeighborPointIds->GetNumberOfIds();
-      for (j=0; j < numPts; ++j)
-      {
-        neiId = this->NeighborPointIds->GetId(j);
-        if ( labels[neiId] < 0 )
-        {
-          // proximial to the current point
-          connectedPoint = true;
-
-          // Does it satisfy scalar connectivity?
-          if ( inScalars != nullptr )
-          {
-            double s = inScalars->GetComponent(neiId,0);
-            if ( s < this->ScalarRange[0] || s > this->ScalarRange[1] )
-            {
-              connectedPoint = false;
-            }
-          }
-
-          // Does it satisfy normal connectivity?
-          if ( normals != nullptr )
-          {
-            n = normals + 3*ptId; //in case normals are used
-            n2 = normals + 3*neiId;
-            if ( vtkMath::Dot(n,n2) < this->NormalThreshold )
-            {
-              connectedPoint = false;
-            }
-          }
-
-          // If all criterion are satisfied
-          if ( connectedPoint )
-          {
-            labels[neiId] = this->CurrentRegionNumber;
-            this->NumPointsInRegion++;
-            wave2->InsertNextId(neiId);
-          }
-        }//if point not yet visited
-      }//for all neighbors
-    }//for all cells in this wave
-
-    tmpWave = wave;
-    wave = wave2;
-    wave2 = tmpWave;
-    tmpWave->Reset();
-  } //while wave is not empty
-}
-
 //----------------------------------------------------------------------------
 // Obtain the number of connected regions.
 int vtkConnectedPointsFilter::GetNumberOfExtractedRegions()
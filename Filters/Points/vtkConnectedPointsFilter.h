@@ -44,6 +44,13 @@
  * extracting all regions then the output size may be less than the input
  * size.
  *
+ * The regions are labeled in parallel with a union-find structure over the
+ * radius graph of the points (see vtkPointConnectivityLabeler), and are
+ * numbered in order of their smallest point id. The connectivity criteria
+ * are symmetric: two neighboring points are connected when both satisfy
+ * the scalar range and their normals are aligned. A point out of the scalar
+ * range forms a region of its own.
+ *
  * @sa
  * vtkPolyDataConnectivityFilter vtkConnectivityFilter
 */
@@ -239,19 +246,9 @@ protected:
   // accelerate searching
   vtkAbstractPointLocator *Locator;
 
-  // Wave propagation used to segment points
-  void TraverseAndMark (vtkPoints *inPts, vtkDataArray *inScalars,
-                        float *normals, vtkIdType *labels);
-
 private:
   // used to support algorithm execution
-  vtkIdType CurrentRegionNumber;
-  vtkIdTypeArray *RegionLabels;
-  vtkIdType NumPointsInRegion;
   vtkIdTypeArray *RegionSizes;
-  vtkIdList *NeighborPointIds; //avoid repetitive new/delete
-  vtkIdList *Wave;
-  vtkIdList *Wave2;
 
 private:
   vtkConnectedPointsFilter(const vtkConnectedPointsFilter&) = delete;
@@ -15,6 +15,7 @@
 #include "vtkEuclideanClusterExtraction.h"
 
 #include "vtkPointSet.h"
+#include "vtkDataArray.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -22,11 +23,13 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
-#include "vtkFloatArray.h"
 #include "vtkAbstractPointLocator.h"
+#include "vtkPointConnectivityLabeler.h"
 #include "vtkStaticPointLocator.h"
 #include "vtkIdTypeArray.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkEuclideanClusterExtraction);
 vtkCxxSetObjectMacro(vtkEuclideanClusterExtraction,Locator,vtkAbstractPointLocator);
 
@@ -46,17 +49,8 @@ vtkEuclideanClusterExtraction::vtkEuclideanClusterExtraction()
 
   this->Locator = vtkStaticPointLocator::New();
 
-  this->NeighborScalars = vtkFloatArray::New();
-  this->NeighborScalars->Allocate(64);
-
-  this->NeighborPointIds = vtkIdList::New();
-  this->NeighborPointIds->Allocate(64);
-
   this->Seeds = vtkIdList::New();
   this->SpecifiedClusterIds = vtkIdList::New();
-
-  this->NewScalars = nullptr;
-
 }
 
 //----------------------------------------------------------------------------
@@ -64,8 +58,6 @@ vtkEuclideanClusterExtraction::~vtkEuclideanClusterExtraction()
 {
   this->SetLocator(nullptr);
   this->ClusterSizes->Delete();
-  this->NeighborScalars->Delete();
-  this->NeighborPointIds->Delete();
   this->Seeds->Delete();
   this->SpecifiedClusterIds->Delete();
 }
@@ -87,14 +79,13 @@ int vtkEuclideanClusterExtraction::RequestData(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkIdType numPts, i, ptId;
-  vtkPoints *newPts;
-  int maxPointsInCluster, clusterId, largestClusterId=0;
   vtkPointData *pd=input->GetPointData(), *outputPD=output->GetPointData();
 
   vtkDebugMacro(<<"Executing point clustering filter.");
 
   //  Check input/allocate storage
   //
+  this->ClusterSizes->Reset();
   if ( (numPts=input->GetNumberOfPoints()) < 1 )
   {
     vtkDebugMacro(<<"No data to cluster!");
@@ -110,269 +101,164 @@ int vtkEuclideanClusterExtraction::RequestData(
   }
   this->Locator->SetDataSet(input);
   this->Locator->BuildLocator();
+  this->UpdateProgress (0.1);
 
-  // See whether to consider scalar connectivity
+  // See whether to consider scalar connectivity. Points out of the scalar
+  // range belong to no cluster.
   //
-  this->InScalars = input->GetPointData()->GetScalars();
-  if ( !this->ScalarConnectivity )
+  vtkDataArray *inScalars = input->GetPointData()->GetScalars();
+  std::vector<unsigned char> mask;
+  if ( this->ScalarConnectivity && inScalars )
   {
-    this->InScalars = nullptr;
-  }
-  else
-  {
-    this->NeighborScalars->SetNumberOfComponents(this->InScalars->GetNumberOfComponents());
     if ( this->ScalarRange[1] < this->ScalarRange[0] )
     {
       this->ScalarRange[1] = this->ScalarRange[0];
     }
-  }
-
-  // Initialize.  Keep track of the points visited.
-  //
-  this->Visited = new char [numPts];
-  std::fill_n(this->Visited, numPts, static_cast<char>(0));
-
-  this->ClusterSizes->Reset();
-  this->PointMap = new vtkIdType[numPts];
-  std::fill_n(this->PointMap, numPts, static_cast<vtkIdType>(-1));
-
-  this->NewScalars = vtkIdTypeArray::New();
-  this->NewScalars->SetName("ClusterId");
-  this->NewScalars->SetNumberOfTuples(numPts);
-
-  newPts = vtkPoints::New();
-  newPts->SetDataType(input->GetPoints()->GetDataType());
-  newPts->Allocate(numPts);
-
-  // Traverse all points marking those visited.  Each new search
-  // starts a new connected cluster. Connected clusters grow
-  // using a connected wave propagation.
-  //
-  this->Wave = vtkIdList::New();
-  this->Wave->Allocate(numPts/4+1,numPts);
-  this->Wave2 = vtkIdList::New();
-  this->Wave2->Allocate(numPts/4+1,numPts);
-
-  this->PointNumber = 0;
-  this->ClusterNumber = 0;
-  maxPointsInCluster = 0;
-
-  this->PointIds = vtkIdList::New();
-  this->PointIds->Allocate(8, VTK_CELL_SIZE);
-
-  if ( this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_CLUSTERS &&
-  this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_CLUSTER )
-  { //visit all points assigning cluster number
+    mask.resize(numPts);
     for (ptId=0; ptId < numPts; ptId++)
     {
-      if ( ptId && !(ptId % 10000) )
-      {
-        this->UpdateProgress (0.1 + 0.8*ptId/numPts);
-      }
-
-      if ( ! this->Visited[ptId] )
-      {
-        this->NumPointsInCluster = 0;
-        this->InsertIntoWave(this->Wave,ptId);
-        this->TraverseAndMark (inPts);
-
-        if ( this->NumPointsInCluster > maxPointsInCluster )
-        {
-          maxPointsInCluster = this->NumPointsInCluster;
-          largestClusterId = this->ClusterNumber;
-        }
-
-        if ( this->NumPointsInCluster > 0 )
-        {
-          this->ClusterSizes->InsertValue(this->ClusterNumber++,
-                                          this->NumPointsInCluster);
-        }
-        this->Wave->Reset();
-        this->Wave2->Reset();
-      }
+      double s = inScalars->GetTuple1(ptId);
+      mask[ptId] = ( s >= this->ScalarRange[0] && s <= this->ScalarRange[1] );
     }
   }
-  else // clusters have been seeded, everything considered in same cluster
-  {
-    this->NumPointsInCluster = 0;
 
+  // Label the clusters of all points; clusters are numbered in order of
+  // their smallest point id.
+  //
+  std::vector<vtkIdType> labels(numPts);
+  vtkPointConnectivityLabeler *labeler = vtkPointConnectivityLabeler::New();
+  labeler->SetRadius(this->Radius);
+  vtkIdType numClusters = labeler->LabelPoints(this->Locator, inPts,
+    (mask.empty() ? nullptr : &mask[0]), nullptr, &labels[0], this->ClusterSizes);
+  labeler->Delete();
+  this->UpdateProgress (0.8);
+
+  // Select the cluster of each output point, or -1 if the point is not
+  // extracted.
+  //
+  vtkIdType largestClusterId = 0;
+  if ( this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_CLUSTERS ||
+       this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_CLUSTER )
+  { // clusters have been seeded, everything considered in same cluster
+    std::vector<char> seeded(numClusters, 0);
     if ( this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_CLUSTERS )
     {
-      this->NumPointsInCluster = 0;
       for (i=0; i < this->Seeds->GetNumberOfIds(); i++)
       {
         ptId = this->Seeds->GetId(i);
-        if ( ptId >= 0 )
+        if ( ptId >= 0 && ptId < numPts && labels[ptId] >= 0 )
         {
-          this->InsertIntoWave(this->Wave,ptId);
+          seeded[labels[ptId]] = 1;
         }
       }
     }
-    else if ( this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_CLUSTER )
-    {//loop over points, find closest one
+    else
+    {
       ptId = this->Locator->FindClosestPoint(this->ClosestPoint);
-      this->InsertIntoWave(this->Wave,ptId);
+      if ( ptId >= 0 && labels[ptId] >= 0 )
+      {
+        seeded[labels[ptId]] = 1;
+      }
     }
-    this->UpdateProgress (0.5);
-
-    //mark all seeded clusters
-    this->TraverseAndMark (inPts);
-    this->ClusterSizes->InsertValue(this->ClusterNumber,this->NumPointsInCluster);
-    this->UpdateProgress (0.9);
-  }
-
-  vtkDebugMacro (<<"Extracted " << this->ClusterNumber << " cluster(s)");
-  this->Wave->Delete();
-  this->Wave2->Delete();
-  delete [] this->Visited;
 
-  // Now that points have been marked, traverse the PointMap pulling
-  // everything that has been visited and is selected for output.
-  outputPD->CopyAllocate(pd);
-  if ( this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_CLUSTERS ||
-  this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_CLUSTER ||
-  this->ExtractionMode == VTK_EXTRACT_ALL_CLUSTERS)
-  { // extract any point that's been visited
+    vtkIdType numPointsInCluster = 0;
     for (ptId=0; ptId < numPts; ptId++)
     {
-      if ( this->PointMap[ptId] >= 0 )
+      if ( labels[ptId] >= 0 && seeded[labels[ptId]] )
+      {
+        labels[ptId] = 0;
+        numPointsInCluster++;
+      }
+      else
       {
-        newPts->InsertPoint(this->PointMap[ptId],inPts->GetPoint(ptId));
-        outputPD->CopyData(pd,ptId,this->PointMap[ptId]);
+        labels[ptId] = -1;
       }
     }
+    this->ClusterSizes->Reset();
+    this->ClusterSizes->InsertValue(0,numPointsInCluster);
   }
   else if ( this->ExtractionMode == VTK_EXTRACT_SPECIFIED_CLUSTERS )
   {
-    bool inCluster;
+    std::vector<char> specified(numClusters, 0);
+    for (i=0; i < this->SpecifiedClusterIds->GetNumberOfIds(); i++)
+    {
+      vtkIdType clusterId = this->SpecifiedClusterIds->GetId(i);
+      if ( clusterId >= 0 && clusterId < numClusters )
+      {
+        specified[clusterId] = 1;
+      }
+    }
     for (ptId=0; ptId < numPts; ptId++)
     {
-      if ( this->PointMap[ptId] >= 0 )
+      if ( labels[ptId] >= 0 && !specified[labels[ptId]] )
       {
-        clusterId = this->NewScalars->GetValue(this->PointMap[ptId]);
-        for (inCluster=false,i=0; i<this->SpecifiedClusterIds->GetNumberOfIds(); i++)
-        {
-          if ( clusterId == this->SpecifiedClusterIds->GetId(i) )
-          {
-            inCluster = true;
-            break;
-          }
-        }
-        if ( inCluster )
-        {
-          newPts->InsertPoint(this->PointMap[ptId],inPts->GetPoint(ptId));
-          outputPD->CopyData(pd,ptId,this->PointMap[ptId]);
-        }
+        labels[ptId] = -1;
       }
     }
   }
-  else //extract largest cluster
+  else if ( this->ExtractionMode == VTK_EXTRACT_LARGEST_CLUSTER )
   {
+    vtkIdType maxPointsInCluster = 0;
+    for (vtkIdType clusterId=0; clusterId < numClusters; clusterId++)
+    {
+      if ( this->ClusterSizes->GetValue(clusterId) > maxPointsInCluster )
+      {
+        maxPointsInCluster = this->ClusterSizes->GetValue(clusterId);
+        largestClusterId = clusterId;
+      }
+    }
     for (ptId=0; ptId < numPts; ptId++)
     {
-      if ( this->PointMap[ptId] >= 0 )
+      if ( labels[ptId] != largestClusterId )
       {
-        clusterId = this->NewScalars->GetValue(this->PointMap[ptId]);
-        if ( clusterId == largestClusterId )
-        {
-          newPts->InsertPoint(this->PointMap[ptId],inPts->GetPoint(ptId));
-          outputPD->CopyData(pd,ptId,this->PointMap[ptId]);
-        }
+        labels[ptId] = -1;
       }
     }
   }
 
-  // if coloring clusters; send down new scalar data
-  if ( this->ColorClusters )
-  {
-    int idx = outputPD->AddArray(this->NewScalars);
-    outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-  }
-  this->NewScalars->Delete();
+  vtkDebugMacro (<<"Extracted " << this->GetNumberOfExtractedClusters()
+                 << " cluster(s)");
 
-  newPts->Squeeze();
-  output->SetPoints(newPts);
-
-  delete [] this->PointMap;
-  this->PointIds->Delete();
-
-  // print out some debugging information
-  int num = this->GetNumberOfExtractedClusters();
-  int count = 0;
-
-  for (int ii = 0; ii < num; ii++)
+  // Now traverse the points pulling everything that has been selected
+  // for output, in input order.
+  vtkIdType numNewPts = 0;
+  for (ptId=0; ptId < numPts; ptId++)
   {
-    count += this->ClusterSizes->GetValue (ii);
+    numNewPts += ( labels[ptId] >= 0 );
   }
-  vtkDebugMacro (<< "Total # of points accounted for: " << count);
-  vtkDebugMacro (<< "Extracted " << newPts->GetNumberOfPoints() << " points");
-  newPts->Delete();
-
-  return 1;
-}
 
+  vtkPoints *newPts = vtkPoints::New();
+  newPts->SetDataType(inPts->GetDataType());
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkIdTypeArray *newScalars = vtkIdTypeArray::New();
+  newScalars->SetName("ClusterId");
+  newScalars->SetNumberOfTuples(numNewPts);
+  outputPD->CopyAllocate(pd, numNewPts);
 
-//----------------------------------------------------------------------------
-// Insert point into connected wave. Check to make sure it satisfies connectivity
-// criterion (if enabled).
-void vtkEuclideanClusterExtraction::
-InsertIntoWave(vtkIdList *wave, vtkIdType ptId)
-{
-  this->Visited[ptId] = 1;
-  if ( this->InScalars ) //is scalar connectivity enabled?
+  vtkIdType newId = 0;
+  for (ptId=0; ptId < numPts; ptId++)
   {
-    double s = this->InScalars->GetTuple1(ptId);
-    if ( s >= this->ScalarRange[0] && s <= this->ScalarRange[1] )
+    if ( labels[ptId] >= 0 )
     {
-      wave->InsertNextId(ptId);
+      newPts->SetPoint(newId,inPts->GetPoint(ptId));
+      outputPD->CopyData(pd,ptId,newId);
+      newScalars->SetValue(newId++,labels[ptId]);
     }
   }
-  else
-  {
-    wave->InsertNextId(ptId);
-  }
-}
-
-
-//----------------------------------------------------------------------------
-// Update current point information including updating cluster number.  Note:
-// traversal occurs across proximally located points, possibly limited by
-// scalar connectivty.
-//
-void vtkEuclideanClusterExtraction::TraverseAndMark (vtkPoints *inPts)
-{
-  vtkIdType i, j, numPts, numIds, ptId;
-  vtkIdList *tmpWave;
-  double x[3];
 
-  while ( (numIds=this->Wave->GetNumberOfIds()) > 0 )
+  // if coloring clusters; send down new scalar data
+  if ( this->ColorClusters )
   {
-    for ( i=0; i < numIds; i++ ) //for all points in this wave
-    {
-      ptId = this->Wave->GetId(i);
-      this->PointMap[ptId] = this->PointNumber++;
-      this->NewScalars->SetValue(this->PointMap[ptId],this->ClusterNumber);
-      this->NumPointsInCluster++;
+    int idx = outputPD->AddArray(newScalars);
+    outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+  }
+  newScalars->Delete();
 
-      inPts->GetPoint(ptId,x);
-      this->Locator->FindPointsWithinRadius(this->Radius,x,this->NeighborPointIds);
+  output->SetPoints(newPts);
+  vtkDebugMacro (<< "Extracted " << newPts->GetNumberOfPoints() << " points");
+  newPts->Delete();
 
-      numPts = this->NeighborPointIds->GetNumberOfIds();
-      for (j=0; j < numPts; ++j)
-      {
-        ptId = this->NeighborPointIds->GetId(j);
-        if ( ! this->Visited[ptId] )
-        {
-          this->InsertIntoWave(this->Wave2,ptId);
-        }//if point not yet visited
-      }//for all neighbors
-    }//for all cells in this connected wave
-
-    tmpWave = this->Wave;
-    this->Wave = this->Wave2;
-    this->Wave2 = tmpWave;
-    tmpWave->Reset();
-  } //while wave is not empty
+  return 1;
 }
 
 //----------------------------------------------------------------------------
@@ -44,6 +44,11 @@
  * example, by using a seed point in a known cluster, clustering will pull
  * out all points "representing" the local structure.
  *
+ * The clusters are labeled in parallel with a union-find structure over the
+ * radius graph of the points (see vtkPointConnectivityLabeler). They are
+ * numbered in order of their smallest point id, and the extracted points
+ * keep their input order.
+ *
  * @sa
  * vtkConnectivityFilter vtkPolyDataConnectivityFilter
 */
@@ -60,8 +65,6 @@
 #define VTK_EXTRACT_ALL_CLUSTERS 4
 #define VTK_EXTRACT_CLOSEST_POINT_CLUSTER 5
 
-class vtkDataArray;
-class vtkFloatArray;
 class vtkIdList;
 class vtkIdTypeArray;
 class vtkAbstractPointLocator;
@@ -212,28 +215,9 @@ protected:
                           vtkInformationVector *) override;
   int FillInputPortInformation(int port, vtkInformation *info) override;
 
-  // Internal method for propagating connected waves.
-  void InsertIntoWave(vtkIdList *wave, vtkIdType ptId);
-  void TraverseAndMark(vtkPoints *pts);
-
 private:
   vtkEuclideanClusterExtraction(const vtkEuclideanClusterExtraction&) = delete;
   void operator=(const vtkEuclideanClusterExtraction&) = delete;
-
-  // used to support algorithm execution
-  vtkFloatArray *NeighborScalars;
-  vtkIdList *NeighborPointIds;
-  char *Visited;
-  vtkIdType *PointMap;
-  vtkIdTypeArray *NewScalars;
-  vtkIdType ClusterNumber;
-  vtkIdType PointNumber;
-  vtkIdType NumPointsInCluster;
-  vtkDataArray *InScalars;
-  vtkIdList *Wave;
-  vtkIdList *Wave2;
-  vtkIdList *PointIds;
-
 };
 
 //@{
@@ -52,6 +52,25 @@ ComputeBasis(double x[3], vtkIdList *pIds, vtkIdType)
   return pIds->GetNumberOfIds();
 }
 
+//----------------------------------------------------------------------------
+bool vtkGeneralizedKernel::
+ComputeBases(vtkPoints *points, vtkIdTypeArray *offsets,
+             vtkIdTypeArray *neighbors)
+{
+  if ( this->KernelFootprint == vtkGeneralizedKernel::RADIUS )
+  {
+    this->Locator->FindAllPointsWithinRadius(this->Radius, points, offsets,
+                                             neighbors);
+  }
+  else
+  {
+    this->Locator->FindAllClosestNPoints(this->NumberOfPoints, points, offsets,
+                                         neighbors);
+  }
+
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkGeneralizedKernel::PrintSelf(ostream& os, vtkIndent indent)
 {
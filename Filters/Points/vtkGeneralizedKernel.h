@@ -90,6 +90,13 @@ public:
    */
   vtkIdType ComputeBasis(double x[3], vtkIdList *pIds, vtkIdType ptId=0) override;
 
+  /**
+   * Compute the bases of all the points with the batched queries of the
+   * locator, see vtkInterpolationKernel::ComputeBases().
+   */
+  bool ComputeBases(vtkPoints *points, vtkIdTypeArray *offsets,
+                    vtkIdTypeArray *neighbors) override;
+
   /**
    * Given a point x, a list of basis points pIds, and a probability
    * weighting function prob, compute interpolation weights associated with
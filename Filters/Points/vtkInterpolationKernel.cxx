@@ -81,6 +81,13 @@ Initialize(vtkAbstractPointLocator *loc, vtkDataSet *ds, vtkPointData *attr)
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkInterpolationKernel::
+ComputeBases(vtkPoints *, vtkIdTypeArray *, vtkIdTypeArray *)
+{
+  return false;
+}
+
 //----------------------------------------------------------------------------
 void vtkInterpolationKernel::PrintSelf(ostream& os, vtkIndent indent)
 {
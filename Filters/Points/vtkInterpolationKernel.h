@@ -56,9 +56,11 @@
 
 class vtkAbstractPointLocator;
 class vtkIdList;
+class vtkIdTypeArray;
 class vtkDoubleArray;
 class vtkDataSet;
 class vtkPointData;
+class vtkPoints;
 
 
 class VTKFILTERSPOINTS_EXPORT vtkInterpolationKernel : public vtkObject
@@ -107,6 +109,19 @@ public:
    */
   virtual vtkIdType ComputeBasis(double x[3], vtkIdList *pIds, vtkIdType ptId=0) = 0;
 
+  /**
+   * Compute the interpolation basis of all the given points at once, as a
+   * neighbor graph (see vtkAbstractPointLocator::FindAllClosestNPoints()):
+   * the basis of the i-th point is made of the values of neighbors from
+   * offsets->GetValue(i) to offsets->GetValue(i+1) excluded. The bases are
+   * the ones ComputeBasis() returns for each point. Kernels whose basis
+   * is a locator query implement this method with the batched queries of
+   * the locator; the method returns false if the kernel does not support
+   * it, in which case ComputeBasis() must be used.
+   */
+  virtual bool ComputeBases(vtkPoints *points, vtkIdTypeArray *offsets,
+                            vtkIdTypeArray *neighbors);
+
   /**
    * Given a point x, and a list of basis points pIds, compute interpolation
    * weights associated with these basis points.  Note that both the nearby
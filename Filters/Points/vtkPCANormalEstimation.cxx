@@ -22,11 +22,11 @@
 #include "vtkPointData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkSMPTools.h"
-#include "vtkSMPThreadLocalObject.h"
 
 vtkStandardNewMacro(vtkPCANormalEstimation);
 vtkCxxSetObjectMacro(vtkPCANormalEstimation,Locator,vtkAbstractPointLocator);
@@ -35,25 +35,22 @@ vtkCxxSetObjectMacro(vtkPCANormalEstimation,Locator,vtkAbstractPointLocator);
 namespace {
 
 //----------------------------------------------------------------------------
-// The threaded core of the algorithm.
+// The threaded core of the algorithm. The neighborhoods of the points are
+// precomputed with the batched queries of the locator.
 template <typename T>
 struct GenerateNormals
 {
   const T *Points;
-  vtkAbstractPointLocator *Locator;
-  int SampleSize;
+  const vtkIdType *Offsets;
+  const vtkIdType *Neighbors;
   float *Normals;
   int Orient;
   double OPoint[3];
   bool Flip;
 
-  // Don't want to allocate working arrays on every thread invocation. Thread local
-  // storage lots of new/delete.
-  vtkSMPThreadLocalObject<vtkIdList> PIds;
-
-  GenerateNormals(T *points, vtkAbstractPointLocator *loc, int sample, float *normals,
-                  int orient, double opoint[3], bool flip) :
-    Points(points), Locator(loc), SampleSize(sample), Normals(normals),
+  GenerateNormals(T *points, const vtkIdType *offsets, const vtkIdType *neighbors,
+                  float *normals, int orient, double opoint[3], bool flip) :
+    Points(points), Offsets(offsets), Neighbors(neighbors), Normals(normals),
     Orient(orient), Flip(flip)
   {
       this->OPoint[0] = opoint[0];
@@ -61,20 +58,13 @@ struct GenerateNormals
       this->OPoint[2] = opoint[2];
   }
 
-  // Just allocate a little bit of memory to get started.
-  void Initialize()
-  {
-    vtkIdList*& pIds = this->PIds.Local();
-    pIds->Allocate(128); //allocate some memory
-  }
-
   void operator() (vtkIdType ptId, vtkIdType endPtId)
   {
       const T *px = this->Points + 3*ptId;
       const T *py;
       float *n = this->Normals + 3*ptId;
       double x[3], mean[3], o[3];
-      vtkIdList*& pIds = this->PIds.Local();
+      const vtkIdType *pIds;
       vtkIdType numPts, nei;
       int sample, i;
       double *a[3], a0[3], a1[3], a2[3], xp[3];
@@ -91,14 +81,14 @@ struct GenerateNormals
         x[2] = static_cast<double>(*px++);
 
         // Retrieve the local neighborhood
-        this->Locator->FindClosestNPoints(this->SampleSize, x, pIds);
-        numPts = pIds->GetNumberOfIds();
+        pIds = this->Neighbors + this->Offsets[ptId];
+        numPts = this->Offsets[ptId+1] - this->Offsets[ptId];
 
         // First step: compute the mean position of the neighborhood.
         mean[0] = mean[1] = mean[2] = 0.0;
         for (sample=0; sample<numPts; ++sample)
         {
-          nei = pIds->GetId(sample);
+          nei = pIds[sample];
           py = this->Points + 3*nei;
           mean[0] += static_cast<double>(*py++);
           mean[1] += static_cast<double>(*py++);
@@ -114,7 +104,7 @@ struct GenerateNormals
         a0[2] = a1[2] = a2[2] = 0.0;
         for (sample=0; sample < numPts; ++sample )
         {
-          nei = pIds->GetId(sample);
+          nei = pIds[sample];
           py = this->Points + 3*nei;
           xp[0] = static_cast<double>(*py++) - mean[0];
           xp[1] = static_cast<double>(*py++) - mean[1];
@@ -161,15 +151,12 @@ struct GenerateNormals
       }//for all points
   }
 
-  void Reduce()
+  static void Execute(vtkIdType numPts, T *points, const vtkIdType *offsets,
+                      const vtkIdType *neighbors, float *normals, int orient,
+                      double opoint[3], bool flip)
   {
-  }
-
-  static void Execute(vtkPCANormalEstimation *self, vtkIdType numPts, T *points,
-                      float *normals, int orient, double opoint[3], bool flip)
-  {
-      GenerateNormals gen(points, self->GetLocator(), self->GetSampleSize(),
-                          normals, orient, opoint, flip);
+      GenerateNormals gen(points, offsets, neighbors, normals, orient, opoint,
+                          flip);
       vtkSMPTools::For(0, numPts, gen);
   }
 }; //GenerateNormals
@@ -234,6 +221,15 @@ int vtkPCANormalEstimation::RequestData(
   this->Locator->SetDataSet(input);
   this->Locator->BuildLocator();
 
+  // Compute the neighborhoods of all the points at once, they are used to
+  // estimate the normals and to traverse the point cloud.
+  vtkIdTypeArray *offsets = vtkIdTypeArray::New();
+  vtkIdTypeArray *neighbors = vtkIdTypeArray::New();
+  this->Locator->FindAllClosestNPoints(this->SampleSize, nullptr, offsets,
+                                       neighbors);
+  const vtkIdType *offsetsPtr = offsets->GetPointer(0);
+  const vtkIdType *neighborsPtr = neighbors->GetPointer(0);
+
   // Generate the point normals.
   vtkFloatArray *normals = vtkFloatArray::New();
   normals->SetNumberOfComponents(3);
@@ -243,8 +239,9 @@ int vtkPCANormalEstimation::RequestData(
   void *inPtr = input->GetPoints()->GetVoidPointer(0);
   switch (input->GetPoints()->GetDataType())
   {
-    vtkTemplateMacro(GenerateNormals<VTK_TT>::Execute(this, numPts, (VTK_TT *)inPtr, n,
-       this->NormalOrientation, this->OrientationPoint, this->FlipNormals));
+    vtkTemplateMacro(GenerateNormals<VTK_TT>::Execute(numPts, (VTK_TT *)inPtr,
+       offsetsPtr, neighborsPtr, n, this->NormalOrientation,
+       this->OrientationPoint, this->FlipNormals));
   }
 
   // Orient the normals in a consistent fashion (if requested). This requires a traveral
@@ -265,7 +262,8 @@ int vtkPCANormalEstimation::RequestData(
       {
         wave->InsertNextId(ptId); //begin next connected wave
         pointMap[ptId] = 1;
-        this->TraverseAndFlip (input->GetPoints(), n, pointMap, wave, wave2);
+        this->TraverseAndFlip (offsetsPtr, neighborsPtr, n, pointMap, wave,
+                               wave2);
         wave->Reset();
         wave2->Reset();
       }
@@ -274,6 +272,8 @@ int vtkPCANormalEstimation::RequestData(
     wave->Delete();
     wave2->Delete();
   }//if graph traversal required
+  offsets->Delete();
+  neighbors->Delete();
 
   // Now send the normals to the output and clean up
   output->SetPoints(input->GetPoints());
@@ -289,28 +289,25 @@ int vtkPCANormalEstimation::RequestData(
 // traversal occurs across proximally located points.
 //
 void vtkPCANormalEstimation::
-TraverseAndFlip (vtkPoints *inPts, float *normals, char *pointMap,
-                 vtkIdList *wave, vtkIdList *wave2)
+TraverseAndFlip (const vtkIdType *offsets, const vtkIdType *neighbors,
+                 float *normals, char *pointMap, vtkIdList *wave,
+                 vtkIdList *wave2)
 {
-  vtkIdType i, j, numPts, numIds, ptId;
+  vtkIdType i, j, end, numIds, ptId;
   vtkIdList *tmpWave;
-  double x[3];
   float *n, *n2;
-  vtkIdList *neighborPointIds = vtkIdList::New();
 
   while ( (numIds=wave->GetNumberOfIds()) > 0 )
   {
     for ( i=0; i < numIds; i++ ) //for all points in this wave
     {
       ptId = wave->GetId(i);
-      inPts->GetPoint(ptId,x);
       n = normals + 3*ptId;
-      this->Locator->FindClosestNPoints(this->SampleSize,x,neighborPointIds);
+      end = offsets[ptId+1];
 
-      numPts = neighborPointIds->GetNumberOfIds();
-      for (j=0; j < numPts; ++j)
+      for (j=offsets[ptId]; j < end; ++j)
       {
-        ptId = neighborPointIds->GetId(j);
+        ptId = neighbors[j];
         if ( pointMap[ptId] == 0 )
         {
           pointMap[ptId] = 1;
@@ -331,8 +328,6 @@ TraverseAndFlip (vtkPoints *inPts, float *normals, char *pointMap,
     wave2 = tmpWave;
     tmpWave->Reset();
   } //while wave is not empty
-
-  neighborPointIds->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -160,8 +160,11 @@ protected:
   double OrientationPoint[3];
   bool FlipNormals;
 
-  // Methods used to produce consistent normal orientations
-  void TraverseAndFlip (vtkPoints *inPts, float *normals, char *pointMap,
+  // Methods used to produce consistent normal orientations. The neighbors
+  // of the points are given as a graph (see
+  // vtkAbstractPointLocator::FindAllClosestNPoints()).
+  void TraverseAndFlip (const vtkIdType *offsets, const vtkIdType *neighbors,
+                        float *normals, char *pointMap,
                         vtkIdList *wave, vtkIdList *wave2);
 
   // Pipeline management
@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPointConnectivityLabeler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPointConnectivityLabeler.h"
+
+#include "vtkAbstractPointLocator.h"
+#include "vtkConcurrentUnionFind.h"
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+
+vtkStandardNewMacro(vtkPointConnectivityLabeler);
+
+//----------------------------------------------------------------------------
+// Helper classes to support efficient computing, and threaded execution.
+namespace {
+
+// The radius graph is computed by blocks of points to bound its memory
+const vtkIdType BLOCK_SIZE = 1 << 20;
+
+//----------------------------------------------------------------------------
+// Merge the sets of the connected points of a block. Each edge is processed
+// once, from its larger point id.
+struct UnionEdges
+{
+  vtkConcurrentUnionFind *Sets;
+  const unsigned char *Mask;
+  const float *Normals;
+  double NormalThreshold;
+  vtkIdType BlockStart;
+  const vtkIdType *Offsets;
+  const vtkIdType *Neighbors;
+
+  UnionEdges(vtkConcurrentUnionFind *sets, const unsigned char *mask,
+             const float *normals, double threshold, vtkIdType start,
+             const vtkIdType *offsets, const vtkIdType *neighbors) :
+    Sets(sets), Mask(mask), Normals(normals), NormalThreshold(threshold),
+    BlockStart(start), Offsets(offsets), Neighbors(neighbors)
+  {
+  }
+
+  void operator() (vtkIdType queryId, vtkIdType endQueryId)
+  {
+    for ( ; queryId < endQueryId; ++queryId)
+    {
+      vtkIdType ptId = this->BlockStart + queryId;
+      if ( this->Mask && !this->Mask[ptId] )
+      {
+        continue;
+      }
+      vtkIdType end = this->Offsets[queryId+1];
+      for (vtkIdType i=this->Offsets[queryId]; i < end; ++i)
+      {
+        vtkIdType neiId = this->Neighbors[i];
+        if ( neiId >= ptId || (this->Mask && !this->Mask[neiId]) ||
+             (this->Normals && vtkMath::Dot(this->Normals + 3*ptId,
+               this->Normals + 3*neiId) < this->NormalThreshold) )
+        {
+          continue;
+        }
+        this->Sets->Union(ptId, neiId);
+      }
+    }
+  }
+};
+
+} //anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkPointConnectivityLabeler::vtkPointConnectivityLabeler()
+{
+  this->Radius = 1.0;
+  this->NormalThreshold = 1.0;
+  this->LabelMaskedPoints = false;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPointConnectivityLabeler::
+LabelPoints(vtkAbstractPointLocator *locator, vtkPoints *points,
+            const unsigned char *mask, const float *normals,
+            vtkIdType *labels, vtkIdTypeArray *regionSizes)
+{
+  vtkIdType numPts = points->GetNumberOfPoints();
+  regionSizes->Reset();
+  if ( numPts < 1 )
+  {
+    return 0;
+  }
+
+  vtkConcurrentUnionFind sets;
+  sets.Initialize(numPts);
+
+  // Merge the connected points, one block of the radius graph at a time.
+  // The queries of a block are copies of its points.
+  vtkIdTypeArray *offsets = vtkIdTypeArray::New();
+  vtkIdTypeArray *neighbors = vtkIdTypeArray::New();
+  vtkPoints *queries = nullptr;
+  if ( numPts > BLOCK_SIZE )
+  {
+    queries = vtkPoints::New(points->GetDataType());
+  }
+  for (vtkIdType start=0; start < numPts; start += BLOCK_SIZE)
+  {
+    vtkIdType numQueries = std::min(BLOCK_SIZE, numPts - start);
+    if ( queries )
+    {
+      queries->SetNumberOfPoints(numQueries);
+      queries->GetData()->InsertTuples(0, numQueries, start, points->GetData());
+      queries->Modified();
+    }
+    locator->FindAllPointsWithinRadius(this->Radius, queries, offsets, neighbors);
+
+    UnionEdges unionEdges(&sets, mask, normals, this->NormalThreshold, start,
+                          offsets->GetPointer(0), neighbors->GetPointer(0));
+    vtkSMPTools::For(0, numQueries, unionEdges);
+  }
+  offsets->Delete();
+  neighbors->Delete();
+  if ( queries )
+  {
+    queries->Delete();
+  }
+
+  // The regions are numbered in the order of their smallest point id, as a
+  // serial traversal of the points would.
+  vtkIdType numRegions =
+    sets.Label(labels, (this->LabelMaskedPoints ? nullptr : mask));
+
+  regionSizes->SetNumberOfTuples(numRegions);
+  vtkIdType *sizes = regionSizes->GetPointer(0);
+  std::fill_n(sizes, numRegions, 0);
+  for (vtkIdType ptId=0; ptId < numPts; ++ptId)
+  {
+    if ( labels[ptId] >= 0 )
+    {
+      sizes[labels[ptId]]++;
+    }
+  }
+
+  return numRegions;
+}
+
+//----------------------------------------------------------------------------
+void vtkPointConnectivityLabeler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Radius: " << this->Radius << "\n";
+  os << indent << "Normal Threshold: " << this->NormalThreshold << "\n";
+  os << indent << "Label Masked Points: "
+     << (this->LabelMaskedPoints ? "On\n" : "Off\n");
+}
@@ -0,0 +1,113 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPointConnectivityLabeler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPointConnectivityLabeler
+ * @brief   label the connected regions of a point cloud in parallel
+ *
+ * vtkPointConnectivityLabeler is a helper class of the point connectivity
+ * filters (vtkEuclideanClusterExtraction, vtkConnectedPointsFilter). Two
+ * points are connected when they are within Radius of each other, and
+ * optionally when both are selected by a mask and their normals are
+ * aligned (dot product of the normals at least NormalThreshold). The
+ * connected regions are labeled in order of their smallest point id, the
+ * labels are thus the same as the ones of a serial traversal of the points
+ * growing a region from each point not yet labeled.
+ *
+ * The radius graph is computed by blocks of points with the batched queries
+ * of the point locator, and the regions are merged with a
+ * vtkConcurrentUnionFind shared by the threads, which links the roots with
+ * compare-and-swap so no lock is needed.
+ *
+ * @sa
+ * vtkEuclideanClusterExtraction vtkConnectedPointsFilter
+ * vtkAbstractPointLocator vtkConcurrentUnionFind
+ */
+
+#ifndef vtkPointConnectivityLabeler_h
+#define vtkPointConnectivityLabeler_h
+
+#include "vtkFiltersPointsModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkAbstractPointLocator;
+class vtkIdTypeArray;
+class vtkPoints;
+
+class VTKFILTERSPOINTS_EXPORT vtkPointConnectivityLabeler : public vtkObject
+{
+public:
+  //@{
+  /**
+   * Standard methods for instantiation, type information, and printing.
+   */
+  static vtkPointConnectivityLabeler *New();
+  vtkTypeMacro(vtkPointConnectivityLabeler,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Specify the radius within which points are connected.
+   */
+  vtkSetClampMacro(Radius,double,0.0,VTK_DOUBLE_MAX);
+  vtkGetMacro(Radius,double);
+  //@}
+
+  //@{
+  /**
+   * Specify the minimum dot product of the normals of connected points,
+   * when normals are given to LabelPoints().
+   */
+  vtkSetMacro(NormalThreshold,double);
+  vtkGetMacro(NormalThreshold,double);
+  //@}
+
+  //@{
+  /**
+   * Indicate whether the points rejected by the mask given to LabelPoints()
+   * form regions of their own (on), or are not labeled (off, the default).
+   */
+  vtkSetMacro(LabelMaskedPoints,bool);
+  vtkGetMacro(LabelMaskedPoints,bool);
+  vtkBooleanMacro(LabelMaskedPoints,bool);
+  //@}
+
+  /**
+   * Label the connected regions of the points. The locator must be built on
+   * a dataset made of these points. The optional mask selects the points
+   * that may be connected (non-zero values), and the optional normals (3
+   * floats per point) restrict the connections to aligned normals. On
+   * return, labels (one per point) holds the region ids, or -1 for the
+   * points not labeled, and regionSizes the number of points of each
+   * region. The number of regions is returned.
+   */
+  vtkIdType LabelPoints(vtkAbstractPointLocator *locator, vtkPoints *points,
+                        const unsigned char *mask, const float *normals,
+                        vtkIdType *labels, vtkIdTypeArray *regionSizes);
+
+protected:
+  vtkPointConnectivityLabeler();
+  ~vtkPointConnectivityLabeler() override {}
+
+  double Radius;
+  double NormalThreshold;
+  bool LabelMaskedPoints;
+
+private:
+  vtkPointConnectivityLabeler(const vtkPointConnectivityLabeler&) = delete;
+  void operator=(const vtkPointConnectivityLabeler&) = delete;
+};
+
+#endif
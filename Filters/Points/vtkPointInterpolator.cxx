@@ -23,12 +23,14 @@
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkPoints.h"
+#include "vtkPointSet.h"
 #include "vtkCharArray.h"
 #include "vtkFloatArray.h"
 #include "vtkDoubleArray.h"
 #include "vtkCellData.h"
 #include "vtkPointData.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -36,6 +38,7 @@
 #include "vtkSMPTools.h"
 #include "vtkSMPThreadLocalObject.h"
 
+#include <algorithm>
 #include <vector>
 
 vtkStandardNewMacro(vtkPointInterpolator);
@@ -45,6 +48,10 @@ vtkCxxSetObjectMacro(vtkPointInterpolator,Kernel,vtkInterpolationKernel);
 //----------------------------------------------------------------------------
 // Helper classes to support efficient computing, and threaded execution.
 namespace {
+// The probe points are processed in batches of this size, whose bases are
+// computed together
+const vtkIdType PROBE_BATCH_SIZE = 1024;
+
 // The threaded core of the algorithm
 struct ProbePoints
 {
@@ -58,15 +65,20 @@ struct ProbePoints
   char *Valid;
   int Strategy;
   bool Promote;
+  vtkPoints *Points; //points of a point set input, if any
 
   // Don't want to allocate these working arrays on every thread invocation,
   // so make them thread local.
   vtkSMPThreadLocalObject<vtkIdList> PIds;
   vtkSMPThreadLocalObject<vtkDoubleArray> Weights;
+  vtkSMPThreadLocalObject<vtkPoints> BatchPoints;
+  vtkSMPThreadLocalObject<vtkIdTypeArray> Offsets;
+  vtkSMPThreadLocalObject<vtkIdTypeArray> Neighbors;
 
   ProbePoints(vtkPointInterpolator *ptInt, vtkDataSet *input, vtkPointData *inPD,
               vtkPointData *outPD, char *valid) :
-    PointInterpolator(ptInt), Input(input), InPD(inPD), OutPD(outPD), Valid(valid)
+    PointInterpolator(ptInt), Input(input), InPD(inPD), OutPD(outPD), Valid(valid),
+    Points(nullptr)
   {
       // Gather information from the interpolator
       this->Kernel = ptInt->GetKernel();
@@ -131,11 +143,43 @@ struct ProbePoints
       vtkIdType numWeights;
       vtkDoubleArray*& weights = this->Weights.Local();
 
+      // The bases of the points of a point set are computed for the whole
+      // batch at once, when the kernel supports it.
+      vtkIdType beginPtId = ptId;
+      const vtkIdType *offsets = nullptr, *neighbors = nullptr;
+      if ( this->Points )
+      {
+        vtkPoints*& batch = this->BatchPoints.Local();
+        vtkIdTypeArray*& batchOffsets = this->Offsets.Local();
+        vtkIdTypeArray*& batchNeighbors = this->Neighbors.Local();
+        batch->SetDataType(this->Points->GetDataType());
+        batch->SetNumberOfPoints(endPtId - ptId);
+        batch->GetData()->InsertTuples(0, endPtId - ptId, ptId,
+                                       this->Points->GetData());
+        if ( this->Kernel->ComputeBases(batch, batchOffsets, batchNeighbors) )
+        {
+          offsets = batchOffsets->GetPointer(0);
+          neighbors = batchNeighbors->GetPointer(0);
+        }
+      }
+
       for ( ; ptId < endPtId; ++ptId)
       {
         this->Input->GetPoint(ptId,x);
 
-        if ( this->Kernel->ComputeBasis(x, pIds) > 0 )
+        if ( offsets )
+        {
+          vtkIdType offset = offsets[ptId-beginPtId];
+          pIds->SetNumberOfIds(offsets[ptId-beginPtId+1] - offset);
+          std::copy(neighbors + offset, neighbors + offsets[ptId-beginPtId+1],
+                    pIds->GetPointer(0));
+        }
+        else
+        {
+          this->Kernel->ComputeBasis(x, pIds);
+        }
+
+        if ( pIds->GetNumberOfIds() > 0 )
         {
           numWeights = this->Kernel->ComputeWeights(x, pIds, weights);
           this->Arrays.Interpolate(numWeights, pIds->GetPointer(0),
@@ -339,8 +383,12 @@ Probe(vtkDataSet *input, vtkDataSet *source, vtkDataSet *output)
   }
   else
   {
+    // The kernel may compute the bases of each batch of points at once,
+    // with the batched queries of the locator.
     ProbePoints probe(this, input, inPD, outPD, mask);
-    vtkSMPTools::For(0, numPts, probe);
+    vtkPointSet *psInput = vtkPointSet::SafeDownCast(input);
+    probe.Points = ( psInput ? psInput->GetPoints() : nullptr );
+    vtkSMPTools::For(0, numPts, PROBE_BATCH_SIZE, probe);
   }
 
   // Clean up
@@ -19,9 +19,8 @@
 #include "vtkStaticPointLocator.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
-#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkSMPTools.h"
-#include "vtkSMPThreadLocalObject.h"
 
 
 vtkStandardNewMacro(vtkRadiusOutlierRemoval);
@@ -32,48 +31,28 @@ vtkCxxSetObjectMacro(vtkRadiusOutlierRemoval,Locator,vtkAbstractPointLocator);
 namespace {
 
 //----------------------------------------------------------------------------
-// The threaded core of the algorithm (first pass)
-template <typename T>
+// The threaded core of the algorithm (first pass). The neighborhoods of all
+// the points are computed at once with the batched radius query of the
+// locator, only their sizes are needed here.
 struct RemoveOutliers
 {
-  const T *Points;
-  vtkAbstractPointLocator *Locator;
-  double Radius;
+  const vtkIdType *Offsets;
   int NumNeighbors;
   vtkIdType *PointMap;
 
-  // Don't want to allocate working arrays on every thread invocation. Thread local
-  // storage lots of new/delete.
-  vtkSMPThreadLocalObject<vtkIdList> PIds;
-
-  RemoveOutliers(T *points, vtkAbstractPointLocator *loc, double radius, int numNei,
-                 vtkIdType *map) : Points(points), Locator(loc), Radius(radius),
-                                   NumNeighbors(numNei), PointMap(map)
+  RemoveOutliers(const vtkIdType *offsets, int numNei, vtkIdType *map) :
+    Offsets(offsets), NumNeighbors(numNei), PointMap(map)
   {
   }
 
-  // Just allocate a little bit of memory to get started.
-  void Initialize()
-  {
-    vtkIdList*& pIds = this->PIds.Local();
-    pIds->Allocate(128); //allocate some memory
-  }
-
   void operator() (vtkIdType ptId, vtkIdType endPtId)
   {
-      const T *p = this->Points + 3*ptId;
+      const vtkIdType *offsets = this->Offsets + ptId;
       vtkIdType *map = this->PointMap + ptId;
-      double x[3];
-      vtkIdList*& pIds = this->PIds.Local();
 
-      for ( ; ptId < endPtId; ++ptId)
+      for ( ; ptId < endPtId; ++ptId, ++offsets)
       {
-        x[0] = static_cast<double>(*p++);
-        x[1] = static_cast<double>(*p++);
-        x[2] = static_cast<double>(*p++);
-
-        this->Locator->FindPointsWithinRadius(this->Radius, x, pIds);
-        vtkIdType numPts = pIds->GetNumberOfIds();
+        vtkIdType numPts = offsets[1] - offsets[0];
 
         // Keep in mind that The FindPoints method will always return at
         // least one point (itself).
@@ -81,16 +60,18 @@ struct RemoveOutliers
       }
   }
 
-  void Reduce()
-  {
-  }
-
   static void Execute(vtkRadiusOutlierRemoval *self, vtkIdType numPts,
-                      T *points, vtkIdType *map)
+                      vtkIdType *map)
   {
-      RemoveOutliers remove(points, self->GetLocator(), self->GetRadius(),
-                            self->GetNumberOfNeighbors(), map);
+      vtkIdTypeArray *offsets = vtkIdTypeArray::New();
+      vtkIdTypeArray *neighbors = vtkIdTypeArray::New();
+      self->GetLocator()->FindAllPointsWithinRadius(self->GetRadius(), nullptr,
+                                                    offsets, neighbors);
+      RemoveOutliers remove(offsets->GetPointer(0), self->GetNumberOfNeighbors(),
+                            map);
       vtkSMPTools::For(0, numPts, remove);
+      offsets->Delete();
+      neighbors->Delete();
   }
 
 }; //RemoveOutliers
@@ -131,12 +112,7 @@ int vtkRadiusOutlierRemoval::FilterPoints(vtkPointSet *input)
   // Determine which points, if any, should be removed. We create a map
   // to keep track. The bulk of the algorithmic work is done in this pass.
   vtkIdType numPts = input->GetNumberOfPoints();
-  void *inPtr = input->GetPoints()->GetVoidPointer(0);
-  switch (input->GetPoints()->GetDataType())
-  {
-    vtkTemplateMacro(RemoveOutliers<VTK_TT>::
-                     Execute(this, numPts, (VTK_TT *)inPtr, this->PointMap));
-  }
+  RemoveOutliers::Execute(this, numPts, this->PointMap);
 
   return 1;
 }
@@ -24,12 +24,14 @@
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkPoints.h"
+#include "vtkPointSet.h"
 #include "vtkCharArray.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkCellData.h"
 #include "vtkPointData.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -37,6 +39,8 @@
 #include "vtkSMPTools.h"
 #include "vtkSMPThreadLocalObject.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkSPHInterpolator);
 vtkCxxSetObjectMacro(vtkSPHInterpolator,Locator,vtkAbstractPointLocator);
 vtkCxxSetObjectMacro(vtkSPHInterpolator,Kernel,vtkSPHKernel);
@@ -44,6 +48,10 @@ vtkCxxSetObjectMacro(vtkSPHInterpolator,Kernel,vtkSPHKernel);
 //----------------------------------------------------------------------------
 // Helper classes to support efficient computing, and threaded execution.
 namespace {
+// The probe points are processed in batches of this size, whose bases are
+// computed together
+const vtkIdType PROBE_BATCH_SIZE = 1024;
+
 // The threaded core of the algorithm
 struct ProbePoints
 {
@@ -60,18 +68,22 @@ struct ProbePoints
   int Strategy;
   float *Shepard;
   bool Promote;
+  vtkPoints *Points; //points of a point set input, if any
 
   // Don't want to allocate these working arrays on every thread invocation,
   // so make them thread local.
   vtkSMPThreadLocalObject<vtkIdList> PIds;
   vtkSMPThreadLocalObject<vtkDoubleArray> Weights;
+  vtkSMPThreadLocalObject<vtkPoints> BatchPoints;
+  vtkSMPThreadLocalObject<vtkIdTypeArray> Offsets;
+  vtkSMPThreadLocalObject<vtkIdTypeArray> Neighbors;
   vtkSMPThreadLocalObject<vtkDoubleArray> DerivWeights;
 
   ProbePoints(vtkSPHInterpolator *sphInt, vtkDataSet *input,
               vtkPointData *inPD, vtkPointData *outPD,
               char *valid, float *shepCoef) :
     SPHInterpolator(sphInt), Input(input), InPD(inPD), OutPD(outPD),
-    Valid(valid), Shepard(shepCoef)
+    Valid(valid), Shepard(shepCoef), Points(nullptr)
   {
       // Gather information from the interpolator
       this->Kernel = sphInt->GetKernel();
@@ -132,11 +144,44 @@ struct ProbePoints
       vtkDoubleArray*& weights = this->Weights.Local();
       vtkDoubleArray*& gradWeights = this->DerivWeights.Local();
 
+      // The bases of the points of a point set are computed for the whole
+      // batch at once, when the kernel supports it.
+      vtkIdType beginPtId = ptId;
+      const vtkIdType *offsets = nullptr, *neighbors = nullptr;
+      if ( this->Points )
+      {
+        vtkPoints*& batch = this->BatchPoints.Local();
+        vtkIdTypeArray*& batchOffsets = this->Offsets.Local();
+        vtkIdTypeArray*& batchNeighbors = this->Neighbors.Local();
+        batch->SetDataType(this->Points->GetDataType());
+        batch->SetNumberOfPoints(endPtId - ptId);
+        batch->GetData()->InsertTuples(0, endPtId - ptId, ptId,
+                                       this->Points->GetData());
+        if ( this->Kernel->ComputeBases(batch, batchOffsets, batchNeighbors) )
+        {
+          offsets = batchOffsets->GetPointer(0);
+          neighbors = batchNeighbors->GetPointer(0);
+        }
+      }
+
       for ( ; ptId < endPtId; ++ptId)
       {
         this->Input->GetPoint(ptId,x);
 
-        if ( (numWeights=this->Kernel->ComputeBasis(x, pIds, ptId)) > 0 )
+        if ( offsets )
+        {
+          vtkIdType offset = offsets[ptId-beginPtId];
+          numWeights = offsets[ptId-beginPtId+1] - offset;
+          pIds->SetNumberOfIds(numWeights);
+          std::copy(neighbors + offset, neighbors + offset + numWeights,
+                    pIds->GetPointer(0));
+        }
+        else
+        {
+          numWeights = this->Kernel->ComputeBasis(x, pIds, ptId);
+        }
+
+        if ( numWeights > 0 )
         {
           if ( ! this->ComputeDerivArrays )
           {
@@ -297,8 +342,12 @@ Probe(vtkDataSet *input, vtkDataSet *source, vtkDataSet *output)
   }
 
   // Now loop over input points, finding closest points and invoking kernel.
+  // The neighborhoods of each batch of points of a point set are computed at
+  // once with the batched queries of the locator when the kernel supports it.
   ProbePoints probe(this, input, sourcePD, outPD, mask, shepardArray);
-  vtkSMPTools::For(0, numPts, probe);
+  vtkPointSet *psInput = vtkPointSet::SafeDownCast(input);
+  probe.Points = ( psInput ? psInput->GetPoints() : nullptr );
+  vtkSMPTools::For(0, numPts, PROBE_BATCH_SIZE, probe);
 
   // Clean up
   if ( this->ShepardSumArray )
@@ -102,6 +102,21 @@ ComputeBasis(double x[3], vtkIdList *pIds, vtkIdType ptId)
   return pIds->GetNumberOfIds();
 }
 
+//----------------------------------------------------------------------------
+bool vtkSPHKernel::
+ComputeBases(vtkPoints *points, vtkIdTypeArray *offsets,
+             vtkIdTypeArray *neighbors)
+{
+  if ( this->UseCutoffArray )
+  {
+    return false;
+  }
+
+  this->Locator->FindAllPointsWithinRadius(this->Cutoff, points, offsets,
+                                           neighbors);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 vtkIdType vtkSPHKernel::
 ComputeWeights(double x[3], vtkIdList *pIds, vtkDoubleArray *weights)
@@ -147,6 +147,14 @@ public:
    */
   vtkIdType ComputeBasis(double x[3], vtkIdList *pIds, vtkIdType ptId=0) override;
 
+  /**
+   * Compute the bases of all the points with the batched queries of the
+   * locator, see vtkInterpolationKernel::ComputeBases(). This is not
+   * supported with a cutoff array, the method then returns false.
+   */
+  bool ComputeBases(vtkPoints *points, vtkIdTypeArray *offsets,
+                    vtkIdTypeArray *neighbors) override;
+
   /**
    * Given a point x, and a list of basis points pIds, compute interpolation
    * weights associated with these basis points.
@@ -1136,7 +1136,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   char line[80], subLine[80];
   vtkIdType i;
   int *pointIds;
-  float *xCoords, *yCoords, *zCoords;
   vtkPoints *points = vtkPoints::New();
   vtkPolyData *pd = vtkPolyData::New();
 
@@ -1230,10 +1229,8 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   this->ReadInt(&this->NumberOfMeasuredPoints);
 
   pointIds = new int[this->NumberOfMeasuredPoints];
-  xCoords = new float [this->NumberOfMeasuredPoints];
-  yCoords = new float [this->NumberOfMeasuredPoints];
-  zCoords = new float [this->NumberOfMeasuredPoints];
-  points->Allocate(this->NumberOfMeasuredPoints);
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(this->NumberOfMeasuredPoints);
   pd->Allocate(this->NumberOfMeasuredPoints);
 
   // Extract the array of point indices. Note EnSight Manual v8.2 (pp. 559,
@@ -1246,26 +1243,19 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   this->ReadIntArray( pointIds, this->NumberOfMeasuredPoints );
 
   // Read point coordinates tuple by tuple while each tuple contains three
-  // components: (x-cord, y-cord, z-cord)
-  int  floatSize = sizeof( float );
-  for ( i = 0; i < this->NumberOfMeasuredPoints; i ++ )
-  {
-    this->GoldIFile->read(  ( char * )( xCoords + i ),  floatSize  );
-    this->GoldIFile->read(  ( char * )( yCoords + i ),  floatSize  );
-    this->GoldIFile->read(  ( char * )( zCoords + i ),  floatSize  );
-  }
+  // components: (x-cord, y-cord, z-cord). Since this matches the layout of
+  // vtkPoints, read them all at once straight into the points array.
+  float* coords = static_cast<float*>(points->GetVoidPointer(0));
+  this->GoldIFile->read(reinterpret_cast<char*>(coords),
+    sizeof(float) * 3 * static_cast<size_t>(this->NumberOfMeasuredPoints));
 
   if ( this->ByteOrder == FILE_LITTLE_ENDIAN )
   {
-    vtkByteSwap::Swap4LERange( xCoords, this->NumberOfMeasuredPoints );
-    vtkByteSwap::Swap4LERange( yCoords, this->NumberOfMeasuredPoints );
-    vtkByteSwap::Swap4LERange( zCoords, this->NumberOfMeasuredPoints );
+    vtkByteSwap::Swap4LERange( coords, 3 * this->NumberOfMeasuredPoints );
   }
   else
   {
-    vtkByteSwap::Swap4BERange( xCoords, this->NumberOfMeasuredPoints );
-    vtkByteSwap::Swap4BERange( yCoords, this->NumberOfMeasuredPoints );
-    vtkByteSwap::Swap4BERange( zCoords, this->NumberOfMeasuredPoints );
+    vtkByteSwap::Swap4BERange( coords, 3 * this->NumberOfMeasuredPoints );
   }
 
   // NOTE: EnSight always employs a 1-based indexing scheme and therefore
@@ -1274,7 +1264,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   // This bug was noticed while fixing bug #7453.
   for (i = 0; i < this->NumberOfMeasuredPoints; i++)
   {
-    points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
     pd->InsertNextCell(VTK_VERTEX, 1, &i);
   }
 
@@ -1284,9 +1273,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   points->Delete();
   pd->Delete();
   delete [] pointIds;
-  delete [] xCoords;
-  delete [] yCoords;
-  delete [] zCoords;
 
   if (this->GoldIFile)
   {
@@ -1306,7 +1292,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
   char line[80];
   int partId, realId, numPts, i, lineRead;
   vtkFloatArray *scalars;
-  float* scalarsRead;
   vtkDataSet *output;
 
   // Initialize
@@ -1409,17 +1394,13 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
       scalars = vtkFloatArray::New();
       scalars->SetNumberOfComponents(numberOfComponents);
       scalars->SetNumberOfTuples(numPts);
-      scalarsRead = new float [numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
       // Why are we setting only one component here?
       // Only one component is set because scalars are single-component arrays.
       // For complex scalars, there is a file for the real part and another
       // file for the imaginary part, but we are storing them as a 2-component
       // array.
-      for (i = 0; i < numPts; i++)
-      {
-        scalars->SetComponent(i, component, scalarsRead[i]);
-      }
+      this->ReadFloatComponent(scalars->GetPointer(0), numPts,
+        numberOfComponents, component);
       scalars->SetName(description);
       output->GetPointData()->AddArray(scalars);
       if (!output->GetPointData()->GetScalars())
@@ -1427,7 +1408,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
         output->GetPointData()->SetScalars(scalars);
       }
       scalars->Delete();
-      delete [] scalarsRead;
     }
     if (this->GoldIFile)
     {
@@ -1463,13 +1443,8 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
           GetArray(description));
       }
 
-      scalarsRead = new float[numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
-
-      for (i = 0; i < numPts; i++)
-      {
-        scalars->SetComponent(i, component, scalarsRead[i]);
-      }
+      this->ReadFloatComponent(scalars->GetPointer(0), numPts,
+        numberOfComponents, component);
       if (component == 0)
       {
         scalars->SetName(description);
@@ -1484,7 +1459,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
       {
         output->GetPointData()->AddArray(scalars);
       }
-      delete [] scalarsRead;
     }
 
     this->GoldIFile->peek();
@@ -1513,8 +1487,6 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
   char line[80];
   int partId, realId, numPts, i, lineRead;
   vtkFloatArray *vectors;
-  float tuple[3];
-  float *comp1, *comp2, *comp3;
   float *vectorsRead;
   vtkDataSet *output;
 
@@ -1651,19 +1623,10 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
       this->ReadLine(line); // "coordinates" or "block"
       vectors->SetNumberOfComponents(3);
       vectors->SetNumberOfTuples(numPts);
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      for (i = 0; i < numPts; i++)
-      {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        vectors->SetTuple(i, tuple);
-      }
+      float* vectorsPtr = vectors->GetPointer(0);
+      this->ReadFloatComponent(vectorsPtr, numPts, 3, 0);
+      this->ReadFloatComponent(vectorsPtr, numPts, 3, 1);
+      this->ReadFloatComponent(vectorsPtr, numPts, 3, 2);
       vectors->SetName(description);
       output->GetPointData()->AddArray(vectors);
       if (!output->GetPointData()->GetVectors())
@@ -1671,9 +1634,6 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
         output->GetPointData()->SetVectors(vectors);
       }
       vectors->Delete();
-      delete [] comp1;
-      delete [] comp2;
-      delete [] comp3;
     }
 
     this->GoldIFile->peek();
@@ -1703,8 +1663,6 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
   char line[80];
   int partId, realId, numPts, i, lineRead;
   vtkFloatArray *tensors;
-  float *comp1, *comp2, *comp3, *comp4, *comp5, *comp6;
-  float tuple[6];
   vtkDataSet *output;
 
   // Initialize
@@ -1794,37 +1752,17 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
       this->ReadLine(line); // "coordinates" or "block"
       tensors->SetNumberOfComponents(6);
       tensors->SetNumberOfTuples(numPts);
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      comp4 = new float[numPts];
-      comp5 = new float[numPts];
-      comp6 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      this->ReadFloatArray(comp4, numPts);
-      this->ReadFloatArray(comp6, numPts);
-      this->ReadFloatArray(comp5, numPts);
-      for (i = 0; i < numPts; i++)
-      {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        tuple[3] = comp4[i];
-        tuple[4] = comp5[i];
-        tuple[5] = comp6[i];
-        tensors->InsertTuple(i, tuple);
-      }
+      // The file stores the components as xx, yy, zz, xy, xz, yz.
+      float* tensorsPtr = tensors->GetPointer(0);
+      this->ReadFloatComponent(tensorsPtr, numPts, 6, 0);
+      this->ReadFloatComponent(tensorsPtr, numPts, 6, 1);
+      this->ReadFloatComponent(tensorsPtr, numPts, 6, 2);
+      this->ReadFloatComponent(tensorsPtr, numPts, 6, 3);
+      this->ReadFloatComponent(tensorsPtr, numPts, 6, 5);
+      this->ReadFloatComponent(tensorsPtr, numPts, 6, 4);
       tensors->SetName(description);
       output->GetPointData()->AddArray(tensors);
       tensors->Delete();
-      delete [] comp1;
-      delete [] comp2;
-      delete [] comp3;
-      delete [] comp4;
-      delete [] comp5;
-      delete [] comp6;
     }
 
     this->GoldIFile->peek();
@@ -1995,12 +1933,8 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
       // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
       if (strncmp(line, "block", 5) == 0)
       {
-        scalarsRead = new float[numCells];
-        this->ReadFloatArray(scalarsRead, numCells);
-        for (i = 0; i < numCells; i++)
-        {
-          scalars->SetComponent(i, component, scalarsRead[i]);
-        }
+        this->ReadFloatComponent(scalars->GetPointer(0), numCells,
+          numberOfComponents, component);
         if (this->GoldIFile->eof())
         {
           lineRead = 0;
@@ -2009,7 +1943,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
         {
           lineRead = this->ReadLine(line);
         }
-        delete [] scalarsRead;
       }
       else
       {
@@ -2230,19 +2163,10 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
       // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
       if (strncmp(line, "block", 5) == 0)
       {
-        comp1 = new float[numCells];
-        comp2 = new float[numCells];
-        comp3 = new float[numCells];
-        this->ReadFloatArray(comp1, numCells);
-        this->ReadFloatArray(comp2, numCells);
-        this->ReadFloatArray(comp3, numCells);
-        for (i = 0; i < numCells; i++)
-        {
-          tuple[0] = comp1[i];
-          tuple[1] = comp2[i];
-          tuple[2] = comp3[i];
-          vectors->SetTuple(i, tuple);
-        }
+        float* vectorsPtr = vectors->GetPointer(0);
+        this->ReadFloatComponent(vectorsPtr, numCells, 3, 0);
+        this->ReadFloatComponent(vectorsPtr, numCells, 3, 1);
+        this->ReadFloatComponent(vectorsPtr, numCells, 3, 2);
         this->GoldIFile->peek();
         if (this->GoldIFile->eof())
         {
@@ -2252,9 +2176,6 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
         {
           lineRead = this->ReadLine(line);
         }
-        delete [] comp1;
-        delete [] comp2;
-        delete [] comp3;
       }
       else
       {
@@ -2471,28 +2392,13 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
       // type (and what their ids are) -- IF THIS IS NOT A BLOCK SECTION
       if (strncmp(line, "block", 5) == 0)
       {
-        comp1 = new float[numCells];
-        comp2 = new float[numCells];
-        comp3 = new float[numCells];
-        comp4 = new float[numCells];
-        comp5 = new float[numCells];
-        comp6 = new float[numCells];
-        this->ReadFloatArray(comp1, numCells);
-        this->ReadFloatArray(comp2, numCells);
-        this->ReadFloatArray(comp3, numCells);
-        this->ReadFloatArray(comp4, numCells);
-        this->ReadFloatArray(comp6, numCells);
-        this->ReadFloatArray(comp5, numCells);
-        for (i = 0; i < numCells; i++)
-        {
-          tuple[0] = comp1[i];
-          tuple[1] = comp2[i];
-          tuple[2] = comp3[i];
-          tuple[3] = comp4[i];
-          tuple[4] = comp5[i];
-          tuple[5] = comp6[i];
-          tensors->InsertTuple(i, tuple);
-        }
+        float* tensorsPtr = tensors->GetPointer(0);
+        this->ReadFloatComponent(tensorsPtr, numCells, 6, 0);
+        this->ReadFloatComponent(tensorsPtr, numCells, 6, 1);
+        this->ReadFloatComponent(tensorsPtr, numCells, 6, 2);
+        this->ReadFloatComponent(tensorsPtr, numCells, 6, 3);
+        this->ReadFloatComponent(tensorsPtr, numCells, 6, 5);
+        this->ReadFloatComponent(tensorsPtr, numCells, 6, 4);
         this->GoldIFile->peek();
         if (this->GoldIFile->eof())
         {
@@ -2502,12 +2408,6 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
         {
           lineRead = this->ReadLine(line);
         }
-        delete [] comp1;
-        delete [] comp2;
-        delete [] comp3;
-        delete [] comp4;
-        delete [] comp5;
-        delete [] comp6;
       }
       else
       {
@@ -2604,7 +2504,6 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
   int *nodeIdList;
   int numElements;
   int idx, cellId, cellType;
-  float *xCoords, *yCoords, *zCoords;
 
   this->NumberOfNewOutputs++;
 
@@ -2649,30 +2548,21 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
       vtkPoints *points = vtkPoints::New();
       vtkDebugMacro("num. points: " << numPts);
 
-      points->Allocate(numPts);
+      points->SetDataTypeToFloat();
+      points->SetNumberOfPoints(numPts);
 
       if (this->NodeIdsListed)
       {
         this->GoldIFile->seekg(sizeof(int)*numPts, ios::cur);
       }
 
-      xCoords = new float[numPts];
-      yCoords = new float[numPts];
-      zCoords = new float[numPts];
-      this->ReadFloatArray(xCoords, numPts);
-      this->ReadFloatArray(yCoords, numPts);
-      this->ReadFloatArray(zCoords, numPts);
-
-      for (i = 0; i < numPts; i++)
-      {
-        points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
-      }
+      float* coords = static_cast<float*>(points->GetVoidPointer(0));
+      this->ReadFloatComponent(coords, numPts, 3, 0);
+      this->ReadFloatComponent(coords, numPts, 3, 1);
+      this->ReadFloatComponent(coords, numPts, 3, 2);
 
       output->SetPoints(points);
       points->Delete();
-      delete [] xCoords;
-      delete [] yCoords;
-      delete [] zCoords;
     }
     else if (strncmp(line, "point", 5) == 0)
     {
@@ -3715,7 +3605,6 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
   int i;
   vtkPoints *points = vtkPoints::New();
   int numPts;
-  float *xCoords, *yCoords, *zCoords;
 
   this->NumberOfNewOutputs++;
 
@@ -3755,19 +3644,13 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
     return -1;
   }
   output->SetDimensions(dimensions);
-  points->Allocate(numPts);
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(numPts);
 
-  xCoords = new float[numPts];
-  yCoords = new float[numPts];
-  zCoords = new float[numPts];
-  this->ReadFloatArray(xCoords, numPts);
-  this->ReadFloatArray(yCoords, numPts);
-  this->ReadFloatArray(zCoords, numPts);
-
-  for (i = 0; i < numPts; i++)
-  {
-    points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
-  }
+  float* coords = static_cast<float*>(points->GetVoidPointer(0));
+  this->ReadFloatComponent(coords, numPts, 3, 0);
+  this->ReadFloatComponent(coords, numPts, 3, 1);
+  this->ReadFloatComponent(coords, numPts, 3, 2);
   output->SetPoints(points);
   if (iblanked)
   {
@@ -3785,9 +3668,6 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
   }
 
   points->Delete();
-  delete [] xCoords;
-  delete [] yCoords;
-  delete [] zCoords;
 
   this->GoldIFile->peek();
   if (this->GoldIFile->eof())
@@ -4240,6 +4120,70 @@ int vtkEnSightGoldBinaryReader::ReadFloatArray(float *result,
   return 1;
 }
 
+// Internal function to read a float array into one component of an
+// interleaved array: result[i*numComponents+component] for i < numFloats.
+// Values are read through a fixed-size buffer so no temporary of the size
+// of the whole array is needed. Returns zero if there was an error.
+int vtkEnSightGoldBinaryReader::ReadFloatComponent(float *result,
+  int numFloats, int numComponents, int component)
+{
+  if (numComponents == 1)
+  {
+    return this->ReadFloatArray(result, numFloats);
+  }
+  if (numFloats <= 0)
+  {
+    return 1;
+  }
+
+  char dummy[4];
+  if (this->Fortran)
+  {
+    if (!this->GoldIFile->read(dummy, 4))
+    {
+      vtkErrorMacro("Read (fortran) failed.");
+      return 0;
+    }
+  }
+
+  const int bufferSize = 8192;
+  float buffer[bufferSize];
+  float *out = result + component;
+  for (int start = 0; start < numFloats; start += bufferSize)
+  {
+    int count = numFloats - start < bufferSize ? numFloats - start : bufferSize;
+    if (!this->GoldIFile->read((char*)buffer, sizeof(float)*count))
+    {
+      vtkErrorMacro("Read failed");
+      return 0;
+    }
+
+    if (this->ByteOrder == FILE_LITTLE_ENDIAN)
+    {
+      vtkByteSwap::Swap4LERange(buffer, count);
+    }
+    else
+    {
+      vtkByteSwap::Swap4BERange(buffer, count);
+    }
+
+    for (int i = 0; i < count; ++i, out += numComponents)
+    {
+      *out = buffer[i];
+    }
+  }
+
+  if (this->Fortran)
+  {
+    if (!this->GoldIFile->read(dummy, 4))
+    {
+      vtkErrorMacro("Read (fortran) failed.");
+      return 0;
+    }
+  }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -194,6 +194,15 @@ protected:
    */
   int ReadFloatArray(float *result, int numFloats);
 
+  /**
+   * Internal function to read a float array into one component of an
+   * interleaved array (e.g. the x coordinates of a vtkPoints), avoiding a
+   * temporary copy of the whole array.
+   * Returns zero if there was an error.
+   */
+  int ReadFloatComponent(float *result, int numFloats, int numComponents,
+    int component);
+
   /**
    * Counts the number of timesteps in the geometry file
    * This function assumes the file is already open and returns the
@@ -0,0 +1,106 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusIICache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Exercise the LRU array cache used by vtkExodusIIReader, including the
+// file-qualified keys and statistics used when it is shared between readers.
+
+#include "vtkDoubleArray.h"
+#include "vtkExodusIICache.h"
+#include "vtkNew.h"
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+  { \
+    cerr << "Failure at line " << __LINE__ << ": " << msg << endl; \
+    return EXIT_FAILURE; \
+  }
+
+namespace
+{
+// An array of roughly 1 MiB.
+vtkDoubleArray* NewMiBArray()
+{
+  vtkDoubleArray* arr = vtkDoubleArray::New();
+  arr->SetNumberOfTuples(1024 * 1024 / sizeof(double));
+  arr->FillComponent(0, 1.);
+  return arr;
+}
+}
+
+int TestExodusIICache(int, char*[])
+{
+  vtkNew<vtkExodusIICache> cache;
+  cache->SetCacheCapacity(2.5);
+
+  // The same object read from two files must not collide.
+  int fileA = cache->GetFileId("fileA.exo");
+  int fileB = cache->GetFileId("fileB.exo");
+  TEST_ASSERT(fileA > 0 && fileB > 0 && fileA != fileB, "File IDs must be positive and distinct.");
+  TEST_ASSERT(cache->GetFileId("fileA.exo") == fileA, "File IDs must be stable.");
+  int priv = cache->NewFileId();
+  TEST_ASSERT(priv != fileA && priv != fileB, "Private IDs must be unique.");
+
+  vtkExodusIICacheKey keyA(0, 1, 10, 0, fileA);
+  vtkExodusIICacheKey keyB(0, 1, 10, 0, fileB);
+  vtkDataArray* arrA = NewMiBArray();
+  vtkDataArray* arrB = NewMiBArray();
+  cache->Insert(keyA, arrA);
+  cache->Insert(keyB, arrB);
+  arrA->Delete();
+  arrB->Delete();
+
+  TEST_ASSERT(cache->Find(keyA) == arrA, "Entry for file A not found.");
+  TEST_ASSERT(cache->Find(keyB) == arrB, "Entry for file B not found.");
+  TEST_ASSERT(cache->Find(vtkExodusIICacheKey(1, 1, 10, 0, fileA)) == nullptr,
+    "Unexpected entry for another time step.");
+  TEST_ASSERT(cache->GetNumberOfHits() == 2 && cache->GetNumberOfMisses() == 1,
+    "Wrong hit/miss counts.");
+
+  // Inserting a third array exceeds the budget; the least recently used
+  // entry (file A, since B was found last) must be evicted.
+  vtkExodusIICacheKey keyC(1, 1, 10, 0, fileB);
+  vtkDataArray* arrC = NewMiBArray();
+  cache->Insert(keyC, arrC);
+  arrC->Delete();
+  TEST_ASSERT(cache->GetNumberOfEvictions() == 1, "Expected one eviction.");
+  TEST_ASSERT(cache->Find(keyA) == nullptr, "LRU entry was not evicted.");
+  TEST_ASSERT(cache->Find(keyB) != nullptr && cache->Find(keyC) != nullptr,
+    "Recent entries were evicted.");
+  TEST_ASSERT(cache->GetCacheSize() <= cache->GetCacheCapacity(), "Budget exceeded.");
+
+  // Invalidating by file only drops that file's entries.
+  cache->SetCacheCapacity(4.);
+  arrA = NewMiBArray();
+  cache->Insert(keyA, arrA);
+  arrA->Delete();
+  int dropped = cache->Invalidate(
+    vtkExodusIICacheKey(0, 0, 0, 0, fileB), vtkExodusIICacheKey(0, 0, 0, 0, 1));
+  TEST_ASSERT(dropped == 2, "Invalidate by file dropped " << dropped << " entries, expected 2.");
+  TEST_ASSERT(cache->Find(keyB) == nullptr && cache->Find(keyC) == nullptr,
+    "File B entries survived invalidation.");
+  TEST_ASSERT(cache->Find(keyA) == arrA, "File A entry was dropped.");
+
+  cache->ResetStatistics();
+  TEST_ASSERT(cache->GetNumberOfHits() == 0 && cache->GetNumberOfMisses() == 0 &&
+      cache->GetNumberOfEvictions() == 0,
+    "Statistics were not reset.");
+
+  cache->Clear();
+  TEST_ASSERT(cache->GetCacheSize() == 0., "Cache not empty after Clear().");
+
+  TEST_ASSERT(vtkExodusIICache::GetGlobalCache() == vtkExodusIICache::GetGlobalCache(),
+    "Global cache must be a singleton.");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,177 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusIIReaderGlobalCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Read one file with two readers sharing the global array cache, with the
+// usual SetFileName(), UseGlobalCacheOn(), Update() order, and check that
+// the arrays are shared and that changing the file name does not return
+// the arrays of the previous file.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkExodusIICache.h"
+#include "vtkExodusIIReader.h"
+#include "vtkExodusIIWriter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkTesting.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string>
+
+#define TEST_ASSERT(cond, msg) \
+  if (!(cond)) \
+  { \
+    cerr << "Failure at line " << __LINE__ << ": " << msg << endl; \
+    return EXIT_FAILURE; \
+  }
+
+namespace
+{
+
+const int NUMBER_OF_CELLS = 4;
+
+// A row of hexahedra with one cell array whose values start at offset
+void WriteFile(const std::string& fileName, double offset)
+{
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i <= NUMBER_OF_CELLS; ++i)
+  {
+    points->InsertNextPoint(i, 0, 0);
+    points->InsertNextPoint(i, 1, 0);
+    points->InsertNextPoint(i, 1, 1);
+    points->InsertNextPoint(i, 0, 1);
+  }
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points.GetPointer());
+  vtkNew<vtkDoubleArray> pressure;
+  pressure->SetName("Pressure");
+  vtkNew<vtkIdTypeArray> blockIds;
+  blockIds->SetName("ElementBlockIds");
+  for (vtkIdType i = 0; i < NUMBER_OF_CELLS; ++i)
+  {
+    vtkIdType pts[8] = { 4 * i, 4 * i + 1, 4 * i + 2, 4 * i + 3,
+                         4 * i + 4, 4 * i + 5, 4 * i + 6, 4 * i + 7 };
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, pts);
+    pressure->InsertNextValue(offset + i);
+    blockIds->InsertNextValue(1);
+  }
+  grid->GetCellData()->AddArray(pressure.GetPointer());
+  grid->GetCellData()->AddArray(blockIds.GetPointer());
+
+  vtkNew<vtkExodusIIWriter> writer;
+  writer->SetInputData(grid.GetPointer());
+  writer->SetFileName(fileName.c_str());
+  writer->Write();
+}
+
+vtkDataArray* GetBlockArray(vtkExodusIIReader* reader, const char* name, bool pointData)
+{
+  vtkMultiBlockDataSet* elementBlocks =
+    vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput()->GetBlock(0));
+  vtkUnstructuredGrid* block = elementBlocks ?
+    vtkUnstructuredGrid::SafeDownCast(elementBlocks->GetBlock(0)) : nullptr;
+  if (!block)
+  {
+    return nullptr;
+  }
+  return pointData ? block->GetPointData()->GetArray(name) :
+    block->GetCellData()->GetArray(name);
+}
+
+vtkDataArray* GetPressure(vtkExodusIIReader* reader)
+{
+  return GetBlockArray(reader, "Pressure", false);
+}
+
+}
+
+int TestExodusIIReaderGlobalCache(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  for (int i = 0; i < argc; ++i)
+  {
+    testing->AddArgument(argv[i]);
+  }
+  std::string fileA = std::string(testing->GetTempDirectory()) + "/globalCacheA.exii";
+  std::string fileB = std::string(testing->GetTempDirectory()) + "/globalCacheB.exii";
+  WriteFile(fileA, 0.0);
+  WriteFile(fileB, 100.0);
+
+  vtkExodusIICache* cache = vtkExodusIICache::GetGlobalCache();
+  cache->SetCacheCapacity(16.);
+  cache->Clear();
+
+  vtkNew<vtkExodusIIReader> reader1;
+  vtkNew<vtkExodusIIReader> reader2;
+  vtkExodusIIReader* readers[2] = { reader1.GetPointer(), reader2.GetPointer() };
+  for (int r = 0; r < 2; ++r)
+  {
+    readers[r]->SetFileName(fileA.c_str());
+    readers[r]->UseGlobalCacheOn();
+    readers[r]->UpdateInformation();
+    readers[r]->SetElementResultArrayStatus("Pressure", 1);
+    cache->ResetStatistics();
+    readers[r]->Update();
+  }
+  TEST_ASSERT(reader1->GetCache() == cache && reader2->GetCache() == cache,
+    "The readers do not use the global cache.");
+  TEST_ASSERT(cache->GetNumberOfHits() > 0,
+    "The second reader did not reuse the arrays of the first one.");
+  vtkDataArray* pressure1 = GetPressure(reader1.GetPointer());
+  vtkDataArray* pressure2 = GetPressure(reader2.GetPointer());
+  TEST_ASSERT(pressure1 && pressure1 == pressure2,
+    "The readers do not share the array read from the file.");
+  TEST_ASSERT(pressure1->GetTuple1(NUMBER_OF_CELLS - 1) == NUMBER_OF_CELLS - 1,
+    "Wrong values read from the first file.");
+
+  // The key follows the file name: the arrays of the first file are not
+  // returned for the second one.
+  reader2->SetFileName(fileB.c_str());
+  reader2->UpdateInformation();
+  reader2->SetElementResultArrayStatus("Pressure", 1);
+  reader2->Update();
+  pressure2 = GetPressure(reader2.GetPointer());
+  TEST_ASSERT(pressure2 && pressure2 != pressure1 &&
+      pressure2->GetTuple1(0) == 100.0,
+    "Stale arrays returned after changing the file name.");
+  reader1->Update();
+  TEST_ASSERT(GetPressure(reader1.GetPointer())->GetTuple1(0) == 0.0,
+    "The first reader lost its file.");
+
+  // Node ids are subset with the point map of each reader, so they are
+  // never shared.
+  reader2->SetFileName(fileA.c_str());
+  for (int r = 0; r < 2; ++r)
+  {
+    readers[r]->GenerateGlobalNodeIdArrayOn();
+    readers[r]->GenerateImplicitNodeIdArrayOn();
+    readers[r]->Update();
+  }
+  const char* nodeIdNames[2] = { vtkExodusIIReader::GetGlobalNodeIdArrayName(),
+                                 vtkExodusIIReader::GetImplicitNodeIdArrayName() };
+  for (int i = 0; i < 2; ++i)
+  {
+    vtkDataArray* ids1 = GetBlockArray(reader1.GetPointer(), nodeIdNames[i], true);
+    vtkDataArray* ids2 = GetBlockArray(reader2.GetPointer(), nodeIdNames[i], true);
+    TEST_ASSERT(ids1 && ids2 && ids1 != ids2,
+      "The readers share their " << nodeIdNames[i] << " array.");
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -1,8 +1,13 @@
 #include "vtkExodusIICache.h"
 
 #include "vtkDataArray.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 
+#include <vtksys/SystemTools.hxx>
+
+#include <sstream>
+
 // Define VTK_EXO_DBG_CACHE to print cache adds, drops, and replacements.
 //#undef VTK_EXO_DBG_CACHE
 
@@ -65,17 +70,42 @@ void printLRUBack( vtkExodusIICacheRef& cit )
 
 // ============================================================================
 
+// ============================================================================
+vtkExodusIICache* vtkExodusIICache::GlobalCache = nullptr;
+vtkExodusIICacheCleanup vtkExodusIICache::Cleanup;
+
+vtkExodusIICacheCleanup::vtkExodusIICacheCleanup()
+{
+}
+
+vtkExodusIICacheCleanup::~vtkExodusIICacheCleanup()
+{
+  if ( vtkExodusIICache::GlobalCache )
+  {
+    vtkExodusIICache::GlobalCache->Delete();
+    vtkExodusIICache::GlobalCache = nullptr;
+  }
+}
+
+// ============================================================================
+
 vtkStandardNewMacro(vtkExodusIICache);
 
 vtkExodusIICache::vtkExodusIICache()
 {
   this->Size = 0.;
   this->Capacity = 2.;
+  this->LastFileId = 0;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+  this->Lock = vtkSimpleMutexLock::New();
 }
 
 vtkExodusIICache::~vtkExodusIICache()
 {
-  this->ReduceToSize( 0. );
+  this->ReduceToSizeInternal( 0. );
+  this->Lock->Delete();
 }
 
 void vtkExodusIICache::PrintSelf( ostream& os, vtkIndent indent )
@@ -85,37 +115,106 @@ void vtkExodusIICache::PrintSelf( ostream& os, vtkIndent indent )
   os << indent << "Size: " << this->Size << " MiB\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
   os << indent << "LRU: " << &this->LRU << "\n";
+  os << indent << "FileIds: " << this->FileIds.size() << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
+  os << indent << "NumberOfEvictions: " << this->NumberOfEvictions << "\n";
+}
+
+vtkExodusIICache* vtkExodusIICache::GetGlobalCache()
+{
+  // Readers are created on the main thread; lazily creating the instance here
+  // mirrors the other VTK singletons.
+  if ( ! vtkExodusIICache::GlobalCache )
+  {
+    vtkExodusIICache::GlobalCache = vtkExodusIICache::New();
+  }
+  return vtkExodusIICache::GlobalCache;
 }
 
 void vtkExodusIICache::Clear()
 {
   //printCache( this->Cache, this->LRU );
-  this->ReduceToSize( 0. );
+  this->Lock->Lock();
+  this->ReduceToSizeInternal( 0. );
+  this->Lock->Unlock();
 }
 
 void vtkExodusIICache::SetCacheCapacity( double sizeInMiB )
 {
-  if ( sizeInMiB == this->Capacity )
-    return;
+  this->Lock->Lock();
+  if ( sizeInMiB != this->Capacity )
+  {
+    if ( this->Size > sizeInMiB )
+    {
+      this->NumberOfEvictions += this->ReduceToSizeInternal( sizeInMiB );
+    }
+
+    this->Capacity =  sizeInMiB < 0 ? 0 : sizeInMiB;
+  }
+  this->Lock->Unlock();
+}
+
+int vtkExodusIICache::GetFileId( const char* fileName )
+{
+  std::ostringstream fileKey;
+  if ( fileName )
+  {
+    std::string fullName = vtksys::SystemTools::CollapseFullPath( fileName );
+    fileKey << fullName << "@" << vtksys::SystemTools::ModifiedTime( fullName );
+  }
 
-  if ( this->Size > sizeInMiB )
+  this->Lock->Lock();
+  std::map<std::string,int>::iterator it = this->FileIds.find( fileKey.str() );
+  int fileId;
+  if ( it != this->FileIds.end() )
+  {
+    fileId = it->second;
+  }
+  else
   {
-    this->ReduceToSize( sizeInMiB );
+    fileId = ++this->LastFileId;
+    this->FileIds[fileKey.str()] = fileId;
   }
+  this->Lock->Unlock();
+  return fileId;
+}
+
+int vtkExodusIICache::NewFileId()
+{
+  this->Lock->Lock();
+  int fileId = ++this->LastFileId;
+  this->Lock->Unlock();
+  return fileId;
+}
 
-  this->Capacity =  sizeInMiB < 0 ? 0 : sizeInMiB;
+void vtkExodusIICache::ResetStatistics()
+{
+  this->Lock->Lock();
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+  this->Lock->Unlock();
 }
 
 int vtkExodusIICache::ReduceToSize( double newSize )
 {
-  int deletedSomething = 0;
+  this->Lock->Lock();
+  int deletedSomething = this->ReduceToSizeInternal( newSize ) > 0 ? 1 : 0;
+  this->Lock->Unlock();
+  return deletedSomething;
+}
+
+int vtkExodusIICache::ReduceToSizeInternal( double newSize )
+{
+  int numberDeleted = 0;
   while ( this->Size > newSize && ! this->LRU.empty() )
   {
     vtkExodusIICacheRef cit( this->LRU.back() );
     vtkDataArray* arr = cit->second->Value;
     if ( arr )
     {
-      deletedSomething = 1;
+      ++numberDeleted;
       double arrSz = (double) arr->GetActualMemorySize() / 1024.;
       this->Size -= arrSz;
 #ifdef VTK_EXO_DBG_CACHE
@@ -146,18 +245,22 @@ int vtkExodusIICache::ReduceToSize( double newSize )
     this->Size = 0;
   }
 
-  return deletedSomething;
+  return numberDeleted;
 }
 
 void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
 {
   double vsize = value ? value->GetActualMemorySize() / 1024. : 0.;
 
+  this->Lock->Lock();
   vtkExodusIICacheRef it = this->Cache.find( key );
   if ( it != this->Cache.end() )
   {
     if ( it->second->Value == value )
+    {
+      this->Lock->Unlock();
       return;
+    }
 
     // Remove existing array and put in our new one.
     this->Size -= vsize;
@@ -165,7 +268,7 @@ void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
     {
       this->RecomputeSize();
     }
-    this->ReduceToSize( this->Capacity - vsize );
+    this->NumberOfEvictions += this->ReduceToSizeInternal( this->Capacity - vsize );
     it->second->Value->Delete();
     it->second->Value = value;
     it->second->Value->Register( nullptr ); // Since we re-use the cache entry, the constructor's Register won't get called.
@@ -178,7 +281,7 @@ void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
   }
   else
   {
-    this->ReduceToSize( this->Capacity - vsize );
+    this->NumberOfEvictions += this->ReduceToSizeInternal( this->Capacity - vsize );
     std::pair<const vtkExodusIICacheKey,vtkExodusIICacheEntry*> entry( key, new vtkExodusIICacheEntry(value) );
     std::pair<vtkExodusIICacheSet::iterator, bool> iret = this->Cache.insert( entry );
     this->Size += vsize;
@@ -188,26 +291,33 @@ void vtkExodusIICache::Insert( vtkExodusIICacheKey& key, vtkDataArray* value )
     iret.first->second->LRUEntry = this->LRU.insert( this->LRU.begin(), iret.first );
   }
   //printCache( this->Cache, this->LRU );
+  this->Lock->Unlock();
 }
 
-vtkDataArray*& vtkExodusIICache::Find( const vtkExodusIICacheKey& key )
+vtkSmartPointer<vtkDataArray> vtkExodusIICache::Find( const vtkExodusIICacheKey& key )
 {
-  static vtkDataArray* dummy = nullptr;
+  vtkSmartPointer<vtkDataArray> value;
 
+  this->Lock->Lock();
   vtkExodusIICacheRef it = this->Cache.find( key );
   if ( it != this->Cache.end() )
   {
     this->LRU.erase( it->second->LRUEntry );
     it->second->LRUEntry = this->LRU.insert( this->LRU.begin(), it );
-    return it->second->Value;
+    ++this->NumberOfHits;
+    value = it->second->Value;
   }
-
-  dummy = nullptr;
-  return dummy;
+  else
+  {
+    ++this->NumberOfMisses;
+  }
+  this->Lock->Unlock();
+  return value;
 }
 
 int vtkExodusIICache::Invalidate( const vtkExodusIICacheKey& key )
 {
+  this->Lock->Lock();
   vtkExodusIICacheRef it = this->Cache.find( key );
   if ( it != this->Cache.end() )
   {
@@ -230,8 +340,10 @@ int vtkExodusIICache::Invalidate( const vtkExodusIICacheKey& key )
         this->RecomputeSize(); // oops, FP roundoff
     }
 
+    this->Lock->Unlock();
     return 1;
   }
+  this->Lock->Unlock();
   return 0;
 }
 
@@ -239,6 +351,7 @@ int vtkExodusIICache::Invalidate( const vtkExodusIICacheKey& key, const vtkExodu
 {
   vtkExodusIICacheRef it;
   int nDropped = 0;
+  this->Lock->Lock();
   it = this->Cache.begin();
   while ( it != this->Cache.end() )
   {
@@ -270,6 +383,7 @@ int vtkExodusIICache::Invalidate( const vtkExodusIICacheKey& key, const vtkExodu
 
     ++nDropped;
   }
+  this->Lock->Unlock();
   return nDropped;
 }
 
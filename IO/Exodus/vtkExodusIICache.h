@@ -9,7 +9,7 @@
 // cache entries (vtkExodusIICacheEntry) and a list of
 // cache references (vtkExodusIICacheRef). The entries in
 // these containers are sorted for fast retrieval:
-// 1. The cache entries are indexed by the timestep, the
+// 1. The cache entries are indexed by the file, the timestep, the
 //    object type (edge block, face set, ...), and the
 //    object ID (if one exists). When you call Find() to
 //    retrieve a cache entry, you provide a key containing
@@ -22,12 +22,22 @@
 // entries O(1). Each cache entry stores an iterator into
 // the list of references so that it can be located quickly for
 // removal.
+//
+// A single process-wide cache is available through GetGlobalCache().
+// Readers sharing it tag their keys with a file ID obtained from
+// GetFileId() so that several readers of the same file reuse each
+// other's arrays while the total memory stays within one budget.
+// All public methods of vtkExodusIICache are serialized by a mutex.
+// Find() returns a new reference to the array, so an array stays valid
+// when another reader sharing the cache evicts it.
 
 #include "vtkIOExodusModule.h" // For export macro
 #include "vtkObject.h"
+#include "vtkSmartPointer.h" // For Find()
 
 #include <map> // used for cache storage
 #include <list> // use for LRU ordering
+#include <string> // used for file ID lookup
 
 class VTKIOEXODUS_EXPORT vtkExodusIICacheKey
 {
@@ -36,19 +46,22 @@ public:
   int ObjectType;
   int ObjectId;
   int ArrayId;
+  int FileId;
   vtkExodusIICacheKey()
   {
     Time = -1;
     ObjectType = -1;
     ObjectId = -1;
     ArrayId = -1;
+    FileId = 0;
   }
-  vtkExodusIICacheKey( int time, int objType, int objId, int arrId )
+  vtkExodusIICacheKey( int time, int objType, int objId, int arrId, int fileId = 0 )
   {
     Time = time;
     ObjectType = objType;
     ObjectId = objId;
     ArrayId = arrId;
+    FileId = fileId;
   }
   vtkExodusIICacheKey( const vtkExodusIICacheKey& src )
   {
@@ -56,6 +69,7 @@ public:
     ObjectType = src.ObjectType;
     ObjectId = src.ObjectId;
     ArrayId = src.ArrayId;
+    FileId = src.FileId;
   }
   vtkExodusIICacheKey& operator = ( const vtkExodusIICacheKey& src )
   {
@@ -63,10 +77,13 @@ public:
     ObjectType = src.ObjectType;
     ObjectId = src.ObjectId;
     ArrayId = src.ArrayId;
+    FileId = src.FileId;
     return *this;
   }
   bool match( const vtkExodusIICacheKey&other, const vtkExodusIICacheKey& pattern ) const
   {
+    if ( pattern.FileId && this->FileId != other.FileId )
+      return false;
     if ( pattern.Time && this->Time != other.Time )
       return false;
     if ( pattern.ObjectType && this->ObjectType != other.ObjectType )
@@ -79,6 +96,10 @@ public:
   }
   bool operator < ( const vtkExodusIICacheKey& other ) const
   {
+    if ( this->FileId < other.FileId )
+      return true;
+    else if ( this->FileId > other.FileId )
+      return false;
     if ( this->Time < other.Time )
       return true;
     else if ( this->Time > other.Time )
@@ -100,6 +121,7 @@ public:
 class vtkExodusIICacheEntry;
 class vtkExodusIICache;
 class vtkDataArray;
+class vtkSimpleMutexLock;
 
 typedef std::map<vtkExodusIICacheKey,vtkExodusIICacheEntry*> vtkExodusIICacheSet;
 typedef std::map<vtkExodusIICacheKey,vtkExodusIICacheEntry*>::iterator vtkExodusIICacheRef;
@@ -124,6 +146,17 @@ protected:
   friend class vtkExodusIICache;
 };
 
+class VTKIOEXODUS_EXPORT vtkExodusIICacheCleanup
+{
+public:
+  vtkExodusIICacheCleanup();
+  ~vtkExodusIICacheCleanup();
+
+private:
+  vtkExodusIICacheCleanup( const vtkExodusIICacheCleanup& ) = delete;
+  vtkExodusIICacheCleanup& operator = ( const vtkExodusIICacheCleanup& ) = delete;
+};
+
 class VTKIOEXODUS_EXPORT vtkExodusIICache : public vtkObject
 {
 public:
@@ -131,12 +164,26 @@ public:
   vtkTypeMacro(vtkExodusIICache,vtkObject);
   void PrintSelf( ostream& os, vtkIndent indent ) override;
 
+  /** Return the process-wide cache shared by readers with UseGlobalCache enabled.
+    * It is created on first use with the default capacity and destroyed when
+    * the program exits. Use SetCacheCapacity() on it to set the global budget.
+    */
+  static vtkExodusIICache* GetGlobalCache();
+
   /// Empty the cache
   void Clear();
 
   /// Set the maximum allowable cache size. This will remove cache entries if the capacity is reduced below the current size.
   void SetCacheCapacity( double sizeInMiB );
 
+  /// Get the maximum allowable cache size in MiB.
+  double GetCacheCapacity()
+    { return this->Capacity; }
+
+  /// Get the current size of all cached arrays in MiB.
+  double GetCacheSize()
+    { return this->Size; }
+
   /** See how much cache space is left.
     * This is the difference between the capacity and the size of the cache.
     * The result is in MiB.
@@ -144,6 +191,30 @@ public:
   double GetSpaceLeft()
     { return this->Capacity - this->Size; }
 
+  /** Return the file ID to store in keys for arrays read from \a fileName.
+    * Every call with the same file name and modification time returns the same ID,
+    * so readers of the same file share entries; rewriting the file yields a new ID
+    * so stale arrays are never returned. IDs are always positive.
+    */
+  int GetFileId( const char* fileName );
+
+  /** Return a new file ID that no other caller will receive.
+    * Use this for arrays that depend on per-reader settings and must not be shared.
+    */
+  int NewFileId();
+
+  //@{
+  /** Instrumentation: the number of Find() calls that returned an array,
+    * the number that did not, and the number of entries dropped to honor the capacity.
+    */
+  vtkGetMacro(NumberOfHits,vtkTypeInt64);
+  vtkGetMacro(NumberOfMisses,vtkTypeInt64);
+  vtkGetMacro(NumberOfEvictions,vtkTypeInt64);
+  //@}
+
+  /// Reset the hit, miss, and eviction counters to zero.
+  void ResetStatistics();
+
   /** Remove cache entries until the size of the cache is at or below the given size.
     * Returns a nonzero value if deletions were required.
     */
@@ -153,9 +224,10 @@ public:
   void Insert( vtkExodusIICacheKey& key, vtkDataArray* value );
 
   /** Determine whether a cache entry exists. If it does, return it -- otherwise return nullptr.
-    * If a cache entry exists, it is marked as most recently used.
+    * If a cache entry exists, it is marked as most recently used. The array is referenced
+    * before the cache is unlocked, so it outlives its eviction by another thread.
     */
-  vtkDataArray*& Find( const vtkExodusIICacheKey& );
+  vtkSmartPointer<vtkDataArray> Find( const vtkExodusIICacheKey& );
 
   /** Invalidate a cache entry (drop it from the cache) if the key exists.
     * This does nothing if the cache entry does not exist.
@@ -185,6 +257,9 @@ protected:
   /// Avoid (some) FP problems
   void RecomputeSize();
 
+  /// Unlocked version of ReduceToSize() that returns the number of entries dropped.
+  int ReduceToSizeInternal( double newSize );
+
   /// The capacity of the cache (i.e., the maximum size of all arrays it contains) in MiB.
   double Capacity;
 
@@ -202,8 +277,23 @@ protected:
   /// The actual LRU list (indices into the cache ordered least to most recently used).
   vtkExodusIICacheLRU LRU;
 
+  /// File IDs handed out by GetFileId(), keyed on file name and modification time.
+  std::map<std::string,int> FileIds;
+  int LastFileId;
+
+  vtkTypeInt64 NumberOfHits;
+  vtkTypeInt64 NumberOfMisses;
+  vtkTypeInt64 NumberOfEvictions;
+
+  /// Serializes access so that one cache can be shared between readers and threads.
+  vtkSimpleMutexLock* Lock;
+
 private:
   vtkExodusIICache( const vtkExodusIICache& ) = delete;
   void operator = ( const vtkExodusIICache& ) = delete;
+
+  static vtkExodusIICache* GlobalCache;
+  static vtkExodusIICacheCleanup Cleanup;
+  friend class vtkExodusIICacheCleanup;
 };
 #endif // vtkExodusIICache_h
@@ -381,6 +381,9 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
+  this->UseGlobalCache = 0;
+  this->CacheFileId = 0;
+  this->CachePrivateId = 0;
 
   this->HasModeShapes = 0;
   this->ModeShapeTime = -1.;
@@ -411,7 +414,17 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 vtkExodusIIReaderPrivate::~vtkExodusIIReaderPrivate()
 {
   this->CloseFile();
-  this->Cache->Delete();
+  if ( this->UseGlobalCache )
+  {
+    this->Cache->Invalidate(
+      vtkExodusIICacheKey( 0, 0, 0, 0, this->CachePrivateId ),
+      vtkExodusIICacheKey( 0, 0, 0, 0, 1 ) );
+    this->Cache->UnRegister( this );
+  }
+  else
+  {
+    this->Cache->Delete();
+  }
   this->CacheSize = 0;
   this->ClearConnectivityCaches();
   if(this->Parser)
@@ -1725,10 +1738,24 @@ void vtkExodusIIReaderPrivate::InsertSetSides(
   }
 }
 
+//-----------------------------------------------------------------------------
+int vtkExodusIIReaderPrivate::GetCacheFileId( int objectType )
+{
+  if ( objectType == vtkExodusIIReader::GLOBAL ||
+    objectType == vtkExodusIIReader::NODAL_COORDS ||
+    objectType == vtkExodusIIReader::GLOBAL_NODE_ID ||
+    objectType == vtkExodusIIReader::IMPLICIT_NODE_ID )
+  {
+    return this->CachePrivateId;
+  }
+  return this->CacheFileId;
+}
+
 //-----------------------------------------------------------------------------
 vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key )
 {
   vtkDataArray* arr;
+  key.FileId = this->GetCacheFileId( key.ObjectType );
   // Never cache points deflected for a mode shape animation... doubles don't make good keys.
   if ( this->HasModeShapes && key.ObjectType == vtkExodusIIReader::NODAL_COORDS )
   {
@@ -1736,13 +1763,13 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
   }
   else
   {
-    arr = this->Cache->Find( key );
-  }
-
-  if ( arr )
-  {
-    //
-    return arr;
+    vtkSmartPointer<vtkDataArray> cached = this->Cache->Find( key );
+    if ( cached )
+    {
+      this->CacheReferences.push_back( cached );
+      return cached;
+    }
+    arr = nullptr;
   }
 
   int exoid = this->Exoid;
@@ -3040,13 +3067,12 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     arr = nullptr;
   }
 
-  // Even if the array is larger than the allowable cache size, it will keep the most recent insertion.
-  // So, we delete our reference knowing that the Cache will keep the object "alive" until whatever
-  // called GetCacheOrRead() references the array. But, once you get an array from GetCacheOrRead(),
-  // you better start running!
+  // Our reference moves to CacheReferences, which keeps the array alive until the file is
+  // closed even if the cache (possibly shared with readers in other threads) evicts it.
   if ( arr )
   {
     this->Cache->Insert( key, arr );
+    this->CacheReferences.push_back( arr );
     arr->FastDelete();
   }
   return arr;
@@ -3842,6 +3868,7 @@ void vtkExodusIIReaderPrivate::PrintData( ostream& os, vtkIndent indent )
     }
   }
 
+  os << indent << "UseGlobalCache: " << this->UseGlobalCache << "\n";
   os << indent << "Array Cache:\n";
   this->Cache->PrintSelf( os, inden2 );
 
@@ -3886,6 +3913,13 @@ int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
   float dummyFloat;
   ex_inquire(this->Exoid, EX_INQ_NODES, &numNodesInFile, &dummyFloat, &dummyChar);
 
+  // Key shared arrays on the file being read now: the file name or its
+  // modification time may have changed since the cache was enabled.
+  if ( this->UseGlobalCache )
+  {
+    this->CacheFileId = this->Cache->GetFileId( filename );
+  }
+
   return 1;
 }
 
@@ -3896,6 +3930,7 @@ int vtkExodusIIReaderPrivate::CloseFile()
     VTK_EXO_FUNC( ex_close( this->Exoid ), "Could not close an open file (" << this->Exoid << ")" );
     this->Exoid = -1;
   }
+  this->CacheReferences.clear();
   return 0;
 }
 
@@ -4760,8 +4795,19 @@ void vtkExodusIIReaderPrivate::ResetSettings()
 
 void vtkExodusIIReaderPrivate::ResetCache()
 {
-  this->Cache->Clear();
-  this->Cache->SetCacheCapacity(this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
+  if ( this->UseGlobalCache )
+  {
+    // Arrays shared with other readers are keyed on the file name and
+    // modification time so they stay valid; only drop our own.
+    this->Cache->Invalidate(
+      vtkExodusIICacheKey( 0, 0, 0, 0, this->CachePrivateId ),
+      vtkExodusIICacheKey( 0, 0, 0, 0, 1 ) );
+  }
+  else
+  {
+    this->Cache->Clear();
+    this->Cache->SetCacheCapacity(this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
+  }
   this->ClearConnectivityCaches();
 }
 
@@ -4770,11 +4816,50 @@ void vtkExodusIIReaderPrivate::SetCacheSize( double size )
   if (this->CacheSize != size)
   {
     this->CacheSize = size;
-    this->Cache->SetCacheCapacity(this->CacheSize);
+    if ( ! this->UseGlobalCache )
+    {
+      this->Cache->SetCacheCapacity(this->CacheSize);
+    }
     this->Modified();
   }
 }
 
+void vtkExodusIIReaderPrivate::SetUseGlobalCache( int use )
+{
+  use = use ? 1 : 0;
+  if ( this->UseGlobalCache == use )
+  {
+    return;
+  }
+
+  this->ResetCache();
+  if ( this->UseGlobalCache )
+  {
+    this->Cache->UnRegister( this );
+  }
+  else
+  {
+    this->Cache->Delete();
+  }
+  this->UseGlobalCache = use;
+  if ( use )
+  {
+    this->Cache = vtkExodusIICache::GetGlobalCache();
+    this->Cache->Register( this );
+    this->CachePrivateId = this->Cache->NewFileId();
+    this->CacheFileId = this->Exoid >= 0 ?
+      this->Cache->GetFileId( this->Parent->GetFileName() ) : this->CachePrivateId;
+  }
+  else
+  {
+    this->Cache = vtkExodusIICache::New();
+    this->Cache->SetCacheCapacity( this->CacheSize );
+    this->CacheFileId = 0;
+    this->CachePrivateId = 0;
+  }
+  this->Modified();
+}
+
 bool vtkExodusIIReaderPrivate::IsXMLMetadataValid()
 {
   // Make sure that each block id referred to in the metadata arrays exist
@@ -5055,8 +5140,8 @@ void vtkExodusIIReaderPrivate::SetObjectArrayStatus( int otyp, int i, int stat )
     //vtkExodusIICacheKey key( 0, GLOBAL, 0, i );
     //vtkExodusIICacheKey pattern( 0, 1, 0, 1 );
     this->Cache->Invalidate(
-      vtkExodusIICacheKey( 0, vtkExodusIIReader::GLOBAL, otyp, i ),
-      vtkExodusIICacheKey( 0, 1, 1, 1 ) );
+      vtkExodusIICacheKey( 0, vtkExodusIIReader::GLOBAL, otyp, i, this->CachePrivateId ),
+      vtkExodusIICacheKey( 0, 1, 1, 1, 1 ) );
   }
   else
   {
@@ -5220,8 +5305,8 @@ void vtkExodusIIReaderPrivate::SetApplyDisplacements( int d )
 
   // Require the coordinates to be recomputed:
   this->Cache->Invalidate(
-    vtkExodusIICacheKey( 0, vtkExodusIIReader::NODAL_COORDS, 0, 0 ),
-    vtkExodusIICacheKey( 0, 1, 0, 0 ) );
+    vtkExodusIICacheKey( 0, vtkExodusIIReader::NODAL_COORDS, 0, 0, this->CachePrivateId ),
+    vtkExodusIICacheKey( 0, 1, 0, 0, 1 ) );
 }
 
 void vtkExodusIIReaderPrivate::SetDisplacementMagnitude( double s )
@@ -5234,8 +5319,8 @@ void vtkExodusIIReaderPrivate::SetDisplacementMagnitude( double s )
 
   // Require the coordinates to be recomputed:
   this->Cache->Invalidate(
-    vtkExodusIICacheKey( 0, vtkExodusIIReader::NODAL_COORDS, 0, 0 ),
-    vtkExodusIICacheKey( 0, 1, 0, 0 ) );
+    vtkExodusIICacheKey( 0, vtkExodusIIReader::NODAL_COORDS, 0, 0, this->CachePrivateId ),
+    vtkExodusIICacheKey( 0, 1, 0, 0, 1 ) );
 }
 
 vtkDataArray* vtkExodusIIReaderPrivate::FindDisplacementVectors( int timeStep )
@@ -6479,6 +6564,21 @@ double vtkExodusIIReader::GetCacheSize()
   return this->Metadata->GetCacheSize();
 }
 
+void vtkExodusIIReader::SetUseGlobalCache(bool use)
+{
+  this->Metadata->SetUseGlobalCache(use ? 1 : 0);
+}
+
+bool vtkExodusIIReader::GetUseGlobalCache()
+{
+  return this->Metadata->GetUseGlobalCache() != 0;
+}
+
+vtkExodusIICache* vtkExodusIIReader::GetCache()
+{
+  return this->Metadata->GetCache();
+}
+
 void vtkExodusIIReader::SetSqueezePoints(bool sp)
 {
   this->Metadata->SetSqueezePoints(sp ? 1 : 0);
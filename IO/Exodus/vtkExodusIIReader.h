@@ -737,6 +737,26 @@ public:
    */
   double GetCacheSize();
 
+  //@{
+  /**
+   * Should the reader keep its arrays in the process-wide cache returned by
+   * vtkExodusIICache::GetGlobalCache() instead of a private one? Readers of the
+   * same file then reuse each other's arrays (e.g. several views of one
+   * time series) and all of them share a single memory budget, set with
+   * vtkExodusIICache::GetGlobalCache()->SetCacheCapacity(). While this is on,
+   * SetCacheSize() has no effect. Off by default.
+   */
+  void SetUseGlobalCache(bool use);
+  bool GetUseGlobalCache();
+  vtkBooleanMacro(UseGlobalCache, bool);
+  //@}
+
+  /**
+   * Return the cache holding this reader's arrays. Its hit, miss and eviction
+   * counts can be used to tune the cache size.
+   */
+  vtkExodusIICache* GetCache();
+
   //@{
   /**
    * Should the reader output only points used by elements in the output mesh,
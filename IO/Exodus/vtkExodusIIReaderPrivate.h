@@ -77,6 +77,13 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /// Share arrays with other readers through vtkExodusIICache::GetGlobalCache().
+  void SetUseGlobalCache(int use);
+  vtkGetMacro(UseGlobalCache, int);
+
+  /// Return the cache currently holding arrays for this reader.
+  vtkExodusIICache* GetCache() { return this->Cache; }
+
   /** Return the number of time steps in the open file.
     * You must have called RequestInformation() before
     * invoking this member function.
@@ -628,12 +635,19 @@ protected:
     vtkIntArray* refs, int otyp, int obj, SetInfoType* sinfo );
 
   /** Return an array for the specified cache key. If the array was not cached,
-    * read it from the file.
+    * read it from the file. The array stays valid until CloseFile().
     * This function can still return 0 if you are foolish enough to request an
     * array not present in the file, grasshopper.
     */
   vtkDataArray* GetCacheOrRead( vtkExodusIICacheKey );
 
+  /** Return the cache file ID for arrays of the given object type.
+    * Arrays that depend on reader settings (assembled global arrays,
+    * displaced coordinates, node ids subset by the point map) are never
+    * shared with other readers.
+    */
+  int GetCacheFileId( int objectType );
+
   /** Return the index of an object type (in a private list of all object types).
     * This returns a 0-based index if the object type was found and -1 if it
     * was not.
@@ -820,6 +834,18 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  /// When nonzero, Cache is the process-wide cache shared with other readers.
+  int UseGlobalCache;
+
+  /// File ID of arrays read straight from the open file (shared between readers).
+  int CacheFileId;
+
+  /// File ID of arrays that depend on this reader's settings.
+  int CachePrivateId;
+
+  /// References to the arrays returned by GetCacheOrRead(), released by CloseFile().
+  std::vector<vtkSmartPointer<vtkDataArray> > CacheReferences;
+
   int ApplyDisplacements;
   float DisplacementMagnitude;
   int HasModeShapes;
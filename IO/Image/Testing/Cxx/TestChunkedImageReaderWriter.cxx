@@ -0,0 +1,241 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestChunkedImageReaderWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Round trip an image through vtkChunkedImageWriter/vtkChunkedImageReader
+// and check that sub-extent requests only read the intersecting chunks, and
+// that a truncated file makes the reader fail.
+
+#include "vtkChunkedImageReader.h"
+#include "vtkChunkedImageWriter.h"
+#include "vtkExecutive.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkShortArray.h"
+#include "vtkTestUtilities.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+const int Dims[3] = { 40, 30, 20 };
+
+short ShortValue(int i, int j, int k)
+{
+  return static_cast<short>(i + 100 * j - 50 * k);
+}
+
+float FloatValue(int i, int j, int k, int c)
+{
+  return 0.5f * i + 2.f * j + 3.f * k + 1000.f * c;
+}
+
+// Check every point of the reader output against the source values.
+bool CheckOutput(vtkImageData* output, const int extent[6])
+{
+  int outExt[6];
+  output->GetExtent(outExt);
+  for (int a = 0; a < 6; ++a)
+  {
+    if (outExt[a] != extent[a])
+    {
+      cerr << "Unexpected output extent." << endl;
+      return false;
+    }
+  }
+  vtkShortArray* scalars =
+    vtkShortArray::SafeDownCast(output->GetPointData()->GetScalars());
+  vtkFloatArray* vectors =
+    vtkFloatArray::SafeDownCast(output->GetPointData()->GetArray("vectors"));
+  if (!scalars || !vectors || vectors->GetNumberOfComponents() != 3)
+  {
+    cerr << "Arrays were not read back." << endl;
+    return false;
+  }
+  vtkIdType id = 0;
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i, ++id)
+      {
+        if (scalars->GetValue(id) != ShortValue(i, j, k))
+        {
+          cerr << "Wrong scalar at " << i << " " << j << " " << k << endl;
+          return false;
+        }
+        for (int c = 0; c < 3; ++c)
+        {
+          if (vectors->GetTypedComponent(id, c) != FloatValue(i, j, k, c))
+          {
+            cerr << "Wrong vector at " << i << " " << j << " " << k << endl;
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestChunkedImageReaderWriter(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+  }
+  std::string fileName = std::string(tempDir) + "/TestChunkedImage.vtic";
+  delete[] tempDir;
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Dims[0], Dims[1], Dims[2]);
+  image->SetSpacing(0.5, 0.25, 2.0);
+  image->SetOrigin(1.0, 2.0, 3.0);
+  vtkNew<vtkShortArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(image->GetNumberOfPoints());
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(image->GetNumberOfPoints());
+  vtkIdType id = 0;
+  for (int k = 0; k < Dims[2]; ++k)
+  {
+    for (int j = 0; j < Dims[1]; ++j)
+    {
+      for (int i = 0; i < Dims[0]; ++i, ++id)
+      {
+        scalars->SetValue(id, ShortValue(i, j, k));
+        for (int c = 0; c < 3; ++c)
+        {
+          vectors->SetTypedComponent(id, c, FloatValue(i, j, k, c));
+        }
+      }
+    }
+  }
+  image->GetPointData()->SetScalars(scalars.GetPointer());
+  image->GetPointData()->AddArray(vectors.GetPointer());
+
+  int compressors[3] = { vtkChunkedImageWriter::NONE,
+                         vtkChunkedImageWriter::ZLIB,
+                         vtkChunkedImageWriter::LZ4 };
+  for (int c = 0; c < 3; ++c)
+  {
+    vtkNew<vtkChunkedImageWriter> writer;
+    writer->SetInputData(image.GetPointer());
+    writer->SetFileName(fileName.c_str());
+    writer->SetChunkDimensions(16, 16, 8);
+    writer->SetCompressorType(compressors[c]);
+    // Force several batches.
+    writer->SetMaximumBatchSize(16 * 16 * 8 * 4 * 3);
+    if (!writer->Write())
+    {
+      cerr << "Write failed." << endl;
+      return EXIT_FAILURE;
+    }
+
+    vtkNew<vtkChunkedImageReader> reader;
+    if (!reader->CanReadFile(fileName.c_str()))
+    {
+      cerr << "CanReadFile failed." << endl;
+      return EXIT_FAILURE;
+    }
+    reader->SetFileName(fileName.c_str());
+
+    // Whole extent: 3x2x3 chunks for each of the two arrays.
+    reader->Update();
+    int whole[6] = { 0, Dims[0] - 1, 0, Dims[1] - 1, 0, Dims[2] - 1 };
+    if (!CheckOutput(reader->GetOutput(), whole))
+    {
+      return EXIT_FAILURE;
+    }
+    if (reader->GetNumberOfChunksRead() != 2 * 18)
+    {
+      cerr << "Read " << reader->GetNumberOfChunksRead()
+           << " chunks for the whole extent, expected 36." << endl;
+      return EXIT_FAILURE;
+    }
+    double* spacing = reader->GetOutput()->GetSpacing();
+    double* origin = reader->GetOutput()->GetOrigin();
+    if (spacing[0] != 0.5 || spacing[2] != 2.0 || origin[1] != 2.0)
+    {
+      cerr << "Wrong geometry." << endl;
+      return EXIT_FAILURE;
+    }
+
+    // A VOI inside a single chunk only reads that chunk. The reader is
+    // marked modified since a smaller request would otherwise be served
+    // from the previous output.
+    int voi[6] = { 17, 30, 1, 14, 9, 12 };
+    reader->Modified();
+    reader->UpdateExtent(voi);
+    if (!CheckOutput(reader->GetOutput(), voi))
+    {
+      return EXIT_FAILURE;
+    }
+    if (reader->GetNumberOfChunksRead() != 2)
+    {
+      cerr << "Read " << reader->GetNumberOfChunksRead()
+           << " chunks for a single chunk VOI, expected 2." << endl;
+      return EXIT_FAILURE;
+    }
+
+    // A VOI straddling chunk boundaries reads 2x2x2 chunks per array.
+    int straddle[6] = { 10, 20, 12, 20, 5, 10 };
+    reader->Modified();
+    reader->UpdateExtent(straddle);
+    if (!CheckOutput(reader->GetOutput(), straddle))
+    {
+      return EXIT_FAILURE;
+    }
+    if (reader->GetNumberOfChunksRead() != 2 * 8)
+    {
+      cerr << "Read " << reader->GetNumberOfChunksRead()
+           << " chunks for a straddling VOI, expected 16." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Drop the end of the last chunk: every chunk is visited, and the request
+  // fails.
+  std::string contents;
+  {
+    std::ifstream in(fileName.c_str(), std::ios::in | std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(in),
+                    std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream out(fileName.c_str(), std::ios::out | std::ios::binary);
+    out.write(contents.data(), contents.size() - 16);
+  }
+  vtkNew<vtkChunkedImageReader> reader;
+  reader->SetFileName(fileName.c_str());
+  vtkObject::GlobalWarningDisplayOff();
+  int status = reader->GetExecutive()->Update();
+  vtkObject::GlobalWarningDisplayOn();
+  if (status || reader->GetNumberOfChunksRead() != 2 * 18)
+  {
+    cerr << "Reading a truncated file did not fail." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
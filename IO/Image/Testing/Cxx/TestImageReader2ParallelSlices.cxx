@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageReader2ParallelSlices.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write a stack of 2D slices and check that reading them with
+// ParallelSliceReading on gives the same volume as the serial path.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageReader2.h"
+#include "vtkImageWriter.h"
+#include "vtkJPEGReader.h"
+#include "vtkJPEGWriter.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+
+#include <cstring>
+#include <string>
+
+namespace
+{
+bool SameScalars(vtkImageData* a, vtkImageData* b)
+{
+  vtkDataArray* sa = a->GetPointData()->GetScalars();
+  vtkDataArray* sb = b->GetPointData()->GetScalars();
+  if (!sa || !sb || sa->GetDataSize() != sb->GetDataSize() ||
+      sa->GetDataType() != sb->GetDataType())
+  {
+    return false;
+  }
+  return memcmp(sa->GetVoidPointer(0), sb->GetVoidPointer(0),
+                sa->GetDataSize() * sa->GetDataTypeSize()) == 0;
+}
+}
+
+int TestImageReader2ParallelSlices(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+  }
+  std::string prefix = std::string(tempDir) + "/TestImageReader2ParallelSlices";
+  delete[] tempDir;
+
+  const int dims[3] = { 64, 48, 12 };
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(dims[0], dims[1], dims[2]);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  unsigned char* ptr = static_cast<unsigned char*>(image->GetScalarPointer());
+  for (int k = 0; k < dims[2]; ++k)
+  {
+    for (int j = 0; j < dims[1]; ++j)
+    {
+      for (int i = 0; i < dims[0]; ++i)
+      {
+        *ptr++ = static_cast<unsigned char>((i + 3 * j + 17 * k) % 256);
+      }
+    }
+  }
+
+  // Raw slices through the base class.
+  vtkNew<vtkImageWriter> rawWriter;
+  rawWriter->SetInputData(image.GetPointer());
+  rawWriter->SetFileDimensionality(2);
+  rawWriter->SetFilePrefix(prefix.c_str());
+  rawWriter->SetFilePattern("%s.%d.raw");
+  rawWriter->Write();
+
+  for (int parallel = 0; parallel < 2; ++parallel)
+  {
+    vtkNew<vtkImageReader2> reader;
+    reader->SetFilePrefix(prefix.c_str());
+    reader->SetFilePattern("%s.%d.raw");
+    reader->SetFileDimensionality(2);
+    reader->SetDataScalarTypeToUnsignedChar();
+    reader->SetNumberOfScalarComponents(1);
+    reader->SetDataExtent(0, dims[0] - 1, 0, dims[1] - 1, 0, dims[2] - 1);
+    reader->SetParallelSliceReading(parallel);
+    reader->Update();
+    if (!SameScalars(image.GetPointer(), reader->GetOutput()))
+    {
+      cerr << "Raw slices differ with ParallelSliceReading=" << parallel << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // JPEG slices; decoding is lossy so compare the two reading paths.
+  vtkNew<vtkJPEGWriter> jpegWriter;
+  jpegWriter->SetInputData(image.GetPointer());
+  jpegWriter->SetFilePrefix(prefix.c_str());
+  jpegWriter->SetFilePattern("%s.%d.jpg");
+  jpegWriter->Write();
+
+  vtkNew<vtkJPEGReader> serialReader;
+  serialReader->SetFilePrefix(prefix.c_str());
+  serialReader->SetFilePattern("%s.%d.jpg");
+  serialReader->SetDataExtent(0, dims[0] - 1, 0, dims[1] - 1, 0, dims[2] - 1);
+  serialReader->Update();
+
+  vtkNew<vtkJPEGReader> parallelReader;
+  parallelReader->SetFilePrefix(prefix.c_str());
+  parallelReader->SetFilePattern("%s.%d.jpg");
+  parallelReader->SetDataExtent(0, dims[0] - 1, 0, dims[1] - 1, 0, dims[2] - 1);
+  parallelReader->ParallelSliceReadingOn();
+  parallelReader->Update();
+
+  int* ext = parallelReader->GetOutput()->GetExtent();
+  if (ext[5] - ext[4] + 1 != dims[2])
+  {
+    cerr << "Unexpected number of JPEG slices read." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!SameScalars(serialReader->GetOutput(), parallelReader->GetOutput()))
+  {
+    cerr << "JPEG slices differ between serial and parallel reading." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
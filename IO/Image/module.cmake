@@ -16,6 +16,7 @@ vtk_module(vtkIOImage
   DEPENDS
     vtkCommonCore
     vtkCommonExecutionModel
+    vtkIOCore
   PRIVATE_DEPENDS
     vtkCommonDataModel
     vtkCommonMath
@@ -0,0 +1,461 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkChunkedImageReader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkChunkedImageReader.h"
+
+#include "vtkByteSwap.h"
+#include "vtkDataArray.h"
+#include "vtkDataCompressor.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkZLibDataCompressor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkChunkedImageReader);
+
+namespace
+{
+const char vtkChunkedImageMagic[8] = { 'v', 't', 'k', 'C', 'h', 'u', 'n', 'k' };
+const vtkTypeUInt32 vtkChunkedImageVersion = 1;
+
+// Convert a buffer of words between file (little endian) and host order.
+void vtkChunkedImageSwapLE(void *buffer, size_t numWords, size_t wordSize)
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  if (wordSize > 1)
+  {
+    vtkByteSwap::SwapVoidRange(buffer, numWords, wordSize);
+  }
+#else
+  (void)buffer;
+  (void)numWords;
+  (void)wordSize;
+#endif
+}
+
+template <class T>
+bool vtkChunkedImageReadLE(istream& is, T *values, size_t num)
+{
+  is.read(reinterpret_cast<char*>(values), num * sizeof(T));
+  vtkChunkedImageSwapLE(values, num, sizeof(T));
+  return !is.fail();
+}
+}
+
+class vtkChunkedImageReaderInternals
+{
+public:
+  struct ArrayInfo
+  {
+    int DataType;
+    int NumberOfComponents;
+    int IsScalars;
+    std::string Name;
+  };
+
+  vtkTypeUInt32 CompressorType;
+  int WholeExtent[6];
+  double Origin[3];
+  double Spacing[3];
+  int NumberOfChunks[3];
+  std::vector<ArrayInfo> Arrays;
+  // (offset, compressed size) for every array and chunk.
+  std::vector<vtkTypeUInt64> ChunkTable;
+
+  vtkIdType GetTotalNumberOfChunks() const
+  {
+    return static_cast<vtkIdType>(this->NumberOfChunks[0]) *
+      this->NumberOfChunks[1] * this->NumberOfChunks[2];
+  }
+};
+
+namespace
+{
+// Reads, decompresses and scatters one (array, chunk) pair per task into the
+// output arrays. Each invocation uses its own stream.
+class vtkChunkedImageReadFunctor
+{
+public:
+  vtkChunkedImageReader *Self;
+  const char *FileName;
+  const vtkChunkedImageReaderInternals *Internals;
+  vtkDataCompressor *Compressor;
+  int ChunkDimensions[3];
+  int UpdateExtent[6];
+  std::vector<vtkDataArray*> OutputArrays;
+  std::vector<vtkIdType> Chunks;
+  std::vector<char> *Failed;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    ifstream is(this->FileName, ios::in | ios::binary);
+    std::vector<unsigned char> compressed;
+    std::vector<unsigned char> brick;
+    vtkIdType numChunks = static_cast<vtkIdType>(this->Chunks.size());
+    const int *whole = this->Internals->WholeExtent;
+    const int *nc = this->Internals->NumberOfChunks;
+    const int *uExt = this->UpdateExtent;
+
+    for (vtkIdType task = begin; task < end; ++task)
+    {
+      if (!is.is_open() || this->Self->GetAbortExecute())
+      {
+        (*this->Failed)[task] = 1;
+        continue;
+      }
+      size_t arrayIdx = static_cast<size_t>(task / numChunks);
+      vtkIdType chunk = this->Chunks[task % numChunks];
+      vtkDataArray *array = this->OutputArrays[arrayIdx];
+      size_t wordSize = array->GetDataTypeSize();
+      size_t tupleSize = wordSize * array->GetNumberOfComponents();
+
+      int c[3];
+      c[0] = static_cast<int>(chunk % nc[0]);
+      c[1] = static_cast<int>((chunk / nc[0]) % nc[1]);
+      c[2] = static_cast<int>(chunk / (static_cast<vtkIdType>(nc[0]) * nc[1]));
+      int lo[3], n[3], first[3], last[3];
+      for (int a = 0; a < 3; ++a)
+      {
+        lo[a] = whole[2*a] + c[a] * this->ChunkDimensions[a];
+        n[a] = std::min(this->ChunkDimensions[a], whole[2*a+1] - lo[a] + 1);
+        first[a] = std::max(lo[a], uExt[2*a]);
+        last[a] = std::min(lo[a] + n[a] - 1, uExt[2*a+1]);
+      }
+
+      size_t entry = 2 * (arrayIdx * this->Internals->GetTotalNumberOfChunks() + chunk);
+      vtkTypeUInt64 offset = this->Internals->ChunkTable[entry];
+      size_t size = static_cast<size_t>(this->Internals->ChunkTable[entry + 1]);
+      brick.resize(tupleSize * n[0] * n[1] * n[2]);
+      compressed.resize(size);
+      is.seekg(static_cast<std::streamoff>(offset));
+      is.read(reinterpret_cast<char*>(compressed.data()), size);
+      if (!is)
+      {
+        // Clear the fail state so that the next chunks can still be read
+        is.clear();
+        (*this->Failed)[task] = 1;
+        continue;
+      }
+      if (this->Compressor)
+      {
+        if (this->Compressor->Uncompress(compressed.data(), size, brick.data(),
+                                         brick.size()) != brick.size())
+        {
+          (*this->Failed)[task] = 1;
+          continue;
+        }
+      }
+      else if (size == brick.size())
+      {
+        brick.swap(compressed);
+      }
+      else
+      {
+        (*this->Failed)[task] = 1;
+        continue;
+      }
+      vtkChunkedImageSwapLE(brick.data(), brick.size() / wordSize, wordSize);
+
+      unsigned char *out = static_cast<unsigned char*>(array->GetVoidPointer(0));
+      size_t rowSize = (last[0] - first[0] + 1) * tupleSize;
+      vtkIdType outDims[2] = { uExt[1] - uExt[0] + 1, uExt[3] - uExt[2] + 1 };
+      for (int k = first[2]; k <= last[2]; ++k)
+      {
+        for (int j = first[1]; j <= last[1]; ++j)
+        {
+          size_t src = ((static_cast<size_t>(k - lo[2]) * n[1] + (j - lo[1])) *
+                        n[0] + (first[0] - lo[0])) * tupleSize;
+          size_t dst = ((static_cast<size_t>(k - uExt[4]) * outDims[1] +
+                         (j - uExt[2])) * outDims[0] + (first[0] - uExt[0])) * tupleSize;
+          memcpy(out + dst, brick.data() + src, rowSize);
+        }
+      }
+    }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+vtkChunkedImageReader::vtkChunkedImageReader()
+{
+  this->SetNumberOfInputPorts(0);
+  this->FileName = nullptr;
+  this->ChunkDimensions[0] = this->ChunkDimensions[1] =
+    this->ChunkDimensions[2] = 0;
+  this->NumberOfChunksRead = 0;
+  this->Internals = new vtkChunkedImageReaderInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkChunkedImageReader::~vtkChunkedImageReader()
+{
+  this->SetFileName(nullptr);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+int vtkChunkedImageReader::CanReadFile(const char* fname)
+{
+  ifstream is(fname, ios::in | ios::binary);
+  char magic[8];
+  if (!is || !is.read(magic, sizeof(magic)))
+  {
+    return 0;
+  }
+  return memcmp(magic, vtkChunkedImageMagic, sizeof(magic)) == 0 ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkChunkedImageReader::ReadHeader()
+{
+  if (!this->FileName)
+  {
+    vtkErrorMacro("A FileName must be specified.");
+    return 0;
+  }
+  ifstream is(this->FileName, ios::in | ios::binary);
+  if (!is)
+  {
+    vtkErrorMacro("Unable to open file " << this->FileName);
+    return 0;
+  }
+
+  char magic[8];
+  vtkTypeUInt32 version = 0;
+  is.read(magic, sizeof(magic));
+  if (!is || memcmp(magic, vtkChunkedImageMagic, sizeof(magic)) != 0 ||
+      !vtkChunkedImageReadLE(is, &version, 1) || version != vtkChunkedImageVersion)
+  {
+    vtkErrorMacro("File " << this->FileName << " is not a chunked image file.");
+    return 0;
+  }
+
+  vtkChunkedImageReaderInternals *internals = this->Internals;
+  int numArrays = 0;
+  if (!vtkChunkedImageReadLE(is, &internals->CompressorType, 1) ||
+      !vtkChunkedImageReadLE(is, internals->WholeExtent, 6) ||
+      !vtkChunkedImageReadLE(is, internals->Origin, 3) ||
+      !vtkChunkedImageReadLE(is, internals->Spacing, 3) ||
+      !vtkChunkedImageReadLE(is, this->ChunkDimensions, 3) ||
+      !vtkChunkedImageReadLE(is, &numArrays, 1) ||
+      internals->CompressorType > vtkTypeUInt32(2) || numArrays < 0)
+  {
+    vtkErrorMacro("Error reading header of " << this->FileName);
+    return 0;
+  }
+  for (int a = 0; a < 3; ++a)
+  {
+    if (this->ChunkDimensions[a] < 1)
+    {
+      vtkErrorMacro("Invalid chunk dimensions in " << this->FileName);
+      return 0;
+    }
+    int dim = internals->WholeExtent[2*a+1] - internals->WholeExtent[2*a] + 1;
+    internals->NumberOfChunks[a] = std::max(
+      0, (dim + this->ChunkDimensions[a] - 1) / this->ChunkDimensions[a]);
+  }
+
+  internals->Arrays.resize(numArrays);
+  for (int i = 0; i < numArrays; ++i)
+  {
+    vtkChunkedImageReaderInternals::ArrayInfo& info = internals->Arrays[i];
+    vtkTypeUInt32 nameLength = 0;
+    if (!vtkChunkedImageReadLE(is, &info.DataType, 1) ||
+        !vtkChunkedImageReadLE(is, &info.NumberOfComponents, 1) ||
+        !vtkChunkedImageReadLE(is, &info.IsScalars, 1) ||
+        !vtkChunkedImageReadLE(is, &nameLength, 1))
+    {
+      vtkErrorMacro("Error reading array description in " << this->FileName);
+      return 0;
+    }
+    info.Name.resize(nameLength);
+    if (nameLength > 0 && !is.read(&info.Name[0], nameLength))
+    {
+      vtkErrorMacro("Error reading array name in " << this->FileName);
+      return 0;
+    }
+  }
+
+  internals->ChunkTable.resize(
+    2 * internals->Arrays.size() * internals->GetTotalNumberOfChunks());
+  if (!internals->ChunkTable.empty() &&
+      !vtkChunkedImageReadLE(is, internals->ChunkTable.data(),
+                             internals->ChunkTable.size()))
+  {
+    vtkErrorMacro("Error reading chunk table in " << this->FileName);
+    return 0;
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkChunkedImageReader::RequestInformation(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  if (!this->ReadHeader())
+  {
+    return 0;
+  }
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(),
+               this->Internals->WholeExtent, 6);
+  outInfo->Set(vtkDataObject::SPACING(), this->Internals->Spacing, 3);
+  outInfo->Set(vtkDataObject::ORIGIN(), this->Internals->Origin, 3);
+  outInfo->Set(vtkAlgorithm::CAN_PRODUCE_SUB_EXTENT(), 1);
+  for (size_t i = 0; i < this->Internals->Arrays.size(); ++i)
+  {
+    if (this->Internals->Arrays[i].IsScalars)
+    {
+      vtkDataObject::SetPointDataActiveScalarInfo(
+        outInfo, this->Internals->Arrays[i].DataType,
+        this->Internals->Arrays[i].NumberOfComponents);
+    }
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkChunkedImageReader::RequestData(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  this->NumberOfChunksRead = 0;
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* output = vtkImageData::SafeDownCast(
+    outInfo->Get(vtkDataObject::DATA_OBJECT()));
+  int uExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), uExt);
+  output->SetExtent(uExt);
+  output->SetOrigin(this->Internals->Origin);
+  output->SetSpacing(this->Internals->Spacing);
+  if (uExt[0] > uExt[1] || uExt[2] > uExt[3] || uExt[4] > uExt[5])
+  {
+    return 1;
+  }
+
+  vtkChunkedImageReadFunctor functor;
+  functor.Self = this;
+  functor.FileName = this->FileName;
+  functor.Internals = this->Internals;
+  for (int a = 0; a < 6; ++a)
+  {
+    functor.UpdateExtent[a] = uExt[a];
+  }
+  for (int a = 0; a < 3; ++a)
+  {
+    functor.ChunkDimensions[a] = this->ChunkDimensions[a];
+  }
+
+  vtkIdType numPoints = output->GetNumberOfPoints();
+  vtkPointData* pd = output->GetPointData();
+  for (size_t i = 0; i < this->Internals->Arrays.size(); ++i)
+  {
+    const vtkChunkedImageReaderInternals::ArrayInfo& info =
+      this->Internals->Arrays[i];
+    vtkDataArray* array = vtkDataArray::CreateDataArray(info.DataType);
+    if (!array)
+    {
+      // The arrays index the chunk table: stop rather than shift them
+      vtkErrorMacro("Unsupported data type " << info.DataType);
+      return 0;
+    }
+    array->SetName(info.Name.empty() ? nullptr : info.Name.c_str());
+    array->SetNumberOfComponents(info.NumberOfComponents);
+    array->SetNumberOfTuples(numPoints);
+    if (info.IsScalars)
+    {
+      pd->SetScalars(array);
+    }
+    else
+    {
+      pd->AddArray(array);
+    }
+    array->Delete();
+    functor.OutputArrays.push_back(array);
+  }
+
+  // Only the chunks that intersect the update extent are visited.
+  const int* whole = this->Internals->WholeExtent;
+  int first[3], last[3];
+  for (int a = 0; a < 3; ++a)
+  {
+    first[a] = (std::max(uExt[2*a], whole[2*a]) - whole[2*a]) /
+      this->ChunkDimensions[a];
+    last[a] = (std::min(uExt[2*a+1], whole[2*a+1]) - whole[2*a]) /
+      this->ChunkDimensions[a];
+  }
+  const int* nc = this->Internals->NumberOfChunks;
+  for (int k = first[2]; k <= last[2]; ++k)
+  {
+    for (int j = first[1]; j <= last[1]; ++j)
+    {
+      for (int i = first[0]; i <= last[0]; ++i)
+      {
+        functor.Chunks.push_back(
+          (static_cast<vtkIdType>(k) * nc[1] + j) * nc[0] + i);
+      }
+    }
+  }
+
+  vtkSmartPointer<vtkDataCompressor> compressor;
+  if (this->Internals->CompressorType == 1)
+  {
+    compressor = vtkSmartPointer<vtkZLibDataCompressor>::New();
+  }
+  else if (this->Internals->CompressorType == 2)
+  {
+    compressor = vtkSmartPointer<vtkLZ4DataCompressor>::New();
+  }
+  functor.Compressor = compressor;
+
+  vtkIdType numTasks = static_cast<vtkIdType>(
+    functor.Chunks.size() * functor.OutputArrays.size());
+  std::vector<char> failed(numTasks, 0);
+  functor.Failed = &failed;
+  vtkSMPTools::For(0, numTasks, functor);
+  this->NumberOfChunksRead = numTasks;
+
+  this->UpdateProgress(1.0);
+  if (std::find(failed.begin(), failed.end(), 1) != failed.end() &&
+      !this->GetAbortExecute())
+  {
+    vtkErrorMacro("Error reading chunks from " << this->FileName);
+    return 0;
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkChunkedImageReader::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "FileName: "
+     << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "ChunkDimensions: " << this->ChunkDimensions[0] << " "
+     << this->ChunkDimensions[1] << " " << this->ChunkDimensions[2] << "\n";
+  os << indent << "NumberOfChunksRead: " << this->NumberOfChunksRead << "\n";
+}
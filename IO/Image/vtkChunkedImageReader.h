@@ -0,0 +1,101 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkChunkedImageReader.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkChunkedImageReader
+ * @brief   read sub-extents of images written by vtkChunkedImageWriter
+ *
+ * vtkChunkedImageReader reads the chunked, compressed image files produced
+ * by vtkChunkedImageWriter. The reader can produce any sub-extent: the
+ * update extent requested by the pipeline is mapped onto the chunk grid and
+ * only the intersecting chunks are read and decompressed, so extracting a
+ * small volume of interest from a very large file touches only a small part
+ * of it. Chunks are decoded in parallel with vtkSMPTools.
+ *
+ * All point data arrays stored in the file are read; the array that was
+ * the active scalars when the file was written becomes the active scalars
+ * of the output.
+ *
+ * @sa
+ * vtkChunkedImageWriter
+*/
+
+#ifndef vtkChunkedImageReader_h
+#define vtkChunkedImageReader_h
+
+#include "vtkIOImageModule.h" // For export macro
+#include "vtkImageAlgorithm.h"
+
+class vtkChunkedImageReaderInternals;
+
+class VTKIOIMAGE_EXPORT vtkChunkedImageReader : public vtkImageAlgorithm
+{
+public:
+  static vtkChunkedImageReader *New();
+  vtkTypeMacro(vtkChunkedImageReader,vtkImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Specify file name of the chunked image file to read.
+   */
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+  //@}
+
+  /**
+   * Return 1 if the file looks like a file written by
+   * vtkChunkedImageWriter, 0 otherwise.
+   */
+  virtual int CanReadFile(const char* fname);
+
+  /**
+   * Get the chunk dimensions of the file. Valid after UpdateInformation().
+   */
+  vtkGetVector3Macro(ChunkDimensions, int);
+
+  /**
+   * Get the number of chunks read and decompressed by the last execution,
+   * counting every array separately.
+   */
+  vtkGetMacro(NumberOfChunksRead, vtkIdType);
+
+protected:
+  vtkChunkedImageReader();
+  ~vtkChunkedImageReader() override;
+
+  int RequestInformation(vtkInformation* request,
+                         vtkInformationVector** inputVector,
+                         vtkInformationVector* outputVector) override;
+  int RequestData(vtkInformation* request,
+                  vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector) override;
+
+  /**
+   * Read the file header and chunk table into the internal state.
+   */
+  int ReadHeader();
+
+  char* FileName;
+  int ChunkDimensions[3];
+  vtkIdType NumberOfChunksRead;
+
+  vtkChunkedImageReaderInternals* Internals;
+
+private:
+  vtkChunkedImageReader(const vtkChunkedImageReader&) = delete;
+  void operator=(const vtkChunkedImageReader&) = delete;
+};
+
+#endif
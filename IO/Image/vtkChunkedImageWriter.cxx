@@ -0,0 +1,351 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkChunkedImageWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkChunkedImageWriter.h"
+
+#include "vtkByteSwap.h"
+#include "vtkDataArray.h"
+#include "vtkDataCompressor.h"
+#include "vtkErrorCode.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkLZ4DataCompressor.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkZLibDataCompressor.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+vtkStandardNewMacro(vtkChunkedImageWriter);
+
+namespace
+{
+const char vtkChunkedImageMagic[8] = { 'v', 't', 'k', 'C', 'h', 'u', 'n', 'k' };
+const vtkTypeUInt32 vtkChunkedImageVersion = 1;
+
+// Convert a buffer of words between host and file (little endian) order.
+void vtkChunkedImageSwapLE(void *buffer, size_t numWords, size_t wordSize)
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  if (wordSize > 1)
+  {
+    vtkByteSwap::SwapVoidRange(buffer, numWords, wordSize);
+  }
+#else
+  (void)buffer;
+  (void)numWords;
+  (void)wordSize;
+#endif
+}
+
+template <class T>
+void vtkChunkedImageWriteLE(ostream& os, const T *values, size_t num)
+{
+  std::vector<T> tmp(values, values + num);
+  vtkChunkedImageSwapLE(tmp.data(), num, sizeof(T));
+  os.write(reinterpret_cast<const char*>(tmp.data()), num * sizeof(T));
+}
+
+template <class T>
+void vtkChunkedImageWriteLE(ostream& os, T value)
+{
+  vtkChunkedImageWriteLE(os, &value, 1);
+}
+
+// Compresses the chunks [BatchStart, BatchStart + n) of one array into
+// Buffers. Each chunk is gathered into a contiguous brick first. Chunks
+// that could not be compressed are flagged in Failed.
+class vtkChunkedImageCompressFunctor
+{
+public:
+  const unsigned char *Data;
+  int Dimensions[3];
+  int ChunkDimensions[3];
+  int NumberOfChunks[3];
+  size_t TupleSize;
+  size_t WordSize;
+  vtkIdType BatchStart;
+  vtkDataCompressor *Compressor;
+  std::vector<std::vector<unsigned char> > *Buffers;
+  std::vector<char> *Failed;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<unsigned char> brick;
+    for (vtkIdType idx = begin; idx < end; ++idx)
+    {
+      vtkIdType chunk = this->BatchStart + idx;
+      int c[3];
+      c[0] = static_cast<int>(chunk % this->NumberOfChunks[0]);
+      c[1] = static_cast<int>((chunk / this->NumberOfChunks[0]) %
+                              this->NumberOfChunks[1]);
+      c[2] = static_cast<int>(chunk / (static_cast<vtkIdType>(this->NumberOfChunks[0]) *
+                                       this->NumberOfChunks[1]));
+      int lo[3], n[3];
+      for (int a = 0; a < 3; ++a)
+      {
+        lo[a] = c[a] * this->ChunkDimensions[a];
+        n[a] = std::min(this->ChunkDimensions[a], this->Dimensions[a] - lo[a]);
+      }
+
+      size_t rowSize = n[0] * this->TupleSize;
+      brick.resize(rowSize * n[1] * n[2]);
+      unsigned char *dst = brick.data();
+      for (int k = 0; k < n[2]; ++k)
+      {
+        for (int j = 0; j < n[1]; ++j)
+        {
+          size_t src = ((static_cast<size_t>(lo[2] + k) * this->Dimensions[1] +
+                         (lo[1] + j)) * this->Dimensions[0] + lo[0]) * this->TupleSize;
+          memcpy(dst, this->Data + src, rowSize);
+          dst += rowSize;
+        }
+      }
+      vtkChunkedImageSwapLE(brick.data(), brick.size() / this->WordSize,
+                            this->WordSize);
+
+      std::vector<unsigned char>& out = (*this->Buffers)[idx];
+      if (this->Compressor)
+      {
+        out.resize(this->Compressor->GetMaximumCompressionSpace(brick.size()));
+        size_t size = this->Compressor->Compress(brick.data(), brick.size(),
+                                                 out.data(), out.size());
+        out.resize(size);
+        if (size == 0)
+        {
+          (*this->Failed)[idx] = 1;
+        }
+      }
+      else
+      {
+        out.swap(brick);
+      }
+    }
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+vtkChunkedImageWriter::vtkChunkedImageWriter()
+{
+  this->FileName = nullptr;
+  this->ChunkDimensions[0] = 64;
+  this->ChunkDimensions[1] = 64;
+  this->ChunkDimensions[2] = 64;
+  this->CompressorType = ZLIB;
+  this->MaximumBatchSize = 64 * 1024 * 1024;
+}
+
+//----------------------------------------------------------------------------
+vtkChunkedImageWriter::~vtkChunkedImageWriter()
+{
+  this->SetFileName(nullptr);
+}
+
+//----------------------------------------------------------------------------
+vtkImageData* vtkChunkedImageWriter::GetInput()
+{
+  return vtkImageData::SafeDownCast(this->Superclass::GetInput());
+}
+
+//----------------------------------------------------------------------------
+vtkImageData* vtkChunkedImageWriter::GetInput(int port)
+{
+  return vtkImageData::SafeDownCast(this->Superclass::GetInput(port));
+}
+
+//----------------------------------------------------------------------------
+int vtkChunkedImageWriter::FillInputPortInformation(int, vtkInformation *info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkImageData");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkChunkedImageWriter::WriteData()
+{
+  this->SetErrorCode(vtkErrorCode::NoError);
+
+  vtkImageData *input = this->GetInput();
+  if (!input)
+  {
+    vtkErrorMacro("No input provided.");
+    return;
+  }
+  if (!this->FileName)
+  {
+    vtkErrorMacro("A FileName must be specified.");
+    this->SetErrorCode(vtkErrorCode::NoFileNameError);
+    return;
+  }
+  for (int a = 0; a < 3; ++a)
+  {
+    if (this->ChunkDimensions[a] < 1)
+    {
+      vtkErrorMacro("ChunkDimensions must be positive.");
+      return;
+    }
+  }
+
+  // Only fixed size numeric arrays can be chunked.
+  vtkPointData *pd = input->GetPointData();
+  std::vector<vtkDataArray*> arrays;
+  for (int i = 0; i < pd->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray *array = pd->GetArray(i);
+    if (array && array->GetDataType() != VTK_BIT)
+    {
+      arrays.push_back(array);
+    }
+  }
+
+  int extent[6];
+  input->GetExtent(extent);
+  int dims[3];
+  int numChunks[3];
+  for (int a = 0; a < 3; ++a)
+  {
+    dims[a] = extent[2*a+1] - extent[2*a] + 1;
+    numChunks[a] = (dims[a] + this->ChunkDimensions[a] - 1) /
+      this->ChunkDimensions[a];
+  }
+  vtkIdType totalChunks = static_cast<vtkIdType>(numChunks[0]) *
+    numChunks[1] * numChunks[2];
+
+  vtkSmartPointer<vtkDataCompressor> compressor;
+  if (this->CompressorType == ZLIB)
+  {
+    compressor = vtkSmartPointer<vtkZLibDataCompressor>::New();
+  }
+  else if (this->CompressorType == LZ4)
+  {
+    compressor = vtkSmartPointer<vtkLZ4DataCompressor>::New();
+  }
+
+  ofstream os(this->FileName, ios::out | ios::binary);
+  if (!os)
+  {
+    vtkErrorMacro("Unable to open file " << this->FileName);
+    this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+    return;
+  }
+
+  os.write(vtkChunkedImageMagic, sizeof(vtkChunkedImageMagic));
+  vtkChunkedImageWriteLE(os, vtkChunkedImageVersion);
+  vtkChunkedImageWriteLE(os, static_cast<vtkTypeUInt32>(this->CompressorType));
+  vtkChunkedImageWriteLE(os, extent, 6);
+  vtkChunkedImageWriteLE(os, input->GetOrigin(), 3);
+  vtkChunkedImageWriteLE(os, input->GetSpacing(), 3);
+  vtkChunkedImageWriteLE(os, this->ChunkDimensions, 3);
+  vtkChunkedImageWriteLE(os, static_cast<int>(arrays.size()));
+  for (size_t i = 0; i < arrays.size(); ++i)
+  {
+    const char *name = arrays[i]->GetName() ? arrays[i]->GetName() : "";
+    vtkChunkedImageWriteLE(os, arrays[i]->GetDataType());
+    vtkChunkedImageWriteLE(os, arrays[i]->GetNumberOfComponents());
+    vtkChunkedImageWriteLE(os, arrays[i] == pd->GetScalars() ? 1 : 0);
+    vtkChunkedImageWriteLE(os, static_cast<vtkTypeUInt32>(strlen(name)));
+    os.write(name, strlen(name));
+  }
+
+  // Reserve the chunk table; it is filled in once the payloads are written.
+  std::vector<vtkTypeUInt64> table(2 * arrays.size() * totalChunks, 0);
+  std::streamoff tableOffset = os.tellp();
+  vtkChunkedImageWriteLE(os, table.data(), table.size());
+
+  for (size_t i = 0; i < arrays.size() && os; ++i)
+  {
+    vtkDataArray *array = arrays[i];
+    vtkChunkedImageCompressFunctor functor;
+    functor.Data = static_cast<const unsigned char*>(array->GetVoidPointer(0));
+    functor.WordSize = array->GetDataTypeSize();
+    functor.TupleSize = functor.WordSize * array->GetNumberOfComponents();
+    functor.Compressor = compressor;
+    for (int a = 0; a < 3; ++a)
+    {
+      functor.Dimensions[a] = dims[a];
+      functor.ChunkDimensions[a] = this->ChunkDimensions[a];
+      functor.NumberOfChunks[a] = numChunks[a];
+    }
+
+    vtkIdType chunkBytes = static_cast<vtkIdType>(functor.TupleSize) *
+      this->ChunkDimensions[0] * this->ChunkDimensions[1] *
+      this->ChunkDimensions[2];
+    vtkIdType batchSize = std::max<vtkIdType>(
+      1, this->MaximumBatchSize / std::max<vtkIdType>(chunkBytes, 1));
+    std::vector<std::vector<unsigned char> > buffers;
+    std::vector<char> failed;
+    functor.Buffers = &buffers;
+    functor.Failed = &failed;
+
+    for (vtkIdType start = 0; start < totalChunks && os; start += batchSize)
+    {
+      vtkIdType n = std::min(batchSize, totalChunks - start);
+      buffers.clear();
+      buffers.resize(n);
+      failed.assign(n, 0);
+      functor.BatchStart = start;
+      vtkSMPTools::For(0, n, 1, functor);
+      if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+      {
+        // An empty payload would be read back as a corrupted chunk
+        vtkErrorMacro("Error compressing chunks of array " << i << " for "
+                      << this->FileName);
+        this->SetErrorCode(vtkErrorCode::UnknownError);
+        os.close();
+        vtksys::SystemTools::RemoveFile(this->FileName);
+        return;
+      }
+
+      for (vtkIdType c = 0; c < n; ++c)
+      {
+        size_t entry = 2 * (i * totalChunks + start + c);
+        table[entry] = static_cast<vtkTypeUInt64>(os.tellp());
+        table[entry + 1] = buffers[c].size();
+        os.write(reinterpret_cast<const char*>(buffers[c].data()),
+                 buffers[c].size());
+      }
+      this->UpdateProgress(
+        (i + static_cast<double>(start + n) / totalChunks) / arrays.size());
+    }
+  }
+
+  os.seekp(tableOffset);
+  vtkChunkedImageWriteLE(os, table.data(), table.size());
+  os.flush();
+  if (os.fail())
+  {
+    vtkErrorMacro("Error writing file " << this->FileName);
+    this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkChunkedImageWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "FileName: "
+     << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "ChunkDimensions: " << this->ChunkDimensions[0] << " "
+     << this->ChunkDimensions[1] << " " << this->ChunkDimensions[2] << "\n";
+  os << indent << "CompressorType: " << this->CompressorType << "\n";
+  os << indent << "MaximumBatchSize: " << this->MaximumBatchSize << "\n";
+}
@@ -0,0 +1,147 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkChunkedImageWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkChunkedImageWriter
+ * @brief   write image data as independently compressed chunks
+ *
+ * vtkChunkedImageWriter writes the point data arrays of a vtkImageData to a
+ * single binary file in which every array is split into bricks of
+ * ChunkDimensions points. Each brick is compressed on its own and its
+ * location is recorded in an index table at the start of the file, so that
+ * vtkChunkedImageReader can satisfy an update extent by reading and
+ * decompressing only the bricks that intersect it.
+ *
+ * The file layout is, all values little endian:
+ *
+ *    char[8]   "vtkChunk"
+ *    uint32    format version (1)
+ *    uint32    compressor (0 none, 1 zlib, 2 lz4)
+ *    int32[6]  whole extent
+ *    double[3] origin
+ *    double[3] spacing
+ *    int32[3]  chunk dimensions
+ *    int32     number of arrays
+ *    per array: int32 data type, int32 components, int32 is-scalars,
+ *               uint32 name length, name characters
+ *    uint64[2] (offset, compressed size) per array per chunk
+ *    compressed chunk payloads
+ *
+ * Chunks are numbered with i varying fastest. Chunks on the upper
+ * boundary of the extent are truncated rather than padded. Chunks are
+ * compressed in parallel with vtkSMPTools, a batch at a time, so that the
+ * amount of compressed data held in memory stays bounded.
+ *
+ * @sa
+ * vtkChunkedImageReader
+*/
+
+#ifndef vtkChunkedImageWriter_h
+#define vtkChunkedImageWriter_h
+
+#include "vtkIOImageModule.h" // For export macro
+#include "vtkWriter.h"
+
+class vtkImageData;
+
+class VTKIOIMAGE_EXPORT vtkChunkedImageWriter : public vtkWriter
+{
+public:
+  static vtkChunkedImageWriter *New();
+  vtkTypeMacro(vtkChunkedImageWriter,vtkWriter);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Get the input to this writer.
+   */
+  vtkImageData* GetInput();
+  vtkImageData* GetInput(int port);
+  //@}
+
+  //@{
+  /**
+   * Specify file name of the chunked image file to write.
+   */
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of points along each axis of a chunk. Smaller chunks
+   * make small sub-extent reads cheaper at the cost of a larger index and a
+   * lower compression ratio. The default is 64x64x64.
+   */
+  vtkSetVector3Macro(ChunkDimensions, int);
+  vtkGetVector3Macro(ChunkDimensions, int);
+  //@}
+
+  /**
+   * Enumerate the supported compressors.
+   */
+  enum CompressorType
+  {
+    NONE,
+    ZLIB,
+    LZ4
+  };
+
+  //@{
+  /**
+   * Set/Get the compressor applied to every chunk. The default is ZLIB.
+   */
+  vtkSetClampMacro(CompressorType, int, NONE, LZ4);
+  vtkGetMacro(CompressorType, int);
+  void SetCompressorTypeToNone()
+  {
+    this->SetCompressorType(NONE);
+  }
+  void SetCompressorTypeToZLib()
+  {
+    this->SetCompressorType(ZLIB);
+  }
+  void SetCompressorTypeToLZ4()
+  {
+    this->SetCompressorType(LZ4);
+  }
+  //@}
+
+  //@{
+  /**
+   * Set/Get an upper bound, in bytes, on the uncompressed chunk data that is
+   * compressed concurrently before being written. The default is 64 MiB.
+   */
+  vtkSetClampMacro(MaximumBatchSize, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(MaximumBatchSize, vtkIdType);
+  //@}
+
+protected:
+  vtkChunkedImageWriter();
+  ~vtkChunkedImageWriter() override;
+
+  void WriteData() override;
+  int FillInputPortInformation(int port, vtkInformation *info) override;
+
+  char* FileName;
+  int ChunkDimensions[3];
+  int CompressorType;
+  vtkIdType MaximumBatchSize;
+
+private:
+  vtkChunkedImageWriter(const vtkChunkedImageWriter&) = delete;
+  void operator=(const vtkChunkedImageWriter&) = delete;
+};
+
+#endif
@@ -22,6 +22,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkErrorCode.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 
@@ -72,6 +73,8 @@ vtkImageReader2::vtkImageReader2()
   this->FileNameSliceOffset = 0;
   this->FileNameSliceSpacing = 1;
 
+  this->ParallelSliceReading = 0;
+
   // Left over from short reader
   this->SwapBytes = 0;
   this->FileLowerLeft = 0;
@@ -407,6 +410,8 @@ void vtkImageReader2::PrintSelf(ostream& os, vtkIndent indent)
      << this->FileNameSliceOffset << "\n";
   os << indent << "FileNameSliceSpacing: "
      << this->FileNameSliceSpacing << "\n";
+  os << indent << "ParallelSliceReading: "
+     << (this->ParallelSliceReading ? "On\n" : "Off\n");
 
   os << indent << "DataScalarType: "
      << vtkImageScalarTypeNameMacro(this->DataScalarType) << "\n";
@@ -689,6 +694,143 @@ void vtkImageReader2::SeekFile(int i, int j, int k)
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkImageReader2::UseParallelSliceReading(const int extent[6])
+{
+  return (this->ParallelSliceReading &&
+          this->GetFileDimensionality() == 2 &&
+          extent[5] > extent[4] &&
+          this->MemoryBuffer == nullptr &&
+          (this->FileNames || (this->FilePattern && !this->FileName)));
+}
+
+//----------------------------------------------------------------------------
+void vtkImageReader2::ComputeSliceFileNames(const int extent[6],
+                                            std::vector<std::string>& fileNames)
+{
+  fileNames.clear();
+  for (int idx2 = extent[4]; idx2 <= extent[5]; ++idx2)
+  {
+    this->ComputeInternalFileName(idx2);
+    fileNames.push_back(this->InternalFileName ? this->InternalFileName : "");
+  }
+}
+
+//----------------------------------------------------------------------------
+// Reads whole slices of a stack of 2D raw files. Every slice is read through
+// its own stream so that vtkSMPTools may process slices concurrently.
+template <class OT>
+class vtkImageReader2SliceFunctor
+{
+public:
+  vtkImageReader2 *Self;
+  OT *OutPtr;
+  int *OutExtent;
+  vtkIdType *OutIncr;
+  const std::vector<std::string> *FileNames;
+  const std::vector<unsigned long> *HeaderSizes;
+  std::vector<char> *Failed;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    int *dataExtent = this->Self->GetDataExtent();
+    unsigned long *dataIncr = this->Self->GetDataIncrements();
+    int nComponents = this->Self->GetNumberOfScalarComponents();
+    int pixelRead = this->OutExtent[1] - this->OutExtent[0] + 1;
+    std::streamsize streamRead =
+      static_cast<std::streamsize>(pixelRead*nComponents*sizeof(OT));
+
+    for (vtkIdType slice = begin; slice < end; ++slice)
+    {
+      if (this->Self->GetAbortExecute())
+      {
+        return;
+      }
+#ifdef _WIN32
+      ifstream file((*this->FileNames)[slice].c_str(), ios::in | ios::binary);
+#else
+      ifstream file((*this->FileNames)[slice].c_str(), ios::in);
+#endif
+      if (file.fail())
+      {
+        (*this->Failed)[slice] = 1;
+        continue;
+      }
+
+      OT *outPtr1 = this->OutPtr + slice*this->OutIncr[2];
+      for (int idx1 = this->OutExtent[2]; idx1 <= this->OutExtent[3]; ++idx1)
+      {
+        // same offset as SeekFile() computes for two dimensional files
+        unsigned long streamStart =
+          (this->OutExtent[0] - dataExtent[0]) * dataIncr[0];
+        if (this->Self->GetFileLowerLeft())
+        {
+          streamStart += (idx1 - dataExtent[2]) * dataIncr[1];
+        }
+        else
+        {
+          streamStart += (dataExtent[3] - dataExtent[2] - idx1) * dataIncr[1];
+        }
+        streamStart += (*this->HeaderSizes)[slice];
+
+        file.seekg(static_cast<long>(streamStart), ios::beg);
+        if (file.fail() || !file.read(reinterpret_cast<char *>(outPtr1), streamRead))
+        {
+          (*this->Failed)[slice] = 1;
+          break;
+        }
+        if (this->Self->GetSwapBytes() && sizeof(OT) > 1)
+        {
+          vtkByteSwap::SwapVoidRange(outPtr1, pixelRead*nComponents, sizeof(OT));
+        }
+        outPtr1 += this->OutIncr[1];
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Read the slices of a 2D file stack concurrently.
+template <class OT>
+void vtkImageReader2ParallelUpdate(vtkImageReader2 *self,
+                                   const std::vector<std::string>& fileNames,
+                                   int outExtent[6], vtkIdType outIncr[3],
+                                   OT *outPtr)
+{
+  vtkIdType numSlices = static_cast<vtkIdType>(fileNames.size());
+
+  // GetHeaderSize() may compute the internal file name, so query it here
+  // rather than from the worker threads.
+  std::vector<unsigned long> headerSizes(numSlices);
+  for (vtkIdType slice = 0; slice < numSlices; ++slice)
+  {
+    headerSizes[slice] = self->GetHeaderSize(
+      static_cast<unsigned long>(outExtent[4] + slice));
+  }
+
+  std::vector<char> failed(numSlices, 0);
+  vtkImageReader2SliceFunctor<OT> functor;
+  functor.Self = self;
+  functor.OutPtr = outPtr;
+  functor.OutExtent = outExtent;
+  functor.OutIncr = outIncr;
+  functor.FileNames = &fileNames;
+  functor.HeaderSizes = &headerSizes;
+  functor.Failed = &failed;
+  vtkSMPTools::For(0, numSlices, 1, functor);
+
+  for (vtkIdType slice = 0; slice < numSlices; ++slice)
+  {
+    if (failed[slice])
+    {
+      vtkGenericWarningMacro("File operation failed while reading "
+                             << fileNames[slice]);
+      return;
+    }
+  }
+  self->UpdateProgress(1.0);
+}
+
 //----------------------------------------------------------------------------
 // This function reads in one data of data.
 // templated to handle different data types.
@@ -717,6 +859,14 @@ void vtkImageReader2Update(vtkImageReader2 *self, vtkImageData *data, OT *outPtr
                            (outExtent[3]-outExtent[2]+1)/50.0);
   target++;
 
+  if (self->UseParallelSliceReading(outExtent))
+  {
+    std::vector<std::string> fileNames;
+    self->ComputeSliceFileNames(outExtent, fileNames);
+    vtkImageReader2ParallelUpdate(self, fileNames, outExtent, outIncr, outPtr);
+    return;
+  }
+
   // read the data row by row
   if (self->GetFileDimensionality() == 3)
   {
@@ -44,6 +44,9 @@
 #include "vtkIOImageModule.h" // For export macro
 #include "vtkImageAlgorithm.h"
 
+#include <string> // for ComputeSliceFileNames
+#include <vector> // for ComputeSliceFileNames
+
 class vtkStringArray;
 
 #define VTK_FILE_BYTE_ORDER_BIG_ENDIAN 0
@@ -243,6 +246,20 @@ public:
   vtkBooleanMacro(SwapBytes,int);
   //@}
 
+  //@{
+  /**
+   * When reading a stack of 2D files (one file per slice, given through
+   * FileNames or FilePattern), decode several slices concurrently with
+   * vtkSMPTools. Each slice is opened with its own stream and decoder and
+   * written straight into the output image, so the speedup grows with the
+   * number of slices read per update. Readers that do not support it
+   * (e.g. those with per-file state) ignore this flag. Off by default.
+   */
+  vtkSetMacro(ParallelSliceReading, int);
+  vtkGetMacro(ParallelSliceReading, int);
+  vtkBooleanMacro(ParallelSliceReading, int);
+  //@}
+
   ifstream *GetFile() {return this->File;}
   vtkGetVectorMacro(DataIncrements,unsigned long,4);
 
@@ -267,6 +284,21 @@ public:
   vtkGetStringMacro(InternalFileName);
   //@}
 
+  /**
+   * Return 1 if the slices of the given output extent should be read in
+   * parallel, i.e. ParallelSliceReading is on, the extent spans several
+   * slices stored in separate files and no memory buffer is used.
+   */
+  int UseParallelSliceReading(const int extent[6]);
+
+  /**
+   * Compute the file name of every slice of the extent, in order. This calls
+   * ComputeInternalFileName() on the calling thread so that worker threads
+   * never touch InternalFileName.
+   */
+  void ComputeSliceFileNames(const int extent[6],
+                             std::vector<std::string>& fileNames);
+
   /**
    * Return non zero if the reader can read the given file name.
    * Should be implemented by all sub-classes of vtkImageReader2.
@@ -332,6 +364,8 @@ protected:
   int FileNameSliceOffset;
   int FileNameSliceSpacing;
 
+  int ParallelSliceReading;
+
   int RequestInformation(vtkInformation* request,
                                  vtkInformationVector** inputVector,
                                  vtkInformationVector* outputVector) override;
@@ -18,9 +18,13 @@
 #include "vtkImageData.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkToolkits.h"
 #include <vtksys/SystemTools.hxx>
 
+#include <string>
+#include <vector>
+
 extern "C" {
 #include "vtk_jpeg.h"
 #include <csetjmp>
@@ -221,8 +225,8 @@ void vtkJPEGReader::ExecuteInformation()
 }
 
 template <class OT>
-int vtkJPEGReaderUpdate2(vtkJPEGReader *self, OT *outPtr,
-                          int *outExt, vtkIdType *outInc, long)
+int vtkJPEGReaderUpdate2(vtkJPEGReader *self, const char *fileName,
+                         OT *outPtr, int *outExt, vtkIdType *outInc, long)
 {
   // certain variables must be stored here for longjmp
   struct vtk_jpeg_error_mgr jerr;
@@ -231,7 +235,7 @@ int vtkJPEGReaderUpdate2(vtkJPEGReader *self, OT *outPtr,
 
   if (!self->GetMemoryBuffer())
   {
-    jerr.fp = vtksys::SystemTools::Fopen(self->GetInternalFileName(), "rb");
+    jerr.fp = vtksys::SystemTools::Fopen(fileName, "rb");
     if (!jerr.fp)
     {
       return 1;
@@ -326,6 +330,32 @@ int vtkJPEGReaderUpdate2(vtkJPEGReader *self, OT *outPtr,
   return 0;
 }
 
+//----------------------------------------------------------------------------
+// Decodes whole slices of a JPEG stack, each with its own decompressor, so
+// that vtkSMPTools may process slices concurrently.
+template <class OT>
+class vtkJPEGReaderSliceFunctor
+{
+public:
+  vtkJPEGReader *Self;
+  OT *OutPtr;
+  int *OutExtent;
+  vtkIdType *OutIncr;
+  long PixSize;
+  const std::vector<std::string> *FileNames;
+  std::vector<int> *Results;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType slice = begin; slice < end && !this->Self->GetAbortExecute(); ++slice)
+    {
+      (*this->Results)[slice] = vtkJPEGReaderUpdate2(this->Self,
+        (*this->FileNames)[slice].c_str(), this->OutPtr + slice*this->OutIncr[2],
+        this->OutExtent, this->OutIncr, this->PixSize);
+    }
+  }
+};
+
 //----------------------------------------------------------------------------
 // This function reads in one data of data.
 // templated to handle different data types.
@@ -341,13 +371,42 @@ void vtkJPEGReaderUpdate(vtkJPEGReader *self, vtkImageData *data, OT *outPtr)
 
   long pixSize = data->GetNumberOfScalarComponents()*sizeof(OT);
 
+  if (self->UseParallelSliceReading(outExtent))
+  {
+    std::vector<std::string> fileNames;
+    self->ComputeSliceFileNames(outExtent, fileNames);
+    std::vector<int> results(fileNames.size(), 0);
+
+    vtkJPEGReaderSliceFunctor<OT> functor;
+    functor.Self = self;
+    functor.OutPtr = outPtr;
+    functor.OutExtent = outExtent;
+    functor.OutIncr = outIncr;
+    functor.PixSize = pixSize;
+    functor.FileNames = &fileNames;
+    functor.Results = &results;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(fileNames.size()), 1, functor);
+
+    for (size_t slice = 0; slice < results.size(); ++slice)
+    {
+      if (results[slice] == 2)
+      {
+        vtkErrorWithObjectMacro(self, "libjpeg could not read file: "
+                                << fileNames[slice]);
+      }
+    }
+    self->UpdateProgress(1.0);
+    return;
+  }
+
   outPtr2 = outPtr;
   int idx2;
   for (idx2 = outExtent[4]; idx2 <= outExtent[5]; ++idx2)
   {
     self->ComputeInternalFileName(idx2);
     // read in a JPEG file
-    if ( vtkJPEGReaderUpdate2(self, outPtr2, outExtent, outIncr, pixSize) == 2 )
+    if ( vtkJPEGReaderUpdate2(self, self->GetInternalFileName(),
+                              outPtr2, outExtent, outIncr, pixSize) == 2 )
     {
       const char* fn = self->GetInternalFileName();
       vtkErrorWithObjectMacro(self, "libjpeg could not read file: " << fn);
@@ -0,0 +1,153 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompositeDataWriterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write a multiblock dataset with ParallelBlockWriting on and off and check
+// that both files read back to the same blocks.
+
+#include "vtkCallbackCommand.h"
+#include "vtkDataSet.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLMultiBlockDataReader.h"
+#include "vtkXMLMultiBlockDataWriter.h"
+
+#include <string>
+
+namespace
+{
+// Count the progress events reported while the blocks are written, before
+// the meta file
+void CountProgress(vtkObject* caller, unsigned long, void* clientData, void*)
+{
+  double progress = vtkAlgorithm::SafeDownCast(caller)->GetProgress();
+  if (progress > 0.0 && progress < 0.5)
+  {
+    ++*static_cast<int*>(clientData);
+  }
+}
+}
+
+int TestXMLCompositeDataWriterParallel(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    cerr << "Could not determine temporary directory." << endl;
+    return EXIT_FAILURE;
+  }
+  std::string prefix = std::string(tempDir) + "/TestXMLCompositeDataWriterParallel";
+  delete[] tempDir;
+
+  const unsigned int numBlocks = 6;
+  vtkNew<vtkMultiBlockDataSet> mb;
+  mb->SetNumberOfBlocks(numBlocks + 2);
+  for (unsigned int i = 0; i < numBlocks; ++i)
+  {
+    if (i % 2)
+    {
+      vtkNew<vtkSphereSource> sphere;
+      sphere->SetThetaResolution(8 + 4 * i);
+      sphere->SetPhiResolution(8 + 2 * i);
+      sphere->SetCenter(i, 0, 0);
+      sphere->Update();
+      mb->SetBlock(i, sphere->GetOutput());
+    }
+    else
+    {
+      vtkNew<vtkImageData> image;
+      image->SetDimensions(5 + i, 6, 7);
+      image->SetOrigin(0, i, 0);
+      mb->SetBlock(i, image.GetPointer());
+    }
+  }
+  // The same dataset in two blocks must still be written correctly.
+  mb->SetBlock(numBlocks, mb->GetBlock(1));
+  // So must two datasets that share their points and point data.
+  vtkPolyData* sphere = vtkPolyData::SafeDownCast(mb->GetBlock(3));
+  vtkNew<vtkPolyData> shared;
+  shared->SetPoints(sphere->GetPoints());
+  shared->GetPointData()->ShallowCopy(sphere->GetPointData());
+  mb->SetBlock(numBlocks + 1, shared.GetPointer());
+
+  vtkSmartPointer<vtkMultiBlockDataSet> outputs[2];
+  for (int parallel = 0; parallel < 2; ++parallel)
+  {
+    std::string fileName = prefix + (parallel ? "_parallel.vtm" : "_serial.vtm");
+    vtkNew<vtkXMLMultiBlockDataWriter> writer;
+    writer->SetInputData(mb.GetPointer());
+    writer->SetFileName(fileName.c_str());
+    writer->SetParallelBlockWriting(parallel);
+    writer->SetDataModeToAppended();
+    writer->SetCompressorTypeToZLib();
+    int numProgress = 0;
+    vtkNew<vtkCallbackCommand> progressObserver;
+    progressObserver->SetCallback(CountProgress);
+    progressObserver->SetClientData(&numProgress);
+    writer->AddObserver(vtkCommand::ProgressEvent, progressObserver.GetPointer());
+    if (!writer->Write())
+    {
+      cerr << "Writing failed with ParallelBlockWriting=" << parallel << endl;
+      return EXIT_FAILURE;
+    }
+    if (numProgress == 0)
+    {
+      cerr << "No progress reported with ParallelBlockWriting=" << parallel << endl;
+      return EXIT_FAILURE;
+    }
+
+    vtkNew<vtkXMLMultiBlockDataReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    outputs[parallel] = vtkMultiBlockDataSet::SafeDownCast(reader->GetOutputDataObject(0));
+    if (!outputs[parallel] || outputs[parallel]->GetNumberOfBlocks() != numBlocks + 2)
+    {
+      cerr << "Wrong number of blocks read back." << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  for (unsigned int i = 0; i <= numBlocks + 1; ++i)
+  {
+    vtkDataSet* expected = vtkDataSet::SafeDownCast(mb->GetBlock(i));
+    for (int parallel = 0; parallel < 2; ++parallel)
+    {
+      vtkDataSet* ds = vtkDataSet::SafeDownCast(outputs[parallel]->GetBlock(i));
+      if (!ds || ds->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+          ds->GetNumberOfCells() != expected->GetNumberOfCells())
+      {
+        cerr << "Block " << i << " differs with ParallelBlockWriting="
+             << parallel << endl;
+        return EXIT_FAILURE;
+      }
+      double p[3], q[3];
+      vtkIdType last = expected->GetNumberOfPoints() - 1;
+      ds->GetPoint(last, p);
+      expected->GetPoint(last, q);
+      if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+      {
+        cerr << "Block " << i << " has wrong points." << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
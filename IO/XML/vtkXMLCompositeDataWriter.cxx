@@ -14,7 +14,10 @@
 =========================================================================*/
 #include "vtkXMLCompositeDataWriter.h"
 
+#include "vtkAtomic.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataObjectTreeIterator.h"
@@ -26,9 +29,14 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -40,6 +48,7 @@
 
 #include <vtksys/SystemTools.hxx>
 #include <map>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -58,6 +67,8 @@ public:
   std::string FilePrefix;
   vtkSmartPointer<vtkXMLDataElement> Root;
   std::vector<int> DataTypes;
+  // Writers whose file name is set but that have not written yet.
+  std::vector<vtkXMLWriter*> PendingWriters;
 
   // Get the default extension for the dataset_type. Will return nullptr if an
   // extension cannot be determined.
@@ -83,12 +94,113 @@ public:
   }
 };
 
+//----------------------------------------------------------------------------
+// Collect the arrays a leaf writer may read or compute the range of.
+static void vtkXMLCompositeDataWriterAddArrays(vtkFieldData* fd,
+                                               std::vector<vtkAbstractArray*>& arrays)
+{
+  for (int i = 0; fd && i < fd->GetNumberOfArrays(); ++i)
+  {
+    arrays.push_back(fd->GetAbstractArray(i));
+  }
+}
+
+static void vtkXMLCompositeDataWriterAddCells(vtkCellArray* cells,
+                                              std::vector<vtkAbstractArray*>& arrays)
+{
+  if (cells)
+  {
+    arrays.push_back(cells->GetData());
+  }
+}
+
+static void vtkXMLCompositeDataWriterCollectArrays(vtkDataObject* data,
+                                                   std::vector<vtkAbstractArray*>& arrays)
+{
+  arrays.clear();
+  if (!data)
+  {
+    return;
+  }
+  vtkXMLCompositeDataWriterAddArrays(data->GetFieldData(), arrays);
+  if (vtkTable* table = vtkTable::SafeDownCast(data))
+  {
+    vtkXMLCompositeDataWriterAddArrays(table->GetRowData(), arrays);
+  }
+  vtkDataSet* ds = vtkDataSet::SafeDownCast(data);
+  if (!ds)
+  {
+    return;
+  }
+  vtkXMLCompositeDataWriterAddArrays(ds->GetPointData(), arrays);
+  vtkXMLCompositeDataWriterAddArrays(ds->GetCellData(), arrays);
+  if (vtkPointSet* ps = vtkPointSet::SafeDownCast(ds))
+  {
+    if (ps->GetPoints())
+    {
+      arrays.push_back(ps->GetPoints()->GetData());
+    }
+  }
+  if (vtkRectilinearGrid* rg = vtkRectilinearGrid::SafeDownCast(ds))
+  {
+    arrays.push_back(rg->GetXCoordinates());
+    arrays.push_back(rg->GetYCoordinates());
+    arrays.push_back(rg->GetZCoordinates());
+  }
+  if (vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    vtkXMLCompositeDataWriterAddCells(ug->GetCells(), arrays);
+    arrays.push_back(ug->GetCellTypesArray());
+    arrays.push_back(ug->GetCellLocationsArray());
+  }
+  if (vtkPolyData* pd = vtkPolyData::SafeDownCast(ds))
+  {
+    vtkXMLCompositeDataWriterAddCells(pd->GetVerts(), arrays);
+    vtkXMLCompositeDataWriterAddCells(pd->GetLines(), arrays);
+    vtkXMLCompositeDataWriterAddCells(pd->GetPolys(), arrays);
+    vtkXMLCompositeDataWriterAddCells(pd->GetStrips(), arrays);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Runs the Write() of a range of independent leaf writers. The finished
+// leaves are counted by all the threads, and the progress is reported from
+// the thread that called WriteData() since the observers of the writer need
+// not be thread safe.
+class vtkXMLCompositeDataWriterFunctor
+{
+public:
+  std::vector<vtkXMLWriter*>* Writers;
+  vtkXMLCompositeDataWriter* Self;
+  vtkMultiThreaderIDType Caller;
+  vtkAtomic<vtkIdType> NumberOfWritten;
+  vtkIdType NumberOfWriters;
+  float ProgressRange[2];
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      (*this->Writers)[i]->Write();
+      vtkIdType written = ++this->NumberOfWritten;
+      if (vtkMultiThreader::ThreadsEqual(this->Caller,
+                                         vtkMultiThreader::GetCurrentThreadID()))
+      {
+        this->Self->UpdateProgress(this->ProgressRange[0] +
+          (this->ProgressRange[1] - this->ProgressRange[0]) * written /
+          this->NumberOfWriters);
+      }
+    }
+  }
+};
+
 //----------------------------------------------------------------------------
 vtkXMLCompositeDataWriter::vtkXMLCompositeDataWriter()
 {
   this->Internal = new vtkXMLCompositeDataWriterInternals;
   this->GhostLevel = 0;
   this->WriteMetaFile = 1;
+  this->ParallelBlockWriting = 0;
 
   // Setup a callback for the internal writers to report progress.
   this->InternalProgressObserver = vtkCallbackCommand::New();
@@ -129,6 +241,7 @@ void vtkXMLCompositeDataWriter::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "GhostLevel: " << this->GhostLevel << endl;
   os << indent << "WriteMetaFile: " << this->WriteMetaFile<< endl;
+  os << indent << "ParallelBlockWriting: " << this->ParallelBlockWriting << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -228,8 +341,11 @@ int vtkXMLCompositeDataWriter::RequestData(vtkInformation*,
   this->Internal->Root->SetName(compositeData->GetClassName());
 
   int writerIdx = 0;
-  if (!this->WriteComposite(compositeData, this->Internal->Root, writerIdx))
+  this->Internal->PendingWriters.clear();
+  if (!this->WriteComposite(compositeData, this->Internal->Root, writerIdx) ||
+      !this->WritePendingData(progressRange))
   {
+    this->Internal->PendingWriters.clear();
     this->RemoveWrittenFiles(subdir.c_str());
     return 0;
   }
@@ -298,6 +414,13 @@ int vtkXMLCompositeDataWriter::WriteNonCompositeData(
 
   writer->SetFileName(full.c_str());
 
+  if (this->ParallelBlockWriting)
+  {
+    // Written later by WritePendingData().
+    this->Internal->PendingWriters.push_back(writer);
+    return 1;
+  }
+
   // Write the data.
   writer->AddObserver(vtkCommand::ProgressEvent, this->InternalProgressObserver);
   writer->Write();
@@ -312,6 +435,71 @@ int vtkXMLCompositeDataWriter::WriteNonCompositeData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkXMLCompositeDataWriter::WritePendingData(const float progressRange[2])
+{
+  std::vector<vtkXMLWriter*>& pending = this->Internal->PendingWriters;
+  if (pending.empty())
+  {
+    return 1;
+  }
+
+  // A dataset referenced by several blocks would have its pipeline
+  // information updated by several writers at once, and an array shared by
+  // several datasets (e.g. their vtkPoints) would have its cached range
+  // computed by several writers at once. The writers of blocks that share
+  // their dataset or any array with a previous block are run serially,
+  // after the concurrent ones.
+  std::vector<vtkXMLWriter*> concurrent;
+  std::vector<vtkXMLWriter*> serial;
+  std::set<vtkObject*> used;
+  std::vector<vtkAbstractArray*> arrays;
+  for (size_t i = 0; i < pending.size(); ++i)
+  {
+    vtkDataObject* input = pending[i]->GetInputDataObject(0, 0);
+    vtkXMLCompositeDataWriterCollectArrays(input, arrays);
+    bool shared = used.count(input) > 0;
+    for (size_t j = 0; j < arrays.size() && !shared; ++j)
+    {
+      shared = arrays[j] && used.count(arrays[j]) > 0;
+    }
+    if (shared)
+    {
+      serial.push_back(pending[i]);
+      continue;
+    }
+    used.insert(input);
+    used.insert(arrays.begin(), arrays.end());
+    concurrent.push_back(pending[i]);
+  }
+
+  vtkXMLCompositeDataWriterFunctor functor;
+  functor.Self = this;
+  functor.Caller = vtkMultiThreader::GetCurrentThreadID();
+  functor.NumberOfWritten = 0;
+  functor.NumberOfWriters = static_cast<vtkIdType>(pending.size());
+  functor.ProgressRange[0] = progressRange[0];
+  functor.ProgressRange[1] = progressRange[1];
+  functor.Writers = &concurrent;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(concurrent.size()), 1, functor);
+  functor.Writers = &serial;
+  functor(0, static_cast<vtkIdType>(serial.size()));
+
+  int result = 1;
+  for (size_t i = 0; i < pending.size(); ++i)
+  {
+    if (pending[i]->GetErrorCode() == vtkErrorCode::OutOfDiskSpaceError)
+    {
+      this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+      vtkErrorMacro("Ran out of disk space; deleting file: " << this->FileName);
+      result = 0;
+      break;
+    }
+  }
+  pending.clear();
+  return result;
+}
+
 //----------------------------------------------------------------------------
 int vtkXMLCompositeDataWriter::WriteData()
 {
@@ -66,6 +66,24 @@ public:
   virtual void SetWriteMetaFile(int flag);
   //@}
 
+  //@{
+  /**
+   * When on, the leaf datasets are not written one after the other while
+   * the hierarchy is traversed. Instead they are collected and then
+   * encoded and written concurrently with vtkSMPTools, each by its own
+   * writer into its own file, so that compression and base64 encoding of
+   * one block overlap with disk writes of another. Blocks that share their
+   * dataset or any array (e.g. their points) with another block are written
+   * serially afterwards. No memory budget is enforced: each thread encodes
+   * and writes one block at a time with its own buffers. Progress is then
+   * reported per finished block, from the calling thread only. Off by
+   * default.
+   */
+  vtkSetMacro(ParallelBlockWriting, int);
+  vtkGetMacro(ParallelBlockWriting, int);
+  vtkBooleanMacro(ParallelBlockWriting, int);
+  //@}
+
   /**
    * See the vtkAlgorithm for a description of what these do
    */
@@ -136,6 +154,13 @@ protected:
    */
   const char* GetDefaultFileExtensionForDataSet(int dataset_type);
 
+  /**
+   * Write the leaf datasets queued by WriteNonCompositeData() when
+   * ParallelBlockWriting is on, reporting the progress of the finished
+   * leaves over the given range. Returns 0 on error.
+   */
+  int WritePendingData(const float progressRange[2]);
+
   /**
    * Write the collection file if it is requested.
    * This is overridden in parallel writers to communicate the hierarchy to the
@@ -162,6 +187,9 @@ protected:
    */
   int WriteMetaFile;
 
+  // Whether leaf datasets are written concurrently.
+  int ParallelBlockWriting;
+
   // Callback registered with the InternalProgressObserver.
   static void ProgressCallbackFunction(vtkObject*, unsigned long, void*,
                                        void*);
@@ -125,7 +125,12 @@ int vtkXMLMultiBlockDataWriter::WriteComposite(vtkCompositeDataSet* compositeDat
       }
       vtkStdString fileName = this->CreatePieceFileName(writerIdx);
 
-      this->SetProgressRange(progressRange, writerIdx, toBeWritten);
+      // Queued blocks report their progress once written, in
+      // WritePendingData().
+      if (!this->GetParallelBlockWriting())
+      {
+        this->SetProgressRange(progressRange, writerIdx, toBeWritten);
+      }
       if (this->WriteNonCompositeData( curDO, datasetXML, writerIdx,
                                        fileName.c_str()))
       {
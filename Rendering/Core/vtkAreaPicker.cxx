@@ -418,6 +418,16 @@ int vtkAreaPicker::ABoxFrustumIsect(double *bounds, double &mindist)
   return this->FrustumExtractor->OverallBoundsTest(bounds);
 }
 
+//--------------------------------------------------------------------------
+void vtkAreaPicker::SelectIds(vtkDataSet *input, int fieldType,
+                              vtkSelection *selection)
+{
+  this->FrustumExtractor->SetFieldType(fieldType);
+  this->FrustumExtractor->SetContainingCells(0);
+  this->FrustumExtractor->SetInsideOut(0);
+  this->FrustumExtractor->SelectIds(input, selection);
+}
+
 //--------------------------------------------------------------------------
 void vtkAreaPicker::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -37,6 +37,10 @@
  * position, you will get the centroid of the pick frustum. This may be outside
  * of all props in the prop list.
  *
+ * SelectIds() selects the cells or points of a dataset inside the frustum,
+ * exactly and in parallel, which does not need a graphics context unlike
+ * vtkHardwareSelector.
+ *
  * @sa
  * vtkInteractorStyleRubberBandPick, vtkExtractSelectedFrustum.
 */
@@ -55,6 +59,7 @@ class vtkAbstractMapper3D;
 class vtkDataSet;
 class vtkExtractSelectedFrustum;
 class vtkProp;
+class vtkSelection;
 
 class VTKRENDERINGCORE_EXPORT vtkAreaPicker : public vtkAbstractPropPicker
 {
@@ -131,6 +136,16 @@ public:
   vtkGetObjectMacro(ClipPoints, vtkPoints);
   //@}
 
+  /**
+   * Select the cells or points (fieldType is vtkSelectionNode::CELL or
+   * vtkSelectionNode::POINT) of a dataset that intersect the frustum of the
+   * last pick, without rendering. The selection holds their ids and can be
+   * given to vtkExtractSelection; see vtkExtractSelectedFrustum::SelectIds().
+   * The bounds used to cull the cells are kept between calls, so repeated
+   * selections on the same dataset are faster.
+   */
+  void SelectIds(vtkDataSet *input, int fieldType, vtkSelection *selection);
+
 protected:
   vtkAreaPicker();
   ~vtkAreaPicker() override;